@@ -4,8 +4,8 @@
 
     /* Multiboot header */
     .set MAGIC,    0x1BADB002      /* magic */
-    /* Flags: Bit 0 (bellek bilgisi) ve Bit 6 (bellek haritası) set edilmeli */
-    .set FLAGS,    (1<<0) | (1<<6)
+    /* Flags: Bit 0 (modüller sayfa hizalı yüklensin), Bit 1 (bellek bilgisi ve haritası) */
+    .set FLAGS,    (1<<0) | (1<<1)
     .set CHECKSUM, -(MAGIC + FLAGS)
 
     .long MAGIC
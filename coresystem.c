@@ -13,6 +13,24 @@
 #include "kernel/utils.h"
 #include "kernel/vga.h"
 #include "kernel/string.h"
+#include "kernel/klog.h"
+#include "kernel/keyboard.h"
+#include "kernel/serial.h"
+#include "kernel/printf.h"
+#include "kernel/memory.h"
+#include "kernel/vfs.h"
+#include "kernel/ramfs.h"
+#include "kernel/vmm.h"
+#include "kernel/fdtable.h"
+#include "kernel/initrd.h"
+#include "kernel/pci.h"
+#include "kernel/ata.h"
+#include "kernel/virtio_blk.h"
+#include "kernel/sched.h"
+#include "kernel/timer.h"
+#include "kernel/bcache.h"
+#include "kernel/fat32.h"
+#include "kernel/ksyms.h"
 
 // =================================================================================================
 // BÖLÜM 0: TEMEL TİP TANIMLAMALARI VE GLOBAL AYARLAR
@@ -34,9 +52,8 @@
 #define KERNEL_HEAP_SIZE       (1024 * 1024 * 4) // 4 MB kernel yığını
 
 #define MAX_PROCESSES          64
-#define MAX_FILE_DESCRIPTORS   256
-#define MAX_FILENAME_LENGTH    128
-#define MAX_PATH_LENGTH        1024
+// MAX_FILE_DESCRIPTORS kernel/fdtable.h içinde tanımlıdır.
+// MAX_FILENAME_LENGTH ve MAX_PATH_LENGTH kernel/vfs.h içinde tanımlıdır.
 
 #define SCHEDULER_QUANTUM_MS   20 // Her sürece verilecek zaman dilimi (milisaniye)
 
@@ -66,32 +83,18 @@ void outb(uint16_t port, uint8_t value);
  */
 uint8_t inb(uint16_t port);
 
-/**
- * @brief Belirtilen bir bellek alanını belirli bir değerle doldurur.
- * @param dest Hedef bellek adresi.
- * @param val Doldurulacak değer.
- * @param len Doldurulacak byte sayısı.
- * @return Hedef bellek adresi.
- */
-// Implementations for memset/memcpy appear later in this file.
+// memset/memcpy/memmove/memcmp kernel/memory.c'de (rep movsd/stosd ve SSE2
+// non-temporal store yolları ile) implement edilmiştir; bkz. kernel/string.h.
 
 
 // --- Çekirdek Günlükleme Sistemi (Kernel Logger) ---
-typedef enum {
-    LOG_LEVEL_DEBUG,
-    LOG_LEVEL_INFO,
-    LOG_LEVEL_WARN,
-    LOG_LEVEL_ERROR,
-    LOG_LEVEL_FATAL
-} log_level_t;
+// log_level_t, kernel_log() ve KLOG() kernel/klog.h içinde tanımlıdır. Kayıtlar
+// kilitsiz bir halka tampona ikili olarak yazılır, `klog` komutu okurken biçimlendirir.
 
 /**
- * @brief Sistemin standart çıktı birimine (örn. VGA) log mesajı yazar.
- * @param level Log seviyesi.
- * @param component Mesajı üreten bileşen (örn. "PMM", "VFS").
- * @param message Log mesajı.
+ * @brief Log kayıtlarını seri porta (COM1) aktaran sink. Bölüm 9'da tanımlıdır.
  */
-void kernel_log(log_level_t level, const char* component, const char* message);
+static void klog_serial_sink(const klog_record_t* rec);
 
 
 // --- Kernel Panic Sistemi ---
@@ -132,84 +135,6 @@ static int k_atoi(const char* s) {
 // Provide standard name used elsewhere
 int atoi(const char* s) { return k_atoi(s); }
 
-// Minimal printf-like for the shell; supports %s, %d, %x, %02x, %08x
-static void shell_printf(const char* fmt, ...) {
-    char buf[512];
-    char* p = buf;
-    va_list ap;
-    va_start(ap, fmt);
-    for (const char* f = fmt; *f && (p - buf) < (int)sizeof(buf) - 1; f++) {
-        if (*f != '%') { *p++ = *f; continue; }
-        f++;
-        int pad = 0;
-        if (*f == '0') {
-            f++;
-            if (*f == '2') pad = 2;
-            if (*f == '8') pad = 8;
-            while (*f >= '0' && *f <= '9') f++; // skip any digits left
-        }
-        char numbuf[32];
-        switch (*f) {
-            case 's': {
-                const char* s = va_arg(ap, const char*);
-                while (*s && (p - buf) < (int)sizeof(buf) - 1) *p++ = *s++;
-                break;
-            }
-            case 'd': {
-                int v = va_arg(ap, int);
-                int len = 0;
-                int neg = v < 0;
-                unsigned int uv = neg ? -v : v;
-                if (uv == 0) numbuf[len++] = '0';
-                while (uv) { numbuf[len++] = '0' + (uv % 10); uv /= 10; }
-                if (neg) numbuf[len++] = '-';
-                for (int i = len - 1; i >= 0; i--) *p++ = numbuf[i];
-                break;
-            }
-            case 'x': {
-                unsigned int v = va_arg(ap, unsigned int);
-                const char* hex = "0123456789abcdef";
-                int started = 0;
-                for (int i = (sizeof(unsigned int) * 2) - 1; i >= 0; i--) {
-                    unsigned int nib = (v >> (i * 4)) & 0xF;
-                    if (nib || started || i == 0) { *p++ = hex[nib]; started = 1; }
-                }
-                break;
-            }
-            case '0': // handled above; fallthrough
-            case '2':
-            case '8': {
-                // pad-handling already advanced f; do hex with padding
-                unsigned int v = va_arg(ap, unsigned int);
-                int width = (*f == '2') ? 2 : ((*f == '8') ? 8 : 0);
-                char tmp[32]; int idx = 0;
-                const char* hex = "0123456789abcdef";
-                for (int i = width - 1; i >= 0; i--) {
-                    unsigned int nib = (v >> (i * 4)) & 0xF;
-                    tmp[idx++] = hex[nib];
-                }
-                for (int i = 0; i < idx; i++) *p++ = tmp[i];
-                break;
-            }
-            case 'c': {
-                char c = (char)va_arg(ap, int);
-                *p++ = c; break;
-            }
-            case '%': {
-                *p++ = '%'; break;
-            }
-            default: {
-                // unknown specifier: just print it
-                *p++ = *f; break;
-            }
-        }
-    }
-    *p = '\0';
-    va_end(ap);
-    write_vga_at(buf, -1, -1, 0x07);
-}
-
-
 /**************************************************************************************************/
 /*                                                                                                */
 /*                   ██████╗███████╗███╗   ███╗  ██╗   ██╗██╗   ██╗                                  */
@@ -325,115 +250,12 @@ uint32_t pmm_get_free_memory();
 // Bu bölüm, dosya sistemleri için soyut bir katman (VFS) ve bellek-içi bir dosya sistemi
 // (RamFS) implementasyonu sağlar.
 
-typedef enum {
-    FS_NODE_FILE,
-    FS_NODE_DIRECTORY,
-    FS_NODE_SYMLINK,
-    FS_NODE_DEVICE
-} fs_node_type_t;
-
-// VFS Düğüm Yapısı (Inode'un soyut hali)
-struct vfs_node;
-typedef struct vfs_node {
-    char name[MAX_FILENAME_LENGTH];
-    fs_node_type_t type;
-    uint32_t flags;
-    uint32_t permissions;
-    uint32_t uid;
-    uint32_t gid;
-    uint32_t size;
-    uint32_t creation_time;
-    uint32_t modification_time;
-
-    // Fonksiyon pointer'ları (Her dosya sistemi bunları kendi implement eder)
-    int (*open)(struct vfs_node* node, uint32_t flags);
-    int (*close)(struct vfs_node* node);
-    size_t (*read)(struct vfs_node* node, uint32_t offset, size_t size, uint8_t* buffer);
-    size_t (*write)(struct vfs_node* node, uint32_t offset, size_t size, const uint8_t* buffer);
-    struct vfs_node* (*finddir)(struct vfs_node* node, const char* name);
-    int (*mkdir)(struct vfs_node* node, const char* name, uint32_t perms);
-    int (*create)(struct vfs_node* node, const char* name, uint32_t perms);
-    
-    void* internal_data; // Dosya sistemine özel veri (örn. RamFS için data pointer'ı)
-    struct vfs_node* parent;
-    struct vfs_node* first_child;
-    struct vfs_node* next_sibling;
-
-} vfs_node_t;
-
-
-// --- RamFS Implementasyonu ---
-// RamFS, tüm dosya ve dizinleri RAM'de saklayan basit bir dosya sistemidir.
+// fs_node_type_t, vfs_node_t ve VFS fonksiyonlarının prototipleri kernel/vfs.h,
+// RamFS'inkiler kernel/ramfs.h içindedir. Yol çözümleme (vfs_lookup) kernel/vfs.c'de, dizin
+// girdisi önbelleği (dentry cache) kernel/dcache.c'de implement edilmiştir.
 
 static vfs_node_t* ramfs_root = NULL;
 
-/**
- * @brief RamFS'i başlatır ve kök dizinini ("/") oluşturur.
- */
-void ramfs_initialize();
-
-/**
- * @brief VFS arayüzünü kullanarak bir RamFS düğümü oluşturur.
- */
-vfs_node_t* ramfs_create_node(const char* name, fs_node_type_t type);
-
-
-// --- VFS Ana Fonksiyonları ---
-static vfs_node_t* vfs_root_node = NULL;
-
-/**
- * @brief Sanal dosya sistemini başlatır ve kök olarak bir dosya sistemi bağlar.
- * @param root_fs Kök olarak bağlanacak dosya sisteminin vfs_node'u.
- */
-void vfs_initialize(vfs_node_t* root_fs);
-
-/**
- * @brief Verilen bir yola (path) karşılık gelen VFS düğümünü bulur.
- * @param path Aranacak yol (örn. "/usr/bin/program").
- * @return Düğüm bulunduysa pointer'ı, bulunamadıysa NULL.
- */
-vfs_node_t* vfs_lookup(const char* path);
-
-/**
- * @brief Bir dosyayı açar.
- * @param path Dosyanın yolu.
- * @param flags Açma modları (O_RDONLY, O_WRONLY, O_CREAT vb.).
- * @return Dosya tanıtıcısı (file descriptor) numarası. Hata durumunda -1.
- */
-int vfs_open(const char* path, uint32_t flags);
-
-/**
- * @brief Açık bir dosyayı kapatır.
- * @param fd Kapatılacak dosyanın tanıtıcısı.
- */
-void vfs_close(int fd);
-
-/**
- * @brief Bir dosyadan veri okur.
- * @param fd Dosya tanıtıcısı.
- * @param buffer Okunan verinin yazılacağı tampon.
- * @param count Okunacak byte sayısı.
- * @return Okunan byte sayısı. Hata durumunda -1.
- */
-size_t vfs_read(int fd, void* buffer, size_t count);
-
-/**
- * @brief Bir dosyaya veri yazar.
- * @param fd Dosya tanıtıcısı.
- * @param buffer Yazılacak veriyi içeren tampon.
- * @param count Yazılacak byte sayısı.
- * @return Yazılan byte sayısı. Hata durumunda -1.
- */
-size_t vfs_write(int fd, const void* buffer, size_t count);
-
-/**
- * @brief Yeni bir dizin oluşturur.
- * @param path Oluşturulacak dizinin yolu.
- * @param mode İzinler.
- * @return Başarılıysa 0, hata durumunda negatif bir değer.
- */
-int vfs_mkdir(const char* path, uint32_t mode);
-
 
 /**************************************************************************************************/
 /*                                                                                                */
@@ -473,11 +295,13 @@ typedef struct pcb {
     
     uint32_t kernel_stack;       // Sürecin kernel modundaki yığınının tepesi
     uint32_t user_stack;         // Sürecin kullanıcı modundaki yığınının tepesi
+    struct mm* mm;               // Adres alanı ve VMA'lar (kernel/vmm.h); kernel thread'lerinde NULL
     
     uint32_t sleep_until_tick;   // Uyuma süresi (sistem tick'i cinsinden)
     
-    // Dosya tanıtıcıları tablosu
-    struct file_descriptor* fds[MAX_FILE_DESCRIPTORS];
+    // Dosya tanıtıcıları tablosu (kernel/fdtable.h). Küçük başlar, gerektikçe
+    // büyür; fork() ile kopyalanır, thread'ler arasında paylaşılır.
+    struct fd_table* files;
     
     // Süreç hiyerarşisi
     struct pcb* parent;
@@ -501,7 +325,9 @@ static uint32_t next_pid = 1;
 void scheduler_initialize();
 
 /**
- * @brief Yeni bir kernel-level süreç (thread) oluşturur.
+ * @brief Yeni bir kernel-level süreç (thread) oluşturur. Aynı adres alanını
+ *        ve fd tablosunu paylaşan thread'ler için kernel/sched.h: sched_clone
+ *        (CLONE_VM | CLONE_FILES | CLONE_THREAD, TLS için CLONE_SETTLS).
  * @param name Sürecin adı (debug için).
  * @param entry_point Sürecin başlangıç fonksiyonunun adresi.
  * @return Yeni sürecin PCB'sine pointer. Hata durumunda NULL.
@@ -564,6 +390,17 @@ static syscall_handler_t syscall_table[MAX_SYSCALLS];
 #define SYSCALL_MALLOC     9
 #define SYSCALL_FREE       10
 #define SYSCALL_MKDIR      11
+#define SYSCALL_MMAP       12 // arg1: mmap_args_t* (kernel/vmm.h)
+#define SYSCALL_MUNMAP     13
+#define SYSCALL_MSYNC      14
+#define SYSCALL_SHM_MAP    15 // arg1: ad, arg2: boyut (nesne yoksa oluşturulur), arg3: prot (kernel/shm.h)
+#define SYSCALL_SHM_UNLINK 16
+#define SYSCALL_PIPE       17 // arg1: int[2] (okuyan, yazan fd) (kernel/pipe.h)
+#define SYSCALL_FUTEX      18 // arg1: u32*, arg2: FUTEX_WAIT/WAKE, arg3: değer/sayı, arg4: ms (kernel/futex.h)
+#define SYSCALL_CLONE      19 // arg1: CLONE_*, arg2: kullanıcı yığını, arg3: TLS, arg4: giriş, arg5: argüman (kernel/sched.h)
+#define SYSCALL_EPOLL_CREATE 20 // Dönüş: epoll fd'si (kernel/epoll.h)
+#define SYSCALL_EPOLL_CTL    21 // arg1: epfd, arg2: EPOLL_CTL_*, arg3: fd, arg4: epoll_event_t*
+#define SYSCALL_EPOLL_WAIT   22 // arg1: epfd, arg2: epoll_event_t[], arg3: en fazla, arg4: ms
 // ... ve diğerleri
 
 /**
@@ -584,6 +421,13 @@ uint32_t sys_exit(uint32_t code, ...);
 uint32_t sys_read(uint32_t fd, uint32_t buffer, uint32_t count, ...);
 uint32_t sys_write(uint32_t fd, uint32_t buffer, uint32_t count, ...);
 uint32_t sys_getpid();
+// sys_getpid ve saat sorgularının tuzaksız (syscall'sız) sürümleri her süreçte eşli vDSO sayfasındadır (kernel/vdso.h).
+// sys_mmap, sys_munmap ve sys_msync kernel/vmm.c içindedir.
+// sys_shm_map ve sys_shm_unlink kernel/shm.c içindedir.
+// sys_pipe kernel/pipe.c içindedir.
+// sys_futex kernel/futex.c içindedir; kullanıcı tarafı mutex/condvar kernel/ulock.h'ta.
+// sys_clone kernel/sched.c içindedir.
+// sys_epoll_create, sys_epoll_ctl ve sys_epoll_wait kernel/epoll.c içindedir.
 // ...
 
 
@@ -623,6 +467,9 @@ void coreshell_main();
 
 /**
  * @brief Gelen bir komut satırını ayrıştırır ve ilgili komutu çalıştırır.
+ *        Satır '|', '<' ya da '>' içeriyorsa bir boru hattıdır: her aşama
+ *        kendi görevinde, fd 0/1'i borulara (kernel/pipe.h) ya da dosyalara
+ *        bağlı olarak aynı anda çalışır (kernel/shell.c'deki uygulama gibi).
  * @param command_line İşlenecek komut satırı.
  */
 static void shell_execute_command(char* command_line);
@@ -645,6 +492,23 @@ int cmd_panic(int argc, char* argv[]);      // Kernel panic test komutu
 // BÖLÜM 7: ANA SİSTEM BAŞLATMA RUTİNİ
 // =================================================================================================
 
+/**
+ * @brief Üzerinde FAT32 bulunan her blok aygıtını /mnt/<aygıt> altına bağlar
+ *        (örn. QEMU'ya -hda ile verilen, mkfs.vfat ile hazırlanmış imaj).
+ */
+static void mount_fat_volumes() {
+    char path[16];
+    for (blk_dev_t* dev = blk_first(); dev; dev = dev->next) {
+        vfs_node_t* root = fat32_mount(dev);
+        if (!root) continue;
+        ksnprintf(path, sizeof(path), "/mnt/%s", dev->name);
+        vfs_mkdir("/mnt", 0755);
+        if (vfs_mkdir(path, 0755) < 0 || vfs_mount(path, root) < 0) {
+            kernel_log(LOG_LEVEL_ERROR, "VFS", "Failed to mount FAT32 volume.");
+        }
+    }
+}
+
 /**
  * @brief Tüm sistem bileşenlerini belirli bir sırada başlatan ana fonksiyon.
  *        Bu fonksiyon, çekirdeğin en temel donanım kurulumları bittikten sonra
@@ -653,7 +517,10 @@ int cmd_panic(int argc, char* argv[]);      // Kernel panic test komutu
  */
 void CoreSystem_Initialize(void* boot_info) {
     // 1. Temel sistem ve günlükleme mekanizmasını başlat
-    // ...
+    klog_init();
+    mem_init();
+    serial_early_init();
+    klog_add_sink(klog_serial_sink);
     kernel_log(LOG_LEVEL_INFO, "CORE", "CoreSystem Initialization Sequence Started.");
 
     // 2. Fiziksel Bellek Yöneticisini (PMM) başlat
@@ -661,12 +528,26 @@ void CoreSystem_Initialize(void* boot_info) {
     kernel_log(LOG_LEVEL_INFO, "PMM", "Physical Memory Manager initialized.");
 
     // 3. Sanal Dosya Sistemi (VFS) ve kök RamFS'i başlat
-    // ramfs_initialize();
-    // vfs_initialize(ramfs_root);
+    ramfs_root = ramfs_initialize();
+    vfs_initialize(ramfs_root);
+    fdtable_init();
+    // GRUB'un yüklediği tar modülleri köke açılır (kopyasız, init_pmm ayırdı)
+    initrd_init((multiboot_info_t*)boot_info, ramfs_root);
+    // PCI aygıt tablosu, sonra IDE diskleri blok katmanına (hda..hdd)
+    pci_init();
+    ata_init();
     kernel_log(LOG_LEVEL_INFO, "VFS", "Virtual File System initialized with RamFS root.");
 
     // 4. Süreç yönetimi ve zamanlayıcıyı (Scheduler) başlat
     // scheduler_initialize();
+    // Çekirdek thread'leri (kernel/sched.c) ve blok önbelleğinin flusher'ı
+    sched_init();
+    timer_init();
+    // virtio diskleri (vda..) tamamlanmaları bir thread'de toplar
+    virtio_blk_init();
+    bcache_init();
+    // Disk G/Ç'si tamamlanma kesmesini bekler; bu yüzden zamanlayıcıdan sonra
+    mount_fat_volumes();
     kernel_log(LOG_LEVEL_INFO, "SCHED", "Process Manager and Scheduler initialized.");
 
     // 5. Sistem çağrısı (Syscall) arayüzünü kur
@@ -685,7 +566,9 @@ void CoreSystem_Initialize(void* boot_info) {
     // Bu noktadan sonra, sistem idle döngüsüne girmelidir.
     // Zamanlayıcı, diğer süreçlere geçişi sağlayacaktır.
     for (;;) {
-        // HLT (Halt) komutu ile işlemciyi uyut
+        // bekleyen log kayıtlarını seri porta aktar, sonra HLT ile işlemciyi uyut
+        klog_flush_sinks();
+        asm volatile("hlt");
     }
 }
 
@@ -769,12 +652,28 @@ static void panic_vga_print_hex(uint32_t n, int x, int y, uint8_t attr) {
 }
 
 /**
- * @brief Stack'in içeriğini (stack trace) ekrana basmaya çalışır.
+ * @brief Panic durumunda seri porta (polled modda) bir hex sayı yazar.
+ */
+static void panic_serial_hex(uint32_t n) {
+    const char* hex = "0123456789abcdef";
+    char buffer[11] = "0x00000000";
+    for (int i = 0; i < 8; i++) {
+        buffer[9 - i] = hex[(n >> (i * 4)) & 0xf];
+    }
+    serial_puts(buffer);
+}
+
+/**
+ * @brief Stack'in içeriğini (stack trace) ekrana basmaya çalışır. Dönüş
+ *        adresleri gömülü sembol tablosuyla "fonksiyon+0xofset" olarak yazılır
+ *        (ksyms.h; kilitsiz ve bellek ayırmadan).
  * @param ebp Hata anındaki EBP register'ının değeri.
  * @param max_frames Gösterilecek maksimum fonksiyon çağrısı sayısı.
+ * @param row Başlığın yazılacağı ekran satırı.
  */
-static void print_stack_trace(uint32_t ebp, int max_frames) {
-    panic_vga_print_str("stack trace:", 2, 8, 0x0c);
+static void print_stack_trace(uint32_t ebp, int max_frames, int row) {
+    panic_vga_print_str("stack trace:", 2, row, 0x0c);
+    serial_puts("stack trace:\n");
     uint32_t* frame_pointer = (uint32_t*)ebp;
     for (int i = 0; i < max_frames && frame_pointer; i++) {
         uint32_t return_address = frame_pointer[1];
@@ -782,11 +681,24 @@ static void print_stack_trace(uint32_t ebp, int max_frames) {
         
         char frame_num_str[4] = "[ ]";
         frame_num_str[1] = '0' + i;
-        panic_vga_print_str(frame_num_str, 4, 9 + i, 0x0e);
-        panic_vga_print_hex(return_address, 8, 9 + i, 0x0f);
+        char symbol[KSYMS_NAME_MAX];
+        ksyms_format(return_address, symbol, sizeof(symbol));
+
+        panic_vga_print_str(frame_num_str, 4, row + 1 + i, 0x0e);
+        panic_vga_print_hex(return_address, 8, row + 1 + i, 0x0f);
+        panic_vga_print_str(symbol, 20, row + 1 + i, 0x0f);
+        serial_puts("  ");
+        serial_puts(frame_num_str);
+        serial_puts(" ");
+        panic_serial_hex(return_address);
+        serial_puts(" ");
+        serial_puts(symbol);
+        serial_puts("\n");
         
-        // bir sonraki frame'e geç
-        frame_pointer = (uint32_t*)frame_pointer[0];
+        // bir sonraki frame'e geç; zincir geriye gidiyorsa yığın bozuktur
+        uint32_t* next = (uint32_t*)frame_pointer[0];
+        if (next <= frame_pointer) break;
+        frame_pointer = next;
     }
 }
 
@@ -803,6 +715,10 @@ void kernel_panic(const char* message, const char* file, uint32_t line, register
     }
     panic_in_progress = true;
 
+    // seri port kesme tabanlı çalışıyor olabilir; bekleyen çıktıyı boşaltıp
+    // polled moda geç ki çökme raporu headless çalıştırmalarda da görülsün.
+    serial_enter_polled_mode();
+
     // ekranı kırmızı arka planla temizle
     uint8_t attr = 0x4f; // beyaz üzerine kırmızı
     for (int y = 0; y < 25; y++) {
@@ -840,6 +756,14 @@ void kernel_panic(const char* message, const char* file, uint32_t line, register
     panic_vga_print_str(":", 40, 4, 0x0f);
     panic_vga_print_str(line_buf, 42, 4, 0x0f);
 
+    serial_puts("\n!!! imperium os kernel panic !!!\nreason: ");
+    serial_puts(message);
+    serial_puts("\nat: ");
+    serial_puts(file);
+    serial_puts(":");
+    serial_puts(line_buf);
+    serial_puts("\n");
+
     // eğer register bilgisi varsa, yazdır.
     if (regs) {
         panic_vga_print_str("register dump:", 2, 6, 0x0c);
@@ -856,16 +780,34 @@ void kernel_panic(const char* message, const char* file, uint32_t line, register
         panic_vga_print_str("eip:", 4, 10, 0x0c); panic_vga_print_hex(regs->eip, 9, 10, 0x0f);
         panic_vga_print_str("cs:", 24, 10, 0x0c); panic_vga_print_hex(regs->cs, 29, 10, 0x0f);
         panic_vga_print_str("eflags:", 44, 10, 0x0c); panic_vga_print_hex(regs->eflags, 52, 10, 0x0f);
+        char eip_symbol[KSYMS_NAME_MAX];
+        ksyms_format(regs->eip, eip_symbol, sizeof(eip_symbol));
+        panic_vga_print_str(eip_symbol, 9, 11, 0x0f);
+
+        serial_puts("eax="); panic_serial_hex(regs->eax);
+        serial_puts(" ebx="); panic_serial_hex(regs->ebx);
+        serial_puts(" ecx="); panic_serial_hex(regs->ecx);
+        serial_puts(" edx="); panic_serial_hex(regs->edx);
+        serial_puts("\nesi="); panic_serial_hex(regs->esi);
+        serial_puts(" edi="); panic_serial_hex(regs->edi);
+        serial_puts(" ebp="); panic_serial_hex(regs->ebp);
+        serial_puts(" esp="); panic_serial_hex(regs->esp);
+        serial_puts("\neip="); panic_serial_hex(regs->eip);
+        serial_puts(" <"); serial_puts(eip_symbol); serial_puts(">");
+        serial_puts(" cs="); panic_serial_hex(regs->cs);
+        serial_puts(" eflags="); panic_serial_hex(regs->eflags);
+        serial_puts("\n");
         
-        print_stack_trace(regs->ebp, 5);
+        print_stack_trace(regs->ebp, 5, 13);
     } else {
         // ebp'yi manuel olarak al
         uint32_t ebp;
         asm volatile("mov %%ebp, %0" : "=r"(ebp));
-        print_stack_trace(ebp, 5);
+        print_stack_trace(ebp, 5, 6);
     }
 
     panic_vga_print_str("system halted. please reboot.", 25, 23, attr);
+    serial_puts("system halted. please reboot.\n");
 
     // sistemi güvenli bir şekilde durdur.
     for (;;) {
@@ -878,40 +820,114 @@ void kernel_panic(const char* message, const char* file, uint32_t line, register
 // =================================================================================================
 // bu komutlar, coresh'e eklenir ve sistemin iç durumu hakkında bilgi verir.
 
+// kernel_log çıktısını seri porta aktaran sink (idle döngüsünde beslenir).
+static void klog_serial_sink(const klog_record_t* rec) {
+    klog_render(rec, &kprintf_serial_sink);
+}
+
+static int klog_parse_level(const char* s) {
+    for (int l = LOG_LEVEL_DEBUG; l <= LOG_LEVEL_FATAL; l++) {
+        if (strcmp(s, klog_level_name(l)) == 0) return l;
+    }
+    return -1;
+}
+
 /**
  * @brief `dmesg` benzeri, çekirdek log'larını gösteren komut.
+ *        kullanım: klog [-l seviye] [-c bileşen] [-f]
+ *        -l: verilen seviye ve üstündeki kayıtlar, -c: sadece o bileşen,
+ *        -f: yeni kayıtları takip et (bir tuşa basılana kadar).
  */
 int cmd_klog(int argc, char* argv[]) {
-    // gerçek bir implementasyonda, kernel_log fonksiyonu logları
-    // dairesel bir tampona (circular buffer) yazmalıdır.
-    // bu komut da o tamponu ekrana basmalıdır.
-    
-    // şimdilik temsili bir çıktı:
-    shell_printf("kernel log buffer (last 10 entries):\n");
-    shell_printf("[info]  core: coresystem initialization sequence started.\n");
-    shell_printf("[info]  pmm: physical memory manager initialized.\n");
-    shell_printf("[info]  vfs: virtual file system initialized with ramfs root.\n");
-    shell_printf("[info]  sched: process manager and scheduler initialized.\n");
-    shell_printf("[info]  syscall: system call interface configured.\n");
-    shell_printf("[info]  core: coresh process has been created as pid 1.\n");
-    shell_printf("[info]  core: scheduler enabled. handing over control to multitask kernel.\n");
-    shell_printf("[debug] pmm: allocated page.\n");
-    
+    int min_level = LOG_LEVEL_DEBUG;
+    int component = -1;
+    int follow = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-f") == 0) {
+            follow = true;
+        } else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
+            min_level = klog_parse_level(argv[++i]);
+            if (min_level < 0) {
+                kprintf("klog: unknown level '%s'\n", argv[i]);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            component = klog_component_lookup(argv[++i]);
+            if (component < 0) {
+                kprintf("klog: unknown component '%s'\n", argv[i]);
+                return -1;
+            }
+        } else {
+            kprintf("usage: klog [-l level] [-c component] [-f]\n");
+            return -1;
+        }
+    }
+
+    uint32_t cursor = klog_oldest_seq();
+    uint32_t key_events = keyboard_event_count();
+    klog_record_t rec;
+
+    for (;;) {
+        while (klog_read(&cursor, &rec)) {
+            if (rec.level < min_level) continue;
+            if (component >= 0 && rec.component != component) continue;
+            klog_render(&rec, &kprintf_console_sink);
+        }
+        if (!follow || keyboard_event_count() != key_events) break;
+        // bir sonraki kesmeye kadar bekle (timer, klavye veya yeni log).
+        asm volatile("hlt");
+    }
+
     return 0;
 }
 
+static const char* pci_cap_name(uint8_t id) {
+    switch (id) {
+    case PCI_CAP_PM:     return "PM";
+    case PCI_CAP_MSI:    return "MSI";
+    case PCI_CAP_VENDOR: return "Vendor";
+    case PCI_CAP_PCIE:   return "PCIe";
+    case PCI_CAP_MSIX:   return "MSI-X";
+    default:             return NULL;
+    }
+}
+
 /**
- * @brief sisteme bağlı donanımları (pci, vb.) listeleyen komut.
+ * @brief pci_init'in bulduğu aygıtları listeleyen komut.
+ *        kullanım: lspci [-v]  (-v: BAR'lar, yetenekler, kesme ve sürücü)
  */
 int cmd_lspci(int argc, char* argv[]) {
-    // bu fonksiyon, pci veri yollarını tarayarak cihazları bulmalıdır.
-    // pci konfigürasyon alanı (0xcf8 ve 0xcfc portları) okunarak yapılır.
-    shell_printf("scanning pci bus...\n");
-    shell_printf("00:00.0 host bridge: intel corporation 440fx - 82441fx pci bridge (rev 02)\n");
-    shell_printf("00:01.0 isa bridge: intel corporation 82371sb piiq3 isa bridge (rev 00)\n");
-    shell_printf("00:01.1 ide interface: intel corporation 82371sb piiq3 ide [tri-state] (rev 01)\n");
-    shell_printf("00:02.0 vga compatible controller: innotek gmbh virtualbox graphics adapter\n");
-    
+    int verbose = argc > 1 && strcmp(argv[1], "-v") == 0;
+
+    for (uint32_t i = 0; i < pci_device_count(); i++) {
+        pci_device_t* d = pci_get_device(i);
+        kprintf("%02x:%02x.%u %s [%02x%02x]: %04x:%04x (rev %02x)\n", d->bus, d->dev, d->func,
+                pci_class_name(d->class_code, d->subclass), d->class_code, d->subclass,
+                d->vendor_id, d->device_id, d->revision);
+        if (!verbose) continue;
+
+        if (d->irq_pin) kprintf("\tinterrupt: pin %c, irq %u\n", 'A' + d->irq_pin - 1, d->irq_line);
+        for (int b = 0; b < PCI_MAX_BARS; b++) {
+            pci_bar_t* bar = &d->bars[b];
+            if (!bar->base) continue;
+            if (bar->flags & PCI_BAR_IO) {
+                kprintf("\tbar%d: i/o ports at %04x [size=%u]\n", b, (uint32_t)bar->base, bar->size);
+            } else {
+                kprintf("\tbar%d: memory at %08x (%s%s) [size=%uK]\n", b, (uint32_t)bar->base,
+                        (bar->flags & PCI_BAR_MEM64) ? "64-bit" : "32-bit",
+                        (bar->flags & PCI_BAR_PREFETCH) ? ", prefetchable" : "", bar->size / 1024);
+            }
+        }
+        for (int c = 0; c < d->nr_caps; c++) {
+            const char* name = pci_cap_name(d->cap_ids[c]);
+            if (name) kprintf("\tcapability [%02x]: %s\n", d->cap_offsets[c], name);
+            else kprintf("\tcapability [%02x]: id %02x\n", d->cap_offsets[c], d->cap_ids[c]);
+        }
+        if (d->msi_vectors) kprintf("\tmsi: %u vectors%s\n", d->msi_vectors, d->msi_64bit ? ", 64-bit" : "");
+        if (d->msix_vectors) kprintf("\tmsi-x: %u vectors\n", d->msix_vectors);
+        if (d->driver) kprintf("\tdriver: %s\n", d->driver->name);
+    }
     return 0;
 }
 
@@ -930,8 +946,8 @@ int cmd_uptime(int argc, char* argv[]) {
     minutes %= 60;
     hours %= 24;
     
-    shell_printf("system up for: %d days, %d hours, %d minutes, %d seconds (%d ticks)\n",
-                 days, hours, minutes, seconds, ticks);
+    kprintf("system up for: %u days, %u hours, %u minutes, %u seconds (%u ticks)\n",
+            days, hours, minutes, seconds, ticks);
                  
     return 0;
 }
@@ -941,8 +957,8 @@ int cmd_uptime(int argc, char* argv[]) {
  * @brief belirli bir sürecin kaynak kullanımını detaylı gösterir.
  */
 int cmd_top(int argc, char* argv[]) {
-    shell_printf("pid\tstate\t\tparent\tname\n");
-    shell_printf("---------------------------------------------\n");
+    kprintf("pid\tstate\t\tparent\tname\n");
+    kprintf("---------------------------------------------\n");
     
     for(int i = 0; i < MAX_PROCESSES; i++) {
         if (process_table[i]) {
@@ -956,7 +972,7 @@ int cmd_top(int argc, char* argv[]) {
                 default:                    state_str = "unknown"; break;
             }
             
-            shell_printf("%d\t%s\t%d\t%s\n", p->pid, state_str, p->parent ? p->parent->pid : 0, "process_name");
+            kprintf("%d\t%s\t%d\t%s\n", p->pid, state_str, p->parent ? p->parent->pid : 0, "process_name");
         }
     }
     return 0;
@@ -968,12 +984,13 @@ int cmd_top(int argc, char* argv[]) {
  */
 int cmd_hexdump(int argc, char* argv[]) {
     if (argc < 3) {
-        shell_printf("usage: hexdump <address> <length>\n");
+        kprintf("usage: hexdump <address> <length>\n");
         return -1;
     }
     
-    uint32_t addr = atoi(argv[1]); // atoi'nin implementasyonu gerekli
-    uint32_t len = atoi(argv[2]);
+    // adres ve uzunluk 0x (hex), 0b (ikili) veya 0 (sekizli) önekiyle verilebilir
+    uint32_t addr = strtoul(argv[1], NULL, 0);
+    uint32_t len = strtoul(argv[2], NULL, 0);
     uint8_t* ptr = (uint8_t*)addr;
     
     char ascii_buf[17];
@@ -983,13 +1000,13 @@ int cmd_hexdump(int argc, char* argv[]) {
         // adres
         if (i % 16 == 0) {
             if (i > 0) {
-                shell_printf("  |%s|\n", ascii_buf);
+                kprintf("  |%s|\n", ascii_buf);
             }
-            shell_printf("0x%08x: ", addr + i);
+            kprintf("0x%08x: ", addr + i);
         }
         
         // hex
-        shell_printf("%02x ", ptr[i]);
+        kprintf("%02x ", ptr[i]);
         
         // ascii
         if (ptr[i] >= 32 && ptr[i] <= 126) {
@@ -1003,11 +1020,11 @@ int cmd_hexdump(int argc, char* argv[]) {
     int remainder = len % 16;
     if (remainder != 0) {
         for (int i = remainder; i < 16; i++) {
-            shell_printf("   ");
+            kprintf("   ");
             ascii_buf[i] = ' ';
         }
     }
-    shell_printf("  |%s|\n", ascii_buf);
+    kprintf("  |%s|\n", ascii_buf);
     
     return 0;
 }
@@ -1018,7 +1035,7 @@ int cmd_hexdump(int argc, char* argv[]) {
 /*
     ...
     {"klog",    "prints the kernel log buffer.", cmd_klog},
-    {"lspci",   "lists pci devices.", cmd_lspci},
+    {"lspci",   "lists pci devices (-v: bars, capabilities).", cmd_lspci},
     {"uptime",  "shows how long the system has been running.", cmd_uptime},
     {"top",     "displays information about processes.", cmd_top},
     {"hexdump", "dumps memory content.", cmd_hexdump},
@@ -1032,21 +1049,4 @@ int cmd_hexdump(int argc, char* argv[]) {
 // bu bölümde, daha önce prototipleri verilmiş olan ancak implementasyonu
 // gösterilmemiş temel fonksiyonlar yer alır.
 
-void* memset(void* dest, int val, size_t len) {
-    uint8_t* ptr = (uint8_t*)dest;
-    while (len-- > 0) {
-        *ptr++ = (uint8_t)val;
-    }
-    return dest;
-}
-
-void* memcpy(void* dest, const void* src, size_t len) {
-    uint8_t* d = (uint8_t*)dest;
-    const uint8_t* s = (const uint8_t*)src;
-    while (len-- > 0) {
-        *d++ = *s++;
-    }
-    return dest;
-}
-
-
+// memset/memcpy artık kernel/memory.c içindedir (memmove, memcmp ve zero_page ile birlikte).
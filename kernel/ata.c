@@ -0,0 +1,412 @@
+#include "ata.h"
+#include "blk.h"
+#include "pci.h"
+#include "idt.h"
+#include "io.h"
+#include "pmm.h"
+#include "klog.h"
+#include "string.h"
+
+// Komut bloğu register ofsetleri
+#define ATA_REG_DATA     0
+#define ATA_REG_ERROR    1
+#define ATA_REG_SECCOUNT 2
+#define ATA_REG_LBA0     3
+#define ATA_REG_LBA1     4
+#define ATA_REG_LBA2     5
+#define ATA_REG_DRIVE    6
+#define ATA_REG_STATUS   7 // Okuma
+#define ATA_REG_COMMAND  7 // Yazma
+
+#define ATA_SR_ERR  0x01
+#define ATA_SR_DRQ  0x08
+#define ATA_SR_DF   0x20
+#define ATA_SR_BSY  0x80
+
+#define ATA_CTRL_NIEN 0x02 // Aygıt kesmesini kapatır
+
+#define ATA_CMD_READ_PIO      0x20
+#define ATA_CMD_READ_PIO_EXT  0x24
+#define ATA_CMD_WRITE_PIO     0x30
+#define ATA_CMD_WRITE_PIO_EXT 0x34
+#define ATA_CMD_READ_DMA      0xC8
+#define ATA_CMD_READ_DMA_EXT  0x25
+#define ATA_CMD_WRITE_DMA     0xCA
+#define ATA_CMD_WRITE_DMA_EXT 0x35
+#define ATA_CMD_IDENTIFY      0xEC
+
+#define ATA_LBA28_LIMIT 0x10000000
+#define ATA_MAX_SECTORS 256  // LBA28 sektör sayacı (0 = 256)
+#define ATA_POLL_LIMIT  1000000
+
+// Bus-master IDE (PIIX) register'ları, kanal tabanına göre
+#define BM_REG_CMD    0
+#define BM_REG_STATUS 2
+#define BM_REG_PRDT   4
+
+#define BM_CMD_START  0x01
+#define BM_CMD_READ   0x08 // Aygıttan belleğe
+#define BM_SR_ERR     0x02
+#define BM_SR_IRQ     0x04
+
+// Fiziksel Bölge Tanımlayıcısı: bir PRD 64 KB sınırını geçemez
+typedef struct {
+    u32 addr;
+    u16 bytes;  // 0 = 64 KB
+    u16 flags;  // PRD_EOT: tablonun son girdisi
+} __attribute__((packed)) prd_t;
+
+#define PRD_EOT      0x8000
+#define PRD_BOUNDARY 0x10000
+#define PRDT_ENTRIES (PAGE_SIZE / sizeof(prd_t))
+
+typedef struct ata_channel {
+    u16 io;
+    u16 ctrl;
+    u16 bmide;                  // 0 ise DMA yok
+    u8 irq;
+    prd_t* prdt;
+
+    blk_request_t* active;      // Kanalda tek komut olabilir
+    struct ata_drive* active_drive;
+    int active_dma;
+    // PIO aktarım konumu
+    bio_t* pio_bio;
+    u32 pio_offset;             // pio_bio içindeki byte
+    u32 pio_remaining;          // Kalan sektör
+} ata_channel_t;
+
+typedef struct ata_drive {
+    ata_channel_t* chan;
+    u8 slave;
+    ata_drive_info_t info;
+    blk_dev_t blk;
+} ata_drive_t;
+
+static ata_channel_t channels[2] = {
+    { .io = 0x1F0, .ctrl = 0x3F6, .irq = 14 },
+    { .io = 0x170, .ctrl = 0x376, .irq = 15 },
+};
+static ata_drive_t drives[ATA_MAX_DRIVES];
+static u8 ata_log;
+
+// Alternatif durum register'ını okumak ~100 ns sürer; sürücü seçimi sonrası
+// durum geçerli hale gelsin diye 400 ns beklenir.
+static void ata_delay(ata_channel_t* ch) {
+    for (int i = 0; i < 4; i++) inb(ch->ctrl);
+}
+
+static int ata_wait_not_busy(ata_channel_t* ch) {
+    for (u32 i = 0; i < ATA_POLL_LIMIT; i++) {
+        if (!(inb(ch->io + ATA_REG_STATUS) & ATA_SR_BSY)) return 0;
+    }
+    return -1;
+}
+
+// --- PCI Bus-Master IDE Keşfi ---
+// IDE sınıfındaki (0x01/0x01) ilk bus-master denetleyicinin BAR4'ü kullanılır
+// (pci_init ata_init'ten önce çağrılmalı).
+
+static u16 ata_bmide = 0;
+
+static int ata_pci_probe(pci_device_t* dev, const pci_device_id_t* id) {
+    // prog-if bit 7: bus-master; BAR4 G/Ç alanı olmalı
+    if (ata_bmide || !(dev->prog_if & 0x80)) return -1;
+    if (!dev->bars[4].base || !(dev->bars[4].flags & PCI_BAR_IO)) return -1;
+
+    // G/Ç erişimi ve bus-mastering açık olsun
+    pci_enable_device(dev);
+    ata_bmide = (u16)dev->bars[4].base;
+    return 0;
+}
+
+static const pci_device_id_t ata_pci_ids[] = {
+    { PCI_ANY_ID, PCI_ANY_ID, 0x0101 },
+    { 0, 0, 0 }
+};
+
+static pci_driver_t ata_pci_driver = { "ata", ata_pci_ids, ata_pci_probe, NULL };
+
+// --- Komut Gönderimi ---
+
+static void ata_select_lba(ata_drive_t* drive, u32 lba, u32 count, int lba48) {
+    ata_channel_t* ch = drive->chan;
+    u16 io = ch->io;
+    if (lba48) {
+        outb(io + ATA_REG_DRIVE, 0x40 | (drive->slave << 4));
+        ata_delay(ch);
+        // Önce yüksek byte'lar, sonra düşükler (LBA 47:32 her zaman 0)
+        outb(io + ATA_REG_SECCOUNT, (count >> 8) & 0xFF);
+        outb(io + ATA_REG_LBA0, (lba >> 24) & 0xFF);
+        outb(io + ATA_REG_LBA1, 0);
+        outb(io + ATA_REG_LBA2, 0);
+    } else {
+        outb(io + ATA_REG_DRIVE, 0xE0 | (drive->slave << 4) | ((lba >> 24) & 0x0F));
+        ata_delay(ch);
+    }
+    outb(io + ATA_REG_SECCOUNT, count & 0xFF);
+    outb(io + ATA_REG_LBA0, lba & 0xFF);
+    outb(io + ATA_REG_LBA1, (lba >> 8) & 0xFF);
+    outb(io + ATA_REG_LBA2, (lba >> 16) & 0xFF);
+}
+
+// İsteğin bio'larını PRD tablosuna döker. Tampon çift adresli ve kimlik
+// eşlemeli bölgede olmalı; değilse (ya da tablo yetmezse) PIO'ya düşülür.
+static int ata_build_prdt(ata_channel_t* ch, blk_request_t* req) {
+    u32 n = 0;
+    for (bio_t* bio = req->bio_head; bio; bio = bio->next) {
+        u32 addr = (u32)bio->buffer;
+        u32 len = bio->count * BLK_SECTOR_SIZE;
+        if ((addr & 1) || addr + len > PMM_MAX_ADDR) return -1;
+
+        while (len) {
+            u32 chunk = PRD_BOUNDARY - (addr & (PRD_BOUNDARY - 1));
+            if (chunk > len) chunk = len;
+            if (n == PRDT_ENTRIES) return -1;
+            ch->prdt[n].addr = addr;
+            ch->prdt[n].bytes = (u16)chunk; // 64 KB -> 0
+            ch->prdt[n].flags = 0;
+            n++;
+            addr += chunk;
+            len -= chunk;
+        }
+    }
+    ch->prdt[n - 1].flags = PRD_EOT;
+    return 0;
+}
+
+static inline u8* ata_pio_ptr(ata_channel_t* ch) {
+    return ch->pio_bio->buffer + ch->pio_offset;
+}
+
+static void ata_pio_advance(ata_channel_t* ch) {
+    ch->pio_offset += BLK_SECTOR_SIZE;
+    if (ch->pio_offset == ch->pio_bio->count * BLK_SECTOR_SIZE && ch->pio_bio->next) {
+        ch->pio_bio = ch->pio_bio->next;
+        ch->pio_offset = 0;
+    }
+}
+
+static int ata_start(blk_dev_t* dev, blk_request_t* req) {
+    ata_drive_t* drive = (ata_drive_t*)dev->driver_data;
+    ata_channel_t* ch = drive->chan;
+    if (ch->active) return -1; // Kanal diğer diskte meşgul
+
+    int lba48 = req->sector + req->count > ATA_LBA28_LIMIT;
+    int write = req->dir == BLK_WRITE;
+    ch->active = req;
+    ch->active_drive = drive;
+    ch->active_dma = drive->info.dma && ata_build_prdt(ch, req) == 0;
+
+    if (ata_wait_not_busy(ch) < 0) {
+        ch->active = NULL;
+        blk_complete(dev, req, -1);
+        return 0;
+    }
+
+    if (ch->active_dma) {
+        u16 bm = ch->bmide;
+        outb(bm + BM_REG_CMD, 0);
+        outl(bm + BM_REG_PRDT, (u32)ch->prdt);
+        outb(bm + BM_REG_STATUS, inb(bm + BM_REG_STATUS) | BM_SR_IRQ | BM_SR_ERR);
+        outb(bm + BM_REG_CMD, write ? 0 : BM_CMD_READ);
+
+        ata_select_lba(drive, req->sector, req->count, lba48);
+        outb(ch->io + ATA_REG_COMMAND, write ? (lba48 ? ATA_CMD_WRITE_DMA_EXT : ATA_CMD_WRITE_DMA)
+                                             : (lba48 ? ATA_CMD_READ_DMA_EXT : ATA_CMD_READ_DMA));
+        outb(bm + BM_REG_CMD, (write ? 0 : BM_CMD_READ) | BM_CMD_START);
+        return 0;
+    }
+
+    ch->pio_bio = req->bio_head;
+    ch->pio_offset = 0;
+    ch->pio_remaining = req->count;
+    ata_select_lba(drive, req->sector, req->count, lba48);
+    outb(ch->io + ATA_REG_COMMAND, write ? (lba48 ? ATA_CMD_WRITE_PIO_EXT : ATA_CMD_WRITE_PIO)
+                                         : (lba48 ? ATA_CMD_READ_PIO_EXT : ATA_CMD_READ_PIO));
+    if (write) {
+        // İlk sektör kesme beklemeden verilir; sonrakiler her kesmede
+        ata_delay(ch);
+        if (ata_wait_not_busy(ch) < 0 || !(inb(ch->io + ATA_REG_STATUS) & ATA_SR_DRQ)) {
+            ch->active = NULL;
+            blk_complete(dev, req, -1);
+            return 0;
+        }
+        outsw(ch->io + ATA_REG_DATA, ata_pio_ptr(ch), BLK_SECTOR_SIZE / 2);
+        ata_pio_advance(ch);
+    }
+    return 0;
+}
+
+// --- Kesme ---
+
+static void ata_finish(ata_channel_t* ch, int status) {
+    ata_drive_t* drive = ch->active_drive;
+    blk_request_t* req = ch->active;
+    ch->active = NULL;
+    ch->active_drive = NULL;
+    blk_complete(&drive->blk, req, status);
+
+    // Aynı kanaldaki diğer disk kanal boşalsın diye bekliyor olabilir
+    ata_drive_t* other = &drives[(drive - drives) ^ 1];
+    if (!ch->active && other->info.present) blk_run_queue(&other->blk);
+}
+
+static void ata_channel_irq(ata_channel_t* ch) {
+    if (ch->active && ch->active_dma) {
+        u8 bm_status = inb(ch->bmide + BM_REG_STATUS);
+        if (!(bm_status & BM_SR_IRQ)) return; // Bu kanal kesme üretmedi
+        outb(ch->bmide + BM_REG_CMD, 0);
+        u8 status = inb(ch->io + ATA_REG_STATUS); // Aygıt kesmesini de temizler
+        outb(ch->bmide + BM_REG_STATUS, bm_status | BM_SR_IRQ | BM_SR_ERR);
+        int failed = (status & (ATA_SR_ERR | ATA_SR_DF)) || (bm_status & BM_SR_ERR);
+        ata_finish(ch, failed ? -1 : 0);
+        return;
+    }
+
+    u8 status = inb(ch->io + ATA_REG_STATUS);
+    if (!ch->active) return; // Beklenmeyen kesme (örn. IDENTIFY'dan kalan)
+    if (status & (ATA_SR_ERR | ATA_SR_DF)) {
+        ata_finish(ch, -1);
+        return;
+    }
+
+    if (ch->active->dir == BLK_READ) {
+        if (!(status & ATA_SR_DRQ)) {
+            ata_finish(ch, -1);
+            return;
+        }
+        insw(ch->io + ATA_REG_DATA, ata_pio_ptr(ch), BLK_SECTOR_SIZE / 2);
+        ata_pio_advance(ch);
+        if (--ch->pio_remaining == 0) ata_finish(ch, 0);
+    } else {
+        // Yazmada kesme bir önceki sektörün diske geçtiğini bildirir
+        if (--ch->pio_remaining == 0) {
+            ata_finish(ch, 0);
+        } else if (!(status & ATA_SR_DRQ)) {
+            ata_finish(ch, -1);
+        } else {
+            outsw(ch->io + ATA_REG_DATA, ata_pio_ptr(ch), BLK_SECTOR_SIZE / 2);
+            ata_pio_advance(ch);
+        }
+    }
+}
+
+static void ata_irq_primary() {
+    ata_channel_irq(&channels[0]);
+}
+
+static void ata_irq_secondary() {
+    ata_channel_irq(&channels[1]);
+}
+
+// --- Keşif ---
+
+static void ata_copy_model(char* dst, const u16* identify) {
+    // Kelime 27-46, her kelimede byte'lar ters sırada
+    for (int i = 0; i < 20; i++) {
+        dst[i * 2] = (char)(identify[27 + i] >> 8);
+        dst[i * 2 + 1] = (char)(identify[27 + i] & 0xFF);
+    }
+    int len = 40;
+    while (len > 0 && dst[len - 1] == ' ') len--;
+    dst[len] = '\0';
+}
+
+static int ata_identify(ata_drive_t* drive) {
+    ata_channel_t* ch = drive->chan;
+    u16 io = ch->io;
+    u16 identify[256];
+
+    outb(io + ATA_REG_DRIVE, 0xA0 | (drive->slave << 4));
+    ata_delay(ch);
+    outb(io + ATA_REG_SECCOUNT, 0);
+    outb(io + ATA_REG_LBA0, 0);
+    outb(io + ATA_REG_LBA1, 0);
+    outb(io + ATA_REG_LBA2, 0);
+    outb(io + ATA_REG_COMMAND, ATA_CMD_IDENTIFY);
+    ata_delay(ch);
+
+    u8 status = inb(io + ATA_REG_STATUS);
+    if (status == 0 || status == 0xFF) return -1; // Aygıt yok
+    if (ata_wait_not_busy(ch) < 0) return -1;
+    // ATAPI/SATA aygıtları LBA1/LBA2'ye imza yazar
+    if (inb(io + ATA_REG_LBA1) || inb(io + ATA_REG_LBA2)) return -1;
+
+    for (u32 i = 0;; i++) {
+        status = inb(io + ATA_REG_STATUS);
+        if (status & ATA_SR_ERR) return -1;
+        if (status & ATA_SR_DRQ) break;
+        if (i == ATA_POLL_LIMIT) return -1;
+    }
+    insw(io + ATA_REG_DATA, identify, 256);
+
+    ata_drive_info_t* info = &drive->info;
+    info->sectors = identify[60] | ((u32)identify[61] << 16);
+    info->lba48 = (identify[83] >> 10) & 1;
+    if (info->lba48) {
+        // 32 bit sektör numarası: 2 TB üstü kullanılmaz
+        info->sectors = (identify[102] || identify[103]) ? 0xFFFFFFFFu
+                        : identify[100] | ((u32)identify[101] << 16);
+    }
+    info->dma = ch->bmide && ((identify[49] >> 8) & 1);
+    ata_copy_model(info->model, identify);
+    info->present = info->sectors != 0;
+    return info->present ? 0 : -1;
+}
+
+int ata_init() {
+    static const char* names[ATA_MAX_DRIVES] = { "hda", "hdb", "hdc", "hdd" };
+    ata_log = klog_component_id("ATA");
+
+    pci_register_driver(&ata_pci_driver);
+    u16 bmide = ata_bmide;
+    int found = 0;
+
+    for (int c = 0; c < 2; c++) {
+        ata_channel_t* ch = &channels[c];
+        // Sürücü seçilmemişken durum 0xFF ise kanalda hiç aygıt yok (yüzen veriyolu)
+        if (inb(ch->io + ATA_REG_STATUS) == 0xFF) continue;
+        outb(ch->ctrl, ATA_CTRL_NIEN); // Keşif yoklamalı yapılır
+
+        if (bmide) {
+            ch->bmide = bmide + c * 8;
+            ch->prdt = (prd_t*)pmm_alloc_zeroed_page();
+            if (!ch->prdt) ch->bmide = 0;
+        }
+
+        int channel_drives = 0;
+        for (int s = 0; s < 2; s++) {
+            ata_drive_t* drive = &drives[c * 2 + s];
+            drive->chan = ch;
+            drive->slave = (u8)s;
+            if (ata_identify(drive) < 0) continue;
+
+            blk_dev_t* blk = &drive->blk;
+            strlcpy(blk->name, names[c * 2 + s], sizeof(blk->name));
+            blk->sector_count = drive->info.sectors;
+            blk->max_sectors = ATA_MAX_SECTORS;
+            blk->queue_depth = 1;
+            blk->start = ata_start;
+            blk->driver_data = drive;
+            blk_register(blk);
+
+            KLOG(LOG_LEVEL_INFO, ata_log, "%s: %s, %u MB, %s", blk->name, drive->info.model,
+                 drive->info.sectors / 2048, drive->info.dma ? "DMA" : "PIO");
+            channel_drives++;
+        }
+
+        if (channel_drives) {
+            inb(ch->io + ATA_REG_STATUS); // Keşiften kalan kesmeyi temizle
+            outb(ch->ctrl, 0);
+            irq_register_handler(ch->irq, c == 0 ? ata_irq_primary : ata_irq_secondary);
+            found += channel_drives;
+        }
+    }
+    return found;
+}
+
+const ata_drive_info_t* ata_drive_info(int index) {
+    if (index < 0 || index >= ATA_MAX_DRIVES || !drives[index].info.present) return NULL;
+    return &drives[index].info;
+}
@@ -0,0 +1,35 @@
+#ifndef ATA_H
+#define ATA_H
+
+#include "utils.h"
+
+// --- ATA (IDE) Disk Sürücüsü ---
+// İki klasik IDE kanalını (0x1F0/IRQ14 ve 0x170/IRQ15) ve her kanaldaki
+// master/slave diskleri tarar; bulunan ATA diskleri blok katmanına "hda".."hdd"
+// adıyla kaydedilir. ATAPI (CD-ROM) aygıtları atlanır.
+//
+// PCI'da bus-master destekli bir IDE denetleyicisi (PIIX) varsa aktarımlar
+// DMA ile yapılır: istek PRD tablosuna yazılır, disk tek kesmeyle tamamlanır.
+// Aksi halde PIO kullanılır; her sektör için bir kesme gelir ve veri
+// handler'da taşınır. İki durumda da durum portu döngüde beklenmez.
+//
+// LBA28 yeterliyse LBA28, değilse LBA48 komutları kullanılır.
+
+#define ATA_MAX_DRIVES 4
+
+typedef struct {
+    int present;
+    int dma;              // Bus-master DMA kullanılıyor
+    int lba48;
+    u32 sectors;
+    char model[41];
+} ata_drive_info_t;
+
+// Kanalları tarar, diskleri blk_register ile kaydeder, IRQ'ları bağlar.
+// Bulunan disk sayısını döner.
+int ata_init();
+
+// index: 0 = hda (birincil master) ... 3 = hdd (ikincil slave)
+const ata_drive_info_t* ata_drive_info(int index);
+
+#endif
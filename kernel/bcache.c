@@ -0,0 +1,344 @@
+#include "bcache.h"
+#include "pagecache.h"
+#include "sched.h"
+#include "timer.h"
+#include "slab.h"
+#include "io.h"
+#include "string.h"
+
+static slab_cache_t buffer_cache = SLAB_CACHE_INIT("buffer", sizeof(buffer_t));
+
+static buffer_t* buckets[BCACHE_BUCKETS];
+static buffer_t* lru_head = NULL; // En son kullanılan
+static buffer_t* lru_tail = NULL; // Geri alınmaya ilk aday
+static bcache_stats_t stats;
+static task_t* flusher = NULL;
+
+static inline u32 bcache_hash(blk_dev_t* dev, u32 block) {
+    return (((u32)dev >> 4) ^ (block * 2654435761u)) & (BCACHE_BUCKETS - 1);
+}
+
+// --- Hash ve LRU (kesmeler kapalıyken) ---
+
+static void hash_insert(buffer_t* buf) {
+    u32 h = bcache_hash(buf->dev, buf->block);
+    buf->hash_next = buckets[h];
+    buckets[h] = buf;
+}
+
+static void hash_remove(buffer_t* buf) {
+    buffer_t** link = &buckets[bcache_hash(buf->dev, buf->block)];
+    while (*link && *link != buf) link = &(*link)->hash_next;
+    if (*link) *link = buf->hash_next;
+    buf->hash_next = NULL;
+}
+
+static buffer_t* hash_find(blk_dev_t* dev, u32 block) {
+    for (buffer_t* b = buckets[bcache_hash(dev, block)]; b; b = b->hash_next) {
+        if (b->dev == dev && b->block == block) return b;
+    }
+    return NULL;
+}
+
+static void lru_unlink(buffer_t* buf) {
+    if (buf->lru_prev) buf->lru_prev->lru_next = buf->lru_next;
+    else lru_head = buf->lru_next;
+    if (buf->lru_next) buf->lru_next->lru_prev = buf->lru_prev;
+    else lru_tail = buf->lru_prev;
+    buf->lru_prev = buf->lru_next = NULL;
+}
+
+static void lru_push_front(buffer_t* buf) {
+    buf->lru_prev = NULL;
+    buf->lru_next = lru_head;
+    if (lru_head) lru_head->lru_prev = buf;
+    else lru_tail = buf;
+    lru_head = buf;
+}
+
+static inline int buf_reclaimable(buffer_t* buf) {
+    return buf->refcount == 0 && !(buf->flags & (BUF_DIRTY | BUF_BUSY));
+}
+
+// LRU sonundan temiz ve kullanılmayan ilk tampon
+static buffer_t* lru_victim() {
+    for (buffer_t* b = lru_tail; b; b = b->lru_prev) {
+        if (buf_reclaimable(b)) return b;
+    }
+    return NULL;
+}
+
+// --- Tampon Tahsisi ---
+
+static buffer_t* buffer_new() {
+    buffer_t* buf = (buffer_t*)slab_alloc(&buffer_cache);
+    if (!buf) return NULL;
+    buf->data = (u8*)pmm_alloc_page();
+    if (!buf->data) {
+        slab_free(&buffer_cache, buf);
+        return NULL;
+    }
+    stats.buffers++;
+    return buf;
+}
+
+// Sınırın altındaysak ve PMM rahatsa yeni tampon, değilse LRU'dan geri al
+static buffer_t* buffer_alloc() {
+    buffer_t* buf = NULL;
+    if (stats.buffers < BCACHE_MAX_BUFFERS && !pmm_under_pressure()) {
+        buf = buffer_new();
+        if (buf) return buf;
+    }
+
+    buf = lru_victim();
+    if (buf) {
+        hash_remove(buf);
+        lru_unlink(buf);
+        stats.evictions++;
+        return buf;
+    }
+    return buffer_new(); // Hepsi kullanımda ya da kirli: sınırı aş
+}
+
+static u32 bcache_shrink(u32 want) {
+    u32 freed = 0;
+    u32 flags = irq_save();
+    while (freed < want) {
+        buffer_t* buf = lru_victim();
+        if (!buf) break;
+        hash_remove(buf);
+        lru_unlink(buf);
+        pmm_free_page(buf->data);
+        slab_free(&buffer_cache, buf);
+        stats.buffers--;
+        freed++;
+    }
+    stats.shrunk += freed;
+    irq_restore(flags);
+    return freed;
+}
+
+// --- G/Ç ---
+
+// Kesme bağlamında çağrılır
+static void bcache_end_io(bio_t* bio) {
+    buffer_t* buf = (buffer_t*)bio->private;
+    buf->io_error = bio->status < 0;
+    if (bio->dir == BLK_READ) {
+        if (!buf->io_error) buf->flags |= BUF_VALID;
+    } else if (buf->io_error && !(buf->flags & BUF_DIRTY)) {
+        buf->flags |= BUF_DIRTY; // Sonra tekrar denenir
+        stats.dirty++;
+    }
+    buf->flags &= ~BUF_BUSY;
+    waitq_wake_all(&buf->wait, NULL);
+}
+
+// Kesmeler kapalıyken çağrılır; BUF_BUSY'yi çağıran ayarlamış olmalı
+static int bcache_submit(buffer_t* buf, int dir) {
+    u32 first = buf->block * BCACHE_SECTORS;
+    u32 count = buf->dev->sector_count - first;
+    if (count > BCACHE_SECTORS) count = BCACHE_SECTORS;
+
+    bio_t* bio = &buf->bio;
+    memset(bio, 0, sizeof(*bio));
+    bio->sector = first;
+    bio->count = count;
+    bio->buffer = buf->data;
+    bio->dir = dir;
+    bio->end_io = bcache_end_io;
+    bio->private = buf;
+    return blk_submit(buf->dev, bio);
+}
+
+static int buf_idle(void* arg) {
+    return !(((buffer_t*)arg)->flags & BUF_BUSY);
+}
+
+static void bcache_wait_idle(buffer_t* buf) {
+    waitq_wait_event(&buf->wait, buf_idle, buf);
+}
+
+// Kirli blokları yazmaya başlatır (beklemez). expired_only ise yalnızca
+// BCACHE_DIRTY_EXPIRE_MS'den eski olanlar. Başlatılan blok sayısını döner.
+static u32 bcache_start_writeback(blk_dev_t* dev, int expired_only) {
+    u32 now = timer_ticks();
+    u32 expire = timer_ms_to_ticks(BCACHE_DIRTY_EXPIRE_MS);
+    u32 started = 0;
+
+    // Tüm bloklar kuyruğa girince gönderilsin: asansör hepsini birlikte sıralar
+    for (blk_dev_t* d = blk_first(); d; d = d->next) blk_plug(d);
+
+    u32 flags = irq_save();
+    for (buffer_t* b = lru_tail; b; b = b->lru_prev) {
+        if ((b->flags & (BUF_DIRTY | BUF_BUSY)) != BUF_DIRTY) continue;
+        if (dev && b->dev != dev) continue;
+        if (expired_only && now - b->dirty_tick < expire) continue;
+
+        b->flags = (b->flags & ~BUF_DIRTY) | BUF_BUSY;
+        stats.dirty--;
+        if (bcache_submit(b, BLK_WRITE) < 0) {
+            b->flags = (b->flags & ~BUF_BUSY) | BUF_DIRTY;
+            b->io_error = 1;
+            stats.dirty++;
+            continue;
+        }
+        started++;
+    }
+    stats.writebacks += started;
+    irq_restore(flags);
+
+    for (blk_dev_t* d = blk_first(); d; d = d->next) blk_unplug(d);
+    return started;
+}
+
+static void bcache_flusher(void* arg) {
+    for (;;) {
+        sched_sleep_ms(BCACHE_FLUSH_INTERVAL_MS);
+        stats.flusher_runs++;
+        // Sayfa önbelleğindeki kirli sayfalar önce tamponlara yazılır
+        pagecache_writeback_all();
+        // Çok kirli blok biriktiyse yaşına bakmadan hepsini yaz
+        bcache_start_writeback(NULL, stats.dirty < BCACHE_DIRTY_HIGH);
+    }
+}
+
+// --- Genel Arayüz ---
+
+void bcache_init() {
+    pmm_register_shrinker(bcache_shrink);
+    flusher = kthread_create("bcache_flush", bcache_flusher, NULL);
+}
+
+buffer_t* bcache_get(blk_dev_t* dev, u32 block) {
+    if (!dev || block >= (dev->sector_count + BCACHE_SECTORS - 1) / BCACHE_SECTORS) return NULL;
+
+    u32 flags = irq_save();
+    buffer_t* buf = hash_find(dev, block);
+    if (buf) {
+        stats.hits++;
+        lru_unlink(buf);
+    } else {
+        stats.misses++;
+        buf = buffer_alloc();
+        if (!buf) {
+            irq_restore(flags);
+            return NULL;
+        }
+        buf->dev = dev;
+        buf->block = block;
+        buf->flags = 0;
+        buf->io_error = 0;
+        waitq_init(&buf->wait);
+        hash_insert(buf);
+    }
+    buf->refcount++;
+    lru_push_front(buf);
+    irq_restore(flags);
+    return buf;
+}
+
+buffer_t* bcache_read(blk_dev_t* dev, u32 block) {
+    buffer_t* buf = bcache_get(dev, block);
+    if (!buf) return NULL;
+
+    u32 flags = irq_save();
+    // Başka bir görev okuyor olabilir; onun bitmesini bekle
+    bcache_wait_idle(buf);
+    if (!(buf->flags & BUF_VALID)) {
+        buf->flags |= BUF_BUSY;
+        stats.reads++;
+        if (bcache_submit(buf, BLK_READ) < 0) {
+            buf->flags &= ~BUF_BUSY;
+            buf->io_error = 1;
+        } else {
+            bcache_wait_idle(buf);
+        }
+    }
+    int ok = buf->flags & BUF_VALID;
+    irq_restore(flags);
+
+    if (!ok) {
+        bcache_release(buf);
+        return NULL;
+    }
+    return buf;
+}
+
+void bcache_release(buffer_t* buf) {
+    if (!buf) return;
+    u32 flags = irq_save();
+    if (buf->refcount) buf->refcount--;
+    irq_restore(flags);
+}
+
+void bcache_mark_dirty(buffer_t* buf) {
+    u32 flags = irq_save();
+    if (!(buf->flags & BUF_DIRTY)) {
+        buf->flags |= BUF_DIRTY;
+        buf->dirty_tick = timer_ticks();
+        stats.dirty++;
+    }
+    buf->flags |= BUF_VALID;
+    int wake = stats.dirty >= BCACHE_DIRTY_HIGH;
+    irq_restore(flags);
+
+    if (wake && flusher) sched_wake(flusher);
+}
+
+void bcache_update_range(blk_dev_t* dev, u32 sector, u32 count, const u8* data) {
+    u32 flags = irq_save();
+    while (count) {
+        u32 first = sector % BCACHE_SECTORS;
+        u32 n = BCACHE_SECTORS - first;
+        if (n > count) n = count;
+
+        buffer_t* buf = hash_find(dev, sector / BCACHE_SECTORS);
+        if (buf) {
+            // Okuması süren tampon, bitince diskteki eski veriyi getirir
+            buf->refcount++;
+            bcache_wait_idle(buf);
+            if (buf->flags & BUF_VALID) {
+                memcpy(buf->data + first * BLK_SECTOR_SIZE, data, n * BLK_SECTOR_SIZE);
+            }
+            buf->refcount--;
+        }
+        sector += n;
+        count -= n;
+        data += n * BLK_SECTOR_SIZE;
+    }
+    irq_restore(flags);
+}
+
+int bcache_sync(blk_dev_t* dev) {
+    bcache_start_writeback(dev, 0);
+
+    // Yazılmakta olan her bloğu bekle; beklerken liste değişebileceği için
+    // her beklemeden sonra baştan taranır.
+    int result = 0;
+    u32 flags = irq_save();
+    for (;;) {
+        buffer_t* busy = NULL;
+        for (buffer_t* b = lru_head; b; b = b->lru_next) {
+            if (dev && b->dev != dev) continue;
+            if (b->flags & BUF_BUSY) {
+                busy = b;
+                break;
+            }
+            if (b->io_error && (b->flags & BUF_DIRTY)) result = -1;
+        }
+        if (!busy) break;
+        busy->refcount++;
+        bcache_wait_idle(busy);
+        if (busy->bio.dir == BLK_WRITE && busy->io_error) result = -1;
+        busy->refcount--;
+    }
+    irq_restore(flags);
+    return result;
+}
+
+void bcache_get_stats(bcache_stats_t* out) {
+    u32 flags = irq_save();
+    *out = stats;
+    irq_restore(flags);
+}
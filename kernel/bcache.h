@@ -0,0 +1,104 @@
+#ifndef BCACHE_H
+#define BCACHE_H
+
+#include "utils.h"
+#include "blk.h"
+#include "pmm.h"
+#include "waitq.h"
+
+// --- Blok Tampon Önbelleği (Buffer Cache) ---
+// Disk üzerindeki dosya sistemleri süper blok, FAT ve dizin gibi üst veri
+// bloklarını tekrar tekrar okur. Bu önbellek blokları (aygıt, blok no)
+// anahtarıyla bir hash tablosunda tutar; isabet eden okuma diske gitmez.
+//
+// Blok boyutu bir sayfadır (BCACHE_SECTORS sektör); her tamponun verisi ayrı
+// bir PMM sayfasıdır. Tüm tamponlar bir LRU listesindedir:
+//   * Tampon sayısı BCACHE_MAX_BUFFERS'a ulaştığında ya da PMM baskı
+//     bildirdiğinde (pmm_under_pressure) yeni sayfa alınmaz, listenin
+//     sonundaki temiz ve kullanılmayan tampon yeniden kullanılır.
+//   * PMM sayfa bulamadığında shrinker temiz tamponları geri verir.
+// Kirli tamponları arka planda "bcache_flush" thread'i yazar: süresi dolan
+// (BCACHE_DIRTY_EXPIRE_MS) bütün kirli bloklar tek seferde kuyruğa verilir,
+// böylece blok katmanı bitişik olanları birleştirip sıralar. Aynı thread her
+// turda önce sayfa önbelleğinin kirli sayfalarını (paylaşımlı mmap'ler dahil)
+// writepage ile tamponlara indirir; onlar da aynı turda diske gider.
+
+#define BCACHE_BLOCK_SIZE        PAGE_SIZE
+#define BCACHE_SECTORS           (BCACHE_BLOCK_SIZE / BLK_SECTOR_SIZE)
+#define BCACHE_BUCKETS           256  // 2'nin kuvveti olmalı
+#define BCACHE_MAX_BUFFERS       1024 // 4 MB
+#define BCACHE_FLUSH_INTERVAL_MS 1000
+#define BCACHE_DIRTY_EXPIRE_MS   3000
+#define BCACHE_DIRTY_HIGH        128  // Bu kadar kirli blokta flusher hemen uyanır
+
+#define BUF_VALID 0x01 // Veri diskle eşleşiyor ya da daha yeni
+#define BUF_DIRTY 0x02 // Diske yazılmamış değişiklik var
+#define BUF_BUSY  0x04 // Okuma/yazma sürüyor
+
+typedef struct buffer {
+    blk_dev_t* dev;
+    u32 block;              // BCACHE_BLOCK_SIZE birimli blok numarası
+    u8* data;
+    volatile u32 flags;
+    u32 refcount;
+    u32 dirty_tick;         // İlk kirlendiği an
+    int io_error;
+
+    struct buffer* hash_next;
+    struct buffer* lru_prev;
+    struct buffer* lru_next;
+    bio_t bio;
+    wait_queue_t wait;      // BUF_BUSY'nin kalkmasını bekleyenler
+} buffer_t;
+
+typedef struct {
+    u32 hits;
+    u32 misses;
+    u32 evictions;          // Başka blok için yeniden kullanılan tamponlar
+    u32 shrunk;             // PMM'ye geri verilen sayfalar
+    u32 reads;              // Diskten okunan bloklar
+    u32 writebacks;         // Diske yazılan bloklar
+    u32 flusher_runs;
+    u32 buffers;
+    u32 dirty;
+} bcache_stats_t;
+
+// Shrinker'ı kaydeder ve flusher thread'ini başlatır (sched_init'ten sonra)
+void bcache_init();
+
+/**
+ * @brief Bloğun tamponunu verir, gerekirse diskten okur.
+ * @return Referansı alınmış tampon (bcache_release ile bırakılmalı);
+ *         G/Ç hatasında ya da bellek yoksa NULL.
+ */
+buffer_t* bcache_read(blk_dev_t* dev, u32 block);
+
+/**
+ * @brief Bloğun tamponunu okumadan verir. Bloğun tamamı yazılacaksa
+ *        kullanılır; veri BUF_VALID değilse tanımsızdır.
+ */
+buffer_t* bcache_get(blk_dev_t* dev, u32 block);
+
+void bcache_release(buffer_t* buf);
+
+// Tampon değiştirildi: BUF_VALID | BUF_DIRTY; flusher daha sonra yazar
+void bcache_mark_dirty(buffer_t* buf);
+
+/**
+ * @brief Önbelleği atlayıp doğrudan diske yazılan sektörleri (örn. dosya
+ *        verisi) önbellekteki kopyalara da işler. Önbellek bloğu bir sayfa,
+ *        küme ise daha küçük olabileceğinden bir blok hem üst veri hem dosya
+ *        verisi taşıyabilir; bu çağrı olmadan bloğun sonraki geri yazımı
+ *        dosya verisini eski haliyle ezerdi.
+ */
+void bcache_update_range(blk_dev_t* dev, u32 sector, u32 count, const u8* data);
+
+/**
+ * @brief Aygıtın (dev NULL ise hepsinin) kirli bloklarını yazar ve bitmelerini bekler.
+ * @return Bir blok yazılamadıysa -1.
+ */
+int bcache_sync(blk_dev_t* dev);
+
+void bcache_get_stats(bcache_stats_t* out);
+
+#endif
@@ -0,0 +1,226 @@
+#include "blk.h"
+#include "slab.h"
+#include "io.h"
+#include "string.h"
+
+static slab_cache_t request_cache = SLAB_CACHE_INIT("blk_request", sizeof(blk_request_t));
+
+static blk_dev_t* devices = NULL;
+
+void blk_register(blk_dev_t* dev) {
+    if (!dev->max_sectors) dev->max_sectors = 1;
+    if (!dev->queue_depth) dev->queue_depth = 1;
+    dev->queue = NULL;
+    dev->in_flight = 0;
+    dev->head_pos = 0;
+    dev->plugged = 0;
+    memset(&dev->stats, 0, sizeof(dev->stats));
+
+    // Kayıt sırası korunur (hda, hdb, ...)
+    dev->next = NULL;
+    blk_dev_t** link = &devices;
+    while (*link) link = &(*link)->next;
+    *link = dev;
+}
+
+blk_dev_t* blk_get(const char* name) {
+    for (blk_dev_t* dev = devices; dev; dev = dev->next) {
+        if (strcmp(dev->name, name) == 0) return dev;
+    }
+    return NULL;
+}
+
+blk_dev_t* blk_first() {
+    return devices;
+}
+
+// --- Kuyruk ---
+
+static void queue_insert_sorted(blk_dev_t* dev, blk_request_t* req) {
+    blk_request_t** link = &dev->queue;
+    while (*link && (*link)->sector <= req->sector) link = &(*link)->next;
+    req->next = *link;
+    *link = req;
+}
+
+// `b`, sıralı listede `a`'nın hemen ardındaysa ve bitişikse ikisini birleştirir
+static int queue_join(blk_dev_t* dev, blk_request_t* a, blk_request_t* b) {
+    if (!a || !b || a->dir != b->dir || a->sector + a->count != b->sector ||
+        a->count + b->count > dev->max_sectors) {
+        return 0;
+    }
+    a->bio_tail->next = b->bio_head;
+    a->bio_tail = b->bio_tail;
+    a->count += b->count;
+    a->nr_bios += b->nr_bios;
+    a->next = b->next;
+    slab_free(&request_cache, b);
+    return 1;
+}
+
+// Var olan bir isteğin hemen önüne ya da arkasına düşüyorsa bio'yu ona ekler.
+// Eklenen bio iki isteğin arasındaki boşluğu kapatıyorsa istekler de birleşir.
+static int queue_try_merge(blk_dev_t* dev, bio_t* bio) {
+    blk_request_t* prev = NULL;
+    for (blk_request_t* req = dev->queue; req; prev = req, req = req->next) {
+        if (req->dir != bio->dir || req->count + bio->count > dev->max_sectors) continue;
+
+        if (req->sector + req->count == bio->sector) {
+            req->bio_tail->next = bio;
+            req->bio_tail = bio;
+            req->count += bio->count;
+            req->nr_bios++;
+            queue_join(dev, req, req->next);
+        } else if (bio->sector + bio->count == req->sector) {
+            // Sıralama korunur: önceki istek bio'ya bitişik olsaydı bio ona eklenirdi
+            bio->next = req->bio_head;
+            req->bio_head = bio;
+            req->sector = bio->sector;
+            req->count += bio->count;
+            req->nr_bios++;
+            queue_join(dev, prev, req);
+        } else {
+            continue;
+        }
+        dev->stats.merges++;
+        return 1;
+    }
+    return 0;
+}
+
+// C-LOOK: kafanın ilerisindeki ilk istek; yoksa en küçük sektöre dön
+static blk_request_t* queue_pick(blk_dev_t* dev) {
+    blk_request_t** link = &dev->queue;
+    while (*link && (*link)->sector < dev->head_pos) link = &(*link)->next;
+    if (!*link) link = &dev->queue;
+
+    blk_request_t* req = *link;
+    *link = req->next;
+    req->next = NULL;
+    return req;
+}
+
+void blk_run_queue(blk_dev_t* dev) {
+    u32 flags = irq_save();
+    u32 started = 0;
+    while (!dev->plugged && dev->queue && dev->in_flight < dev->queue_depth) {
+        blk_request_t* req = queue_pick(dev);
+        u32 end = req->sector + req->count;
+        // Sürücü isteği start içinde hemen tamamlayabilir (blk_complete)
+        dev->in_flight++;
+        if (dev->start(dev, req) < 0) {
+            dev->in_flight--;
+            queue_insert_sorted(dev, req); // Aygıt meşgul; sonra tekrar denenir
+            break;
+        }
+        dev->head_pos = end;
+        dev->stats.requests++;
+        started++;
+    }
+    if (started && dev->commit) dev->commit(dev);
+    irq_restore(flags);
+}
+
+int blk_submit(blk_dev_t* dev, bio_t* bio) {
+    if (!dev || !bio->count || bio->count > dev->max_sectors ||
+        bio->sector + bio->count < bio->sector || bio->sector + bio->count > dev->sector_count) {
+        return -1;
+    }
+    bio->status = BIO_PENDING;
+    bio->next = NULL;
+    waitq_init(&bio->wait);
+
+    u32 flags = irq_save();
+    if (!queue_try_merge(dev, bio)) {
+        blk_request_t* req = (blk_request_t*)slab_alloc(&request_cache);
+        if (!req) {
+            irq_restore(flags);
+            return -1;
+        }
+        req->sector = bio->sector;
+        req->count = bio->count;
+        req->dir = bio->dir;
+        req->bio_head = req->bio_tail = bio;
+        req->nr_bios = 1;
+        queue_insert_sorted(dev, req);
+    }
+    blk_run_queue(dev);
+    irq_restore(flags);
+    return 0;
+}
+
+static int bio_done(void* arg) {
+    return ((bio_t*)arg)->status != BIO_PENDING;
+}
+
+int blk_wait(bio_t* bio) {
+    waitq_wait_event(&bio->wait, bio_done, bio);
+    return bio->status;
+}
+
+// Aygıt sınırından büyük aktarımlar max_sectors'luk parçalara bölünür
+static int blk_rw(blk_dev_t* dev, u32 sector, u32 count, void* buffer, int dir) {
+    if (!dev) return -1;
+    u8* p = (u8*)buffer;
+    while (count) {
+        u32 n = count < dev->max_sectors ? count : dev->max_sectors;
+        bio_t bio;
+        memset(&bio, 0, sizeof(bio));
+        bio.sector = sector;
+        bio.count = n;
+        bio.buffer = p;
+        bio.dir = dir;
+        if (blk_submit(dev, &bio) < 0 || blk_wait(&bio) < 0) return -1;
+        sector += n;
+        count -= n;
+        p += n * BLK_SECTOR_SIZE;
+    }
+    return 0;
+}
+
+int blk_read(blk_dev_t* dev, u32 sector, u32 count, void* buffer) {
+    return blk_rw(dev, sector, count, buffer, BLK_READ);
+}
+
+int blk_write(blk_dev_t* dev, u32 sector, u32 count, const void* buffer) {
+    return blk_rw(dev, sector, count, (void*)buffer, BLK_WRITE);
+}
+
+void blk_plug(blk_dev_t* dev) {
+    u32 flags = irq_save();
+    dev->plugged++;
+    irq_restore(flags);
+}
+
+void blk_unplug(blk_dev_t* dev) {
+    u32 flags = irq_save();
+    if (dev->plugged) dev->plugged--;
+    irq_restore(flags);
+    blk_run_queue(dev);
+}
+
+// --- Tamamlanma ---
+
+void blk_complete(blk_dev_t* dev, blk_request_t* req, int status) {
+    bio_t* bio = req->bio_head;
+    while (bio) {
+        bio_t* next = bio->next; // end_io bio'yu serbest bırakabilir
+        if (bio->dir == BLK_WRITE) {
+            dev->stats.writes++;
+            dev->stats.sectors_written += bio->count;
+        } else {
+            dev->stats.reads++;
+            dev->stats.sectors_read += bio->count;
+        }
+        if (status < 0) dev->stats.errors++;
+
+        bio->status = status < 0 ? -1 : 0;
+        if (bio->end_io) bio->end_io(bio);
+        else waitq_wake_all(&bio->wait, NULL);
+        bio = next;
+    }
+
+    slab_free(&request_cache, req);
+    if (dev->in_flight) dev->in_flight--;
+    blk_run_queue(dev);
+}
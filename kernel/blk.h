@@ -0,0 +1,126 @@
+#ifndef BLK_H
+#define BLK_H
+
+#include "utils.h"
+#include "waitq.h"
+
+// --- Blok Katmanı (Block Layer) ---
+// Dosya sistemleri diske doğrudan değil, bu katman üzerinden erişir. Çağıranın
+// birimi bio_t'dir: bir sektör aralığı ve bellekte bitişik bir tampon. Her
+// aygıtın bir istek kuyruğu vardır:
+//   * Kuyruktaki bir isteğin hemen önüne ya da arkasına düşen bio aynı
+//     isteğe eklenir (birleştirme); sürücü tek komutla hepsini aktarır.
+//   * Bekleyen istekler sektöre göre sıralı tutulur ve tek yönlü asansör
+//     (C-LOOK) ile gönderilir: kafanın ilerisindeki en yakın istek, o yönde
+//     istek kalmayınca en küçük sektöre dönülür.
+// Tamamlanma kesme bağlamında bildirilir; eşzamanlı çağıran görev bio'nun
+// bekleme kuyruğunda uyur.
+
+#define BLK_SECTOR_SIZE 512
+#define BLK_NAME_MAX    8
+
+#define BLK_READ  0
+#define BLK_WRITE 1
+
+#define BIO_PENDING 1 // bio->status: tamamlanınca 0 (başarı) ya da -1
+
+struct bio;
+typedef void (*bio_end_io_t)(struct bio* bio);
+
+typedef struct bio {
+    u32 sector;
+    u32 count;              // Sektör sayısı
+    u8* buffer;             // count * BLK_SECTOR_SIZE byte
+    int dir;                // BLK_READ / BLK_WRITE
+    volatile int status;
+    bio_end_io_t end_io;    // NULL değilse tamamlanınca (kesme bağlamında) çağrılır
+    void* private;
+    wait_queue_t wait;
+    struct bio* next;       // İstek içindeki sıra
+} bio_t;
+
+// Sürücüye giden tek komut: sektörleri ardışık bir ya da birkaç bio
+typedef struct blk_request {
+    u32 sector;
+    u32 count;
+    int dir;
+    bio_t* bio_head;
+    bio_t* bio_tail;
+    u32 nr_bios;
+    struct blk_request* next;
+    void* driver_data;      // Sürücü, istek donanımdayken kullanabilir
+} blk_request_t;
+
+typedef struct {
+    u32 reads;              // Tamamlanan bio'lar
+    u32 writes;
+    u32 sectors_read;
+    u32 sectors_written;
+    u32 requests;           // Sürücüye gönderilen komutlar
+    u32 merges;             // Var olan isteğe eklenen bio'lar
+    u32 errors;
+} blk_stats_t;
+
+typedef struct blk_dev {
+    char name[BLK_NAME_MAX];
+    u32 sector_count;
+    u32 max_sectors;        // Tek istekte en fazla sektör
+    u32 queue_depth;        // Aynı anda sürücüde olabilecek istek sayısı
+
+    // İsteği donanıma verir. Aygıt o an meşgulse (örn. kanal diğer sürücüde)
+    // -1 döner; istek kuyrukta kalır ve sürücü boşalınca blk_run_queue çağırır.
+    // İş bitince sürücü blk_complete ile bildirir. Kesmeler kapalı çağrılır.
+    int (*start)(struct blk_dev* dev, blk_request_t* req);
+    // İsteğe bağlı: blk_run_queue bir ya da daha fazla isteği start'a verdikten
+    // sonra bir kez çağırır. Kuyruklu aygıtlar (virtio) istekleri start'ta
+    // halkaya yazıp aygıtı burada tek seferde uyarır. Kesmeler kapalı çağrılır.
+    void (*commit)(struct blk_dev* dev);
+    void* driver_data;
+
+    // Kuyruk durumu (blk.c'ye özel)
+    blk_request_t* queue;   // Sektöre göre sıralı, henüz gönderilmemiş
+    u32 in_flight;
+    u32 head_pos;           // Son gönderilen isteğin bittiği sektör
+    u32 plugged;            // >0 iken gönderim ertelenir (toplu gönderim)
+    blk_stats_t stats;
+
+    struct blk_dev* next;
+} blk_dev_t;
+
+/**
+ * @brief Aygıtı kaydeder; adıyla blk_get ile bulunabilir hale gelir.
+ *        name, sector_count, max_sectors ve start doldurulmuş olmalıdır.
+ */
+void blk_register(blk_dev_t* dev);
+blk_dev_t* blk_get(const char* name);
+blk_dev_t* blk_first(); // Liste: dev->next
+
+/**
+ * @brief bio'yu aygıt kuyruğuna ekler (gerekirse komşu istekle birleştirir)
+ *        ve beklemeden döner. Tamamlanma bio->status / end_io ile izlenir.
+ * @return Geçersiz aralıkta ya da count > max_sectors ise -1.
+ */
+int blk_submit(blk_dev_t* dev, bio_t* bio);
+
+// bio tamamlanana kadar uyur; bio->status döner
+int blk_wait(bio_t* bio);
+
+// Eşzamanlı yardımcılar: submit + wait (büyük aktarımları kendileri böler)
+int blk_read(blk_dev_t* dev, u32 sector, u32 count, void* buffer);
+int blk_write(blk_dev_t* dev, u32 sector, u32 count, const void* buffer);
+
+// plug/unplug arasında gönderilen bio'lar kuyrukta birikir; birleştirme ve
+// sıralama bunların hepsini görür. unplug kuyruğu sürücüye boşaltır.
+void blk_plug(blk_dev_t* dev);
+void blk_unplug(blk_dev_t* dev);
+
+// --- Sürücü Tarafı ---
+
+// Sürücü isteği bitirdiğinde (kesme bağlamında) çağırır; status 0 ya da -1.
+// İsteğin bio'larını tamamlar ve kuyruktan sıradakini gönderir.
+void blk_complete(blk_dev_t* dev, blk_request_t* req, int status);
+
+// Kuyrukta bekleyen istekleri kapasite elverdiğince sürücüye verir
+void blk_run_queue(blk_dev_t* dev);
+
+#endif
@@ -0,0 +1,189 @@
+#include "dcache.h"
+#include "string.h"
+#include "sched.h"
+
+#define DCACHE_BUCKET_MASK (DCACHE_BUCKETS - 1)
+
+typedef struct dentry {
+    struct dentry*  hash_next;
+    struct dentry** hash_pprev; // Kovadaki önceki girdinin hash_next alanı
+    struct dentry*  lru_prev;
+    struct dentry*  lru_next;
+    vfs_node_t*     parent;
+    vfs_node_t*     node;       // NULL ise negatif girdi
+    u32             hash;
+    u8              len;
+    char            name[DCACHE_NAME_MAX + 1];
+} dentry_t;
+
+static dentry_t dcache_pool[DCACHE_ENTRIES];
+static dentry_t* dcache_table[DCACHE_BUCKETS];
+static dentry_t* dcache_free_list = NULL;
+
+// LRU listesi: baş en son kullanılan, kuyruk geri alınacak ilk aday
+static dentry_t* lru_head = NULL;
+static dentry_t* lru_tail = NULL;
+
+static dcache_stats_t dcache_stats;
+
+// Tablo, LRU ve boş liste görevler arasında paylaşılır: genel arayüz
+// fonksiyonları preempt_disable içinde çalışır (hiçbiri uyumaz).
+
+// FNV-1a isim hash'i, üst dizinin adresiyle karıştırılır. Böylece farklı
+// dizinlerdeki aynı isimler ("bin", "lib" ...) farklı kovalara düşer.
+static inline u32 dcache_hash(vfs_node_t* parent, const char* name, size_t len) {
+    u32 h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (u8)name[i];
+        h *= 16777619u;
+    }
+    h ^= (u32)parent * 0x9E3779B1u;
+    return h ^ (h >> 16);
+}
+
+static void lru_unlink(dentry_t* d) {
+    if (d->lru_prev) d->lru_prev->lru_next = d->lru_next;
+    else lru_head = d->lru_next;
+    if (d->lru_next) d->lru_next->lru_prev = d->lru_prev;
+    else lru_tail = d->lru_prev;
+    d->lru_prev = d->lru_next = NULL;
+}
+
+static void lru_push_front(dentry_t* d) {
+    d->lru_prev = NULL;
+    d->lru_next = lru_head;
+    if (lru_head) lru_head->lru_prev = d;
+    lru_head = d;
+    if (!lru_tail) lru_tail = d;
+}
+
+static void hash_unlink(dentry_t* d) {
+    *d->hash_pprev = d->hash_next;
+    if (d->hash_next) d->hash_next->hash_pprev = d->hash_pprev;
+    d->hash_next = NULL;
+    d->hash_pprev = NULL;
+}
+
+// Girdiyi tablodan ve LRU'dan çıkarıp boş listeye geri verir
+static void dentry_release(dentry_t* d) {
+    hash_unlink(d);
+    lru_unlink(d);
+    d->hash_next = dcache_free_list;
+    dcache_free_list = d;
+    dcache_stats.entries--;
+}
+
+static dentry_t* dentry_find(vfs_node_t* parent, const char* name, size_t len, u32 hash) {
+    for (dentry_t* d = dcache_table[hash & DCACHE_BUCKET_MASK]; d; d = d->hash_next) {
+        if (d->hash == hash && d->parent == parent && d->len == len &&
+            memcmp(d->name, name, len) == 0) {
+            return d;
+        }
+    }
+    return NULL;
+}
+
+void dcache_init() {
+    memset(dcache_table, 0, sizeof(dcache_table));
+    memset(&dcache_stats, 0, sizeof(dcache_stats));
+    lru_head = lru_tail = NULL;
+    dcache_free_list = NULL;
+    for (int i = DCACHE_ENTRIES - 1; i >= 0; i--) {
+        dcache_pool[i].hash_pprev = NULL;
+        dcache_pool[i].hash_next = dcache_free_list;
+        dcache_free_list = &dcache_pool[i];
+    }
+}
+
+int dcache_lookup(vfs_node_t* parent, const char* name, size_t len, vfs_node_t** out) {
+    if (len > DCACHE_NAME_MAX) {
+        dcache_stats.misses++;
+        return DCACHE_MISS;
+    }
+
+    u32 hash = dcache_hash(parent, name, len);
+    preempt_disable();
+    dentry_t* d = dentry_find(parent, name, len, hash);
+    if (!d) {
+        dcache_stats.misses++;
+        preempt_enable();
+        return DCACHE_MISS;
+    }
+
+    if (d != lru_head) {
+        lru_unlink(d);
+        lru_push_front(d);
+    }
+    if (d->node) dcache_stats.hits++;
+    else dcache_stats.negative_hits++;
+    *out = d->node;
+    preempt_enable();
+    return DCACHE_HIT;
+}
+
+void dcache_insert(vfs_node_t* parent, const char* name, size_t len, vfs_node_t* node) {
+    if (len > DCACHE_NAME_MAX) return;
+
+    u32 hash = dcache_hash(parent, name, len);
+    preempt_disable();
+    dentry_t* d = dentry_find(parent, name, len, hash);
+    if (d) {
+        // Zaten var (örn. negatif girdi artık pozitif oldu): sadece güncelle
+        d->node = node;
+        if (d != lru_head) {
+            lru_unlink(d);
+            lru_push_front(d);
+        }
+        preempt_enable();
+        return;
+    }
+
+    if (!dcache_free_list) {
+        dentry_release(lru_tail);
+        dcache_stats.evictions++;
+    }
+    d = dcache_free_list;
+    dcache_free_list = d->hash_next;
+
+    d->parent = parent;
+    d->node = node;
+    d->hash = hash;
+    d->len = (u8)len;
+    memcpy(d->name, name, len);
+    d->name[len] = '\0';
+
+    dentry_t** bucket = &dcache_table[hash & DCACHE_BUCKET_MASK];
+    d->hash_next = *bucket;
+    d->hash_pprev = bucket;
+    if (*bucket) (*bucket)->hash_pprev = &d->hash_next;
+    *bucket = d;
+
+    lru_push_front(d);
+    dcache_stats.entries++;
+    preempt_enable();
+}
+
+void dcache_invalidate(vfs_node_t* parent, const char* name, size_t len) {
+    if (len > DCACHE_NAME_MAX) return;
+    u32 hash = dcache_hash(parent, name, len);
+    preempt_disable();
+    dentry_t* d = dentry_find(parent, name, len, hash);
+    if (d) dentry_release(d);
+    preempt_enable();
+}
+
+void dcache_purge_node(vfs_node_t* node) {
+    // Nadiren çağrılır (düğüm silinirken); tüm havuzu taramak kabul edilebilir
+    preempt_disable();
+    for (int i = 0; i < DCACHE_ENTRIES; i++) {
+        dentry_t* d = &dcache_pool[i];
+        if (d->hash_pprev && (d->parent == node || d->node == node)) {
+            dentry_release(d);
+        }
+    }
+    preempt_enable();
+}
+
+void dcache_get_stats(dcache_stats_t* out) {
+    *out = dcache_stats;
+}
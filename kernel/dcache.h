@@ -0,0 +1,52 @@
+#ifndef DCACHE_H
+#define DCACHE_H
+
+#include <stddef.h>
+#include "utils.h"
+#include "vfs.h"
+
+// --- Dizin Girdisi Önbelleği (Dentry Cache) ---
+// (üst dizin, isim) çiftini VFS düğümüne eşleyen hash tablosu. Yol çözümleme
+// her bileşende önce buraya bakar; isabet olursa dizinin kardeş listesi hiç
+// taranmaz. Bulunamayan isimler de "negatif" girdi olarak saklanır, böylece
+// var olmayan bir dosyayı tekrar tekrar aramak da ucuzdur.
+//
+// Girdiler sabit bir havuzdan gelir; havuz dolunca en uzun süredir
+// kullanılmayan (LRU) girdi geri alınır.
+
+#define DCACHE_ENTRIES   512 // Havuzdaki girdi sayısı
+#define DCACHE_BUCKETS   256 // Hash kovası sayısı, 2'nin kuvveti olmalı
+#define DCACHE_NAME_MAX  39  // Bundan uzun isimler önbelleğe alınmaz
+
+#define DCACHE_MISS      0   // Önbellekte yok, dosya sistemine sorulmalı
+#define DCACHE_HIT       1   // Girdi var (negatifse *out NULL)
+
+typedef struct {
+    u32 hits;
+    u32 negative_hits;
+    u32 misses;
+    u32 evictions;
+    u32 entries;
+} dcache_stats_t;
+
+void dcache_init();
+
+/**
+ * @brief (parent, name) çiftini önbellekte arar.
+ * @param out İsabet durumunda bulunan düğüm (negatif girdi için NULL).
+ * @return DCACHE_HIT veya DCACHE_MISS.
+ */
+int dcache_lookup(vfs_node_t* parent, const char* name, size_t len, vfs_node_t** out);
+
+// Sonucu önbelleğe ekler; node NULL ise negatif girdi oluşturur
+void dcache_insert(vfs_node_t* parent, const char* name, size_t len, vfs_node_t* node);
+
+// Dizine isim eklendiğinde/silindiğinde ilgili girdiyi (negatif dahil) düşürür
+void dcache_invalidate(vfs_node_t* parent, const char* name, size_t len);
+
+// Bir düğümü üst dizin ya da hedef olarak gösteren tüm girdileri düşürür
+void dcache_purge_node(vfs_node_t* node);
+
+void dcache_get_stats(dcache_stats_t* out);
+
+#endif
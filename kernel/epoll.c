@@ -0,0 +1,325 @@
+#include "epoll.h"
+#include "fdtable.h"
+#include "sched.h"
+#include "timer.h"
+#include "slab.h"
+#include "io.h"
+#include "string.h"
+
+struct epoll;
+
+// İlgi kümesindeki bir fd
+typedef struct epitem {
+    struct epoll* ep;
+    file_t* file;               // Kayıt silinene kadar tutulan referans
+    int fd;
+    u32 events;                 // İzlenen maske (EPOLLET dahil)
+    u32 data;
+    wait_entry_t waits[EPOLL_MAX_WAITQ];
+    wait_queue_t* wqs[EPOLL_MAX_WAITQ];
+    u32 nr_waits;
+    int ready;                  // Hazır listesinde mi
+    struct epitem* ready_next;
+    struct epitem* ready_prev;
+    struct epitem* next;        // İlgi kümesi
+} epitem_t;
+
+typedef struct {
+    epitem_t* head;
+    epitem_t* tail;
+} epitem_list_t;
+
+typedef struct epoll {
+    epitem_t* items;
+    epitem_list_t ready;
+    wait_queue_t wq;            // epoll_wait'te uyuyanlar
+    vfs_node_t node;
+} epoll_t;
+
+// poll sırasında kuyrukları hangi kayda bağlayacağımızı taşır
+typedef struct {
+    poll_table_t pt;            // İlk alan olmalı
+    epitem_t* item;
+} epoll_pqueue_t;
+
+static slab_cache_t epoll_cache = SLAB_CACHE_INIT("epoll", sizeof(epoll_t));
+static slab_cache_t epitem_cache = SLAB_CACHE_INIT("epitem", sizeof(epitem_t));
+
+u32 vfs_poll_node(vfs_node_t* node, poll_table_t* pt) {
+    if (!node) return EPOLLERR;
+    if (node->poll) return node->poll(node, pt);
+    return EPOLLIN | EPOLLOUT; // Normal dosya: okuma/yazma beklemez
+}
+
+// --- Hazır Listesi (kesmeler kapalıyken) ---
+
+static void ready_push(epitem_list_t* list, epitem_t* item) {
+    item->ready_next = NULL;
+    item->ready_prev = list->tail;
+    if (list->tail) list->tail->ready_next = item;
+    else list->head = item;
+    list->tail = item;
+}
+
+static void ready_unlink(epitem_list_t* list, epitem_t* item) {
+    if (item->ready_prev) item->ready_prev->ready_next = item->ready_next;
+    else list->head = item->ready_next;
+    if (item->ready_next) item->ready_next->ready_prev = item->ready_prev;
+    else list->tail = item->ready_prev;
+    item->ready_next = item->ready_prev = NULL;
+}
+
+static void ready_mark(epoll_t* ep, epitem_t* item) {
+    if (item->ready) return;
+    item->ready = 1;
+    ready_push(&ep->ready, item);
+}
+
+// Kaynağın bekleme kuyruğundan çağrılır (çoğu zaman kesme bağlamı)
+static void epoll_callback(wait_entry_t* entry, void* key) {
+    epitem_t* item = (epitem_t*)entry->private;
+    u32 mask = (u32)key;
+    if (mask && !(mask & (item->events | EPOLLERR | EPOLLHUP))) return;
+
+    epoll_t* ep = item->ep;
+    ready_mark(ep, item);
+    if (waitq_active(&ep->wq)) waitq_wake_all(&ep->wq, NULL);
+}
+
+static void epoll_queue(poll_table_t* pt, wait_queue_t* wq) {
+    epitem_t* item = ((epoll_pqueue_t*)pt)->item;
+    if (item->nr_waits >= EPOLL_MAX_WAITQ) return;
+    wait_entry_t* e = &item->waits[item->nr_waits];
+    waitq_entry_init(e, epoll_callback, item);
+    item->wqs[item->nr_waits++] = wq;
+    waitq_add(wq, e);
+}
+
+static u32 epitem_poll(epitem_t* item, poll_table_t* pt) {
+    return vfs_poll_node(item->file->node, pt) & (item->events | EPOLLERR | EPOLLHUP);
+}
+
+// Kaydı ilgi kümesinden çıkarır ve serbest bırakır
+static void epitem_remove(epoll_t* ep, epitem_t* item) {
+    u32 flags = irq_save();
+    epitem_t** link = &ep->items;
+    while (*link && *link != item) link = &(*link)->next;
+    if (*link) *link = item->next;
+    for (u32 i = 0; i < item->nr_waits; i++) waitq_remove(item->wqs[i], &item->waits[i]);
+    if (item->ready) ready_unlink(&ep->ready, item);
+    irq_restore(flags);
+
+    file_put(item->file);
+    slab_free(&epitem_cache, item);
+}
+
+static epitem_t* epitem_find(epoll_t* ep, int fd) {
+    for (epitem_t* item = ep->items; item; item = item->next) {
+        if (item->fd == fd) return item;
+    }
+    return NULL;
+}
+
+// --- epoll Nesnesi ---
+
+static int epoll_release(vfs_node_t* node) {
+    epoll_t* ep = (epoll_t*)node->internal_data;
+    while (ep->items) epitem_remove(ep, ep->items);
+    slab_free(&epoll_cache, ep);
+    return 0;
+}
+
+// Başarıda *filep referanslı dosyadır: epoll örneği çağıran file_put edene kadar yaşar
+static epoll_t* epoll_from_fd(int epfd, file_t** filep) {
+    file_t* file = fd_get(fdtable_current(), epfd);
+    if (!file) return NULL;
+    if (!file->node || file->node->close != epoll_release) {
+        file_put(file);
+        return NULL;
+    }
+    *filep = file;
+    return (epoll_t*)file->node->internal_data;
+}
+
+int epoll_create() {
+    fd_table_t* table = fdtable_current();
+    if (!table) return EPOLL_EBADF;
+    epoll_t* ep = (epoll_t*)slab_alloc(&epoll_cache);
+    if (!ep) return EPOLL_ENOMEM;
+    strlcpy(ep->node.name, "epoll", sizeof(ep->node.name));
+    ep->node.type = FS_NODE_DEVICE;
+    ep->node.close = epoll_release;
+    ep->node.internal_data = ep;
+
+    file_t* file = file_alloc(&ep->node, O_RDWR);
+    if (!file) {
+        slab_free(&epoll_cache, ep);
+        return EPOLL_ENOMEM;
+    }
+    int fd = fd_install(table, file);
+    if (fd < 0) {
+        file_put(file);
+        return EPOLL_ENOMEM;
+    }
+    return fd;
+}
+
+static int epoll_add(epoll_t* ep, int fd, const epoll_event_t* ev) {
+    file_t* file = fd_get(fdtable_current(), fd);
+    if (!file) return EPOLL_EBADF;
+    int err = 0;
+    // İç içe epoll desteklenmez (kendini izleyen döngüler olmasın diye)
+    if (!file->node || file->node->close == epoll_release) err = EPOLL_EBADF;
+    else if (epitem_find(ep, fd)) err = EPOLL_EEXIST;
+
+    epitem_t* item = err ? NULL : (epitem_t*)slab_alloc(&epitem_cache);
+    if (!item) {
+        file_put(file);
+        return err ? err : EPOLL_ENOMEM;
+    }
+    item->ep = ep;
+    item->file = file; // fd_get'in referansını öğe devralır
+    item->fd = fd;
+    item->events = ev->events;
+    item->data = ev->data;
+
+    epoll_pqueue_t pq;
+    pq.pt.queue = epoll_queue;
+    pq.item = item;
+
+    // Kuyruklara kaydolma ile ilk kontrol arasında gelen olay kaçmasın
+    u32 flags = irq_save();
+    item->next = ep->items;
+    ep->items = item;
+    if (epitem_poll(item, &pq.pt)) ready_mark(ep, item);
+    irq_restore(flags);
+
+    if (item->ready && waitq_active(&ep->wq)) waitq_wake_all(&ep->wq, NULL);
+    return 0;
+}
+
+static int epoll_do_ctl(epoll_t* ep, int op, int fd, const epoll_event_t* ev) {
+    if (op != EPOLL_CTL_DEL && !ev) return EPOLL_EINVAL;
+
+    if (op == EPOLL_CTL_ADD) return epoll_add(ep, fd, ev);
+
+    epitem_t* item = epitem_find(ep, fd);
+    if (!item) return EPOLL_ENOENT;
+    switch (op) {
+    case EPOLL_CTL_DEL:
+        epitem_remove(ep, item);
+        return 0;
+    case EPOLL_CTL_MOD: {
+        u32 flags = irq_save();
+        item->events = ev->events;
+        item->data = ev->data;
+        if (epitem_poll(item, NULL)) ready_mark(ep, item);
+        irq_restore(flags);
+        if (item->ready && waitq_active(&ep->wq)) waitq_wake_all(&ep->wq, NULL);
+        return 0;
+    }
+    default:
+        return EPOLL_EINVAL;
+    }
+}
+
+int epoll_ctl(int epfd, int op, int fd, const epoll_event_t* ev) {
+    file_t* file;
+    epoll_t* ep = epoll_from_fd(epfd, &file);
+    if (!ep) return EPOLL_EBADF;
+    int ret = epoll_do_ctl(ep, op, fd, ev);
+    file_put(file);
+    return ret;
+}
+
+// Hazır listesini boşaltıp olayları yazar; yalnızca hazır kayıtlara bakılır.
+// Kesmeler kapalıyken çağrılır.
+static int epoll_harvest(epoll_t* ep, epoll_event_t* events, int max) {
+    epitem_list_t pending = ep->ready;
+    epitem_list_t again = { NULL, NULL };
+    ep->ready.head = ep->ready.tail = NULL;
+
+    int n = 0;
+    while (n < max && pending.head) {
+        epitem_t* item = pending.head;
+        ready_unlink(&pending, item);
+        item->ready = 0;
+
+        // Uyandırmadan beri durum değişmiş olabilir (örn. veri okunmuş)
+        u32 mask = epitem_poll(item, NULL) & ~EPOLLET;
+        if (!mask) continue;
+        events[n].events = mask;
+        events[n].data = item->data;
+        n++;
+        // Seviye tetiklemeli: hâlâ hazırsa sonraki çağrı yine görür
+        if (!(item->events & EPOLLET)) {
+            item->ready = 1;
+            ready_push(&again, item);
+        }
+    }
+
+    // Sıra: bu çağrıda bakılmayanlar, sonra yeniden eklenenler
+    ep->ready = pending;
+    if (again.head) {
+        if (ep->ready.tail) {
+            ep->ready.tail->ready_next = again.head;
+            again.head->ready_prev = ep->ready.tail;
+        } else {
+            ep->ready.head = again.head;
+        }
+        ep->ready.tail = again.tail;
+    }
+    return n;
+}
+
+static int epoll_do_wait(epoll_t* ep, epoll_event_t* events, int max, u32 timeout_ms) {
+    if (!events || max <= 0) return EPOLL_EINVAL;
+
+    wait_entry_t wait;
+    waitq_entry_init(&wait, 0, 0);
+    wait.task = sched_current();
+    u32 deadline = timer_ticks() + timer_ms_to_ticks(timeout_ms);
+
+    u32 flags = irq_save();
+    int n;
+    for (;;) {
+        n = epoll_harvest(ep, events, max);
+        if (n || !timeout_ms) break;
+
+        int left = (int)(deadline - timer_ticks());
+        if (timeout_ms != EPOLL_INFINITE && left <= 0) break;
+
+        wait.woken = 0;
+        waitq_add(&ep->wq, &wait);
+        if (timeout_ms == EPOLL_INFINITE) {
+            while (!wait.woken) sched_block();
+        } else {
+            sched_sleep_ms((u32)left * 1000 / TIMER_HZ);
+        }
+        waitq_remove(&ep->wq, &wait);
+    }
+    irq_restore(flags);
+    return n;
+}
+
+int epoll_wait(int epfd, epoll_event_t* events, int max, u32 timeout_ms) {
+    // Uyurken başka bir iş parçacığı epfd'yi kapatsa da örnek serbest kalmaz
+    file_t* file;
+    epoll_t* ep = epoll_from_fd(epfd, &file);
+    if (!ep) return EPOLL_EBADF;
+    int ret = epoll_do_wait(ep, events, max, timeout_ms);
+    file_put(file);
+    return ret;
+}
+
+u32 sys_epoll_create(u32 unused, ...) {
+    return (u32)epoll_create();
+}
+
+u32 sys_epoll_ctl(u32 epfd, u32 op, u32 fd, u32 ev_ptr, ...) {
+    return (u32)epoll_ctl((int)epfd, (int)op, (int)fd, (const epoll_event_t*)ev_ptr);
+}
+
+u32 sys_epoll_wait(u32 epfd, u32 events_ptr, u32 max, u32 timeout_ms, ...) {
+    return (u32)epoll_wait((int)epfd, (epoll_event_t*)events_ptr, (int)max, timeout_ms);
+}
@@ -0,0 +1,105 @@
+#ifndef EPOLL_H
+#define EPOLL_H
+
+#include "utils.h"
+#include "waitq.h"
+#include "vfs.h"
+
+// --- Olay Çoğullama (epoll) ---
+// Bir görev birden çok kaynağı (boru, klavye, seri port, IPC uç noktası,
+// dosya) tek bir beklemeyle izler: ilgi kümesine (epoll nesnesi) fd'ler
+// eklenir, epoll_wait yalnızca hazır olanları döner.
+//
+// Beklenebilen her düğüm bir `poll` işlemi sağlar (vfs_node_t::poll). poll
+// o anki hazırlık maskesini döner ve verilen poll_table ile düğümün bekleme
+// kuyruklarını bildirir (poll_wait). epoll bu kuyruklara kendini callback'li
+// bir wait_entry ile ekler; kaynak waitq_wake_* ile uyandırdığında callback
+// kaydı hazır listesine koyar ve epoll_wait'te uyuyanı uyandırır. Uyandırma
+// anahtarı (key) o an oluşan olayların maskesidir; ilgilenilmeyen olaylar
+// (örn. yalnız EPOLLIN izlenirken EPOLLOUT) kaydı hazır yapmaz. Anahtarsız
+// (NULL) uyandırmalar her zaman hazır sayılır.
+//
+// Böylece epoll_wait izlenen fd sayısıyla değil hazır fd sayısıyla orantılı
+// iş yapar: yalnızca hazır listesindeki kayıtların poll'u yeniden çağrılıp
+// maskeleri doğrulanır.
+//
+//  * Seviye tetiklemeli (varsayılan): hâlâ hazır olan kayıt döndükten sonra
+//    listede kalır; bir sonraki epoll_wait onu yine döner.
+//  * EPOLLET (kenar tetiklemeli): kayıt yalnızca yeni bir uyandırmayla
+//    listeye geri girer.
+//
+// poll'u olmayan düğümler (normal dosyalar) her zaman okunabilir ve
+// yazılabilirdir. İzlenen dosya epoll kaydı silinene kadar açık kalır
+// (kayıt file_t'nin bir referansını tutar); fd'yi kapatmak kaydı silmez.
+
+// Olay maskeleri (Linux değerleri)
+#define EPOLLIN       0x001
+#define EPOLLOUT      0x004
+#define EPOLLERR      0x008 // Her zaman bildirilir
+#define EPOLLHUP      0x010 // Her zaman bildirilir; karşı uç kapandı
+#define EPOLLET       (1u << 31)
+
+// epoll_ctl işlemleri
+#define EPOLL_CTL_ADD 1
+#define EPOLL_CTL_DEL 2
+#define EPOLL_CTL_MOD 3
+
+#define EPOLL_INFINITE 0xFFFFFFFF // epoll_wait: süresiz bekle
+
+// Bir düğümün en fazla kaç bekleme kuyruğu bildirebileceği
+#define EPOLL_MAX_WAITQ 2
+
+// Dönüş değerleri
+#define EPOLL_EBADF   -1 // Geçersiz fd ya da epoll nesnesi değil
+#define EPOLL_EEXIST  -2
+#define EPOLL_ENOENT  -3
+#define EPOLL_ENOMEM  -4
+#define EPOLL_EINVAL  -5
+
+typedef struct {
+    u32 events;
+    u32 data; // Kullanıcının verdiği değer, olayla aynen döner
+} epoll_event_t;
+
+// poll sırasında bekleme kuyruklarını toplayan nesne; NULL ise yalnızca
+// maske sorulmaktadır
+typedef struct poll_table {
+    void (*queue)(struct poll_table* pt, wait_queue_t* wq);
+} poll_table_t;
+
+static inline void poll_wait(wait_queue_t* wq, poll_table_t* pt) {
+    if (pt) pt->queue(pt, wq);
+}
+
+// Kaynakların uyandırma anahtarı: oluşan olayların maskesi
+#define POLL_KEY(mask) ((void*)(u32)(mask))
+
+// Düğümün hazırlık maskesi; poll'u olmayan düğümler için EPOLLIN | EPOLLOUT
+u32 vfs_poll_node(vfs_node_t* node, poll_table_t* pt);
+
+/**
+ * @brief Yeni bir epoll nesnesi oluşturur ve mevcut tabloya yerleştirir.
+ * @return epoll fd'si; hata durumunda negatif.
+ */
+int epoll_create();
+
+/**
+ * @brief İlgi kümesine fd ekler, maskesini değiştirir ya da çıkarır.
+ * @param ev EPOLL_CTL_DEL'de kullanılmaz.
+ * @return Başarılıysa 0; EPOLL_E* hata kodu.
+ */
+int epoll_ctl(int epfd, int op, int fd, const epoll_event_t* ev);
+
+/**
+ * @brief En az bir fd hazır olana (ya da süre dolana) kadar bekler.
+ * @param timeout_ms 0: beklemez, EPOLL_INFINITE: süresiz.
+ * @return `events`e yazılan olay sayısı (en fazla `max`); süre dolduysa 0.
+ */
+int epoll_wait(int epfd, epoll_event_t* events, int max, u32 timeout_ms);
+
+// Syscall arayüzü
+u32 sys_epoll_create(u32 unused, ...);
+u32 sys_epoll_ctl(u32 epfd, u32 op, u32 fd, u32 ev_ptr, ...);
+u32 sys_epoll_wait(u32 epfd, u32 events_ptr, u32 max, u32 timeout_ms, ...);
+
+#endif
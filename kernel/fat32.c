@@ -0,0 +1,989 @@
+#include "fat32.h"
+#include "dcache.h"
+#include "slab.h"
+#include "pmm.h"
+#include "klog.h"
+#include "string.h"
+
+#define FAT_DIRENT_SIZE  32
+#define FAT_DEFAULT_DATE 0x0021 // 1980-01-01; saat kaynağı yok
+#define FAT_FSINFO_LEAD   0x41615252
+#define FAT_FSINFO_STRUCT 0x61417272
+
+static slab_cache_t fat_fs_cache = SLAB_CACHE_INIT("fat_fs", sizeof(fat_fs_t));
+static slab_cache_t fat_inode_cache = SLAB_CACHE_INIT("fat_inode", sizeof(fat_inode_t));
+static u8 fat_log;
+
+// LFN girdisinde 13 UCS-2 karakterin byte ofsetleri
+static const u8 lfn_offsets[FAT_LFN_CHARS] = { 1, 3, 5, 7, 9, 14, 16, 18, 20, 22, 24, 28, 30 };
+
+static vfs_node_t* fat_finddir(vfs_node_t* node, const char* name);
+static int fat_mkdir(vfs_node_t* node, const char* name, uint32_t perms);
+static int fat_create(vfs_node_t* node, const char* name, uint32_t perms);
+static int fat_close(vfs_node_t* node);
+static int fat_truncate(vfs_node_t* node, uint32_t length);
+static int fat_readpage(vfs_node_t* node, uint32_t index, uint8_t* page);
+static int fat_writepage(vfs_node_t* node, uint32_t index, const uint8_t* page);
+
+static inline fat_inode_t* FAT_I(vfs_node_t* node) {
+    return (fat_inode_t*)node;
+}
+
+static inline int cluster_valid(fat_fs_t* fs, u32 cluster) {
+    return cluster >= 2 && cluster < fs->total_clusters + 2;
+}
+
+static inline u32 cluster_sector(fat_fs_t* fs, u32 cluster) {
+    return fs->data_start + (cluster - 2) * fs->sectors_per_cluster;
+}
+
+// Mutlak sektörün bcache tamponu ve sektörün tampon içindeki adresi
+static u8* fat_sector(fat_fs_t* fs, u32 sector, buffer_t** out) {
+    buffer_t* buf = bcache_read(fs->dev, sector / BCACHE_SECTORS);
+    *out = buf;
+    if (!buf) return NULL;
+    return buf->data + (sector % BCACHE_SECTORS) * BLK_SECTOR_SIZE;
+}
+
+// --- FAT Tablosu ---
+
+static u32* fat_entry(fat_fs_t* fs, u32 cluster, buffer_t** out) {
+    u32 byte = (fs->fat_start % BCACHE_SECTORS) * BLK_SECTOR_SIZE + cluster * 4;
+    *out = fs->fat_blocks[byte / BCACHE_BLOCK_SIZE];
+    return (u32*)((*out)->data + byte % BCACHE_BLOCK_SIZE);
+}
+
+static u32 fat_get(fat_fs_t* fs, u32 cluster) {
+    buffer_t* buf;
+    return *fat_entry(fs, cluster, &buf) & FAT_CLUSTER_MASK;
+}
+
+static void fat_set(fat_fs_t* fs, u32 cluster, u32 value) {
+    buffer_t* buf;
+    u32* e = fat_entry(fs, cluster, &buf);
+    *e = (*e & ~FAT_CLUSTER_MASK) | (value & FAT_CLUSTER_MASK);
+    bcache_mark_dirty(buf);
+
+    // Yansı FAT'ler sabitlenmez; nadiren değiştikleri için önbellekten okunur
+    if (!fs->mirror) return;
+    for (u32 i = 1; i < fs->num_fats; i++) {
+        buffer_t* mbuf;
+        u8* p = fat_sector(fs, fs->fat_start + i * fs->fat_sectors + cluster * 4 / BLK_SECTOR_SIZE, &mbuf);
+        if (!p) continue;
+        u32* m = (u32*)(p + cluster * 4 % BLK_SECTOR_SIZE);
+        *m = (*m & ~FAT_CLUSTER_MASK) | (value & FAT_CLUSTER_MASK);
+        bcache_mark_dirty(mbuf);
+        bcache_release(mbuf);
+    }
+}
+
+// `want` boş kümelik aralık arar: önce `prefer`den başlayanı (zinciri bitişik
+// uzatmak için), yoksa next_free'den itibaren yeterli ilk aralığı, o da yoksa
+// en uzununu. Bulunan uzunluk *len'e yazılır (0: boş küme yok).
+static u32 fat_find_run(fat_fs_t* fs, u32 prefer, u32 want, u32* len) {
+    u32 n = 0;
+    while (n < want && cluster_valid(fs, prefer + n) && fat_get(fs, prefer + n) == 0) n++;
+    if (n) {
+        *len = n;
+        return prefer;
+    }
+
+    u32 best = 0, best_len = 0;
+    u32 run = 0, run_len = 0;
+    u32 c = cluster_valid(fs, fs->next_free) ? fs->next_free : 2;
+    for (u32 i = 0; i < fs->total_clusters; i++, c++) {
+        if (!cluster_valid(fs, c)) { // Başa sar; aralık sınırda kopar
+            c = 2;
+            if (run_len > best_len) { best = run; best_len = run_len; }
+            run_len = 0;
+        }
+        if (fat_get(fs, c) == 0) {
+            if (!run_len) run = c;
+            if (++run_len >= want) {
+                *len = want;
+                return run;
+            }
+        } else {
+            if (run_len > best_len) { best = run; best_len = run_len; }
+            run_len = 0;
+        }
+    }
+    if (run_len > best_len) { best = run; best_len = run_len; }
+    *len = best_len;
+    return best;
+}
+
+// `count` küme ayırıp `after`ın (0: yeni zincir) arkasına bağlar. İlk yeni
+// kümeyi döner, sonuncusu *last'a yazılır; yer yoksa hiç ayırmadan 0.
+static u32 fat_alloc(fat_fs_t* fs, u32 after, u32 count, u32* last) {
+    if (!count || count > fs->free_count) return 0;
+
+    u32 first = 0, prev = after;
+    while (count) {
+        u32 len;
+        u32 start = fat_find_run(fs, prev ? prev + 1 : 0, count, &len);
+        if (!len) break; // free_count ile FAT çelişiyor; ayrılan kadarı kalır
+        for (u32 i = 0; i < len; i++) {
+            fat_set(fs, start + i, i + 1 < len ? start + i + 1 : FAT_CLUSTER_END);
+        }
+        if (prev) fat_set(fs, prev, start);
+        if (!first) first = start;
+        prev = start + len - 1;
+        count -= len;
+        fs->free_count -= len;
+        fs->next_free = prev + 1;
+    }
+    *last = prev;
+    return first;
+}
+
+static void fat_free_chain(fat_fs_t* fs, u32 cluster) {
+    for (u32 n = 0; cluster_valid(fs, cluster) && n < fs->total_clusters; n++) {
+        u32 next = fat_get(fs, cluster);
+        fat_set(fs, cluster, 0);
+        fs->free_count++;
+        if (cluster < fs->next_free) fs->next_free = cluster;
+        cluster = next;
+    }
+}
+
+// --- Küme Zincirleri ---
+
+static void fat_chain_scan(fat_inode_t* ino) {
+    fat_fs_t* fs = ino->fs;
+    u32 n = 0, last = 0;
+    for (u32 c = ino->first_cluster; cluster_valid(fs, c) && n < fs->total_clusters; c = fat_get(fs, c)) {
+        last = c;
+        n++;
+    }
+    ino->nr_clusters = n;
+    ino->last_cluster = last;
+    ino->hint_cluster = 0;
+}
+
+// Zincirin `index`. kümesi; zincir kısaysa 0. Sıralı erişim son çözülen
+// kümeden devam eder.
+static u32 fat_cluster_at(fat_inode_t* ino, u32 index) {
+    fat_fs_t* fs = ino->fs;
+    if (index >= ino->nr_clusters) return 0;
+    if (index == ino->nr_clusters - 1) return ino->last_cluster;
+
+    u32 c = ino->first_cluster, i = 0;
+    if (ino->hint_cluster && ino->hint_index <= index) {
+        c = ino->hint_cluster;
+        i = ino->hint_index;
+    }
+    while (i < index && cluster_valid(fs, c)) {
+        c = fat_get(fs, c);
+        i++;
+    }
+    if (!cluster_valid(fs, c)) return 0;
+    ino->hint_index = i;
+    ino->hint_cluster = c;
+    return c;
+}
+
+// Zinciri en az `count` kümeye uzatır; yeni kümeler tek seferde ve bitişik
+// ayrılmaya çalışılır
+static int fat_extend(fat_inode_t* ino, u32 count) {
+    if (count <= ino->nr_clusters) return 0;
+    u32 last;
+    u32 first = fat_alloc(ino->fs, ino->last_cluster, count - ino->nr_clusters, &last);
+    if (!first) return -1;
+    if (!ino->first_cluster) ino->first_cluster = first;
+    fat_chain_scan(ino);
+    return ino->nr_clusters >= count ? 0 : -1;
+}
+
+static int fat_zero_cluster(fat_fs_t* fs, u32 cluster) {
+    u32 sector = cluster_sector(fs, cluster);
+    for (u32 i = 0; i < fs->sectors_per_cluster; i++) {
+        buffer_t* buf;
+        u8* p = fat_sector(fs, sector + i, &buf);
+        if (!p) return -1;
+        memset(p, 0, BLK_SECTOR_SIZE);
+        bcache_mark_dirty(buf);
+        bcache_release(buf);
+    }
+    return 0;
+}
+
+// --- Dizin Girdileri ---
+
+static u8 fat_lfn_checksum(const char* short_name) {
+    u8 sum = 0;
+    for (int i = 0; i < 11; i++) sum = (u8)(((sum & 1) << 7) + (sum >> 1) + (u8)short_name[i]);
+    return sum;
+}
+
+static inline char fat_upper(char c) {
+    return (c >= 'a' && c <= 'z') ? c - 32 : c;
+}
+
+static inline char fat_lower(char c) {
+    return (c >= 'A' && c <= 'Z') ? c + 32 : c;
+}
+
+// FAT isimleri büyük/küçük harf duyarsızdır
+static int fat_name_eq(const char* a, const char* b) {
+    while (*a && fat_upper(*a) == fat_upper(*b)) {
+        a++;
+        b++;
+    }
+    return *a == *b;
+}
+
+// Dizinin `slot`. girdisinin yeri; dizin zinciri o kadar uzun değilse -1
+static int fat_slot_pos(fat_inode_t* dir, u32 slot, u32* sector, u32* offset) {
+    fat_fs_t* fs = dir->fs;
+    u32 per_cluster = fs->cluster_bytes / FAT_DIRENT_SIZE;
+    u32 cluster = fat_cluster_at(dir, slot / per_cluster);
+    if (!cluster) return -1;
+    u32 byte = (slot % per_cluster) * FAT_DIRENT_SIZE;
+    *sector = cluster_sector(fs, cluster) + byte / BLK_SECTOR_SIZE;
+    *offset = byte % BLK_SECTOR_SIZE;
+    return 0;
+}
+
+// Girdinin kendisi; tampon bcache_release ile bırakılmalı
+static fat_dirent_t* fat_slot(fat_inode_t* dir, u32 slot, buffer_t** buf, u32* sector, u32* offset) {
+    u32 s, o;
+    if (fat_slot_pos(dir, slot, &s, &o) < 0) return NULL;
+    u8* p = fat_sector(dir->fs, s, buf);
+    if (!p) return NULL;
+    if (sector) *sector = s;
+    if (offset) *offset = o;
+    return (fat_dirent_t*)(p + o);
+}
+
+static void fat_short_to_name(const fat_dirent_t* de, char* out) {
+    int n = 0;
+    for (int i = 0; i < 8 && de->name[i] != ' '; i++) {
+        char c = (i == 0 && (u8)de->name[0] == 0x05) ? (char)0xE5 : de->name[i];
+        out[n++] = (de->nt_res & FAT_NT_LOWER_BASE) ? fat_lower(c) : c;
+    }
+    if (de->name[8] != ' ') {
+        out[n++] = '.';
+        for (int i = 8; i < 11 && de->name[i] != ' '; i++) {
+            out[n++] = (de->nt_res & FAT_NT_LOWER_EXT) ? fat_lower(de->name[i]) : de->name[i];
+        }
+    }
+    out[n] = '\0';
+}
+
+// LFN parçasını isme ekler; isim MAX_FILENAME_LENGTH'e sığmıyorsa -1
+static int fat_lfn_get(const fat_lfn_t* lfn, char* name, u32 pos) {
+    const u8* raw = (const u8*)lfn;
+    for (int i = 0; i < FAT_LFN_CHARS; i++) {
+        u16 ch = raw[lfn_offsets[i]] | (raw[lfn_offsets[i] + 1] << 8);
+        if (ch == 0x0000 || ch == 0xFFFF) break;
+        if (pos + i >= MAX_FILENAME_LENGTH - 1) return -1;
+        name[pos + i] = ch < 0x80 ? (char)ch : '?';
+    }
+    return 0;
+}
+
+static void fat_lfn_put(fat_lfn_t* lfn, const char* name, u32 len, u32 seq, u8 sum, int last) {
+    u8* raw = (u8*)lfn;
+    memset(raw, 0, FAT_DIRENT_SIZE);
+    lfn->order = (u8)(seq | (last ? FAT_LFN_LAST : 0));
+    lfn->attr = FAT_ATTR_LFN;
+    lfn->checksum = sum;
+
+    u32 pos = (seq - 1) * FAT_LFN_CHARS;
+    for (int i = 0; i < FAT_LFN_CHARS; i++, pos++) {
+        // İsimden sonra bir 0x0000, kalanı 0xFFFF doldurulur
+        u16 ch = pos < len ? (u8)name[pos] : (pos == len ? 0x0000 : 0xFFFF);
+        raw[lfn_offsets[i]] = (u8)ch;
+        raw[lfn_offsets[i] + 1] = (u8)(ch >> 8);
+    }
+}
+
+static void fat_dirent_fill(fat_dirent_t* de, const char* short_name, u8 attr, u8 nt_res, u32 cluster) {
+    memset(de, 0, sizeof(*de));
+    memcpy(de->name, short_name, 11);
+    de->attr = attr;
+    de->nt_res = nt_res;
+    de->cluster_hi = (u16)(cluster >> 16);
+    de->cluster_lo = (u16)cluster;
+    de->crt_date = de->wrt_date = de->acc_date = FAT_DEFAULT_DATE;
+}
+
+typedef int (*fat_dir_cb_t)(fat_inode_t* dir, fat_dirent_t* de, u32 sector, u32 offset,
+                            const char* name, void* arg);
+
+// Dizindeki her girdi için (silinmişler ve LFN parçaları hariç) cb'yi uzun
+// ismiyle, LFN yoksa ya da bozuksa kısa ismiyle çağırır. cb sıfır dışı
+// dönerse tarama durur ve o değer döner.
+static int fat_dir_iterate(fat_inode_t* dir, fat_dir_cb_t cb, void* arg) {
+    char lfn[MAX_FILENAME_LENGTH];
+    char name[MAX_FILENAME_LENGTH];
+    u32 lfn_expect = 0; // Beklenen sonraki LFN sırası (0: LFN yok)
+    int lfn_ready = 0;
+    u8 lfn_sum = 0;
+
+    for (u32 slot = 0; ; slot++) {
+        buffer_t* buf;
+        u32 sector, offset;
+        fat_dirent_t* de = fat_slot(dir, slot, &buf, &sector, &offset);
+        if (!de) return 0;
+        u8 first = (u8)de->name[0];
+        if (first == 0x00) { // Dizin sonu
+            bcache_release(buf);
+            return 0;
+        }
+
+        int result = 0;
+        if (first == 0xE5) {
+            lfn_expect = lfn_ready = 0;
+        } else if (de->attr == FAT_ATTR_LFN) {
+            fat_lfn_t* l = (fat_lfn_t*)de;
+            u32 seq = l->order & 0x1F;
+            if (l->order & FAT_LFN_LAST) {
+                memset(lfn, 0, sizeof(lfn));
+                lfn_expect = seq;
+                lfn_sum = l->checksum;
+                lfn_ready = 0;
+            }
+            if (seq && seq == lfn_expect && l->checksum == lfn_sum &&
+                fat_lfn_get(l, lfn, (seq - 1) * FAT_LFN_CHARS) == 0) {
+                lfn_expect--;
+                lfn_ready = lfn_expect == 0;
+            } else {
+                lfn_expect = lfn_ready = 0;
+            }
+        } else {
+            if (lfn_ready && lfn_sum == fat_lfn_checksum(de->name)) {
+                strlcpy(name, lfn, sizeof(name));
+            } else {
+                fat_short_to_name(de, name);
+            }
+            lfn_expect = lfn_ready = 0;
+            result = cb(dir, de, sector, offset, name, arg);
+        }
+        bcache_release(buf);
+        if (result) return result;
+    }
+}
+
+// --- Düğümler ---
+
+static fat_inode_t* fat_node_new(fat_fs_t* fs, fat_inode_t* parent, const char* name,
+                                 const fat_dirent_t* de, u32 sector, u32 offset) {
+    fat_inode_t* ino = (fat_inode_t*)slab_alloc(&fat_inode_cache);
+    if (!ino) return NULL;
+
+    vfs_node_t* node = &ino->vfs;
+    strlcpy(node->name, name, sizeof(node->name));
+    node->internal_data = ino;
+    ino->fs = fs;
+    ino->attr = de->attr;
+    ino->first_cluster = ((u32)de->cluster_hi << 16) | de->cluster_lo;
+    ino->dirent_sector = sector;
+    ino->dirent_offset = offset;
+    fat_chain_scan(ino);
+
+    if (de->attr & FAT_ATTR_DIRECTORY) {
+        node->type = FS_NODE_DIRECTORY;
+        node->permissions = 0755;
+        node->finddir = fat_finddir;
+        node->mkdir = fat_mkdir;
+        node->create = fat_create;
+    } else {
+        node->type = FS_NODE_FILE;
+        node->permissions = (de->attr & FAT_ATTR_READ_ONLY) ? 0444 : 0644;
+        node->size = ino->disk_size = ino->valid_size = de->size;
+        node->close = fat_close;
+        node->truncate = fat_truncate;
+        node->readpage = fat_readpage;
+        node->writepage = fat_writepage;
+        pagecache_attach(node, &ino->cache);
+    }
+
+    if (parent) {
+        node->parent = &parent->vfs;
+        node->next_sibling = parent->vfs.first_child;
+        parent->vfs.first_child = node;
+    }
+    return ino;
+}
+
+static int fat_load_entry(fat_inode_t* dir, fat_dirent_t* de, u32 sector, u32 offset,
+                          const char* name, void* arg) {
+    if (de->attr & FAT_ATTR_VOLUME_ID) return 0;
+    if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) return 0;
+    return fat_node_new(dir->fs, dir, name, de, sector, offset) ? 0 : -1;
+}
+
+// Dizin ilk kez arandığında bütün girdileri düğüm olarak çocuk listesine
+// alınır; sonraki aramalar ve listeleme diske gitmez.
+static void fat_dir_load(fat_inode_t* dir) {
+    if (dir->loaded) return;
+    dir->loaded = 1;
+    if (fat_dir_iterate(dir, fat_load_entry, NULL) < 0) {
+        KLOG(LOG_LEVEL_ERROR, fat_log, "%s: out of memory loading directory", dir->vfs.name);
+    }
+}
+
+static int fat_update_dirent(fat_inode_t* ino) {
+    if (!ino->dirent_sector) return 0; // Kökün girdisi yok
+    u32 size = ino->vfs.type == FS_NODE_FILE ? ino->vfs.size : 0;
+
+    buffer_t* buf;
+    u8* p = fat_sector(ino->fs, ino->dirent_sector, &buf);
+    if (!p) return -1;
+    fat_dirent_t* de = (fat_dirent_t*)(p + ino->dirent_offset);
+    u32 cluster = ((u32)de->cluster_hi << 16) | de->cluster_lo;
+    if (de->size != size || cluster != ino->first_cluster) {
+        de->size = size;
+        de->cluster_hi = (u16)(ino->first_cluster >> 16);
+        de->cluster_lo = (u16)ino->first_cluster;
+        if (ino->vfs.type == FS_NODE_FILE) de->attr |= FAT_ATTR_ARCHIVE;
+        bcache_mark_dirty(buf);
+    }
+    bcache_release(buf);
+    ino->disk_size = size;
+    return 0;
+}
+
+// --- Dosya Verisi ---
+
+// Dosyanın `pos`tan itibaren `bytes` byte'ını (sektöre yuvarlanır) sayfaya
+// okur ya da sayfadan yazar. Her kümenin parçası ayrı bio'dur; hepsi tek plug
+// içinde verilir, bitişik kümeler blok katmanında tek isteğe birleşir.
+// Okumada kümesi olmayan parça sıfırlanır.
+static int fat_page_io(fat_inode_t* ino, u32 pos, u32 bytes, u8* page, int dir) {
+    fat_fs_t* fs = ino->fs;
+    bio_t bios[PAGE_SIZE / BLK_SECTOR_SIZE];
+    u32 nbios = 0;
+    int result = 0;
+
+    blk_plug(fs->dev);
+    for (u32 done = 0; done < bytes; ) {
+        u32 off = pos + done;
+        u32 cluster_off = off % fs->cluster_bytes;
+        u32 n = fs->cluster_bytes - cluster_off;
+        if (n > bytes - done) n = bytes - done;
+        u32 sectors = (n + BLK_SECTOR_SIZE - 1) / BLK_SECTOR_SIZE;
+
+        u32 cluster = fat_cluster_at(ino, off / fs->cluster_bytes);
+        if (!cluster) {
+            if (dir == BLK_READ) memset(page + done, 0, sectors * BLK_SECTOR_SIZE);
+            else result = -1;
+        } else {
+            bio_t* bio = &bios[nbios];
+            memset(bio, 0, sizeof(*bio));
+            bio->sector = cluster_sector(fs, cluster) + cluster_off / BLK_SECTOR_SIZE;
+            bio->count = sectors;
+            bio->buffer = page + done;
+            bio->dir = dir;
+            if (dir == BLK_WRITE) bcache_update_range(fs->dev, bio->sector, sectors, bio->buffer);
+            if (blk_submit(fs->dev, bio) < 0) result = -1;
+            else nbios++;
+        }
+        done += n;
+    }
+    blk_unplug(fs->dev);
+
+    for (u32 i = 0; i < nbios; i++) {
+        if (blk_wait(&bios[i]) < 0) result = -1;
+    }
+    return result;
+}
+
+static int fat_readpage(vfs_node_t* node, uint32_t index, uint8_t* page) {
+    fat_inode_t* ino = FAT_I(node);
+    u32 pos = index * PAGE_SIZE;
+    u32 bytes = 0;
+    if (pos < ino->valid_size) {
+        bytes = ino->valid_size - pos;
+        if (bytes > PAGE_SIZE) bytes = PAGE_SIZE;
+    }
+    if (bytes && fat_page_io(ino, pos, bytes, page, BLK_READ) < 0) return -1;
+    memset(page + bytes, 0, PAGE_SIZE - bytes);
+    return 0;
+}
+
+// valid_size ile `end` arasını diske sıfır olarak yazar. Dosya sonunun
+// ötesine yazılınca ya da dosya büyütülünce aradaki kümelerde eski veri
+// durur; bu yapılmazsa bağlama sonrası görünürdü.
+static int fat_fill_gap(fat_inode_t* ino, u32 end) {
+    if (ino->valid_size >= end) return 0;
+    u8* tmp = (u8*)pmm_alloc_page();
+    if (!tmp) return -1;
+
+    int result = 0;
+    while (ino->valid_size < end) {
+        u32 start = ino->valid_size & ~(PAGE_SIZE - 1);
+        u32 bytes = ino->vfs.size - start;
+        if (bytes > PAGE_SIZE) bytes = PAGE_SIZE;
+        // Geçerli kısım diskten okunur, kalanı sıfırlanır
+        if (fat_readpage(&ino->vfs, start / PAGE_SIZE, tmp) < 0 ||
+            fat_page_io(ino, start, bytes, tmp, BLK_WRITE) < 0) {
+            result = -1;
+            break;
+        }
+        ino->valid_size = start + bytes;
+    }
+    pmm_free_page(tmp);
+    return result;
+}
+
+static inline u32 fat_clusters_for(fat_fs_t* fs, u32 size) {
+    return (size + fs->cluster_bytes - 1) / fs->cluster_bytes;
+}
+
+static int fat_writepage(vfs_node_t* node, uint32_t index, const uint8_t* page) {
+    fat_inode_t* ino = FAT_I(node);
+    u32 pos = index * PAGE_SIZE;
+    if (pos >= node->size) return 0;
+    u32 bytes = node->size - pos;
+    if (bytes > PAGE_SIZE) bytes = PAGE_SIZE;
+
+    // Dosyanın o anki boyutunun tamamı için bir kerede: sıralı yazılan büyük
+    // dosya tek parça yer alır
+    if (fat_extend(ino, fat_clusters_for(ino->fs, node->size)) < 0) {
+        KLOG(LOG_LEVEL_WARN, fat_log, "%s: no space left on device", node->name);
+        return -1;
+    }
+    if (fat_fill_gap(ino, pos) < 0) return -1;
+    if (fat_page_io(ino, pos, bytes, (u8*)page, BLK_WRITE) < 0) return -1;
+    if (pos + bytes > ino->valid_size) ino->valid_size = pos + bytes;
+    return fat_update_dirent(ino);
+}
+
+// Büyütülmüş ama yazılmamış kuyruğu diske indirir ve girdiyi günceller
+static int fat_flush_file(fat_inode_t* ino) {
+    int result = pagecache_writeback(&ino->vfs) < 0 ? -1 : 0;
+    if (ino->valid_size < ino->vfs.size) {
+        if (fat_extend(ino, fat_clusters_for(ino->fs, ino->vfs.size)) < 0 ||
+            fat_fill_gap(ino, ino->vfs.size) < 0) {
+            result = -1;
+        }
+    }
+    if (fat_update_dirent(ino) < 0) result = -1;
+    return result;
+}
+
+static void fat_write_fsinfo(fat_fs_t* fs) {
+    if (!fs->fsinfo_sector) return;
+    buffer_t* buf;
+    fat_fsinfo_t* fi = (fat_fsinfo_t*)fat_sector(fs, fs->fsinfo_sector, &buf);
+    if (!fi) return;
+    if (fi->lead_sig == FAT_FSINFO_LEAD && fi->struct_sig == FAT_FSINFO_STRUCT &&
+        (fi->free_count != fs->free_count || fi->next_free != fs->next_free)) {
+        fi->free_count = fs->free_count;
+        fi->next_free = fs->next_free;
+        bcache_mark_dirty(buf);
+    }
+    bcache_release(buf);
+}
+
+static int fat_close(vfs_node_t* node) {
+    fat_inode_t* ino = FAT_I(node);
+    int result = fat_flush_file(ino);
+    fat_write_fsinfo(ino->fs);
+    return result;
+}
+
+static int fat_truncate(vfs_node_t* node, uint32_t length) {
+    fat_inode_t* ino = FAT_I(node);
+    fat_fs_t* fs = ino->fs;
+    if (node->type != FS_NODE_FILE) return -1;
+    pagecache_truncate(node, length);
+
+    u32 keep = fat_clusters_for(fs, length);
+    if (keep < ino->nr_clusters) {
+        if (keep == 0) {
+            fat_free_chain(fs, ino->first_cluster);
+            ino->first_cluster = 0;
+        } else {
+            u32 last = fat_cluster_at(ino, keep - 1);
+            u32 rest = fat_get(fs, last);
+            fat_set(fs, last, FAT_CLUSTER_END);
+            fat_free_chain(fs, rest);
+        }
+        fat_chain_scan(ino);
+    }
+    if (ino->valid_size > length) ino->valid_size = length;
+    return fat_update_dirent(ino);
+}
+
+// --- Dizin İşlemleri ---
+
+static vfs_node_t* fat_finddir(vfs_node_t* node, const char* name) {
+    fat_dir_load(FAT_I(node));
+    for (vfs_node_t* child = node->first_child; child; child = child->next_sibling) {
+        if (fat_name_eq(child->name, name)) return child;
+    }
+    return NULL;
+}
+
+static int fat_short_char(char c) {
+    if ((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) return 1;
+    return c && strchr("$%'-_@~`!(){}^#&", c) != NULL;
+}
+
+static int fat_valid_name(const char* name, size_t len) {
+    if (len == 0 || len >= MAX_FILENAME_LENGTH) return 0;
+    if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) return 0;
+    for (size_t i = 0; i < len; i++) {
+        if ((u8)name[i] < 0x20 || strchr("\"*/:<>?\\|", name[i])) return 0;
+    }
+    return 1;
+}
+
+// İsmi 8.3'e çevirir. Olduğu gibi sığıyorsa (taban ve uzantı ayrı ayrı
+// tümüyle büyük ya da küçük harf) 0 döner ve *nt_res küçük harf bayraklarını
+// alır; LFN gerekiyorsa 1.
+static int fat_make_short(const char* name, char* short_name, u8* nt_res) {
+    memset(short_name, ' ', 11);
+    const char* dot = strrchr(name, '.');
+    if (dot == name) dot = NULL; // ".profile": uzantı değil
+    size_t base_len = dot ? (size_t)(dot - name) : strlen(name);
+
+    int lossy = 0, lower = 0, upper = 0, lower_ext = 0, upper_ext = 0;
+    int n = 0;
+    for (size_t i = 0; i < base_len; i++) {
+        char c = name[i];
+        if (c == ' ' || c == '.') { lossy = 1; continue; }
+        if (n == 8) { lossy = 1; break; }
+        if (c >= 'a' && c <= 'z') lower = 1;
+        if (c >= 'A' && c <= 'Z') upper = 1;
+        char u = fat_upper(c);
+        if (!fat_short_char(u)) { u = '_'; lossy = 1; }
+        short_name[n++] = u;
+    }
+    if (n == 0) { short_name[n++] = '_'; lossy = 1; }
+
+    if (dot) {
+        n = 8;
+        for (const char* p = dot + 1; *p; p++) {
+            if (*p == ' ') { lossy = 1; continue; }
+            if (n == 11) { lossy = 1; break; }
+            if (*p >= 'a' && *p <= 'z') lower_ext = 1;
+            if (*p >= 'A' && *p <= 'Z') upper_ext = 1;
+            char u = fat_upper(*p);
+            if (!fat_short_char(u)) { u = '_'; lossy = 1; }
+            short_name[n++] = u;
+        }
+    }
+
+    *nt_res = (lower ? FAT_NT_LOWER_BASE : 0) | (lower_ext ? FAT_NT_LOWER_EXT : 0);
+    return lossy || (lower && upper) || (lower_ext && upper_ext);
+}
+
+// Tabanın sonuna "~N" koyar (örn. "LONGFI~1")
+static void fat_short_tail(char* short_name, const char* base, u32 num) {
+    char digits[8];
+    int d = 0;
+    do {
+        digits[d++] = (char)('0' + num % 10);
+        num /= 10;
+    } while (num);
+
+    memcpy(short_name, base, 11);
+    int len = 0;
+    while (len < 8 && base[len] != ' ') len++;
+    int pos = len < 8 - (d + 1) ? len : 8 - (d + 1);
+    short_name[pos++] = '~';
+    while (d) short_name[pos++] = digits[--d];
+}
+
+static int fat_short_taken(fat_inode_t* dir, fat_dirent_t* de, u32 sector, u32 offset,
+                           const char* name, void* arg) {
+    return memcmp(de->name, arg, 11) == 0;
+}
+
+// Dizin sonundaki boş girdiler de (0x00) dahil `count` ardışık boş girdi
+// bulur; yoksa dizini bir küme büyütür
+static int fat_find_free_slots(fat_inode_t* dir, u32 count, u32* first) {
+    u32 run = 0, start = 0;
+    for (u32 slot = 0; ; slot++) {
+        u32 sector, offset;
+        if (fat_slot_pos(dir, slot, &sector, &offset) < 0) {
+            if (fat_extend(dir, dir->nr_clusters + 1) < 0) return -1;
+            if (fat_zero_cluster(dir->fs, dir->last_cluster) < 0) return -1;
+        }
+
+        buffer_t* buf;
+        fat_dirent_t* de = fat_slot(dir, slot, &buf, NULL, NULL);
+        if (!de) return -1;
+        u8 c = (u8)de->name[0];
+        bcache_release(buf);
+
+        if (c == 0x00 || c == 0xE5) {
+            if (!run) start = slot;
+            if (++run == count) {
+                *first = start;
+                return 0;
+            }
+        } else {
+            run = 0;
+        }
+    }
+}
+
+// Dizine `name` için girdi (gerekirse önünde LFN girdileriyle) yazar ve kısa
+// girdinin yerini döner
+static int fat_add_entry(fat_inode_t* dir, const char* name, u8 attr, u32 cluster,
+                         u32* sector, u32* offset) {
+    char short_name[11];
+    u8 nt_res;
+    int need_lfn = fat_make_short(name, short_name, &nt_res);
+    if (!need_lfn && fat_dir_iterate(dir, fat_short_taken, short_name)) need_lfn = 1;
+
+    if (need_lfn) {
+        char base[11];
+        memcpy(base, short_name, 11);
+        nt_res = 0;
+        u32 num;
+        for (num = 1; num < 1000000; num++) {
+            fat_short_tail(short_name, base, num);
+            if (!fat_dir_iterate(dir, fat_short_taken, short_name)) break;
+        }
+        if (num == 1000000) return -1;
+    }
+
+    u32 len = strlen(name);
+    u32 nlfn = need_lfn ? (len + FAT_LFN_CHARS - 1) / FAT_LFN_CHARS : 0;
+    u32 slot;
+    if (fat_find_free_slots(dir, nlfn + 1, &slot) < 0) return -1;
+
+    // LFN parçaları ters sırada: ilk girdi ismin son parçasıdır
+    u8 sum = fat_lfn_checksum(short_name);
+    buffer_t* buf;
+    for (u32 i = 0; i < nlfn; i++) {
+        fat_lfn_t* lfn = (fat_lfn_t*)fat_slot(dir, slot + i, &buf, NULL, NULL);
+        if (!lfn) return -1;
+        fat_lfn_put(lfn, name, len, nlfn - i, sum, i == 0);
+        bcache_mark_dirty(buf);
+        bcache_release(buf);
+    }
+
+    fat_dirent_t* de = fat_slot(dir, slot + nlfn, &buf, sector, offset);
+    if (!de) return -1;
+    fat_dirent_fill(de, short_name, attr, nt_res, cluster);
+    bcache_mark_dirty(buf);
+    bcache_release(buf);
+    return 0;
+}
+
+// Yeni dizin kümesini "." ve ".." girdileriyle hazırlar
+static int fat_dir_init(fat_fs_t* fs, u32 cluster, fat_inode_t* parent) {
+    if (fat_zero_cluster(fs, cluster) < 0) return -1;
+    buffer_t* buf;
+    fat_dirent_t* de = (fat_dirent_t*)fat_sector(fs, cluster_sector(fs, cluster), &buf);
+    if (!de) return -1;
+    // Kökü gösteren ".." kümesi 0'dır
+    u32 up = parent == fs->root ? 0 : parent->first_cluster;
+    fat_dirent_fill(&de[0], ".          ", FAT_ATTR_DIRECTORY, 0, cluster);
+    fat_dirent_fill(&de[1], "..         ", FAT_ATTR_DIRECTORY, 0, up);
+    bcache_mark_dirty(buf);
+    bcache_release(buf);
+    return 0;
+}
+
+static int fat_link_new(vfs_node_t* node, const char* name, int is_dir) {
+    fat_inode_t* dir = FAT_I(node);
+    fat_fs_t* fs = dir->fs;
+    size_t len = strnlen(name, MAX_FILENAME_LENGTH);
+    if (!fat_valid_name(name, len)) return -1;
+    if (fat_finddir(node, name)) return -1; // Zaten var
+
+    u32 cluster = 0, last;
+    if (is_dir) {
+        cluster = fat_alloc(fs, 0, 1, &last);
+        if (!cluster) return -1;
+        if (fat_dir_init(fs, cluster, dir) < 0) {
+            fat_free_chain(fs, cluster);
+            return -1;
+        }
+    }
+
+    u32 sector, offset;
+    u8 attr = is_dir ? FAT_ATTR_DIRECTORY : FAT_ATTR_ARCHIVE;
+    if (fat_add_entry(dir, name, attr, cluster, &sector, &offset) < 0) {
+        if (cluster) fat_free_chain(fs, cluster);
+        return -1;
+    }
+
+    buffer_t* buf;
+    u8* p = fat_sector(fs, sector, &buf);
+    if (!p) return -1;
+    fat_inode_t* ino = fat_node_new(fs, dir, name, (fat_dirent_t*)(p + offset), sector, offset);
+    bcache_release(buf);
+    if (!ino) return -1;
+
+    // vfs_finddir negatif girdi bırakmış olabilir; yeni düğümle değiştir
+    dcache_insert(node, name, len, &ino->vfs);
+    fat_write_fsinfo(fs);
+    return 0;
+}
+
+static int fat_mkdir(vfs_node_t* node, const char* name, uint32_t perms) {
+    return fat_link_new(node, name, 1);
+}
+
+static int fat_create(vfs_node_t* node, const char* name, uint32_t perms) {
+    return fat_link_new(node, name, 0);
+}
+
+// --- Bağlama ---
+
+static int fat_bpb_valid(const u8* sector) {
+    const fat_bpb_t* bpb = (const fat_bpb_t*)sector;
+    if (sector[510] != 0x55 || sector[511] != 0xAA) return 0;
+    u8 spc = bpb->sectors_per_cluster;
+    return bpb->bytes_per_sector == BLK_SECTOR_SIZE && spc && !(spc & (spc - 1)) &&
+           bpb->reserved_sectors && bpb->num_fats && bpb->root_entries == 0 &&
+           bpb->fat_size16 == 0 && bpb->fat_size32;
+}
+
+// Bölümsüz diskin ya da MBR'deki ilk FAT32 bölümünün önyükleme sektörü `buf`
+// (bir sayfa) içine okunur; sektörün adresini döner
+static u8* fat_find_volume(blk_dev_t* dev, u8* buf, u32* start) {
+    if (blk_read(dev, 0, 1, buf) < 0) return NULL;
+    if (fat_bpb_valid(buf)) {
+        *start = 0;
+        return buf;
+    }
+    if (buf[510] != 0x55 || buf[511] != 0xAA) return NULL;
+
+    u8* vbr = buf + BLK_SECTOR_SIZE;
+    for (int i = 0; i < 4; i++) {
+        const u8* e = buf + 446 + i * 16;
+        u8 type = e[4] & ~0x10; // 0x1B/0x1C: gizli FAT32
+        if (type != 0x0B && type != 0x0C) continue;
+        u32 lba = e[8] | (e[9] << 8) | (e[10] << 16) | ((u32)e[11] << 24);
+        if (blk_read(dev, lba, 1, vbr) < 0) continue;
+        if (fat_bpb_valid(vbr)) {
+            *start = lba;
+            return vbr;
+        }
+    }
+    return NULL;
+}
+
+static void fat_unpin(fat_fs_t* fs) {
+    for (u32 i = 0; i < fs->fat_nblocks; i++) bcache_release(fs->fat_blocks[i]);
+    pmm_free_page(fs->fat_blocks);
+}
+
+static int fat_read_super(fat_fs_t* fs, u32* root_cluster) {
+    u8* page = (u8*)pmm_alloc_page();
+    if (!page) return -1;
+    u32 start;
+    u8* sector = fat_find_volume(fs->dev, page, &start);
+    if (!sector) {
+        pmm_free_page(page);
+        return -1;
+    }
+
+    fat_bpb_t* bpb = (fat_bpb_t*)sector;
+    u32 total = bpb->total_sectors16 ? bpb->total_sectors16 : bpb->total_sectors32;
+    u32 meta = bpb->reserved_sectors + bpb->num_fats * bpb->fat_size32;
+    fs->part_start = start;
+    fs->sectors_per_cluster = bpb->sectors_per_cluster;
+    fs->cluster_bytes = bpb->sectors_per_cluster * BLK_SECTOR_SIZE;
+    fs->fat_sectors = bpb->fat_size32;
+    fs->num_fats = bpb->num_fats;
+    fs->fat_start = start + bpb->reserved_sectors;
+    fs->data_start = start + meta;
+    fs->total_clusters = total > meta ? (total - meta) / bpb->sectors_per_cluster : 0;
+    fs->mirror = !(bpb->ext_flags & 0x80) && bpb->num_fats > 1;
+    if (bpb->ext_flags & 0x80) fs->fat_start += (bpb->ext_flags & 0x0F) * bpb->fat_size32;
+    fs->fsinfo_sector = (bpb->fsinfo_sector && bpb->fsinfo_sector != 0xFFFF) ? start + bpb->fsinfo_sector : 0;
+    *root_cluster = bpb->root_cluster;
+    pmm_free_page(page);
+
+    // Daha az küme FAT12/16 demektir; FAT'in tutabileceğinden fazlası kullanılmaz
+    if (fs->total_clusters < 65525) return -1;
+    if (fs->total_clusters + 2 > fs->fat_sectors * (BLK_SECTOR_SIZE / 4)) {
+        fs->total_clusters = fs->fat_sectors * (BLK_SECTOR_SIZE / 4) - 2;
+    }
+    return 0;
+}
+
+// FAT'in kullanılan kısmını önbellekte sabitler ve boş kümeleri sayar
+// (FSInfo'daki sayı yalnızca ipucudur)
+static int fat_load_table(fat_fs_t* fs) {
+    u32 first_block = fs->fat_start / BCACHE_SECTORS;
+    u32 bytes = (fs->fat_start % BCACHE_SECTORS) * BLK_SECTOR_SIZE + (fs->total_clusters + 2) * 4;
+    u32 nblocks = (bytes + BCACHE_BLOCK_SIZE - 1) / BCACHE_BLOCK_SIZE;
+    if (nblocks > FAT32_MAX_FAT_BLOCKS) {
+        KLOG(LOG_LEVEL_WARN, fat_log, "%s: FAT too large (%u blocks)", fs->dev->name, nblocks);
+        return -1;
+    }
+
+    fs->fat_blocks = (buffer_t**)pmm_alloc_page();
+    if (!fs->fat_blocks) return -1;
+    for (fs->fat_nblocks = 0; fs->fat_nblocks < nblocks; fs->fat_nblocks++) {
+        buffer_t* buf = bcache_read(fs->dev, first_block + fs->fat_nblocks);
+        if (!buf) {
+            fat_unpin(fs);
+            return -1;
+        }
+        fs->fat_blocks[fs->fat_nblocks] = buf;
+    }
+
+    fs->free_count = 0;
+    fs->next_free = 0;
+    for (u32 c = 2; cluster_valid(fs, c); c++) {
+        if (fat_get(fs, c) != 0) continue;
+        if (!fs->next_free) fs->next_free = c;
+        fs->free_count++;
+    }
+    if (!fs->next_free) fs->next_free = 2;
+    return 0;
+}
+
+vfs_node_t* fat32_mount(blk_dev_t* dev) {
+    if (!dev) return NULL;
+    fat_log = klog_component_id("FAT");
+
+    fat_fs_t* fs = (fat_fs_t*)slab_alloc(&fat_fs_cache);
+    if (!fs) return NULL;
+    fs->dev = dev;
+
+    u32 root_cluster;
+    if (fat_read_super(fs, &root_cluster) < 0 || !cluster_valid(fs, root_cluster) ||
+        fat_load_table(fs) < 0) {
+        slab_free(&fat_fs_cache, fs);
+        return NULL;
+    }
+
+    fat_dirent_t root_de;
+    fat_dirent_fill(&root_de, "           ", FAT_ATTR_DIRECTORY, 0, root_cluster);
+    fs->root = fat_node_new(fs, NULL, "/", &root_de, 0, 0);
+    if (!fs->root) {
+        fat_unpin(fs);
+        slab_free(&fat_fs_cache, fs);
+        return NULL;
+    }
+
+    KLOG(LOG_LEVEL_INFO, fat_log, "%s: FAT32, %u clusters of %u bytes, %u free",
+         dev->name, fs->total_clusters, fs->cluster_bytes, fs->free_count);
+    return &fs->root->vfs;
+}
+
+int fat32_sync(vfs_node_t* root) {
+    fat_fs_t* fs = FAT_I(root)->fs;
+    int result = 0;
+
+    // Yüklenmiş ağacı özyinelemesiz dolaş
+    vfs_node_t* node = root->first_child;
+    while (node) {
+        if (node->type == FS_NODE_FILE && fat_flush_file(FAT_I(node)) < 0) result = -1;
+        if (node->first_child) {
+            node = node->first_child;
+            continue;
+        }
+        while (node != root && !node->next_sibling) node = node->parent;
+        node = node == root ? NULL : node->next_sibling;
+    }
+
+    fat_write_fsinfo(fs);
+    if (bcache_sync(fs->dev) < 0) result = -1;
+    return result;
+}
@@ -0,0 +1,168 @@
+#ifndef FAT32_H
+#define FAT32_H
+
+#include "utils.h"
+#include "vfs.h"
+#include "blk.h"
+#include "bcache.h"
+#include "pagecache.h"
+
+// --- FAT32 Dosya Sistemi ---
+// mkfs.vfat ile hazırlanmış disklerle (bölümsüz ya da MBR'de 0x0B/0x0C tipli
+// ilk FAT32 bölümü) veri alışverişi için okuma/yazma sürücüsü. Düğümler vfs_node_t
+// işlemlerini doldurur; disk erişimi blok katmanı (blk.h) üzerindendir.
+//
+//  * FAT tablosu bağlamada bir kez okunur ve tamponları önbellekte (bcache.h)
+//    sabitlenir: küme zinciri yürümek diske gitmez, değişen FAT blokları
+//    (ve yansı FAT'ler) flusher ile geri yazılır.
+//  * Dizinler ve süper blok gibi üst veri bcache üzerinden okunur.
+//  * Dosya verisi sayfa önbelleğindedir (pagecache.h); readpage/writepage bir
+//    sayfanın kümelerini tek plug içinde bio olarak verir, bitişik kümeler
+//    blok katmanında tek komuta birleşir.
+//  * Kümeler geri yazma anında dosyanın o anki boyutunun tamamı için birlikte
+//    ve mümkünse son kümenin hemen arkasından (bitişik) ayrılır.
+//  * Uzun dosya isimleri (VFAT LFN) okunur ve oluşturulur; ASCII dışı
+//    karakterler '?' olur.
+
+#define FAT32_MAX_FAT_BLOCKS 1024 // Sabitlenen FAT bloğu üst sınırı (4 MB FAT)
+
+// FAT girdisi değerleri (üst 4 bit ayrılmış)
+#define FAT_CLUSTER_MASK 0x0FFFFFFF
+#define FAT_CLUSTER_BAD  0x0FFFFFF7
+#define FAT_CLUSTER_EOC  0x0FFFFFF8 // Bu ve üstü: zincir sonu
+#define FAT_CLUSTER_END  0x0FFFFFFF // Zincir sonu olarak yazılan değer
+
+// Dizin girdisi öznitelikleri
+#define FAT_ATTR_READ_ONLY 0x01
+#define FAT_ATTR_HIDDEN    0x02
+#define FAT_ATTR_SYSTEM    0x04
+#define FAT_ATTR_VOLUME_ID 0x08
+#define FAT_ATTR_DIRECTORY 0x10
+#define FAT_ATTR_ARCHIVE   0x20
+#define FAT_ATTR_LFN       0x0F
+
+// Kısa isimde küçük harf bayrakları (nt_res; Windows NT uzantısı)
+#define FAT_NT_LOWER_BASE  0x08
+#define FAT_NT_LOWER_EXT   0x10
+
+#define FAT_LFN_LAST       0x40 // LFN sıra numarasında: ismin son parçası
+#define FAT_LFN_CHARS      13   // LFN girdisi başına karakter
+
+typedef struct {
+    u8  jump[3];
+    char oem[8];
+    u16 bytes_per_sector;
+    u8  sectors_per_cluster;
+    u16 reserved_sectors;
+    u8  num_fats;
+    u16 root_entries;       // FAT32'de 0
+    u16 total_sectors16;
+    u8  media;
+    u16 fat_size16;         // FAT32'de 0
+    u16 sectors_per_track;
+    u16 heads;
+    u32 hidden_sectors;
+    u32 total_sectors32;
+    u32 fat_size32;
+    u16 ext_flags;          // bit 7: yansıtma kapalı, bit 0-3: etkin FAT
+    u16 version;
+    u32 root_cluster;
+    u16 fsinfo_sector;
+    u16 backup_boot_sector;
+    u8  reserved[12];
+    u8  drive_number;
+    u8  reserved1;
+    u8  boot_signature;
+    u32 volume_id;
+    char volume_label[11];
+    char fs_type[8];        // "FAT32   "
+} __attribute__((packed)) fat_bpb_t;
+
+typedef struct {
+    u32 lead_sig;           // 0x41615252
+    u8  reserved[480];
+    u32 struct_sig;         // 0x61417272
+    u32 free_count;         // 0xFFFFFFFF: bilinmiyor
+    u32 next_free;
+    u8  reserved2[12];
+    u32 trail_sig;          // 0xAA550000
+} __attribute__((packed)) fat_fsinfo_t;
+
+typedef struct {
+    char name[11];          // 8+3, boşlukla doldurulmuş
+    u8  attr;
+    u8  nt_res;
+    u8  crt_time_tenth;
+    u16 crt_time;
+    u16 crt_date;
+    u16 acc_date;
+    u16 cluster_hi;
+    u16 wrt_time;
+    u16 wrt_date;
+    u16 cluster_lo;
+    u32 size;
+} __attribute__((packed)) fat_dirent_t;
+
+typedef struct {
+    u8  order;              // Sıra (1..20) | FAT_LFN_LAST
+    u16 name1[5];
+    u8  attr;               // FAT_ATTR_LFN
+    u8  type;
+    u8  checksum;           // Kısa ismin sağlaması
+    u16 name2[6];
+    u16 cluster;            // 0
+    u16 name3[2];
+} __attribute__((packed)) fat_lfn_t;
+
+typedef struct fat_fs {
+    blk_dev_t* dev;
+    u32 part_start;         // Bölümün ilk sektörü
+    u32 sectors_per_cluster;
+    u32 cluster_bytes;
+    u32 fat_start;          // Etkin FAT'in ilk sektörü (mutlak)
+    u32 fat_sectors;
+    u32 num_fats;
+    u8  mirror;             // Değişiklikler diğer FAT'lere de yazılır
+    u32 data_start;         // Küme 2'nin ilk sektörü (mutlak)
+    u32 total_clusters;     // Geçerli kümeler: 2 .. total_clusters + 1
+    u32 fsinfo_sector;      // Mutlak; 0 ise yok
+    u32 free_count;
+    u32 next_free;          // Boş küme aramasının başlangıcı
+
+    buffer_t** fat_blocks;  // Sabitlenmiş FAT tamponları
+    u32 fat_nblocks;
+    struct fat_inode* root;
+} fat_fs_t;
+
+typedef struct fat_inode {
+    vfs_node_t vfs;         // İlk alan olmalı; vfs_node_t* <-> fat_inode_t* dönüşümü için
+    page_cache_t cache;     // Dosya verisi (dizinlerde kullanılmaz)
+    fat_fs_t* fs;
+    u32 first_cluster;      // 0: henüz küme yok
+    u32 nr_clusters;        // Zincir uzunluğu
+    u32 last_cluster;
+    u32 hint_index;         // Son çözülen (dosya içi küme no -> disk kümesi)
+    u32 hint_cluster;
+    u32 dirent_sector;      // Kısa girdinin yeri (mutlak sektör, ofset); kökte 0
+    u32 dirent_offset;
+    u32 disk_size;          // Girdideki boyut
+    u32 valid_size;         // Diske yazılmış verinin sonu; ötesi sıfır okunur
+    u8  attr;
+    u8  loaded;             // Dizin: çocuklar okundu
+} fat_inode_t;
+
+/**
+ * @brief Aygıttaki FAT32 dosya sistemini bağlar (bcache_init'ten sonra).
+ * @return Kök dizinin düğümü (vfs_mount ile bir dizine bağlanır); aygıtta
+ *         FAT32 yoksa, desteklenmiyorsa ya da bellek yoksa NULL.
+ */
+vfs_node_t* fat32_mount(blk_dev_t* dev);
+
+/**
+ * @brief Kirli dosya sayfalarını, dizin girdilerini, FSInfo'yu ve FAT'i
+ *        diske yazar ve bitmesini bekler.
+ * @return G/Ç hatasında -1.
+ */
+int fat32_sync(vfs_node_t* root);
+
+#endif
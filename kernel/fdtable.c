@@ -0,0 +1,231 @@
+#include "fdtable.h"
+#include "slab.h"
+#include "pmm.h"
+#include "string.h"
+#include "sched.h"
+
+static slab_cache_t file_cache    = SLAB_CACHE_INIT("file", sizeof(file_t));
+static slab_cache_t fdtable_cache = SLAB_CACHE_INIT("fd_table", sizeof(fd_table_t));
+
+static fd_table_t* kernel_table = NULL;  // Kendi tablosu olmayan görevler bunu kullanır
+static fd_table_t* current_table = NULL;
+
+static inline u32 bit_scan_forward(u32 v) {
+    u32 r;
+    asm ("bsf %1, %0" : "=r"(r) : "rm"(v) : "cc");
+    return r;
+}
+
+// --- Açık Dosya Tanımları ---
+// Referans sayaçları atomik güncellenir; CLONE_FILES ile paylaşılan bir
+// tablonun slotları preempt_disable içinde değişir. Son referansı düşen
+// file_put dosyayı kapatır (uyuyabilir), bu yüzden koruma dışında çağrılır.
+
+file_t* file_alloc(vfs_node_t* node, u32 flags) {
+    file_t* file = (file_t*)slab_alloc(&file_cache);
+    if (!file) return NULL;
+    file->node = node;
+    file->flags = flags;
+    file->refcount = 1;
+    return file;
+}
+
+file_t* file_get(file_t* file) {
+    if (file) __atomic_fetch_add(&file->refcount, 1, __ATOMIC_RELAXED);
+    return file;
+}
+
+void file_put(file_t* file) {
+    if (!file || __atomic_sub_fetch(&file->refcount, 1, __ATOMIC_ACQ_REL)) return;
+    if (file->node && file->node->close) file->node->close(file->node);
+    slab_free(&file_cache, file);
+}
+
+// --- Tablo İşlemleri ---
+
+static void fdtable_setup(fd_table_t* t) {
+    t->capacity = FDTABLE_INLINE;
+    t->files = t->inline_files;
+    t->open_bits = t->inline_bits;
+    t->refcount = 1;
+}
+
+// Satır içi diziden tam boyutlu sayfaya geçer. Sayfanın başında dosya
+// pointer'ları, hemen arkasında bitmap bulunur.
+static int fdtable_grow(fd_table_t* t) {
+    if (t->capacity >= MAX_FILE_DESCRIPTORS) return -1;
+    u8* page = (u8*)pmm_alloc_zeroed_page();
+    if (!page) return -1;
+
+    file_t** files = (file_t**)page;
+    u32* bits = (u32*)(page + MAX_FILE_DESCRIPTORS * sizeof(file_t*));
+    memcpy(files, t->files, t->capacity * sizeof(file_t*));
+    memcpy(bits, t->open_bits, ((t->capacity + 31) / 32) * sizeof(u32));
+
+    t->files = files;
+    t->open_bits = bits;
+    t->capacity = MAX_FILE_DESCRIPTORS;
+    return 0;
+}
+
+// `from` ve sonrasındaki en küçük boş slot; gerekirse tabloyu büyütür
+static int fd_find_free(fd_table_t* t, u32 from) {
+    for (;;) {
+        u32 words = (t->capacity + 31) / 32;
+        for (u32 w = from / 32; w < words; w++) {
+            u32 free = ~t->open_bits[w];
+            if (w == from / 32) free &= ~0u << (from & 31);
+            if (!free) continue;
+            u32 fd = w * 32 + bit_scan_forward(free);
+            if (fd < t->capacity) return fd;
+            break; // Kapasitenin ötesindeki bitler: büyütmek gerek
+        }
+        if (fdtable_grow(t) < 0) return -1;
+    }
+}
+
+static inline void fd_set(fd_table_t* t, u32 fd, file_t* file) {
+    t->files[fd] = file;
+    t->open_bits[fd / 32] |= 1u << (fd & 31);
+}
+
+static inline void fd_clear(fd_table_t* t, u32 fd) {
+    t->files[fd] = NULL;
+    t->open_bits[fd / 32] &= ~(1u << (fd & 31));
+    if (fd < t->next_fd) t->next_fd = fd;
+}
+
+void fdtable_init() {
+    kernel_table = current_table = fdtable_create();
+}
+
+fd_table_t* fdtable_create() {
+    fd_table_t* t = (fd_table_t*)slab_alloc(&fdtable_cache);
+    if (t) fdtable_setup(t);
+    return t;
+}
+
+fd_table_t* fdtable_clone(fd_table_t* src) {
+    fd_table_t* t = fdtable_create();
+    if (!t) return NULL;
+    preempt_disable();
+    if (src->capacity > t->capacity && fdtable_grow(t) < 0) {
+        preempt_enable();
+        fdtable_put(t);
+        return NULL;
+    }
+
+    u32 words = (src->capacity + 31) / 32;
+    for (u32 w = 0; w < words; w++) {
+        u32 bits = src->open_bits[w];
+        t->open_bits[w] = bits;
+        while (bits) {
+            u32 fd = w * 32 + bit_scan_forward(bits);
+            t->files[fd] = file_get(src->files[fd]);
+            bits &= bits - 1;
+        }
+    }
+    t->next_fd = src->next_fd;
+    preempt_enable();
+    return t;
+}
+
+fd_table_t* fdtable_get(fd_table_t* t) {
+    if (t) __atomic_fetch_add(&t->refcount, 1, __ATOMIC_RELAXED);
+    return t;
+}
+
+void fdtable_put(fd_table_t* t) {
+    if (!t || __atomic_sub_fetch(&t->refcount, 1, __ATOMIC_ACQ_REL)) return;
+
+    u32 words = (t->capacity + 31) / 32;
+    for (u32 w = 0; w < words; w++) {
+        u32 bits = t->open_bits[w];
+        while (bits) {
+            file_put(t->files[w * 32 + bit_scan_forward(bits)]);
+            bits &= bits - 1;
+        }
+    }
+    if (t->files != t->inline_files) pmm_free_page(t->files);
+    if (t == current_table) current_table = kernel_table;
+    slab_free(&fdtable_cache, t);
+}
+
+void fdtable_switch(fd_table_t* t) {
+    current_table = t ? t : kernel_table;
+}
+
+fd_table_t* fdtable_current() {
+    return current_table;
+}
+
+int fd_install(fd_table_t* t, file_t* file) {
+    if (!t || !file) return -1;
+    preempt_disable();
+    int fd = fd_find_free(t, t->next_fd);
+    if (fd >= 0) {
+        fd_set(t, fd, file);
+        t->next_fd = fd + 1;
+    }
+    preempt_enable();
+    return fd;
+}
+
+// Çağıran preempt_disable içinde olmalı; dönen işaretçi referanssızdır
+static file_t* fd_lookup(fd_table_t* t, int fd) {
+    if (!t || fd < 0 || (u32)fd >= t->capacity) return NULL;
+    return t->files[fd];
+}
+
+file_t* fd_get(fd_table_t* t, int fd) {
+    // Paylaşılan tabloda başka bir iş parçacığı slotu kapatmadan referans alınır
+    preempt_disable();
+    file_t* file = file_get(fd_lookup(t, fd));
+    preempt_enable();
+    return file;
+}
+
+int fd_close(fd_table_t* t, int fd) {
+    preempt_disable();
+    file_t* file = fd_lookup(t, fd);
+    if (file) fd_clear(t, fd);
+    preempt_enable();
+    if (!file) return -1;
+    file_put(file);
+    return 0;
+}
+
+int fd_dup(fd_table_t* t, int oldfd) {
+    file_t* file = fd_get(t, oldfd);
+    if (!file) return -1;
+    int fd = fd_install(t, file);
+    if (fd < 0) file_put(file);
+    return fd;
+}
+
+int fd_install_at(fd_table_t* t, int fd, file_t* file) {
+    if (!t || !file || fd < 0 || fd >= MAX_FILE_DESCRIPTORS) return -1;
+    preempt_disable();
+    if ((u32)fd >= t->capacity && fdtable_grow(t) < 0) {
+        preempt_enable();
+        return -1;
+    }
+
+    file_t* old = t->files[fd];
+    fd_set(t, fd, file);
+    preempt_enable();
+    if (old) file_put(old);
+    return fd;
+}
+
+int fd_dup2(fd_table_t* t, int oldfd, int newfd) {
+    file_t* file = fd_get(t, oldfd);
+    if (!file) return -1;
+    if (oldfd == newfd) {
+        file_put(file);
+        return newfd;
+    }
+    int fd = fd_install_at(t, newfd, file);
+    if (fd < 0) file_put(file);
+    return fd;
+}
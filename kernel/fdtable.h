@@ -0,0 +1,70 @@
+#ifndef FDTABLE_H
+#define FDTABLE_H
+
+#include <stddef.h>
+#include "utils.h"
+#include "vfs.h"
+
+// --- Dosya Tanıtıcısı Tablosu (File Descriptor Table) ---
+// Açık dosya tanımı (file_t) ofseti ve açılış bayraklarını tutar; referans
+// sayımlıdır ve dup()/fork() ile birden çok tanıtıcı ya da süreç arasında
+// paylaşılır (ofset de ortaktır).
+//
+// Her sürecin fd_table_t'si küçük başlar (FDTABLE_INLINE slot, yapının
+// içinde) ve gerektiğinde MAX_FILE_DESCRIPTORS slotluk tek bir sayfaya
+// büyür. Boş slotlar bir bitmap'te tutulur; en küçük boş fd bit taramasıyla
+// (bsf) bulunur.
+
+#define MAX_FILE_DESCRIPTORS 256
+#define FDTABLE_INLINE       16
+
+typedef struct file {
+    vfs_node_t* node;
+    u32 offset;    // Tüm paylaşan tanıtıcılar için ortak
+    u32 flags;     // O_* açılış bayrakları
+    u32 refcount;
+} file_t;
+
+typedef struct fd_table {
+    u32 capacity;          // FDTABLE_INLINE ya da MAX_FILE_DESCRIPTORS
+    u32 next_fd;           // Bundan küçük tüm fd'ler dolu (arama ipucu)
+    file_t** files;        // inline_files ya da büyütülmüş sayfa
+    u32* open_bits;        // 1 = fd kullanımda
+    file_t* inline_files[FDTABLE_INLINE];
+    u32 inline_bits[(FDTABLE_INLINE + 31) / 32];
+    u32 refcount;          // Thread'ler aynı tabloyu paylaşabilir
+} fd_table_t;
+
+// --- Açık Dosya Tanımları ---
+
+// refcount = 1 olan yeni bir açık dosya tanımı; bellek yoksa NULL
+file_t* file_alloc(vfs_node_t* node, u32 flags);
+file_t* file_get(file_t* file);
+// Son referans bırakılınca düğümün close callback'i çağrılır
+void file_put(file_t* file);
+
+// --- Tablo İşlemleri ---
+
+void fdtable_init(); // Çekirdek bağlamının tablosunu kurar
+fd_table_t* fdtable_create();
+// fork() için: tüm açık dosyalar yeni tabloda da görünür (referansları artar)
+fd_table_t* fdtable_clone(fd_table_t* table);
+// Thread'ler için: aynı tablo paylaşılır (refcount artar)
+fd_table_t* fdtable_get(fd_table_t* table);
+void fdtable_put(fd_table_t* table);
+
+// Zamanlayıcı görev değiştirirken çağırır; NULL: çekirdek bağlamının tablosu
+void fdtable_switch(fd_table_t* table);
+fd_table_t* fdtable_current();
+
+// En küçük boş fd'ye yerleştirir; referansı tablo devralır. Dolu ise -1.
+int fd_install(fd_table_t* table, file_t* file);
+// Tam `fd`ye yerleştirir (orada açık dosya varsa kapanır); referansı tablo devralır
+int fd_install_at(fd_table_t* table, int fd, file_t* file);
+// Referans alınmış dosyayı döndürür; çağıran işi bitince file_put etmeli
+file_t* fd_get(fd_table_t* table, int fd);
+int fd_close(fd_table_t* table, int fd);
+int fd_dup(fd_table_t* table, int oldfd);
+int fd_dup2(fd_table_t* table, int oldfd, int newfd);
+
+#endif
@@ -0,0 +1,114 @@
+#include "futex.h"
+#include "sched.h"
+#include "timer.h"
+#include "vmm.h"
+#include "io.h"
+
+// Uyuyan bir görev; beklerken o görevin yığınında durur
+typedef struct futex_waiter {
+    task_t* task;
+    u32 key;                // Kelimenin fiziksel adresi
+    volatile int woken;
+    struct futex_waiter* next;
+} futex_waiter_t;
+
+typedef struct {
+    futex_waiter_t* head;   // FIFO: önce gelen önce uyanır
+    futex_waiter_t* tail;
+} futex_bucket_t;
+
+static futex_bucket_t buckets[FUTEX_HASH_SIZE];
+
+static inline futex_bucket_t* futex_bucket(u32 key) {
+    return &buckets[(key * 0x9E3779B1u) >> (32 - FUTEX_HASH_BITS)];
+}
+
+// Kesmeler kapalıyken çağrılır
+static void futex_unqueue(futex_bucket_t* b, futex_waiter_t* w) {
+    futex_waiter_t* prev = NULL;
+    for (futex_waiter_t* it = b->head; it; prev = it, it = it->next) {
+        if (it != w) continue;
+        if (prev) prev->next = w->next;
+        else b->head = w->next;
+        if (b->tail == w) b->tail = prev;
+        return;
+    }
+}
+
+int futex_wait(u32* addr, u32 val, u32 timeout_ms) {
+    if ((u32)addr & 3) return FUTEX_EINVAL;
+    u32 key = vmm_resolve((u32)addr, 1);
+    if (!key) return FUTEX_EFAULT;
+
+    futex_bucket_t* b = futex_bucket(key);
+    futex_waiter_t w;
+    w.task = sched_current();
+    w.key = key;
+    w.woken = 0;
+    w.next = NULL;
+
+    u32 flags = irq_save();
+    // Kontrol ile kuyruğa giriş arasında uyandırma olamaz (kesmeler kapalı)
+    if (__atomic_load_n(addr, __ATOMIC_RELAXED) != val) {
+        irq_restore(flags);
+        return FUTEX_EAGAIN;
+    }
+    if (b->tail) b->tail->next = &w;
+    else b->head = &w;
+    b->tail = &w;
+
+    if (!timeout_ms) {
+        while (!w.woken) sched_block();
+    } else {
+        u32 deadline = timer_ticks() + timer_ms_to_ticks(timeout_ms);
+        while (!w.woken) {
+            int left = (int)(deadline - timer_ticks());
+            if (left <= 0) break;
+            sched_sleep_ms((u32)left * 1000 / TIMER_HZ);
+        }
+    }
+
+    int result = FUTEX_OK;
+    if (!w.woken) {
+        futex_unqueue(b, &w);
+        result = FUTEX_ETIMEDOUT;
+    }
+    irq_restore(flags);
+    return result;
+}
+
+int futex_wake(u32* addr, u32 count) {
+    if ((u32)addr & 3) return FUTEX_EINVAL;
+    u32 key = vmm_resolve((u32)addr, 1);
+    if (!key) return FUTEX_EFAULT;
+
+    futex_bucket_t* b = futex_bucket(key);
+    int woken = 0;
+    u32 flags = irq_save();
+    futex_waiter_t* prev = NULL;
+    futex_waiter_t* w = b->head;
+    while (w && (u32)woken < count) {
+        futex_waiter_t* next = w->next;
+        if (w->key != key) {
+            prev = w;
+        } else {
+            if (prev) prev->next = next;
+            else b->head = next;
+            if (b->tail == w) b->tail = prev;
+            w->woken = 1;
+            sched_wake(w->task);
+            woken++;
+        }
+        w = next;
+    }
+    irq_restore(flags);
+    return woken;
+}
+
+u32 sys_futex(u32 addr, u32 op, u32 val, u32 timeout_ms, ...) {
+    switch (op) {
+    case FUTEX_WAIT: return (u32)futex_wait((u32*)addr, val, timeout_ms);
+    case FUTEX_WAKE: return (u32)futex_wake((u32*)addr, val);
+    default:         return (u32)FUTEX_EINVAL;
+    }
+}
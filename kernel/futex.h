@@ -0,0 +1,47 @@
+#ifndef FUTEX_H
+#define FUTEX_H
+
+#include "utils.h"
+
+// --- Futex (Hızlı Kullanıcı Alanı Kilitleri) ---
+// Kilidin durumu kullanıcı belleğindeki tek bir u32'dir ve çekişme yoksa
+// atomik komutlarla kullanıcı alanında değiştirilir (ulock.h); çekirdeğe
+// yalnızca beklemek ya da bekleyen uyandırmak gerektiğinde girilir.
+//
+// Bekleyenler kelimenin fiziksel adresiyle anahtarlanır ve anahtarın hash'ine
+// göre FUTEX_HASH_SIZE kovadan birinde sıralanır. Böylece aynı paylaşımlı
+// sayfayı (shm, MAP_SHARED) farklı adreslerden eşleyen görevler de aynı
+// futex'te buluşur. Anahtar çözülürken sayfa yazılabilir hale getirilir
+// (gerekirse CoW kopyası alınır); bekleme ve uyandırma aynı çerçeveyi görür.
+//
+// futex_wait değeri kovanın kilidi (kesmeler kapalı) altında kontrol edip
+// kuyruğa girer; arada gelen bir futex_wake kaçırılmaz.
+
+#define FUTEX_HASH_BITS 6
+#define FUTEX_HASH_SIZE (1 << FUTEX_HASH_BITS)
+
+// sys_futex işlemleri
+#define FUTEX_WAIT      0
+#define FUTEX_WAKE      1
+
+// Dönüş değerleri
+#define FUTEX_OK         0
+#define FUTEX_EAGAIN    -1 // Kelimenin değeri beklenenden farklı: beklenmedi
+#define FUTEX_ETIMEDOUT -2
+#define FUTEX_EFAULT    -3 // Adres eşli değil ya da yazılamaz
+#define FUTEX_EINVAL    -4
+
+/**
+ * @brief `*addr == val` ise bir futex_wake'e (ya da zaman aşımına) kadar uyur.
+ * @param timeout_ms 0: süresiz.
+ * @return FUTEX_OK (uyandırıldı), FUTEX_EAGAIN, FUTEX_ETIMEDOUT ya da FUTEX_EFAULT.
+ */
+int futex_wait(u32* addr, u32 val, u32 timeout_ms);
+
+// `addr`da bekleyen en fazla `count` görevi uyandırır; uyandırılan sayısını döner
+int futex_wake(u32* addr, u32 count);
+
+// Syscall arayüzü: op FUTEX_WAIT (val, timeout_ms) ya da FUTEX_WAKE (val = sayı)
+u32 sys_futex(u32 addr, u32 op, u32 val, u32 timeout_ms, ...);
+
+#endif
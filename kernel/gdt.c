@@ -0,0 +1,55 @@
+#include "gdt.h"
+
+#define GDT_ENTRIES 6
+
+static gdt_entry_t gdt[GDT_ENTRIES];
+
+static struct {
+    u16 limit;
+    u32 base;
+} __attribute__((packed)) gdt_ptr;
+
+static void gdt_set(int index, u32 base, u32 limit, u8 access, u8 flags) {
+    gdt[index].limit_lo = limit & 0xFFFF;
+    gdt[index].base_lo = base & 0xFFFF;
+    gdt[index].base_mid = (base >> 16) & 0xFF;
+    gdt[index].access = access;
+    gdt[index].flags_limit_hi = (flags & 0xF0) | ((limit >> 16) & 0x0F);
+    gdt[index].base_hi = (base >> 24) & 0xFF;
+}
+
+void gdt_init() {
+    gdt_set(0, 0, 0, 0, 0);
+    // Düz 4 GB segmentler: G=1 (4 KB birim), D=1 (32-bit)
+    gdt_set(1, 0, 0xFFFFF, 0x9A, 0xC0); // Çekirdek kodu
+    gdt_set(2, 0, 0xFFFFF, 0x92, 0xC0); // Çekirdek verisi
+    gdt_set(3, 0, 0xFFFFF, 0xFA, 0xC0); // Kullanıcı kodu
+    gdt_set(4, 0, 0xFFFFF, 0xF2, 0xC0); // Kullanıcı verisi
+    gdt_set(5, 0, 0xFFFFF, 0xF2, 0xC0); // TLS (tabanı görev değişiminde yazılır)
+
+    gdt_ptr.limit = sizeof(gdt) - 1;
+    gdt_ptr.base = (u32)&gdt;
+    asm volatile (
+        "lgdt %0\n\t"
+        "mov %1, %%ds\n\t"
+        "mov %1, %%es\n\t"
+        "mov %1, %%fs\n\t"
+        "mov %1, %%gs\n\t"
+        "mov %1, %%ss\n\t"
+        "ljmp %2, $1f\n"
+        "1:"
+        :: "m"(gdt_ptr), "r"((u32)GDT_KERNEL_DATA), "i"(GDT_KERNEL_CODE)
+        : "memory");
+}
+
+void gdt_load_tls(u32 base) {
+    if (!base) {
+        asm volatile ("mov %0, %%gs" :: "r"((u32)GDT_KERNEL_DATA));
+        return;
+    }
+    gdt_entry_t* e = &gdt[GDT_TLS >> 3];
+    e->base_lo = base & 0xFFFF;
+    e->base_mid = (base >> 16) & 0xFF;
+    e->base_hi = (base >> 24) & 0xFF;
+    asm volatile ("mov %0, %%gs" :: "r"((u32)GDT_TLS) : "memory");
+}
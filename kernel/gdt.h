@@ -0,0 +1,37 @@
+#ifndef GDT_H
+#define GDT_H
+
+#include "utils.h"
+
+// --- Global Descriptor Table ---
+// GRUB'un geçici GDT'sinin yerine geçer. Çekirdek seçicileri GRUB'unkiyle
+// aynıdır (kod 0x08, veri 0x10), böylece IDT girdileri değişmez. Ayrıca
+// kullanıcı kod/veri segmentleri ve thread'e özel bir TLS segmenti vardır.
+//
+// TLS: tek bir GDT girdisi tüm thread'lerce paylaşılır; zamanlayıcı görev
+// değiştirirken girdinin tabanını yeni görevin tls_base'ine yazar ve gs'i
+// yeniden yükler (segment tabanı gs yüklenirken önbelleğe alınır). Thread
+// değişkenlerine %gs:ofset ile erişilir.
+
+#define GDT_KERNEL_CODE 0x08
+#define GDT_KERNEL_DATA 0x10
+#define GDT_USER_CODE   0x1B // RPL 3
+#define GDT_USER_DATA   0x23
+#define GDT_TLS         0x2B // DPL 3: ring 0'da da yüklenebilir
+
+typedef struct {
+    u16 limit_lo;
+    u16 base_lo;
+    u8  base_mid;
+    u8  access;
+    u8  flags_limit_hi; // Üst 4 bit: G, D/B, L, AVL
+    u8  base_hi;
+} __attribute__((packed)) gdt_entry_t;
+
+// GDT'yi kurar, yükler ve segment register'larını yeniler. init_idt'den önce çağrılır.
+void gdt_init();
+
+// TLS girdisinin tabanını değiştirir ve gs'i yeniden yükler; base 0 ise gs çekirdek veri segmentidir
+void gdt_load_tls(u32 base);
+
+#endif
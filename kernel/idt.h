@@ -19,13 +19,52 @@ struct idt_ptr {
 } __attribute__((packed));
 
 
+// isr_handler_common'ın (isr.s) yığına bıraktığı kesme çerçevesi
+typedef struct {
+    u32 gs, ds;
+    u32 edi, esi, ebp, esp, ebx, edx, ecx, eax; // pusha sırası (esp kullanılmaz)
+    u32 int_num, err_code;
+    u32 eip, cs, eflags;                        // CPU'nun koyduğu (ring 0 -> ring 0)
+} isr_frame_t;
+
+// Donanım kesmesi (IRQ 0-15) handler tipi
+typedef void (*irq_handler_t)();
+
+// CPU istisnası (0-31) handler tipi; err_code hata kodu olmayanlarda 0'dır
+typedef void (*exception_handler_t)(u32 int_num, u32 err_code);
+
 // Fonksiyon prototipleri
 void init_idt();
 
+// Bir IRQ hattına handler bağlar ve PIC'te o hattın maskesini kaldırır
+void irq_register_handler(u8 irq, irq_handler_t handler);
+
+// Bir CPU istisnasına handler bağlar (örn. 14 = sayfa hatası)
+void exception_register_handler(u8 vector, exception_handler_t handler);
+
+// O an işlenen IRQ'nun çerçevesi (kesilen kodun EIP/EBP'si); IRQ dışında NULL
+isr_frame_t* irq_frame();
+
 // ISR'ler (Assembly'de tanımlanacaklar)
 extern void isr0();
 extern void isr1();
+extern void isr14(); // Sayfa hatası
 // ... (tüm ISR'ler için bildirimler eklenebilir)
+extern void isr32(); // IRQ 0-15 -> 32-47
 extern void isr33(); // Klavye için
+extern void isr34();
+extern void isr35();
+extern void isr36(); // COM1
+extern void isr37();
+extern void isr38();
+extern void isr39();
+extern void isr40();
+extern void isr41();
+extern void isr42();
+extern void isr43();
+extern void isr44();
+extern void isr45();
+extern void isr46();
+extern void isr47();
 
 #endif
\ No newline at end of file
@@ -2,12 +2,23 @@
 #include "io.h"     // Port I/O için (yeni dosya)
 #include "vga.h"    // VGA yazma fonksiyonları için (kernel.c'den taşınacak)
 #include "keyboard.h"
+#include "sched.h"
 
 #define IDT_ENTRIES 256
 
 struct idt_entry idt[IDT_ENTRIES];
 struct idt_ptr   idtp;
 
+// IRQ numarasına göre kayıtlı handler'lar
+static irq_handler_t irq_handlers[16];
+static exception_handler_t exception_handlers[32];
+static isr_frame_t* current_irq_frame = NULL;
+
+static void (*const irq_stubs[16])() = {
+    isr32, isr33, isr34, isr35, isr36, isr37, isr38, isr39,
+    isr40, isr41, isr42, isr43, isr44, isr45, isr46, isr47
+};
+
 // IDT'ye bir gate (kapı) ekleyen yardımcı fonksiyon
 static void set_idt_gate(u8 num, u32 base, u16 sel, u8 flags) {
     idt[num].base_lo = (base & 0xFFFF);
@@ -31,11 +42,31 @@ static void init_pic(void) {
     outb(0xA1, 0x02);
     outb(0xA1, 0x01);
 
-    // Maskeleme (sadece klavye interrupt'una izin ver)
-    outb(0x21, 0xFD); // Sadece IRQ1 (klavye) açık
+    // Maskeleme: tüm hatlar kapalı, irq_register_handler() gerekenleri açar
+    outb(0x21, 0xFF);
     outb(0xA1, 0xFF);
 }
 
+// Bir IRQ hattının PIC maskesini kaldırır
+static void pic_unmask(u8 irq) {
+    if (irq >= 8) {
+        outb(0xA1, inb(0xA1) & ~(1 << (irq - 8)));
+        irq = 2; // Slave, master'ın IRQ2'sine bağlı
+    }
+    outb(0x21, inb(0x21) & ~(1 << irq));
+}
+
+void irq_register_handler(u8 irq, irq_handler_t handler) {
+    if (irq >= 16) return;
+    irq_handlers[irq] = handler;
+    pic_unmask(irq);
+}
+
+void exception_register_handler(u8 vector, exception_handler_t handler) {
+    if (vector >= 32) return;
+    exception_handlers[vector] = handler;
+}
+
 // IDT'yi kur ve yükle
 void init_idt() {
     idtp.limit = (sizeof(struct idt_entry) * IDT_ENTRIES) - 1;
@@ -48,8 +79,16 @@ void init_idt() {
     
     init_pic();
 
-    // Klavye kesmesi için handler'ı kur (IRQ 1 -> Interrupt 33)
-    set_idt_gate(33, (u32)isr33, 0x08, 0x8E);
+    // CPU istisnaları
+    set_idt_gate(14, (u32)isr14, 0x08, 0x8E);
+
+    // Donanım kesmeleri (IRQ 0-15 -> Interrupt 32-47)
+    for (int irq = 0; irq < 16; irq++) {
+        set_idt_gate(32 + irq, (u32)irq_stubs[irq], 0x08, 0x8E);
+    }
+
+    // Klavye (IRQ 1)
+    irq_register_handler(1, keyboard_handler);
 
     // IDT'yi yükle
     asm volatile ("lidt %0" : : "m"(idtp));
@@ -57,11 +96,31 @@ void init_idt() {
     asm volatile ("sti");
 }
 
+isr_frame_t* irq_frame() {
+    return current_irq_frame;
+}
+
 // C tabanlı genel kesme handler'ı
-void isr_handler(u32 int_num) {
-    if (int_num == 33) { // Klavye
-        // Klavye handler'ını çağır
-        keyboard_handler();
+void isr_handler(u32 int_num, u32 err_code, isr_frame_t* frame) {
+    // CPU istisnaları PIC'ten gelmez, EOI gönderilmez
+    if (int_num < 32) {
+        if (exception_handlers[int_num]) {
+            exception_handlers[int_num](int_num, err_code);
+        } else {
+            panic("Unhandled CPU exception");
+        }
+        return;
+    }
+
+    if (int_num >= 32 && int_num < 48 && irq_handlers[int_num - 32]) {
+        // Handler kesmeleri açıp iç içe bir IRQ'ya izin verebilir: dıştakini
+        // sakla. İçteki IRQ'nun dönüşü handler'ın ortasında görev değiştirmesin.
+        isr_frame_t* outer = current_irq_frame;
+        current_irq_frame = frame;
+        preempt_disable();
+        irq_handlers[int_num - 32]();
+        preempt_enable_no_resched();
+        current_irq_frame = outer;
     }
     
     // İşlem bittiğinde PIC'e sinyal gönder (End of Interrupt)
@@ -69,4 +128,8 @@ void isr_handler(u32 int_num) {
         outb(0xA0, 0x20); // Slave'e gönder
     }
     outb(0x20, 0x20); // Master'a gönder
+
+    // Zaman dilimi bittiyse ya da bir görev uyandıysa görev değiştir. EOI
+    // gönderildiği için PIC diğer görevde gelecek kesmeleri engellemez.
+    sched_preempt();
 }
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "initrd.h"
+#include "ramfs.h"
+#include "string.h"
+#include "klog.h"
+
+// POSIX ustar başlığı (512 byte). Sayısal alanlar ASCII sekizlik tabandadır.
+typedef struct {
+    char name[100];
+    char mode[8];
+    char uid[8];
+    char gid[8];
+    char size[12];
+    char mtime[12];
+    char chksum[8];
+    char typeflag;
+    char linkname[100];
+    char magic[6];     // "ustar\0" (POSIX) ya da "ustar " (GNU)
+    char version[2];
+    char uname[32];
+    char gname[32];
+    char devmajor[8];
+    char devminor[8];
+    char prefix[155];
+    char pad[12];
+} __attribute__((packed)) tar_header_t;
+
+#define TAR_TYPE_FILE     '0'
+#define TAR_TYPE_FILE_OLD '\0'
+#define TAR_TYPE_DIR      '5'
+
+// Sekizlik alan; NUL/boşlukla bitebilir ya da tamamen dolu olabilir
+static u32 tar_octal(const char* field, u32 len) {
+    u32 value = 0;
+    for (u32 i = 0; i < len && field[i] >= '0' && field[i] <= '7'; i++) {
+        value = (value << 3) | (field[i] - '0');
+    }
+    return value;
+}
+
+static int tar_checksum_ok(const tar_header_t* hdr) {
+    const u8* p = (const u8*)hdr;
+    u32 sum = 0;
+    for (u32 i = 0; i < TAR_BLOCK_SIZE; i++) {
+        // chksum alanı hesaplanırken boşluk sayılır
+        if (i >= 148 && i < 156) sum += ' ';
+        else sum += p[i];
+    }
+    return sum == tar_octal(hdr->chksum, sizeof(hdr->chksum));
+}
+
+// `path`'in dizin bileşenlerini (son bileşen hariç) gerekirse oluşturarak
+// yürür. Son bileşen `*leaf`/`*leaf_len` olarak döner.
+static vfs_node_t* initrd_walk(vfs_node_t* dir, const char* path, const char** leaf, size_t* leaf_len) {
+    char name[MAX_FILENAME_LENGTH];
+    const char* p = path;
+
+    for (;;) {
+        while (*p == '/') p++;
+        const char* comp = p;
+        while (*p && *p != '/') p++;
+        size_t len = p - comp;
+        while (*p == '/') p++;
+
+        if (*p == '\0') {
+            *leaf = comp;
+            *leaf_len = len;
+            return dir;
+        }
+        if (len == 0 || len >= MAX_FILENAME_LENGTH) return NULL;
+        if (len == 1 && comp[0] == '.') continue;
+
+        vfs_node_t* next = vfs_finddir(dir, comp, len);
+        if (!next) {
+            memcpy(name, comp, len);
+            name[len] = '\0';
+            if (!dir->mkdir || dir->mkdir(dir, name, 0755) < 0) return NULL;
+            next = vfs_finddir(dir, comp, len);
+        }
+        if (!next || next->type != FS_NODE_DIRECTORY) return NULL;
+        dir = next;
+    }
+}
+
+u32 initrd_load_tar(vfs_node_t* root, const u8* archive, u32 size) {
+    char path[256];
+    char name[MAX_FILENAME_LENGTH];
+    u32 files = 0;
+    u32 offset = 0;
+
+    while (offset + TAR_BLOCK_SIZE <= size) {
+        const tar_header_t* hdr = (const tar_header_t*)(archive + offset);
+        if (hdr->name[0] == '\0') break; // Arşiv sonu (iki boş blok)
+        if (memcmp(hdr->magic, "ustar", 5) != 0 || !tar_checksum_ok(hdr)) {
+            KLOG(LOG_LEVEL_ERROR, KLOG_COMP_VFS, "initrd: bad tar header at offset %u", offset);
+            break;
+        }
+
+        u32 file_size = tar_octal(hdr->size, sizeof(hdr->size));
+        const u8* data = archive + offset + TAR_BLOCK_SIZE;
+        offset += TAR_BLOCK_SIZE + ((file_size + TAR_BLOCK_SIZE - 1) & ~(TAR_BLOCK_SIZE - 1));
+        if (offset > size || offset < TAR_BLOCK_SIZE) break; // Kesik arşiv
+
+        // Tam yol: prefix + "/" + name (alanlar NUL ile bitmeyebilir)
+        size_t plen = strnlen(hdr->prefix, sizeof(hdr->prefix));
+        size_t nlen = strnlen(hdr->name, sizeof(hdr->name));
+        if (plen + nlen + 2 > sizeof(path)) continue;
+        memcpy(path, hdr->prefix, plen);
+        if (plen) path[plen++] = '/';
+        memcpy(path + plen, hdr->name, nlen);
+        path[plen + nlen] = '\0';
+
+        // Sondaki '/' (dizin girdileri) ve baştaki "./" önemsiz
+        size_t len = plen + nlen;
+        while (len > 0 && path[len - 1] == '/') path[--len] = '\0';
+        const char* rel = path;
+        while (rel[0] == '.' && rel[1] == '/') rel += 2;
+        if (*rel == '\0' || (rel[0] == '.' && rel[1] == '\0')) continue;
+
+        const char* leaf;
+        size_t leaf_len;
+        vfs_node_t* dir = initrd_walk(root, rel, &leaf, &leaf_len);
+        if (!dir || leaf_len == 0 || leaf_len >= MAX_FILENAME_LENGTH) continue;
+        memcpy(name, leaf, leaf_len);
+        name[leaf_len] = '\0';
+
+        u32 mode = tar_octal(hdr->mode, sizeof(hdr->mode)) & 07777;
+        vfs_node_t* node = NULL;
+        if (hdr->typeflag == TAR_TYPE_DIR) {
+            node = vfs_finddir(dir, name, leaf_len);
+            if (!node && dir->mkdir && dir->mkdir(dir, name, mode) == 0) {
+                node = vfs_finddir(dir, name, leaf_len);
+            }
+        } else if (hdr->typeflag == TAR_TYPE_FILE || hdr->typeflag == TAR_TYPE_FILE_OLD) {
+            node = ramfs_create_external(dir, name, data, file_size);
+            if (node) files++;
+        } else {
+            // Sembolik/sert bağlantılar ve aygıt dosyaları henüz desteklenmiyor
+            continue;
+        }
+
+        if (node) {
+            node->permissions = mode;
+            node->uid = tar_octal(hdr->uid, sizeof(hdr->uid));
+            node->gid = tar_octal(hdr->gid, sizeof(hdr->gid));
+            node->modification_time = tar_octal(hdr->mtime, sizeof(hdr->mtime));
+        }
+    }
+    return files;
+}
+
+u32 initrd_init(multiboot_info_t* mbd, vfs_node_t* root) {
+    if (!mbd || !root || !(mbd->flags & MBOOT_FLAG_MODS)) return 0;
+
+    multiboot_module_t* mods = (multiboot_module_t*)mbd->mods_addr;
+    u32 total = 0;
+    for (u32 i = 0; i < mbd->mods_count; i++) {
+        u32 size = mods[i].mod_end - mods[i].mod_start;
+        u32 files = initrd_load_tar(root, (const u8*)mods[i].mod_start, size);
+        KLOG(LOG_LEVEL_INFO, KLOG_COMP_VFS, "initrd: module %u: %u files, %u KB (zero-copy)",
+             i, files, size / 1024);
+        total += files;
+    }
+    return total;
+}
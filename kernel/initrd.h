@@ -0,0 +1,31 @@
+#ifndef INITRD_H
+#define INITRD_H
+
+#include "utils.h"
+#include "multiboot.h"
+#include "vfs.h"
+
+// --- Initrd (Boot Modülü Dosya Sistemi) ---
+// GRUB'un yüklediği ustar (POSIX tar) arşivleri açılışta VFS köküne açılır.
+// Dosya içerikleri kopyalanmaz: RamFS düğümleri doğrudan modülün belleğini
+// gösterir (ramfs_create_external). Dizinler normal RamFS dizinleridir, yani
+// arşivin üstüne yeni dosyalar yazılabilir; arşivden gelen bir dosyaya yazmak
+// sadece değişen sayfaları RAM'e kopyalar.
+//
+// Modül belleği init_pmm tarafından PMM'de ayrılır ve hiç geri verilmez.
+
+#define TAR_BLOCK_SIZE 512
+
+/**
+ * @brief Tüm multiboot modüllerini tar arşivi olarak `root` altına açar.
+ * @return Eklenen dosya sayısı.
+ */
+u32 initrd_init(multiboot_info_t* mbd, vfs_node_t* root);
+
+/**
+ * @brief Bellekteki tek bir tar arşivini açar.
+ * @return Eklenen dosya sayısı.
+ */
+u32 initrd_load_tar(vfs_node_t* root, const u8* archive, u32 size);
+
+#endif
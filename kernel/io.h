@@ -13,4 +13,51 @@ static inline u8 inb(u16 port) {
     return ret;
 }
 
+static inline void outw(u16 port, u16 val) {
+    asm volatile ("outw %0, %1" : : "a"(val), "Nd"(port));
+}
+
+static inline u16 inw(u16 port) {
+    u16 ret;
+    asm volatile ("inw %1, %0" : "=a"(ret) : "Nd"(port));
+    return ret;
+}
+
+static inline void outl(u16 port, u32 val) {
+    asm volatile ("outl %0, %1" : : "a"(val), "Nd"(port));
+}
+
+static inline u32 inl(u16 port) {
+    u32 ret;
+    asm volatile ("inl %1, %0" : "=a"(ret) : "Nd"(port));
+    return ret;
+}
+
+// Bir porttan `count` word okur / yazar (ATA veri portu gibi)
+static inline void insw(u16 port, void* buf, u32 count) {
+    asm volatile ("rep insw" : "+D"(buf), "+c"(count) : "d"(port) : "memory");
+}
+
+static inline void outsw(u16 port, const void* buf, u32 count) {
+    asm volatile ("rep outsw" : "+S"(buf), "+c"(count) : "d"(port) : "memory");
+}
+
+// İşlemcinin zaman damgası sayacı (TSC), çevrim cinsinden
+static inline u64 rdtsc() {
+    u32 lo, hi;
+    asm volatile ("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((u64)hi << 32) | lo;
+}
+
+// Kesmeleri kapatır ve önceki EFLAGS'i döner (tek işlemcide kritik bölge)
+static inline u32 irq_save() {
+    u32 eflags;
+    asm volatile ("pushf; pop %0; cli" : "=r"(eflags) :: "memory");
+    return eflags;
+}
+
+static inline void irq_restore(u32 eflags) {
+    asm volatile ("push %0; popf" :: "r"(eflags) : "memory", "cc");
+}
+
 #endif
\ No newline at end of file
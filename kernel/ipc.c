@@ -0,0 +1,355 @@
+#include "ipc.h"
+#include "slab.h"
+#include "io.h"
+#include "string.h"
+#include "epoll.h"
+#include "fdtable.h"
+
+#define IPC_BENCH_STOP 0xFFFFFFFF
+
+static slab_cache_t endpoint_cache = SLAB_CACHE_INIT("ipc_endpoint", sizeof(ipc_endpoint_t));
+
+static ipc_endpoint_t* endpoints = NULL;
+static ipc_stats_t stats;
+
+// --- Bekleme Kuyrukları (kesmeler kapalıyken) ---
+
+static void waiter_push(ipc_waiter_t** head, ipc_waiter_t** tail, ipc_waiter_t* w) {
+    w->next = NULL;
+    if (*tail) (*tail)->next = w;
+    else *head = w;
+    *tail = w;
+}
+
+static ipc_waiter_t* waiter_pop(ipc_waiter_t** head, ipc_waiter_t** tail) {
+    ipc_waiter_t* w = *head;
+    if (w) {
+        *head = w->next;
+        if (!*head) *tail = NULL;
+        w->next = NULL;
+    }
+    return w;
+}
+
+// Kuyruğa giren gönderen/alıcı, uç noktayı izleyen epoll'ları uyandırır
+static void queue_sender(ipc_endpoint_t* ep, ipc_waiter_t* w) {
+    waiter_push(&ep->send_head, &ep->send_tail, w);
+    if (waitq_active(&ep->poll_wq)) waitq_wake_all(&ep->poll_wq, POLL_KEY(EPOLLIN));
+}
+
+static void queue_receiver(ipc_endpoint_t* ep, ipc_waiter_t* w) {
+    waiter_push(&ep->recv_head, &ep->recv_tail, w);
+    if (waitq_active(&ep->poll_wq)) waitq_wake_all(&ep->poll_wq, POLL_KEY(EPOLLOUT));
+}
+
+// Çağıran görevin kaydını hazırlar; kayıt görev beklerken kuyrukta durur
+static ipc_waiter_t* waiter_init(ipc_msg_t* msg, ipc_msg_t* reply) {
+    ipc_waiter_t* w = &sched_current()->ipc;
+    w->task = sched_current();
+    w->msg = msg;
+    w->reply = reply;
+    w->caller = NULL;
+    w->done = 0;
+    w->result = IPC_OK;
+    w->next = NULL;
+    return w;
+}
+
+static void ipc_wait(ipc_waiter_t* w) {
+    while (!w->done) sched_block();
+}
+
+// Karşı tarafı çalıştırıp `self` tamamlanana kadar bekler. Karşı taraf bir
+// IPC beklemesinde uyuyorsa hazır kuyruğuna girmeden doğrudan ona geçilir.
+static void ipc_handoff(task_t* target, ipc_waiter_t* self) {
+    task_t* me = sched_current();
+    if (target != me && target->state == TASK_BLOCKED) {
+        stats.direct_switches++;
+        me->state = TASK_BLOCKED;
+        sched_switch_to(target);
+    } else {
+        sched_wake(target);
+    }
+    ipc_wait(self);
+}
+
+// Kısa kısım her zaman, uzun kısım alıcının tamponuna sığdığı kadar kopyalanır
+static int ipc_transfer(const ipc_msg_t* src, ipc_msg_t* dst) {
+    dst->label = src->label;
+    for (int i = 0; i < IPC_MR_COUNT; i++) dst->mr[i] = src->mr[i];
+
+    int result = IPC_OK;
+    u32 n = src->len;
+    if (n > dst->buf_size) {
+        n = dst->buf_size;
+        result = IPC_ETRUNC;
+    }
+    if (n) {
+        memcpy(dst->buf, src->buf, n);
+        stats.long_bytes += n;
+    }
+    dst->len = n;
+    return result;
+}
+
+// --- Uç Noktalar ---
+
+ipc_endpoint_t* ipc_endpoint_create(const char* name) {
+    ipc_endpoint_t* ep = (ipc_endpoint_t*)slab_alloc(&endpoint_cache);
+    if (!ep) return NULL;
+    strlcpy(ep->name, name, sizeof(ep->name));
+
+    u32 flags = irq_save();
+    ep->next = endpoints;
+    endpoints = ep;
+    irq_restore(flags);
+    return ep;
+}
+
+ipc_endpoint_t* ipc_endpoint_find(const char* name) {
+    u32 flags = irq_save();
+    ipc_endpoint_t* ep = endpoints;
+    while (ep && strcmp(ep->name, name) != 0) ep = ep->next;
+    irq_restore(flags);
+    return ep;
+}
+
+void ipc_endpoint_destroy(ipc_endpoint_t* ep) {
+    if (!ep) return;
+    u32 flags = irq_save();
+    ipc_endpoint_t** link = &endpoints;
+    while (*link && *link != ep) link = &(*link)->next;
+    if (*link) *link = ep->next;
+
+    ipc_waiter_t* w;
+    while ((w = waiter_pop(&ep->send_head, &ep->send_tail)) ||
+           (w = waiter_pop(&ep->recv_head, &ep->recv_tail))) {
+        w->result = IPC_EDEAD;
+        w->done = 1;
+        sched_wake(w->task);
+    }
+    ep->dead = 1;
+    waitq_wake_all(&ep->poll_wq, POLL_KEY(EPOLLHUP));
+    if (!ep->open_files) slab_free(&endpoint_cache, ep);
+    irq_restore(flags);
+}
+
+static u32 ipc_endpoint_poll(vfs_node_t* node, poll_table_t* pt) {
+    ipc_endpoint_t* ep = (ipc_endpoint_t*)node->internal_data;
+    poll_wait(&ep->poll_wq, pt);
+    if (ep->dead) return EPOLLHUP;
+    u32 mask = 0;
+    if (ep->send_head) mask |= EPOLLIN;
+    if (ep->recv_head) mask |= EPOLLOUT;
+    return mask;
+}
+
+static int ipc_endpoint_close(vfs_node_t* node) {
+    ipc_endpoint_t* ep = (ipc_endpoint_t*)node->internal_data;
+    u32 flags = irq_save();
+    if (--ep->open_files == 0 && ep->dead) slab_free(&endpoint_cache, ep);
+    irq_restore(flags);
+    return 0;
+}
+
+int ipc_endpoint_open(ipc_endpoint_t* ep) {
+    fd_table_t* table = fdtable_current();
+    if (!ep || ep->dead || !table) return -1;
+    if (!ep->node.poll) {
+        strlcpy(ep->node.name, ep->name, sizeof(ep->node.name));
+        ep->node.type = FS_NODE_DEVICE;
+        ep->node.close = ipc_endpoint_close;
+        ep->node.poll = ipc_endpoint_poll;
+        ep->node.internal_data = ep;
+    }
+    file_t* file = file_alloc(&ep->node, O_RDWR);
+    if (!file) return -1;
+    ep->open_files++;
+    int fd = fd_install(table, file);
+    if (fd < 0) file_put(file);
+    return fd;
+}
+
+// --- Gönderme / Alma ---
+
+int ipc_send(ipc_endpoint_t* ep, const ipc_msg_t* msg) {
+    if (!ep || !msg) return IPC_EINVAL;
+    u32 flags = irq_save();
+    stats.sends++;
+
+    ipc_waiter_t* r = waiter_pop(&ep->recv_head, &ep->recv_tail);
+    if (r) {
+        r->result = ipc_transfer(msg, r->msg);
+        r->caller = NULL;
+        r->done = 1;
+        sched_wake(r->task);
+        irq_restore(flags);
+        return IPC_OK;
+    }
+
+    ipc_waiter_t* w = waiter_init((ipc_msg_t*)msg, NULL);
+    queue_sender(ep, w);
+    ipc_wait(w);
+    int result = w->result;
+    irq_restore(flags);
+    return result;
+}
+
+int ipc_call(ipc_endpoint_t* ep, const ipc_msg_t* msg, ipc_msg_t* reply) {
+    if (!ep || !msg || !reply) return IPC_EINVAL;
+    u32 flags = irq_save();
+    stats.calls++;
+
+    ipc_waiter_t* w = waiter_init((ipc_msg_t*)msg, reply);
+    ipc_waiter_t* r = waiter_pop(&ep->recv_head, &ep->recv_tail);
+    if (r) {
+        // Hızlı yol: sunucu bekliyor; mesajı ver ve yanıt gelene kadar ona geç
+        r->result = ipc_transfer(msg, r->msg);
+        r->caller = w;
+        r->done = 1;
+        ipc_handoff(r->task, w);
+    } else {
+        queue_sender(ep, w);
+        ipc_wait(w);
+    }
+    int result = w->result;
+    irq_restore(flags);
+    return result;
+}
+
+int ipc_recv(ipc_endpoint_t* ep, ipc_msg_t* msg, ipc_reply_t* caller) {
+    if (!ep || !msg || !caller) return IPC_EINVAL;
+    u32 flags = irq_save();
+
+    ipc_waiter_t* s = waiter_pop(&ep->send_head, &ep->send_tail);
+    if (s) {
+        int result = ipc_transfer(s->msg, msg);
+        if (s->reply) {
+            *caller = s; // Gönderen yanıta kadar uyumaya devam eder
+        } else {
+            *caller = NULL;
+            s->done = 1;
+            sched_wake(s->task);
+        }
+        irq_restore(flags);
+        return result;
+    }
+
+    ipc_waiter_t* w = waiter_init(msg, NULL);
+    queue_receiver(ep, w);
+    ipc_wait(w);
+    *caller = w->caller;
+    int result = w->result;
+    irq_restore(flags);
+    return result;
+}
+
+int ipc_reply(ipc_reply_t caller, const ipc_msg_t* reply) {
+    if (!caller || !reply) return IPC_EINVAL;
+    u32 flags = irq_save();
+    stats.replies++;
+    caller->result = ipc_transfer(reply, caller->reply);
+    caller->done = 1;
+    sched_wake(caller->task);
+    irq_restore(flags);
+    return IPC_OK;
+}
+
+int ipc_reply_recv(ipc_endpoint_t* ep, ipc_reply_t caller, const ipc_msg_t* reply,
+                   ipc_msg_t* msg, ipc_reply_t* next_caller) {
+    if (!caller) return ipc_recv(ep, msg, next_caller);
+    if (!ep || !reply || !msg || !next_caller) return IPC_EINVAL;
+
+    u32 flags = irq_save();
+    if (ep->send_head) {
+        // Sırada mesaj var: sunucu uyumayacak, yanıtlanan görev kuyruktan çalışır
+        ipc_reply(caller, reply);
+        int result = ipc_recv(ep, msg, next_caller);
+        irq_restore(flags);
+        return result;
+    }
+
+    stats.replies++;
+    caller->result = ipc_transfer(reply, caller->reply);
+    caller->done = 1;
+
+    ipc_waiter_t* w = waiter_init(msg, NULL);
+    queue_receiver(ep, w);
+    ipc_handoff(caller->task, w);
+    *next_caller = w->caller;
+    int result = w->result;
+    irq_restore(flags);
+    return result;
+}
+
+void ipc_get_stats(ipc_stats_t* out) {
+    u32 flags = irq_save();
+    *out = stats;
+    irq_restore(flags);
+}
+
+// --- Gidiş-dönüş Gecikme Ölçümü ---
+
+// Etiketi aynen, ilk kelimeyi bir artırarak geri döner
+static void ipc_bench_server(void* arg) {
+    ipc_endpoint_t* ep = (ipc_endpoint_t*)arg;
+    ipc_msg_t msg, reply;
+    ipc_reply_t caller;
+    memset(&msg, 0, sizeof(msg));
+    memset(&reply, 0, sizeof(reply));
+
+    int result = ipc_recv(ep, &msg, &caller);
+    while (result == IPC_OK && caller) {
+        reply.label = msg.label;
+        reply.mr[0] = msg.mr[0] + 1;
+        if (msg.label == IPC_BENCH_STOP) {
+            ipc_reply(caller, &reply);
+            return;
+        }
+        result = ipc_reply_recv(ep, caller, &reply, &msg, &caller);
+    }
+}
+
+int ipc_benchmark(u32 iterations, ipc_bench_result_t* out) {
+    ipc_endpoint_t* ep = ipc_endpoint_create("ipc_bench");
+    if (!ep) return -1;
+    if (!kthread_create("ipc_bench", ipc_bench_server, ep)) {
+        ipc_endpoint_destroy(ep);
+        return -1;
+    }
+
+    ipc_msg_t msg, reply;
+    memset(&msg, 0, sizeof(msg));
+    memset(&reply, 0, sizeof(reply));
+    memset(out, 0, sizeof(*out));
+
+    // İlk çağrı sunucunun ilk kez çalışmasını bekler (hızlı yol değil); ölçülmez
+    msg.label = 1;
+    ipc_call(ep, &msg, &reply);
+
+    u32 switches = stats.direct_switches;
+    u64 total = 0;
+    out->min_cycles = 0xFFFFFFFF;
+    for (u32 i = 0; i < iterations; i++) {
+        msg.mr[0] = i;
+        u64 start = rdtsc();
+        if (ipc_call(ep, &msg, &reply) != IPC_OK || reply.mr[0] != i + 1) break;
+        u32 cycles = (u32)(rdtsc() - start);
+        total += cycles;
+        if (cycles < out->min_cycles) out->min_cycles = cycles;
+        if (cycles > out->max_cycles) out->max_cycles = cycles;
+        out->iterations++;
+    }
+    out->direct_switches = stats.direct_switches - switches;
+    if (out->iterations) {
+        divmod64_32(&total, out->iterations);
+        out->avg_cycles = (u32)total;
+    } else {
+        out->min_cycles = 0;
+    }
+
+    msg.label = IPC_BENCH_STOP;
+    ipc_call(ep, &msg, &reply);
+    ipc_endpoint_destroy(ep);
+    return 0;
+}
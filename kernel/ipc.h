@@ -0,0 +1,129 @@
+#ifndef IPC_H
+#define IPC_H
+
+#include "utils.h"
+#include "sched.h"
+#include "waitq.h"
+#include "vfs.h"
+
+// --- Eşzamanlı Mesajlaşma (IPC) ---
+// Görevler uç noktalar (endpoint) üzerinden buluşur: gönderen ve alıcıdan
+// önce gelen, karşısı gelene kadar uç noktanın kuyruğunda uyur; mesaj ara
+// tamponsuz, buluşma anında aktarılır.
+//
+//  * Kısa mesaj: etiket ve IPC_MR_COUNT kelimelik mesaj register'ları. Bunlar
+//    doğrudan karşı tarafın ipc_msg_t'sine yazılır.
+//  * Uzun mesaj: gönderenin `buf`undaki `len` byte, alıcının tamponuna tek
+//    kopyayla geçer (çekirdek kopyası yok). Sığmayan kısım kesilir.
+//  * ipc_call, bekleyen bir alıcıya mesajı verip hazır kuyruğuna uğramadan
+//    doğrudan ona geçer (sched_switch_to); ipc_reply_recv de yanıtı verip
+//    aynı şekilde çağırana döner. Böylece çağrı-yanıt turu iki bağlam
+//    değişimidir ve zaman dilimi istemciden sunucuya devredilir.
+//
+// ipc_recv, çağrıyla gelen mesajlar için bir yanıt tutamacı döner; sunucu
+// ona ipc_reply ya da ipc_reply_recv ile tam bir kez yanıt vermelidir. Bu
+// fonksiyonlar görev bağlamında çağrılır (kesme handler'ından değil).
+//
+// Uç nokta ipc_endpoint_open ile bir fd olarak da açılabilir; böylece epoll
+// ile izlenir: EPOLLIN, alınmayı bekleyen bir gönderen var (ipc_recv
+// beklemez); EPOLLOUT, mesaj bekleyen bir alıcı var (ipc_send/ipc_call
+// beklemez); EPOLLHUP, uç nokta yok edildi. Açık fd'si olan uç noktanın
+// belleği son fd kapanana kadar yaşar.
+
+#define IPC_MR_COUNT  4
+#define IPC_NAME_MAX  16
+
+// Dönüş değerleri
+#define IPC_OK        0
+#define IPC_EDEAD    -1 // Uç nokta yok edildi
+#define IPC_ETRUNC   -2 // Uzun mesaj alıcının tamponuna sığmadı (kesildi)
+#define IPC_EINVAL   -3
+
+typedef struct ipc_msg {
+    u32 label;              // Mesaj türü/işlem kodu, IPC'ye anlamsız
+    u32 mr[IPC_MR_COUNT];   // Kısa mesaj
+    void* buf;              // Uzun mesaj: gönderende veri, alıcıda hedef tampon
+    u32 len;                // Gönderende veri uzunluğu; alıcıda gelen byte sayısı
+    u32 buf_size;           // Alıcıda tampon kapasitesi
+} ipc_msg_t;
+
+// Uç noktada bekleyen görevin kaydı (ipc_waiter_t) görevin kendisindedir: task_t::ipc
+typedef ipc_waiter_t* ipc_reply_t; // ipc_recv'in verdiği yanıt tutamacı
+
+typedef struct ipc_endpoint {
+    char name[IPC_NAME_MAX];
+    ipc_waiter_t* send_head; // Alıcı bekleyen gönderenler (FIFO)
+    ipc_waiter_t* send_tail;
+    ipc_waiter_t* recv_head; // Mesaj bekleyen alıcılar (FIFO)
+    ipc_waiter_t* recv_tail;
+    wait_queue_t poll_wq;    // epoll kayıtları
+    vfs_node_t node;         // ipc_endpoint_open ile açılan fd'lerin düğümü
+    u32 open_files;
+    int dead;                // Yok edildi, son fd kapanınca serbest kalacak
+    struct ipc_endpoint* next;
+} ipc_endpoint_t;
+
+typedef struct {
+    u32 calls;
+    u32 sends;
+    u32 replies;
+    u32 direct_switches;    // Hazır kuyruğunu atlayan geçişler (hızlı yol)
+    u32 long_bytes;         // Uzun mesajlarla kopyalanan byte
+} ipc_stats_t;
+
+// Adlandırılmış uç nokta oluşturur (ad ipc_endpoint_find ile aranır); bellek yoksa NULL
+ipc_endpoint_t* ipc_endpoint_create(const char* name);
+ipc_endpoint_t* ipc_endpoint_find(const char* name);
+
+// Uç noktayı kaldırır; bekleyen herkes IPC_EDEAD ile uyanır
+void ipc_endpoint_destroy(ipc_endpoint_t* ep);
+
+// Uç noktayı mevcut fd tablosuna yerleştirir (epoll için); hata durumunda -1
+int ipc_endpoint_open(ipc_endpoint_t* ep);
+
+// Mesajı bir alıcı alana kadar bekler; yanıt beklemez
+int ipc_send(ipc_endpoint_t* ep, const ipc_msg_t* msg);
+
+/**
+ * @brief Mesajı gönderir ve yanıtı bekler (tek atomik işlem).
+ * @param reply Yanıtın yazılacağı mesaj; uzun yanıt için buf/buf_size verilir.
+ * @return IPC_OK, IPC_ETRUNC ya da IPC_EDEAD.
+ */
+int ipc_call(ipc_endpoint_t* ep, const ipc_msg_t* msg, ipc_msg_t* reply);
+
+/**
+ * @brief Bir mesaj gelene kadar bekler.
+ * @param caller Mesaj ipc_call ile geldiyse yanıt tutamacı, ipc_send ile geldiyse NULL.
+ */
+int ipc_recv(ipc_endpoint_t* ep, ipc_msg_t* msg, ipc_reply_t* caller);
+
+// Çağırana yanıt verir ve onu uyandırır (beklemez)
+int ipc_reply(ipc_reply_t caller, const ipc_msg_t* reply);
+
+/**
+ * @brief Sunucu döngüsünün hızlı yolu: `caller`a yanıt verip aynı işlemde
+ *        `ep`den sıradaki mesajı bekler. caller NULL ise yalnızca ipc_recv'dir.
+ */
+int ipc_reply_recv(ipc_endpoint_t* ep, ipc_reply_t caller, const ipc_msg_t* reply,
+                   ipc_msg_t* msg, ipc_reply_t* next_caller);
+
+void ipc_get_stats(ipc_stats_t* out);
+
+// --- Gidiş-dönüş Gecikme Ölçümü ---
+
+typedef struct {
+    u32 iterations;
+    u32 min_cycles;         // En hızlı tur (TSC çevrimi)
+    u32 avg_cycles;
+    u32 max_cycles;
+    u32 direct_switches;    // Ölçüm boyunca hızlı yoldan geçişler
+} ipc_bench_result_t;
+
+/**
+ * @brief Bir sunucu thread'i başlatır ve ona `iterations` kez kısa ipc_call
+ *        yapıp tur başına süreyi ölçer. Görev bağlamında çağrılır.
+ * @return Thread ya da uç nokta oluşturulamazsa -1.
+ */
+int ipc_benchmark(u32 iterations, ipc_bench_result_t* out);
+
+#endif
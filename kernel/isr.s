@@ -3,9 +3,19 @@
 .extern isr_handler
 .extern keyboard_handler
 
-/* Hata kodu olmayan ISR'ler için makro */
+/* Hata kodu olmayan ISR'ler için makro: yığın düzeni aynı kalsın diye 0 koyar */
 %macro ISR_NOERR_STUB 1
 .globl isr%1
+isr%1:
+    cli
+    push 0
+    push %1
+    jmp isr_handler_common
+%endmacro
+
+/* CPU'nun hata kodunu kendisi yığına koyduğu istisnalar için makro */
+%macro ISR_ERR_STUB 1
+.globl isr%1
 isr%1:
     cli
     push %1
@@ -16,27 +26,57 @@ isr%1:
 ISR_NOERR_STUB 0
 ISR_NOERR_STUB 1
 ; ... (diğer istisnalar için de eklenebilir)
+ISR_ERR_STUB 14   /* Sayfa hatası (page fault) */
+ISR_NOERR_STUB 32 /* IRQ 0: PIT */
 ISR_NOERR_STUB 33 /* Klavye */
+ISR_NOERR_STUB 34
+ISR_NOERR_STUB 35
+ISR_NOERR_STUB 36 /* COM1 */
+ISR_NOERR_STUB 37
+ISR_NOERR_STUB 38
+ISR_NOERR_STUB 39
+ISR_NOERR_STUB 40
+ISR_NOERR_STUB 41
+ISR_NOERR_STUB 42
+ISR_NOERR_STUB 43
+ISR_NOERR_STUB 44
+ISR_NOERR_STUB 45
+ISR_NOERR_STUB 46 /* IDE */
+ISR_NOERR_STUB 47
 
 /* Tüm ISR'lerin çağıracağı ortak C sarmalayıcısı */
 isr_handler_common:
     pusha       /* Tüm genel amaçlı register'ları sakla */
+    cld         /* i386 ABI: C kodu DF=0 bekler; kesilen kod (memmove) DF=1 olabilir */
 
     mov ax, ds  /* Kernel veri segmentini yükle */
-    push ax
+    push eax
+    mov ax, gs  /* gs ayrı saklanır: thread'in TLS seçicisi olabilir (gdt.h) */
+    push eax
     mov ax, 0x10
     mov ds, ax
     mov es, ax
     mov fs, ax
     mov gs, ax
 
+    /* isr_handler(int_num, err_code, frame): pusha (32) + ds (4) + gs (4)
+       sonrası esp çerçevenin başıdır (isr_frame_t, idt.h); int_num çerçevenin
+       +40'ında, err_code +44'ündedir */
+    mov eax, esp
+    push eax
+    push dword [esp + 48]
+    push dword [esp + 48]
     call isr_handler /* C handler'ını çağır */
+    add esp, 12
 
-    pop ax      /* Orijinal veri segmentini geri yükle */
+    /* Görev değiştiyse bu, kesilen görevin kendi gs'idir; yeniden yüklenince
+       TLS tabanı GDT'deki güncel (o görevin) değerle gelir */
+    pop eax
+    mov gs, ax
+    pop eax     /* Orijinal veri segmentini geri yükle */
     mov ds, ax
     mov es, ax
     mov fs, ax
-    mov gs, ax
 
     popa        /* Register'ları geri yükle */
     add esp, 8  /* Hata kodu ve interrupt numarasını stack'ten temizle */
@@ -1,50 +1,93 @@
 #include "vga.h"
 #include "idt.h"
+#include "gdt.h"
 #include "multiboot.h" // Yeni
 #include "pmm.h"       // Yeni
-
-// Basit bir integer'ı hex string'e çeviren yardımcı fonksiyon
-void hex_to_str(u32 n, char* out) {
-    const char* hex = "0123456789ABCDEF";
-    out[0] = '0';
-    out[1] = 'x';
-    for (int i = 7; i >= 0; i--) {
-        out[i + 2] = hex[(n >> (i * 4)) & 0xF];
-    }
-    out[10] = '\0';
-}
+#include "serial.h"
+#include "shell.h"
+#include "printf.h"
+#include "memory.h"
+#include "vmm.h"
+#include "pci.h"
+#include "ata.h"
+#include "virtio_blk.h"
+#include "sched.h"
+#include "timer.h"
+#include "bcache.h"
+#include "ramfs.h"
+#include "vfs.h"
+#include "fdtable.h"
+#include "keyboard.h"
+#include "vdso.h"
 
 // kernel_main artık multiboot info pointer'ını argüman olarak alıyor.
 void kernel_main(multiboot_info_t* mbd) {
     char buffer[11];
+    // Seri port en başta (polled modda) açılır ki erken hatalar da görülsün
+    serial_early_init();
+    // fpu_sse_install (main.core.asm) çoktan çalıştı; mem* hızlı yollarını seç
+    mem_init();
     clear_screen();
     write_vga_at("MicroKernel++ v0.3", 0, 0, 0x07);
 
     write_vga_at("Initializing Interrupts...", 1, 0, 0x07);
+    // GRUB'un GDT'si yerine kendi GDT'miz (kullanıcı ve TLS segmentleriyle)
+    gdt_init();
     init_idt();
     write_vga_at("OK", 1, 27, 0x02);
+
+    // IDT hazır: seri portu kesme tabanlı gönderime geçir ve konsol olarak bağla
+    serial_init();
+    shell_attach_serial_console();
     
     write_vga_at("Initializing Physical Memory Manager...", 2, 0, 0x07);
     init_pmm(mbd);
+    vmm_init();
     write_vga_at("OK", 2, 38, 0x02);
 
+    // Kök RamFS ve çekirdek fd tablosu (shell'in '<' / '>' yönlendirmeleri için)
+    vfs_initialize(ramfs_initialize());
+    fdtable_init();
+    // Karakter aygıtları (read/poll ile, epoll'la izlenebilir)
+    if (vfs_mkdir("/dev", 0755) == 0) {
+        vfs_node_t* dev = vfs_lookup("/dev");
+        ramfs_link_device(dev, keyboard_device());
+        ramfs_link_device(dev, serial_device());
+    }
+
+    // kernel_main'in bağlamı 0 numaralı görev olur; timer dilimleri sayar
+    sched_init();
+    // vDSO saatini timer besler: sembol tablosu ilk tick'ten önce hazır olmalı
+    vdso_init();
+    timer_init();
+
+    // PCI aygıt tablosu; sürücüler (ATA bus-master) buradan eşleşir
+    pci_init();
+    // IDE diskleri (kesme tabanlı, IDT ve PMM hazır olmalı)
+    ata_init();
+    // virtio diskleri (vda..); alt yarı thread'i için sched_init'ten sonra
+    virtio_blk_init();
+    bcache_init();
+    // Komutlar kesme bağlamında değil, kendi thread'inde çalışır
+    shell_init();
+
     write_vga_at("Keyboard enabled. Type something:", 4, 0, 0x0F);
     
     // Bellek yöneticisini test edelim
     write_vga_at("Testing PMM: Allocating 3 pages...", 8, 0, 0x0B);
     
     void* p1 = pmm_alloc_page();
-    hex_to_str((u32)p1, buffer);
+    ksnprintf(buffer, sizeof(buffer), "0x%08X", (u32)p1);
     write_vga_at("Page 1 allocated at: ", 9, 2, 0x0A);
     write_vga_at(buffer, 9, 25, 0x0E);
     
     void* p2 = pmm_alloc_page();
-    hex_to_str((u32)p2, buffer);
+    ksnprintf(buffer, sizeof(buffer), "0x%08X", (u32)p2);
     write_vga_at("Page 2 allocated at: ", 10, 2, 0x0A);
     write_vga_at(buffer, 10, 25, 0x0E);
 
     void* p3 = pmm_alloc_page();
-    hex_to_str((u32)p3, buffer);
+    ksnprintf(buffer, sizeof(buffer), "0x%08X", (u32)p3);
     write_vga_at("Page 3 allocated at: ", 11, 2, 0x0A);
     write_vga_at(buffer, 11, 25, 0x0E);
 
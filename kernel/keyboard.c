@@ -1,6 +1,10 @@
 #include "keyboard.h"
 #include "io.h"
 #include "vga.h"
+#include "epoll.h"
+#include "string.h"
+
+#define KEYBOARD_RING_MASK (KEYBOARD_RING_SIZE - 1)
 
 // Basit US QWERTY klavye haritası
 const char scancode_to_ascii[] = {
@@ -12,12 +16,30 @@ const char scancode_to_ascii[] = {
 
 static int cursor_x = 0;
 static int cursor_y = 3; // Başlangıç satırı
+static volatile u32 keyboard_events = 0;
+
+// /dev/kbd okuyucuları için girdi halkası
+static char kbd_ring[KEYBOARD_RING_SIZE];
+static volatile u32 kbd_head = 0; // Kesmenin bir sonraki yazacağı indeks
+static volatile u32 kbd_tail = 0; // Okuyucunun bir sonraki okuyacağı indeks
+static u32 kbd_opened = 0;
+static wait_queue_t kbd_wq = WAIT_QUEUE_INIT;
+static vfs_node_t kbd_node;
+
+static void kbd_push(char c) {
+    if (!kbd_opened || kbd_head - kbd_tail >= KEYBOARD_RING_SIZE) return;
+    kbd_ring[kbd_head & KEYBOARD_RING_MASK] = c;
+    kbd_head++;
+    waitq_wake_all(&kbd_wq, POLL_KEY(EPOLLIN));
+}
 
 void keyboard_handler() {
     u8 scancode = inb(0x60); // Klavye portundan scancode'u oku
+    keyboard_events++;
 
     if (scancode < sizeof(scancode_to_ascii)) {
         char c = scancode_to_ascii[scancode];
+        if (c != '?') kbd_push(c);
         if (c == '\n') {
             cursor_y++;
             cursor_x = 0;
@@ -34,4 +56,58 @@ void keyboard_handler() {
             }
         }
     }
-}
\ No newline at end of file
+}
+
+unsigned int keyboard_event_count() {
+    return keyboard_events;
+}
+
+// --- /dev/kbd ---
+
+static int kbd_readable(void* arg) {
+    return kbd_head != kbd_tail;
+}
+
+static size_t kbd_read(vfs_node_t* node, u32 offset, size_t size, u8* buffer) {
+    if (!size) return 0;
+    u32 flags = irq_save();
+    waitq_wait_event(&kbd_wq, kbd_readable, NULL);
+    size_t n = 0;
+    while (n < size && kbd_tail != kbd_head) {
+        buffer[n++] = (u8)kbd_ring[kbd_tail & KEYBOARD_RING_MASK];
+        kbd_tail++;
+    }
+    irq_restore(flags);
+    return n;
+}
+
+static u32 kbd_poll(vfs_node_t* node, poll_table_t* pt) {
+    poll_wait(&kbd_wq, pt);
+    return kbd_head != kbd_tail ? EPOLLIN : 0;
+}
+
+static int kbd_open(vfs_node_t* node, u32 flags) {
+    kbd_opened++;
+    return 0;
+}
+
+// Son okuyucu kapatınca okunmamış tuşlar atılır
+static int kbd_close(vfs_node_t* node) {
+    u32 flags = irq_save();
+    if (--kbd_opened == 0) kbd_tail = kbd_head;
+    irq_restore(flags);
+    return 0;
+}
+
+vfs_node_t* keyboard_device() {
+    if (!kbd_node.read) {
+        strlcpy(kbd_node.name, "kbd", sizeof(kbd_node.name));
+        kbd_node.type = FS_NODE_DEVICE;
+        kbd_node.permissions = 0444;
+        kbd_node.open = kbd_open;
+        kbd_node.close = kbd_close;
+        kbd_node.read = kbd_read;
+        kbd_node.poll = kbd_poll;
+    }
+    return &kbd_node;
+}
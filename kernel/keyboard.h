@@ -1,6 +1,19 @@
 #ifndef KEYBOARD_H
 #define KEYBOARD_H
 
+#include "vfs.h"
+
+// Klavye karakter aygıtı (/dev/kbd): açık olduğu sürece basılan tuşlar
+// KEYBOARD_RING_SIZE byte'lık bir halkada birikir (dolunca yenileri atılır).
+// read en az bir karakter gelene kadar bekler; poll veri varken EPOLLIN döner.
+#define KEYBOARD_RING_SIZE 256 // 2'nin kuvveti olmalı
+
 void keyboard_handler();
 
-#endif
\ No newline at end of file
+// Şimdiye kadar alınan klavye kesmesi sayısı (tuşa basıldı mı kontrolü için)
+unsigned int keyboard_event_count();
+
+// Aygıt düğümü (vfs'e ramfs_link_device ile bağlanır)
+vfs_node_t* keyboard_device();
+
+#endif
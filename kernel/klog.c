@@ -0,0 +1,193 @@
+#include "klog.h"
+
+#define KLOG_RING_MASK (KLOG_RING_SIZE - 1)
+
+// Halka tampon ve bir sonraki rezerve edilecek sıra numarası.
+// Yazıcılar slotu atomik fetch_add ile ayırır, kilit almazlar.
+static klog_record_t klog_ring[KLOG_RING_SIZE];
+static volatile u32 klog_head = 0;
+static u64 klog_boot_tsc = 0;
+
+static const char* klog_components[KLOG_MAX_COMPONENTS] = {
+    "core", "pmm", "vfs", "sched", "syscall", "irq"
+};
+static volatile u32 klog_component_count = KLOG_COMP_COUNT_BUILTIN;
+
+typedef struct {
+    klog_sink_t sink;
+    u32 cursor;
+} klog_sink_slot_t;
+
+static klog_sink_slot_t klog_sinks[KLOG_MAX_SINKS];
+static u32 klog_sink_count = 0;
+static volatile u32 klog_flush_busy = 0;
+
+static const char* const klog_level_names[] = {
+    "debug", "info", "warn", "error", "fatal"
+};
+
+static inline u64 klog_rdtsc(void) {
+    u32 lo, hi;
+    asm volatile ("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((u64)hi << 32) | lo;
+}
+
+// Tek CPU'lu sistemde her zaman 0. SMP geldiğinde LAPIC ID okunmalı.
+static inline u8 klog_cpu_id(void) {
+    return 0;
+}
+
+void klog_init(void) {
+    klog_boot_tsc = klog_rdtsc();
+}
+
+void klog_emit(log_level_t level, u8 component, const char* fmt,
+               u32 a0, u32 a1, u32 a2, u32 a3) {
+    u32 seq = __atomic_fetch_add(&klog_head, 1, __ATOMIC_RELAXED);
+    klog_record_t* rec = &klog_ring[seq & KLOG_RING_MASK];
+
+    // Slotu "yazılıyor" olarak işaretle; okuyucu yarım kaydı böylece fark eder.
+    rec->seq = 0;
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+
+    rec->timestamp = klog_rdtsc();
+    rec->level     = (u8)level;
+    rec->component = component;
+    rec->cpu       = klog_cpu_id();
+    rec->fmt       = fmt;
+    rec->args[0]   = a0;
+    rec->args[1]   = a1;
+    rec->args[2]   = a2;
+    rec->args[3]   = a3;
+
+    __atomic_store_n(&rec->seq, seq + 1, __ATOMIC_RELEASE);
+}
+
+void kernel_log(log_level_t level, const char* component, const char* message) {
+    // Mesaj biçim dizgesi olarak kullanılmaz: içindeki '%' argüman okumasın
+    klog_emit(level, klog_component_id(component), "%s", (u32)message, 0, 0, 0);
+}
+
+int klog_component_lookup(const char* name) {
+    u32 count = __atomic_load_n(&klog_component_count, __ATOMIC_ACQUIRE);
+    for (u32 i = 0; i < count; i++) {
+        const char* a = klog_components[i];
+        const char* b = name;
+        // Büyük/küçük harf duyarsız karşılaştır ("PMM" == "pmm")
+        while (*a && *b) {
+            char ca = (*a >= 'A' && *a <= 'Z') ? *a + 32 : *a;
+            char cb = (*b >= 'A' && *b <= 'Z') ? *b + 32 : *b;
+            if (ca != cb) break;
+            a++;
+            b++;
+        }
+        if (*a == '\0' && *b == '\0') return (int)i;
+    }
+    return -1;
+}
+
+u8 klog_component_id(const char* name) {
+    int id = klog_component_lookup(name);
+    if (id >= 0) return (u8)id;
+
+    // Yeni bileşeni kaydet. Nadir bir yol; kesmeleri kısa süre kapatmak yeterli.
+    u32 eflags;
+    asm volatile ("pushf; pop %0; cli" : "=r"(eflags) :: "memory");
+    id = klog_component_lookup(name);
+    if (id < 0) {
+        if (klog_component_count < KLOG_MAX_COMPONENTS) {
+            klog_components[klog_component_count] = name;
+            id = (int)klog_component_count;
+            __atomic_store_n(&klog_component_count, klog_component_count + 1, __ATOMIC_RELEASE);
+        } else {
+            id = KLOG_COMP_CORE;
+        }
+    }
+    asm volatile ("push %0; popf" :: "r"(eflags) : "memory", "cc");
+    return (u8)id;
+}
+
+const char* klog_component_name(u8 id) {
+    if (id >= klog_component_count) return "?";
+    return klog_components[id];
+}
+
+const char* klog_level_name(u8 level) {
+    if (level > LOG_LEVEL_FATAL) return "?";
+    return klog_level_names[level];
+}
+
+u32 klog_head_seq(void) {
+    return __atomic_load_n(&klog_head, __ATOMIC_ACQUIRE);
+}
+
+u32 klog_oldest_seq(void) {
+    u32 head = klog_head_seq();
+    return head > KLOG_RING_SIZE ? head - KLOG_RING_SIZE : 0;
+}
+
+int klog_read(u32* cursor, klog_record_t* out) {
+    for (;;) {
+        u32 want = *cursor;
+        u32 oldest = klog_oldest_seq();
+        if (want < oldest) {
+            // Okuyucu geride kaldı, üzerine yazılan kayıtları atla.
+            *cursor = want = oldest;
+        }
+        if (want >= klog_head_seq()) return 0;
+
+        klog_record_t* rec = &klog_ring[want & KLOG_RING_MASK];
+        u32 s1 = __atomic_load_n(&rec->seq, __ATOMIC_ACQUIRE);
+        if (s1 == 0) return 0; // Yazıcı henüz bitirmedi
+
+        *out = *rec;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        u32 s2 = __atomic_load_n(&rec->seq, __ATOMIC_RELAXED);
+
+        if (s1 == want + 1 && s2 == s1) {
+            *cursor = want + 1;
+            return 1;
+        }
+        // Kopyalama sırasında slotun üzerine yazıldı; en eski kayıttan tekrar dene.
+        if (s1 > want + 1 || s2 != s1) {
+            *cursor = want + 1;
+            continue;
+        }
+        return 0;
+    }
+}
+
+u32 klog_timestamp_units(const klog_record_t* rec) {
+    if (rec->timestamp < klog_boot_tsc) return 0;
+    return (u32)((rec->timestamp - klog_boot_tsc) >> 10);
+}
+
+int klog_add_sink(klog_sink_t sink) {
+    if (klog_sink_count >= KLOG_MAX_SINKS) return -1;
+    klog_sinks[klog_sink_count].sink = sink;
+    klog_sinks[klog_sink_count].cursor = klog_oldest_seq();
+    klog_sink_count++;
+    return 0;
+}
+
+void klog_flush_sinks(void) {
+    // Aynı anda tek bir flush çalışsın; diğeri sadece geri döner.
+    if (__atomic_exchange_n(&klog_flush_busy, 1, __ATOMIC_ACQUIRE)) return;
+
+    klog_record_t rec;
+    for (u32 i = 0; i < klog_sink_count; i++) {
+        while (klog_read(&klog_sinks[i].cursor, &rec)) {
+            klog_sinks[i].sink(&rec);
+        }
+    }
+
+    __atomic_store_n(&klog_flush_busy, 0, __ATOMIC_RELEASE);
+}
+
+int klog_render(const klog_record_t* rec, kprintf_sink_t* sink) {
+    int n = kprintf_to(sink, "[%10u] [%-5s] %s: ", klog_timestamp_units(rec),
+                       klog_level_name(rec->level), klog_component_name(rec->component));
+    n += kprintf_to(sink, rec->fmt, rec->args[0], rec->args[1], rec->args[2], rec->args[3]);
+    n += kprintf_to(sink, "\n");
+    return n;
+}
@@ -0,0 +1,137 @@
+#ifndef KLOG_H
+#define KLOG_H
+
+#include "utils.h"
+#include "printf.h"
+
+// --- Çekirdek Günlükleme Sistemi (Kernel Logger) ---
+// Kayıtlar sabit boyutlu, kilitsiz (lock-free) bir halka tampona ikili (binary)
+// olarak yazılır. Biçimlendirme (formatting) kayıt yazılırken DEĞİL, okunurken
+// yapılır; bu sayede IRQ bağlamından log atmak birkaç düzine döngüye mal olur.
+
+typedef enum {
+    LOG_LEVEL_DEBUG,
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARN,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_FATAL
+} log_level_t;
+
+#define KLOG_RING_SIZE      1024 // Kayıt sayısı, 2'nin kuvveti olmalı
+#define KLOG_MAX_ARGS       4
+#define KLOG_MAX_COMPONENTS 32
+
+// Önceden tanımlı bileşen kimlikleri. Diğerleri klog_component_id() ile
+// çalışma anında kaydedilir.
+enum {
+    KLOG_COMP_CORE,
+    KLOG_COMP_PMM,
+    KLOG_COMP_VFS,
+    KLOG_COMP_SCHED,
+    KLOG_COMP_SYSCALL,
+    KLOG_COMP_IRQ,
+    KLOG_COMP_COUNT_BUILTIN
+};
+
+// Halka tampondaki tek bir kayıt. `fmt` ve %s argümanları kalıcı (static)
+// string'leri göstermelidir, çünkü okunana kadar biçimlendirilmezler.
+typedef struct {
+    u64 timestamp;          // Kayıt anındaki TSC değeri
+    volatile u32 seq;       // Kayıt sıra numarası + 1 (0 = yazılıyor/boş)
+    u8  level;
+    u8  component;
+    u8  cpu;
+    u8  reserved;
+    const char* fmt;
+    u32 args[KLOG_MAX_ARGS]; // 64-bit argümanlar iki slot kaplar
+} klog_record_t;
+
+/**
+ * @brief Günlükleme sistemini başlatır (zaman damgası başlangıcı ve bileşen tablosu).
+ *        Halka statik olduğu için bu çağrıdan önce atılan loglar da kaybolmaz.
+ */
+void klog_init(void);
+
+/**
+ * @brief Bir kaydı halka tampona ekler. IRQ bağlamından çağrılabilir.
+ */
+void klog_emit(log_level_t level, u8 component, const char* fmt,
+               u32 a0, u32 a1, u32 a2, u32 a3);
+
+// KLOG(level, component, fmt, ...) - en fazla KLOG_MAX_ARGS argüman alır.
+#define KLOG(level, comp, ...) KLOG_EMIT_((level), (comp), __VA_ARGS__, 0, 0, 0, 0)
+#define KLOG_EMIT_(level, comp, fmt, a0, a1, a2, a3, ...) \
+    klog_emit(level, comp, fmt, (u32)(a0), (u32)(a1), (u32)(a2), (u32)(a3))
+
+/**
+ * @brief Sistemin standart çıktı birimine (örn. VGA) log mesajı yazar.
+ *        Eski string tabanlı arayüz; bileşen adını kimliğe çevirip KLOG'a iletir.
+ * @param level Log seviyesi.
+ * @param component Mesajı üreten bileşen (örn. "PMM", "VFS").
+ * @param message Log mesajı (kalıcı bir string olmalı); biçim dizgesi değildir,
+ *        olduğu gibi "%s" ile yazılır.
+ */
+void kernel_log(log_level_t level, const char* component, const char* message);
+
+/**
+ * @brief Bileşen adını kimliğe çevirir, tabloda yoksa kaydeder.
+ * @return Bileşen kimliği. Tablo doluysa KLOG_COMP_CORE.
+ */
+u8 klog_component_id(const char* name);
+
+/**
+ * @brief Bileşen adını kimliğe çevirir, kaydetmez.
+ * @return Bileşen kimliği, bulunamazsa -1.
+ */
+int klog_component_lookup(const char* name);
+
+const char* klog_component_name(u8 id);
+const char* klog_level_name(u8 level);
+
+/**
+ * @brief `*cursor` sıra numarasından itibaren bir sonraki tamamlanmış kaydı kopyalar.
+ *        Okuyucu geride kaldıysa (kayıtların üzerine yazıldıysa) imleç en eski
+ *        geçerli kayda ilerletilir.
+ * @param cursor Okuma imleci (sıra numarası). Başarıda bir artırılır.
+ * @param out Kaydın kopyalanacağı yer.
+ * @return Kayıt okunduysa 1, okunacak tamamlanmış kayıt yoksa 0.
+ */
+int klog_read(u32* cursor, klog_record_t* out);
+
+// Halkada hâlâ bulunan en eski kaydın ve bir sonraki yazılacak kaydın sıra numarası.
+u32 klog_oldest_seq(void);
+u32 klog_head_seq(void);
+
+// --- Log Çıkışları (Sinks) ---
+// Bir sink, her yeni kaydı sırayla alır (örn. seri port). Sink'ler kayıt
+// anında değil klog_flush_sinks() çağrıldığında beslenir; böylece
+// biçimlendirme ve yavaş G/Ç maliyeti kayıt atan koddan ayrılır.
+
+#define KLOG_MAX_SINKS 4
+
+typedef void (*klog_sink_t)(const klog_record_t* rec);
+
+/**
+ * @brief Bir log çıkışı ekler. Sink, halkada hâlâ bulunan en eski kayıttan
+ *        itibaren beslenir; böylece erken açılış logları da ona ulaşır.
+ * @return Başarılıysa 0, sink tablosu doluysa -1.
+ */
+int klog_add_sink(klog_sink_t sink);
+
+/**
+ * @brief Tüm sink'lere bekleyen kayıtları iletir. Kesme bağlamından değil,
+ *        idle döngüsü gibi görev bağlamından çağrılmalı.
+ */
+void klog_flush_sinks(void);
+
+/**
+ * @brief Bir kaydı "[zaman] [seviye] bileşen: mesaj\n" satırı olarak doğrudan
+ *        verilen sink'e biçimlendirir (ara tampon yok).
+ * @return Yazılan karakter sayısı.
+ */
+int klog_render(const klog_record_t* rec, kprintf_sink_t* sink);
+
+// Zaman damgasını klog_init()'ten bu yana geçen 1024 TSC döngüsü birimine çevirir.
+u32 klog_timestamp_units(const klog_record_t* rec);
+
+#endif
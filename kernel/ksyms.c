@@ -0,0 +1,37 @@
+#include "ksyms.h"
+#include "printf.h"
+
+// Sembol tablosu ayrı bir derleme adımında üretilir; yoksa adresleri NULL'dır
+extern const u32 ksyms_count __attribute__((weak));
+extern const u32 ksyms_addresses[] __attribute__((weak));
+extern const u32 ksyms_name_offsets[] __attribute__((weak));
+extern const char ksyms_names[] __attribute__((weak));
+
+int ksyms_available() {
+    return &ksyms_count && ksyms_addresses && ksyms_name_offsets && ksyms_names && ksyms_count > 1;
+}
+
+const char* ksyms_lookup(u32 addr, u32* start) {
+    if (!ksyms_available() || addr < ksyms_addresses[0]) return NULL;
+
+    // addresses[lo] <= addr olan en büyük lo
+    u32 lo = 0, hi = ksyms_count;
+    while (hi - lo > 1) {
+        u32 mid = lo + (hi - lo) / 2;
+        if (ksyms_addresses[mid] <= addr) lo = mid;
+        else hi = mid;
+    }
+
+    const char* name = &ksyms_names[ksyms_name_offsets[lo]];
+    if (!name[0]) return NULL; // Metin bölümünün sonundan sonrası
+    if (start) *start = ksyms_addresses[lo];
+    return name;
+}
+
+int ksyms_format(u32 addr, char* buf, size_t size) {
+    u32 start;
+    const char* name = ksyms_lookup(addr, &start);
+    if (!name) return ksnprintf(buf, size, "0x%08x", addr);
+    if (addr == start) return ksnprintf(buf, size, "%s", name);
+    return ksnprintf(buf, size, "%s+0x%x", name, addr - start);
+}
@@ -0,0 +1,52 @@
+#ifndef KSYMS_H
+#define KSYMS_H
+
+#include <stddef.h>
+#include "utils.h"
+
+// --- Çekirdek Sembol Tablosu ---
+// Çekirdek imajına gömülü, adrese göre sıralı fonksiyon sembolleri. Tablo
+// dört sembolden oluşur:
+//
+//   ksyms_count          Girdi sayısı
+//   ksyms_addresses[]    Artan sırada başlangıç adresleri
+//   ksyms_name_offsets[] Her girdinin ksyms_names içindeki ofseti
+//   ksyms_names[]        '\0' ile ayrılmış isimler
+//
+// Son girdi metin bölümünün sonudur ve adı boştur; ondan sonraki adresler
+// hiçbir fonksiyona ait sayılmaz. Semboller zayıf (weak) bildirilir: tablo
+// bağlanmamışsa ksyms_available() 0 döner ve adresler onaltılık yazılır.
+//
+// Tablo bağlanmış çekirdekten mkksyms.sh ile üretilir (iki geçişli bağlama):
+//
+//   ld -T linker.ld -o kernel.tmp $(OBJS)             # 1. geçiş: tablosuz
+//   sh kernel/mkksyms.sh kernel.tmp > ksyms_table.s
+//   as --32 -o ksyms_table.o ksyms_table.s
+//   ld -T linker.ld -o kernel.bin $(OBJS) ksyms_table.o
+//
+// Tablo yalnızca .rodata'ya girer ve linker.ld'de .rodata metinden sonra
+// gelir; bu yüzden ikinci geçiş fonksiyon adreslerini değiştirmez.
+//
+// Arama ikili aramadır; kilit almaz, bellek ayırmaz, yalnızca salt-okunur
+// tabloyu okur. Bu yüzden panic ve kesme bağlamından güvenle çağrılabilir.
+
+// "isim+0xofset" için yeterli tampon boyu (daha uzun isimler kesilir)
+#define KSYMS_NAME_MAX 64
+
+int ksyms_available();
+
+/**
+ * @brief `addr`ı içeren fonksiyonu bulur.
+ * @param start Bulunursa fonksiyonun başlangıç adresi (NULL olabilir).
+ * @return Fonksiyonun adı; tabloda yoksa NULL.
+ */
+const char* ksyms_lookup(u32 addr, u32* start);
+
+/**
+ * @brief Adresi "fonksiyon+0xofset" (ofset 0 ise yalnız isim) biçiminde
+ *        yazar; bulunamazsa "0x%08x".
+ * @return Yazılan karakter sayısı (ksnprintf gibi).
+ */
+int ksyms_format(u32 addr, char* buf, size_t size);
+
+#endif
@@ -0,0 +1,161 @@
+#include "memory.h"
+#include "string.h"
+#include "pmm.h"
+
+// main.core.asm tarafından sağlanır
+extern u32 sse_enabled; // fpu_sse_install CR4.OSFXSR'yi set ettiyse 1
+
+#define CPUID_EDX_SSE2 26
+
+static int mem_use_sse2 = 0;
+
+// cpuid'in yazdığı tüm register'lar çıktı olarak bildirilir
+static inline void cpuid(u32 leaf, u32* a, u32* b, u32* c, u32* d) {
+    asm volatile ("cpuid" : "=a"(*a), "=b"(*b), "=c"(*c), "=d"(*d) : "a"(leaf), "c"(0));
+}
+
+void mem_init() {
+    u32 a, b, c, d;
+    cpuid(1, &a, &b, &c, &d);
+    mem_use_sse2 = sse_enabled && (d & (1u << CPUID_EDX_SSE2));
+}
+
+int mem_sse2_enabled() {
+    return mem_use_sse2;
+}
+
+// --- Yardımcı Assembly Parçaları ---
+// Çekirdek henüz FPU/SSE durumunu görevler arasında saklamadığı için SSE
+// yolları kullandıkları xmm0'ı kendileri korur.
+
+static inline void rep_movsb(void** d, const void** s, size_t n) {
+    asm volatile ("rep movsb" : "+D"(*d), "+S"(*s), "+c"(n) :: "memory");
+}
+
+static inline void rep_stosb(void** d, u8 v, size_t n) {
+    asm volatile ("rep stosb" : "+D"(*d), "+c"(n) : "a"(v) : "memory");
+}
+
+// `d`'yi 64 byte'lık bloklar halinde `pattern` ile doldurur (önbelleği atlayarak).
+// `d` 16 byte hizalı, `blocks` > 0 olmalı.
+static void sse2_fill_nt(void* d, u32 pattern, size_t blocks) {
+    u8 saved[16];
+    asm volatile (
+        "movdqu %%xmm0, (%3)\n\t"
+        "movd %2, %%xmm0\n\t"
+        "pshufd $0, %%xmm0, %%xmm0\n\t"
+        "1:\n\t"
+        "movntdq %%xmm0, 0(%0)\n\t"
+        "movntdq %%xmm0, 16(%0)\n\t"
+        "movntdq %%xmm0, 32(%0)\n\t"
+        "movntdq %%xmm0, 48(%0)\n\t"
+        "add $64, %0\n\t"
+        "dec %1\n\t"
+        "jnz 1b\n\t"
+        "sfence\n\t"
+        "movdqu (%3), %%xmm0\n\t"
+        : "+r"(d), "+r"(blocks)
+        : "r"(pattern), "r"(saved)
+        : "memory", "cc");
+}
+
+// --- mem* Ailesi ---
+
+void* memcpy(void* dest, const void* src, size_t len) {
+    void* d = dest;
+    const void* s = src;
+
+    if (len >= 16) {
+        // Hedefi 4 byte'a hizala, gövdeyi dword dword kopyala
+        size_t head = (-(u32)d) & 3;
+        rep_movsb(&d, &s, head);
+        len -= head;
+        size_t dwords = len >> 2;
+        asm volatile ("rep movsl" : "+D"(d), "+S"(s), "+c"(dwords) :: "memory");
+        len &= 3;
+    }
+    rep_movsb(&d, &s, len);
+    return dest;
+}
+
+void* memset(void* dest, int val, size_t len) {
+    void* d = dest;
+    u8 b = (u8)val;
+    u32 pattern = b * 0x01010101u;
+
+    if (len >= MEM_NT_THRESHOLD && mem_use_sse2) {
+        size_t head = (-(u32)d) & 15;
+        rep_stosb(&d, b, head);
+        len -= head;
+        size_t blocks = len >> 6;
+        sse2_fill_nt(d, pattern, blocks);
+        d = (u8*)d + (blocks << 6);
+        len &= 63;
+    } else if (len >= 16) {
+        size_t head = (-(u32)d) & 3;
+        rep_stosb(&d, b, head);
+        len -= head;
+        size_t dwords = len >> 2;
+        asm volatile ("rep stosl" : "+D"(d), "+c"(dwords) : "a"(pattern) : "memory");
+        len &= 3;
+    }
+    rep_stosb(&d, b, len);
+    return dest;
+}
+
+void* memmove(void* dest, const void* src, size_t len) {
+    u8* d = (u8*)dest;
+    const u8* s = (const u8*)src;
+
+    // Hedef kaynaktan önce ya da bölgeler çakışmıyorsa ileri kopyalama güvenli
+    if (d <= s || d >= s + len) {
+        return memcpy(dest, src, len);
+    }
+
+    // Çakışan bölge: sondan başa doğru kopyala (DF=1). Önce artık byte'lar,
+    // sonra dword'ler; DF aynı asm bloğu içinde geri temizlenir. Bu aralıkta
+    // gelen bir kesme DF=1 görmez: ortak ISR girişi (isr.s) cld yapar, iret
+    // buradaki EFLAGS'ı geri yükler.
+    size_t tail = len & 3;
+    size_t dwords = len >> 2;
+    d += len - 1;
+    s += len - 1;
+    asm volatile ("std\n\t"
+                  "rep movsb\n\t"
+                  "sub $3, %%edi\n\t"
+                  "sub $3, %%esi\n\t"
+                  "mov %3, %%ecx\n\t"
+                  "rep movsl\n\t"
+                  "cld\n\t"
+                  : "+D"(d), "+S"(s), "+c"(tail)
+                  : "r"(dwords)
+                  : "memory", "cc");
+    return dest;
+}
+
+int memcmp(const void* a, const void* b, size_t len) {
+    const u8* p = (const u8*)a;
+    const u8* q = (const u8*)b;
+
+    // Farklı bir word bulana kadar 4 byte'lık adımlarla ilerle
+    while (len >= 4 && *(const u32*)p == *(const u32*)q) {
+        p += 4;
+        q += 4;
+        len -= 4;
+    }
+    while (len--) {
+        if (*p != *q) return *p - *q;
+        p++;
+        q++;
+    }
+    return 0;
+}
+
+void zero_page(void* page) {
+    if (mem_use_sse2) {
+        sse2_fill_nt(page, 0, PAGE_SIZE / 64);
+    } else {
+        size_t dwords = PAGE_SIZE / 4;
+        asm volatile ("rep stosl" : "+D"(page), "+c"(dwords) : "a"(0) : "memory");
+    }
+}
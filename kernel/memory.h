@@ -0,0 +1,30 @@
+#ifndef MEMORY_H
+#define MEMORY_H
+
+#include <stddef.h>
+#include "utils.h"
+
+// memcpy/memset/memmove/memcmp string.h'ta bildirilir; burada sadece
+// çekirdeğe özel yardımcılar bulunur.
+
+// Bu boyut ve üstündeki memset'ler (SSE2 varsa) non-temporal store ile yapılır.
+// Önbelleği kirletmemek için sadece sayfa boyutundaki temizlemelerde kullanılır.
+#define MEM_NT_THRESHOLD 4096
+
+/**
+ * @brief CPUID ile SSE2 desteğini kontrol eder ve hızlı yolları seçer.
+ *        fpu_sse_install()'dan SONRA çağrılmalıdır; SSE, CR4.OSFXSR set
+ *        edilmeden kullanılırsa #UD üretir.
+ */
+void mem_init();
+
+// SSE2 yolu etkin mi
+int mem_sse2_enabled();
+
+/**
+ * @brief 4 KB hizalı bir sayfayı sıfırlar (SSE2 varsa non-temporal store ile).
+ * @param page Sayfanın adresi (PAGE_SIZE hizalı olmalı).
+ */
+void zero_page(void* page);
+
+#endif
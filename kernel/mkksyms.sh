@@ -0,0 +1,63 @@
+#!/bin/sh
+# mkksyms.sh - Bağlanmış çekirdekten gömülü sembol tablosunu üretir (ksyms.h)
+#
+# Kullanım: mkksyms.sh <kernel.elf> > ksyms_table.s
+#           (NM ortam değişkeniyle çapraz derleyici nm'i seçilebilir)
+#
+# Metin bölümündeki fonksiyon sembolleri (nm tipi T/t) adrese göre sıralanır;
+# aynı adresteki takma adlardan ilki tutulur. Tablonun sonuna linker.ld'deki
+# _etext adresinde adı boş bir bitiş girdisi eklenir. Çıktı GNU as içindir ve
+# yalnızca .rodata'ya yazar.
+
+NM=${NM:-nm}
+
+if [ $# -ne 1 ] || [ ! -f "$1" ]; then
+    echo "usage: $0 <kernel.elf>" >&2
+    exit 1
+fi
+
+"$NM" -n "$1" | awk '
+BEGIN { n = 0 }
+$3 == "_etext" { etext = $1; next }
+$2 != "T" && $2 != "t" { next }
+$3 ~ /^__vdso_text_/ { next }
+{
+    addr = tolower($1)
+    if (n > 0 && addr == addrs[n - 1]) next
+    addrs[n] = addr
+    names[n] = $3
+    n++
+}
+END {
+    if (etext == "") {
+        print "mkksyms.sh: _etext not found (linker.ld)" > "/dev/stderr"
+        exit 1
+    }
+    # _etext ile aynı adresteki ya da sonraki semboller tabloya girmez
+    m = 0
+    for (i = 0; i < n; i++) if (addrs[i] < tolower(etext)) m = i + 1
+
+    print "/* mkksyms.sh tarafından üretildi; elle düzenlemeyin */"
+    print ".section .rodata"
+    print ".balign 4"
+    print ".globl ksyms_count"
+    print "ksyms_count:"
+    printf "    .long %d\n", m + 1
+    print ".globl ksyms_addresses"
+    print "ksyms_addresses:"
+    for (i = 0; i < m; i++) printf "    .long 0x%s\n", addrs[i]
+    printf "    .long 0x%s\n", etext
+    print ".globl ksyms_name_offsets"
+    print "ksyms_name_offsets:"
+    off = 0
+    for (i = 0; i < m; i++) {
+        printf "    .long %d\n", off
+        off += length(names[i]) + 1
+    }
+    printf "    .long %d\n", off
+    print ".globl ksyms_names"
+    print "ksyms_names:"
+    for (i = 0; i < m; i++) printf "    .asciz \"%s\"\n", names[i]
+    print "    .asciz \"\""
+    print ".section .note.GNU-stack,\"\",@progbits"
+}'
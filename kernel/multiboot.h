@@ -30,6 +30,14 @@ typedef struct {
     // ... diğer alanlar
 } __attribute__((packed)) multiboot_info_t;
 
+// mods_addr'in gösterdiği dizinin elemanları (mods_count adet)
+typedef struct {
+    u32 mod_start;
+    u32 mod_end;   // Dahil değil
+    u32 cmdline;   // GRUB'daki "module" satırının argümanları (NUL ile biten string)
+    u32 reserved;
+} __attribute__((packed)) multiboot_module_t;
+
 typedef struct {
     u32 size;
     u64 base_addr;
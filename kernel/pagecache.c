@@ -0,0 +1,439 @@
+#include "pagecache.h"
+#include "slab.h"
+#include "pmm.h"
+#include "vmm.h"
+#include "sched.h"
+#include "memory.h"
+#include "string.h"
+
+#define PC_SLOT_MASK (PAGECACHE_RADIX_SLOTS - 1)
+
+// Yaprak slotları sayfa adresini tutar. Sayfalar 4 KB hizalı olduğundan alt
+// bitler boştur; kirli (dirty) bayrağı doğrudan slotun içine gömülür.
+#define PC_DIRTY     1u
+#define PC_TAG_MASK  (PAGE_SIZE - 1)
+#define PC_PAGE(v)   ((u8*)((size_t)(v) & ~(size_t)PC_TAG_MASK))
+#define PC_IS_DIRTY(v) ((size_t)(v) & PC_DIRTY)
+
+// pc_page modları
+#define PC_LOOKUP    0 // Delik için sayfa oluşturma
+#define PC_CREATE    1 // Eksikse oluştur (diskten oku ya da sıfırla)
+#define PC_OVERWRITE 2 // Eksikse oluştur; çağıran sayfanın tamamını yazacak
+
+// Ağaçlar, sayaçlar ve kirli listesi görevler arasında paylaşılır: genel
+// arayüz preempt_disable içinde çalışır ve yalnızca readpage/writepage
+// (G/Ç'de uyuyabilir) için korumayı bırakır. Uyunan sürede ağaç değişmiş
+// olabileceğinden dönüşte slot yeniden aranır; kullanılan sayfa bir PMM
+// referansıyla tutulur ki truncate onu elden almasın.
+
+static slab_cache_t pagecache_slab = SLAB_CACHE_INIT("page_cache", sizeof(page_cache_t));
+static page_cache_t* dirty_caches = NULL;
+static pagecache_stats_t pagecache_stats;
+
+// `height` yüksekliğindeki bir ağacın kapsadığı sayfa sayısı
+static inline u32 pc_capacity(u32 height) {
+    return height ? 1u << (PAGECACHE_RADIX_SHIFT * (height - 1)) : 0;
+}
+
+static inline u32 pc_file_pages(vfs_node_t* node) {
+    return (node->size + PAGE_SIZE - 1) / PAGE_SIZE;
+}
+
+// --- Radix Ağacı ---
+
+// `index` için yaprak slotunu döner. create=0 iken yol üzerinde eksik
+// tablo varsa NULL döner; create=1 iken ağacı büyütür ve tabloları tahsis eder.
+static void** pc_slot(page_cache_t* c, u32 index, int create) {
+    if (index >= pc_capacity(c->height)) {
+        if (!create) return NULL;
+        // Ağacı kökten büyüt: eski kök yeni kökün 0. slotuna iner
+        while (index >= pc_capacity(c->height)) {
+            if (c->root) {
+                void** table = (void**)pmm_alloc_zeroed_page();
+                if (!table) return NULL;
+                table[0] = c->root;
+                c->root = table;
+            }
+            c->height++;
+        }
+    }
+
+    void** slot = &c->root;
+    for (u32 h = c->height; h > 1; h--) {
+        if (!*slot) {
+            if (!create || !(*slot = pmm_alloc_zeroed_page())) return NULL;
+        }
+        u32 shift = PAGECACHE_RADIX_SHIFT * (h - 2);
+        slot = &((void**)*slot)[(index >> shift) & PC_SLOT_MASK];
+    }
+    return slot;
+}
+
+static void pc_dirty_list_remove(page_cache_t* c) {
+    if (!c->on_dirty_list) return;
+    for (page_cache_t** pp = &dirty_caches; *pp; pp = &(*pp)->dirty_next) {
+        if (*pp == c) {
+            *pp = c->dirty_next;
+            break;
+        }
+    }
+    c->dirty_next = NULL;
+    c->on_dirty_list = 0;
+}
+
+static void pc_mark_dirty(page_cache_t* c, void** slot) {
+    if (PC_IS_DIRTY(*slot)) return;
+    *slot = (void*)((size_t)*slot | PC_DIRTY);
+    c->nr_dirty++;
+    if (!c->on_dirty_list) {
+        c->dirty_next = dirty_caches;
+        dirty_caches = c;
+        c->on_dirty_list = 1;
+    }
+}
+
+// `node` köklü, `height` yüksekliğinde ve ilk sayfası `base` olan alt ağaçta
+// `from` ve sonrasındaki sayfaları bırakır. Alt ağaç tamamen boşaldıysa
+// (node da serbest bırakıldıysa) 1 döner.
+static int pc_free_from(page_cache_t* c, void* node, u32 height, u32 base, u32 from) {
+    if (height == 1) {
+        if (base < from) return 0;
+        if (PC_IS_DIRTY(node)) c->nr_dirty--;
+        pmm_free_page(PC_PAGE(node));
+        c->nr_pages--;
+        return 1;
+    }
+
+    void** slots = (void**)node;
+    u32 span = pc_capacity(height - 1);
+    int empty = 1;
+    for (u32 i = 0; i < PAGECACHE_RADIX_SLOTS; i++) {
+        if (!slots[i]) continue;
+        u32 child_base = base + i * span;
+        if (child_base + span <= from) {
+            empty = 0;
+            continue;
+        }
+        if (pc_free_from(c, slots[i], height - 1, child_base, from)) {
+            slots[i] = NULL;
+        } else {
+            empty = 0;
+        }
+    }
+    if (empty) pmm_free_page(node);
+    return empty;
+}
+
+// `node` köklü alt ağaçta `from` ve sonrasındaki ilk kirli sayfayı arar;
+// bulursa indeksini *index'e yazıp 1 döner
+static int pc_find_dirty(void* node, u32 height, u32 base, u32 from, u32* index) {
+    if (!node) return 0;
+    if (height == 1) {
+        if (base < from || !PC_IS_DIRTY(node)) return 0;
+        *index = base;
+        return 1;
+    }
+
+    void** slots = (void**)node;
+    u32 span = pc_capacity(height - 1);
+    for (u32 i = 0; i < PAGECACHE_RADIX_SLOTS; i++) {
+        u32 child_base = base + i * span;
+        if (child_base + span <= from) continue;
+        if (pc_find_dirty(slots[i], height - 1, child_base, from, index)) return 1;
+    }
+    return 0;
+}
+
+// `index`in slotu hâlâ `page`'i gösteriyorsa onu döner (uyuduktan sonra)
+static void** pc_slot_of(page_cache_t* c, u32 index, u8* page) {
+    void** slot = pc_slot(c, index, 0);
+    return (slot && *slot && PC_PAGE(*slot) == page) ? slot : NULL;
+}
+
+// --- Sayfa Erişimi ---
+
+static u8* pc_page(vfs_node_t* node, page_cache_t* c, u32 index, int mode) {
+    void** slot = pc_slot(c, index, 0);
+    if (slot && *slot) {
+        pagecache_stats.hits++;
+        return PC_PAGE(*slot);
+    }
+    pagecache_stats.misses++;
+
+    int backed = node->readpage && index < pc_file_pages(node);
+    if (mode == PC_LOOKUP && !backed) return NULL; // Delik: sıfır okunur
+
+    u8* page = (u8*)pmm_alloc_page();
+    if (!page) return NULL;
+    if (mode == PC_OVERWRITE) {
+        // Çağıran tüm sayfayı yazacak; okuma ya da sıfırlama gereksiz
+    } else if (backed) {
+        preempt_enable();
+        int r = node->readpage(node, index, page);
+        preempt_disable();
+        if (r < 0) {
+            pmm_free_page(page);
+            return NULL;
+        }
+        // Okurken dosya kesildiyse sayfa artık dosya sonrası: sıfır olmalı
+        if (index >= pc_file_pages(node)) zero_page(page);
+    } else {
+        zero_page(page);
+    }
+
+    // Uyunduysa başka bir görev aynı sayfayı eklemiş olabilir
+    if (!(slot = pc_slot(c, index, 1))) {
+        pmm_free_page(page);
+        return NULL;
+    }
+    if (*slot) {
+        pmm_free_page(page);
+        return PC_PAGE(*slot);
+    }
+    *slot = page;
+    c->nr_pages++;
+    return page;
+}
+
+// Sıralı erişimi algılar ve okunan aralığın ilerisindeki sayfaları önceden
+// doldurur. Pencere her ardışık tetiklemede ikiye katlanır; rastgele bir
+// erişim pencereyi sıfırlar.
+static void pc_readahead(vfs_node_t* node, page_cache_t* c, u32 first, u32 last) {
+    int sequential = (first == c->ra_next) || (c->ra_next && first == c->ra_next - 1);
+    c->ra_next = last + 1;
+    if (!sequential) {
+        c->ra_window = 0;
+        c->ra_end = 0;
+        return;
+    }
+    if (last + 1 < c->ra_end) return; // Önceki pencere henüz tükenmedi
+
+    c->ra_window = c->ra_window ? c->ra_window * 2 : PAGECACHE_RA_MIN;
+    if (c->ra_window > PAGECACHE_RA_MAX) c->ra_window = PAGECACHE_RA_MAX;
+
+    u32 start = last + 1 > c->ra_end ? last + 1 : c->ra_end;
+    u32 end = last + 1 + c->ra_window;
+    u32 limit = pc_file_pages(node);
+    if (end > limit) end = limit;
+    for (u32 idx = start; idx < end; idx++) {
+        void** slot = pc_slot(c, idx, 0);
+        if (slot && *slot) continue;
+        if (!pc_page(node, c, idx, PC_LOOKUP)) break;
+        pagecache_stats.readahead_pages++;
+    }
+    c->ra_end = end;
+}
+
+// --- Genel Arayüz ---
+
+void pagecache_attach(vfs_node_t* node, page_cache_t* cache) {
+    memset(cache, 0, sizeof(*cache));
+    cache->owner = node;
+    node->page_cache = cache;
+}
+
+page_cache_t* pagecache_get(vfs_node_t* node) {
+    if (node->page_cache) return node->page_cache;
+    page_cache_t* c = (page_cache_t*)slab_alloc(&pagecache_slab);
+    if (!c) return NULL;
+    preempt_disable();
+    if (node->page_cache) {
+        // Araya giren bir görev önbelleği oluşturdu
+        preempt_enable();
+        slab_free(&pagecache_slab, c);
+        return node->page_cache;
+    }
+    pagecache_attach(node, c);
+    c->from_slab = 1;
+    preempt_enable();
+    return c;
+}
+
+u8* pagecache_find_page(vfs_node_t* node, u32 index, int create) {
+    page_cache_t* c = pagecache_get(node);
+    if (!c) return NULL;
+    preempt_disable();
+    u8* page = pc_page(node, c, index, create ? PC_CREATE : PC_LOOKUP);
+    if (page) pmm_page_get(page);
+    preempt_enable();
+    return page;
+}
+
+void pagecache_set_dirty(vfs_node_t* node, u32 index) {
+    page_cache_t* c = node->page_cache;
+    if (!c || !node->writepage) return;
+    preempt_disable();
+    void** slot = pc_slot(c, index, 0);
+    if (slot && *slot) pc_mark_dirty(c, slot);
+    preempt_enable();
+}
+
+size_t pagecache_read(vfs_node_t* node, u32 offset, size_t size, u8* buffer) {
+    page_cache_t* c = pagecache_get(node);
+    if (!c) return 0;
+    preempt_disable();
+    if (offset >= node->size) {
+        preempt_enable();
+        return 0;
+    }
+    if (size > node->size - offset) size = node->size - offset;
+    if (size == 0) {
+        preempt_enable();
+        return 0;
+    }
+
+    if (node->readpage) {
+        pc_readahead(node, c, offset / PAGE_SIZE, (offset + size - 1) / PAGE_SIZE);
+    }
+
+    size_t done = 0;
+    while (done < size) {
+        u32 pos = offset + done;
+        u32 page_off = pos & (PAGE_SIZE - 1);
+        size_t chunk = PAGE_SIZE - page_off;
+        if (chunk > size - done) chunk = size - done;
+
+        u8* page = pc_page(node, c, pos / PAGE_SIZE, PC_LOOKUP);
+        if (page) {
+            // Kopyalarken kullanıcı tamponu sayfa hatası verip uyuyabilir
+            pmm_page_get(page);
+            memcpy(buffer + done, page + page_off, chunk);
+            pmm_free_page(page);
+        } else if (node->readpage) {
+            break; // G/Ç hatası ya da bellek yok: kısmi okuma
+        } else {
+            memset(buffer + done, 0, chunk); // Delik
+        }
+        done += chunk;
+    }
+    preempt_enable();
+    return done;
+}
+
+size_t pagecache_write(vfs_node_t* node, u32 offset, size_t size, const u8* buffer) {
+    page_cache_t* c = pagecache_get(node);
+    if (!c) return 0;
+    // 4 GB sınırını aşan kısım yazılmaz
+    if (size > 0xFFFFFFFFu - offset) size = 0xFFFFFFFFu - offset;
+
+    preempt_disable();
+    size_t done = 0;
+    while (done < size) {
+        u32 pos = offset + done;
+        u32 index = pos / PAGE_SIZE;
+        u32 page_off = pos & (PAGE_SIZE - 1);
+        size_t chunk = PAGE_SIZE - page_off;
+        if (chunk > size - done) chunk = size - done;
+
+        u8* page = pc_page(node, c, index, chunk == PAGE_SIZE ? PC_OVERWRITE : PC_CREATE);
+        if (!page) break; // Bellek tükendi: kısmi yazma
+        pmm_page_get(page);
+        memcpy(page + page_off, buffer + done, chunk);
+        // Kopya sırasında uyunup sayfa kesildiyse işaretlenecek slot yok
+        void** slot = pc_slot_of(c, index, page);
+        if (slot && node->writepage) pc_mark_dirty(c, slot);
+        pmm_free_page(page);
+        done += chunk;
+    }
+
+    if (offset + done > node->size) node->size = offset + done;
+    preempt_enable();
+    return done;
+}
+
+int pagecache_truncate(vfs_node_t* node, u32 length) {
+    page_cache_t* c = node->page_cache;
+    preempt_disable();
+
+    if (c && length < node->size && c->root) {
+        u32 first_free = (length + PAGE_SIZE - 1) / PAGE_SIZE;
+        if (pc_free_from(c, c->root, c->height, 0, first_free)) {
+            c->root = NULL;
+            c->height = 0;
+        }
+        // Son sayfanın kesilen kuyruğu sıfırlanır; dosya sonrası her zaman
+        // sıfır olmalı ki sonradan büyütülünce eski veri görünmesin.
+        u32 tail = length & (PAGE_SIZE - 1);
+        if (tail) {
+            void** slot = pc_slot(c, length / PAGE_SIZE, 0);
+            if (slot && *slot) memset(PC_PAGE(*slot) + tail, 0, PAGE_SIZE - tail);
+        }
+        if (c->nr_dirty == 0) pc_dirty_list_remove(c);
+        c->ra_next = c->ra_end = c->ra_window = 0;
+    }
+    // Büyütme sadece boyutu değiştirir; aradaki bölge delik olarak kalır
+    node->size = length;
+    preempt_enable();
+    return 0;
+}
+
+int pagecache_writeback(vfs_node_t* node) {
+    page_cache_t* c = node->page_cache;
+    if (!c || !node->writepage) return 0;
+
+    int written = 0;
+    u32 index = 0;
+    preempt_disable();
+    while (c->nr_dirty && pc_find_dirty(c->root, c->height, 0, index, &index)) {
+        void** slot = pc_slot(c, index, 0);
+        u8* page = PC_PAGE(*slot);
+        // Sayfa yazılmadan önce temizlenir ve paylaşımlı eşlemeleri yazmaya
+        // karşı korunur; writepage sırasındaki yazmalar onu yeniden kirletir
+        *slot = page;
+        c->nr_dirty--;
+        vmm_page_mkclean(node, index);
+        pmm_page_get(page);
+
+        preempt_enable();
+        int r = node->writepage(node, index, page);
+        preempt_disable();
+
+        if (r < 0) {
+            if ((slot = pc_slot_of(c, index, page))) pc_mark_dirty(c, slot);
+        } else {
+            written++;
+        }
+        pmm_free_page(page);
+        if (++index == 0) break;
+    }
+    pagecache_stats.writeback_pages += written;
+    if (c->nr_dirty == 0) pc_dirty_list_remove(c);
+    preempt_enable();
+    return written;
+}
+
+int pagecache_writeback_all() {
+    int written = 0;
+    preempt_disable();
+    page_cache_t* c = dirty_caches;
+    while (c) {
+        // pagecache_writeback c'yi listeden çıkarabilir; sonrakini önceden al.
+        // Writepage'de uyunurken `next` de listeden çıkarsa tur erken biter,
+        // kalan önbellekler sonraki turda yazılır.
+        page_cache_t* next = c->dirty_next;
+        written += pagecache_writeback(c->owner);
+        c = next;
+    }
+    preempt_enable();
+    return written;
+}
+
+void pagecache_release(vfs_node_t* node) {
+    page_cache_t* c = node->page_cache;
+    if (!c) return;
+
+    pagecache_writeback(node);
+    preempt_disable();
+    if (c->root && pc_free_from(c, c->root, c->height, 0, 0)) {
+        c->root = NULL;
+        c->height = 0;
+    }
+    pc_dirty_list_remove(c);
+    node->page_cache = NULL;
+    preempt_enable();
+    if (c->from_slab) slab_free(&pagecache_slab, c);
+}
+
+void pagecache_get_stats(pagecache_stats_t* out) {
+    *out = pagecache_stats;
+}
@@ -0,0 +1,86 @@
+#ifndef PAGECACHE_H
+#define PAGECACHE_H
+
+#include <stddef.h>
+#include "utils.h"
+#include "vfs.h"
+
+// --- Birleşik Sayfa Önbelleği (Page Cache) ---
+// Her dosya düğümünün verisi, dosya ofsetine göre indekslenen PMM
+// sayfalarından oluşan bir radix ağacında tutulur. vfs_read_node/
+// vfs_write_node ve mmap aynı sayfaları kullanır; bu yüzden bir dosyanın
+// bellekte her zaman tek bir kopyası vardır.
+//
+// Dosya sistemleri iki şekilde bağlanır:
+//  - Blok tabanlı olanlar vfs_node_t.readpage/writepage doldurur. Eksik
+//    sayfalar readpage ile diskten okunur, değişenler "kirli" olarak
+//    işaretlenip pagecache_writeback ile geri yazılır.
+//  - RamFS gibi yedek deposu olmayanlar için önbelleğin kendisi veri
+//    deposudur; hiç yazılmamış sayfalar (delikler) sıfır okunur.
+
+#define PAGECACHE_RADIX_SHIFT 10                            // Ağaç düğümü başına 1024 slot
+#define PAGECACHE_RADIX_SLOTS (1u << PAGECACHE_RADIX_SHIFT) // = PAGE_SIZE / sizeof(void*)
+
+#define PAGECACHE_RA_MIN 4   // Sıralı erişim algılanınca ilk readahead penceresi (sayfa)
+#define PAGECACHE_RA_MAX 32  // Pencere her isabette ikiye katlanır, burada durur
+
+struct vma;
+
+typedef struct page_cache {
+    void* root;        // height 1 ise doğrudan sayfa, üstündeyse slot tablosu
+    u32 height;        // 0 = hiç sayfa yok
+    u32 nr_pages;      // Önbellekteki sayfa sayısı
+    u32 nr_dirty;      // Geri yazılmayı bekleyen sayfa sayısı
+    u32 ra_next;       // Sıralı okumada beklenen bir sonraki sayfa
+    u32 ra_window;     // Mevcut readahead penceresi (0 = kapalı)
+    u32 ra_end;        // Readahead'in ulaştığı ilk sayfa (dahil değil)
+    vfs_node_t* owner;
+    struct vma* mmap_list;         // Dosyanın paylaşımlı eşlemeleri (vmm.c bakar)
+    struct page_cache* dirty_next; // Kirli önbellekler listesi (writeback için)
+    u8 on_dirty_list;
+    u8 from_slab;      // pagecache_get tarafından tahsis edildiyse 1
+} page_cache_t;
+
+typedef struct {
+    u32 hits;
+    u32 misses;
+    u32 readahead_pages;
+    u32 writeback_pages;
+} pagecache_stats_t;
+
+// `cache`'i boş olarak hazırlar ve düğüme bağlar (gömülü önbellekler için)
+void pagecache_attach(vfs_node_t* node, page_cache_t* cache);
+
+// Düğümün önbelleğini döner; yoksa oluşturur (bellek yoksa NULL)
+page_cache_t* pagecache_get(vfs_node_t* node);
+
+/**
+ * @brief `index` numaralı sayfayı döner; gerekirse readpage ile doldurur.
+ *        mmap'in sayfa hatası (page fault) yolu bunu kullanır.
+ * @param create Sayfa önbellekte ve diskte yoksa (delik) sıfır bir sayfa oluştur.
+ * @return Sayfa adresi, çağırana ait bir PMM referansıyla (pmm_free_page ile
+ *         bırakılır); delik (create=0) ya da bellek yetersizse NULL.
+ */
+u8* pagecache_find_page(vfs_node_t* node, u32 index, int create);
+
+// Sayfayı kirli işaretler (yazılabilir paylaşımlı mmap'ler için)
+void pagecache_set_dirty(vfs_node_t* node, u32 index);
+
+size_t pagecache_read(vfs_node_t* node, u32 offset, size_t size, u8* buffer);
+size_t pagecache_write(vfs_node_t* node, u32 offset, size_t size, const u8* buffer);
+
+// Dosyayı `length` byte'a getirir; kesilen sayfalar PMM'ye geri verilir
+int pagecache_truncate(vfs_node_t* node, u32 length);
+
+// Düğümün kirli sayfalarını writepage ile geri yazar; yazılan sayfa sayısını döner
+int pagecache_writeback(vfs_node_t* node);
+
+// Tüm kirli önbellekleri geri yazar (sync)
+int pagecache_writeback_all();
+
+// Düğüm yok edilirken tüm sayfaları bırakır (kirli sayfalar önce yazılır)
+void pagecache_release(vfs_node_t* node);
+
+void pagecache_get_stats(pagecache_stats_t* out);
+
+#endif
@@ -0,0 +1,319 @@
+#include "pci.h"
+#include "io.h"
+#include "klog.h"
+#include "string.h"
+
+static pci_device_t devices[PCI_MAX_DEVICES];
+static u32 nr_devices = 0;
+static pci_driver_t* drivers = NULL;
+static u8 pci_log;
+
+// --- Yapılandırma Alanı ---
+// Adres/veri port çifti tek bir erişimde kullanılmalı; arada kesme gelip
+// başka bir adres yazarsa okunan değer yanlış fonksiyona ait olur.
+
+static inline u32 pci_address(u8 bus, u8 dev, u8 func, u8 offset) {
+    return 0x80000000u | ((u32)bus << 16) | ((u32)dev << 11) | ((u32)func << 8) | (offset & 0xFC);
+}
+
+static u32 pci_config_read(u8 bus, u8 dev, u8 func, u8 offset) {
+    u32 flags = irq_save();
+    outl(PCI_CONFIG_ADDRESS, pci_address(bus, dev, func, offset));
+    u32 value = inl(PCI_CONFIG_DATA);
+    irq_restore(flags);
+    return value;
+}
+
+static void pci_config_write(u8 bus, u8 dev, u8 func, u8 offset, u32 value) {
+    u32 flags = irq_save();
+    outl(PCI_CONFIG_ADDRESS, pci_address(bus, dev, func, offset));
+    outl(PCI_CONFIG_DATA, value);
+    irq_restore(flags);
+}
+
+u32 pci_read32(const pci_device_t* dev, u8 offset) {
+    return pci_config_read(dev->bus, dev->dev, dev->func, offset);
+}
+
+u16 pci_read16(const pci_device_t* dev, u8 offset) {
+    return (u16)(pci_read32(dev, offset) >> ((offset & 2) * 8));
+}
+
+u8 pci_read8(const pci_device_t* dev, u8 offset) {
+    return (u8)(pci_read32(dev, offset) >> ((offset & 3) * 8));
+}
+
+void pci_write32(const pci_device_t* dev, u8 offset, u32 value) {
+    pci_config_write(dev->bus, dev->dev, dev->func, offset, value);
+}
+
+// Dar yazmalar oku-değiştir-yaz ile yapılır; status gibi "1 yazınca
+// temizlenen" bitler içeren dword'lere dikkat
+void pci_write16(const pci_device_t* dev, u8 offset, u16 value) {
+    u32 shift = (offset & 2) * 8;
+    u32 old = pci_read32(dev, offset);
+    pci_write32(dev, offset, (old & ~(0xFFFFu << shift)) | ((u32)value << shift));
+}
+
+void pci_write8(const pci_device_t* dev, u8 offset, u8 value) {
+    u32 shift = (offset & 3) * 8;
+    u32 old = pci_read32(dev, offset);
+    pci_write32(dev, offset, (old & ~(0xFFu << shift)) | ((u32)value << shift));
+}
+
+void pci_enable_device(pci_device_t* dev) {
+    // Status dword'ün üst yarısında: sadece command'ı yaz, status'a 0 gider
+    u32 cmd = pci_read32(dev, PCI_COMMAND) & 0xFFFF;
+    cmd |= PCI_CMD_BUS_MASTER;
+    for (int i = 0; i < PCI_MAX_BARS; i++) {
+        if (!dev->bars[i].base) continue;
+        cmd |= (dev->bars[i].flags & PCI_BAR_IO) ? PCI_CMD_IO : PCI_CMD_MEMORY;
+    }
+    pci_write32(dev, PCI_COMMAND, cmd);
+}
+
+u8 pci_find_capability(const pci_device_t* dev, u8 cap_id, u8 after) {
+    for (u32 i = 0; i < dev->nr_caps; i++) {
+        if (dev->cap_ids[i] == cap_id && dev->cap_offsets[i] > after) return dev->cap_offsets[i];
+    }
+    return 0;
+}
+
+// --- Aygıt Çözümleme ---
+
+// BAR boyutu: çözümleme kapalıyken tüm bitler yazılır, aygıtın sıfırda
+// tuttuğu alt bitler boyutu verir
+static u32 pci_bar_probe(pci_device_t* d, u8 offset, u32 original, u32 type_mask) {
+    pci_write32(d, offset, 0xFFFFFFFFu);
+    u32 mask = pci_read32(d, offset);
+    pci_write32(d, offset, original);
+    return mask & ~type_mask;
+}
+
+static void pci_decode_bars(pci_device_t* d) {
+    int count = d->header_type == 0 ? 6 : (d->header_type == 1 ? 2 : 0);
+
+    // Boyutlandırma sırasında yanlış adrese çözümleme olmasın. Host köprüsü
+    // hariç: onun bellek çözümlemesini kapatmak RAM erişimini kesebilir.
+    u32 cmd = pci_read32(d, PCI_COMMAND) & 0xFFFF;
+    int host_bridge = d->class_code == 0x06 && d->subclass == 0x00;
+    if (!host_bridge) pci_write32(d, PCI_COMMAND, cmd & ~(PCI_CMD_IO | PCI_CMD_MEMORY));
+
+    for (int i = 0; i < count; i++) {
+        u8 offset = PCI_BAR0 + i * 4;
+        u32 value = pci_read32(d, offset);
+        pci_bar_t* bar = &d->bars[i];
+
+        if (value & 1) {
+            u32 mask = pci_bar_probe(d, offset, value, 0x3) & 0xFFFF;
+            bar->flags = PCI_BAR_IO;
+            bar->base = value & ~0x3u;
+            bar->size = mask ? (~mask & 0xFFFF) + 1 : 0;
+            continue;
+        }
+
+        u32 type = (value >> 1) & 0x3;
+        u32 mask = pci_bar_probe(d, offset, value, 0xF);
+        bar->flags = (value & 0x8) ? PCI_BAR_PREFETCH : 0;
+        bar->base = value & ~0xFu;
+        bar->size = mask ? ~mask + 1 : 0;
+        if (type == 2 && i + 1 < count) {
+            // 64 bit: üst yarı sonraki BAR'dadır; 4 GB'tan büyük BAR desteklenmez
+            u32 high = pci_read32(d, offset + 4);
+            bar->flags |= PCI_BAR_MEM64;
+            bar->base |= (u64)high << 32;
+            i++;
+        }
+    }
+    if (!host_bridge) pci_write32(d, PCI_COMMAND, cmd);
+
+    for (int i = 0; i < PCI_MAX_BARS; i++) {
+        if (!d->bars[i].size) d->bars[i].base = 0;
+    }
+}
+
+static void pci_decode_caps(pci_device_t* d) {
+    if (!(pci_read16(d, PCI_STATUS) & PCI_STATUS_CAP_LIST)) return;
+
+    u8 offset = pci_read8(d, PCI_CAP_PTR) & 0xFC;
+    // Bozuk bir liste döngü oluşturabilir: en fazla 48 yetenek sığar
+    for (int guard = 0; offset >= 0x40 && guard < 48; guard++) {
+        u32 header = pci_read32(d, offset);
+        u8 id = header & 0xFF;
+        if (d->nr_caps < PCI_MAX_CAPS) {
+            d->cap_ids[d->nr_caps] = id;
+            d->cap_offsets[d->nr_caps] = offset;
+            d->nr_caps++;
+        }
+
+        u16 control = header >> 16;
+        if (id == PCI_CAP_MSI) {
+            d->msi_vectors = 1 << ((control >> 1) & 0x7);
+            d->msi_64bit = (control >> 7) & 1;
+        } else if (id == PCI_CAP_MSIX) {
+            d->msix_vectors = (control & 0x7FF) + 1;
+        }
+        offset = (header >> 8) & 0xFC;
+    }
+}
+
+static void pci_scan_bus(u8 bus, u32* visited);
+
+static void pci_scan_function(u8 bus, u8 dev, u8 func, u32* visited) {
+    u32 id = pci_config_read(bus, dev, func, PCI_VENDOR_ID);
+    if ((id & 0xFFFF) == 0xFFFF) return;
+    if (nr_devices == PCI_MAX_DEVICES) {
+        KLOG(LOG_LEVEL_WARN, pci_log, "device table full, %02x:%02x.%u ignored", bus, dev, func);
+        return;
+    }
+
+    pci_device_t* d = &devices[nr_devices++];
+    memset(d, 0, sizeof(*d));
+    d->bus = bus;
+    d->dev = dev;
+    d->func = func;
+    d->vendor_id = id & 0xFFFF;
+    d->device_id = id >> 16;
+
+    u32 class = pci_read32(d, PCI_REVISION);
+    d->revision = class & 0xFF;
+    d->prog_if = (class >> 8) & 0xFF;
+    d->subclass = (class >> 16) & 0xFF;
+    d->class_code = class >> 24;
+    d->header_type = pci_read8(d, PCI_HEADER_TYPE) & 0x7F;
+
+    u32 irq = pci_read32(d, PCI_IRQ_LINE);
+    d->irq_line = irq & 0xFF;
+    d->irq_pin = (irq >> 8) & 0xFF;
+    if (d->header_type == 0) {
+        u32 subsys = pci_read32(d, PCI_SUBSYS_VENDOR);
+        d->subsys_vendor = subsys & 0xFFFF;
+        d->subsys_id = subsys >> 16;
+    }
+
+    pci_decode_bars(d);
+    pci_decode_caps(d);
+
+    // PCI-PCI köprüsü: arkasındaki veriyolunu da tara
+    if (d->header_type == 1) {
+        u8 secondary = pci_read8(d, PCI_SECONDARY_BUS);
+        if (secondary && !(visited[secondary / 32] & (1u << (secondary % 32)))) {
+            pci_scan_bus(secondary, visited);
+        }
+    }
+}
+
+static void pci_scan_bus(u8 bus, u32* visited) {
+    visited[bus / 32] |= 1u << (bus % 32);
+    for (u8 dev = 0; dev < 32; dev++) {
+        u32 id = pci_config_read(bus, dev, 0, PCI_VENDOR_ID);
+        if ((id & 0xFFFF) == 0xFFFF) continue;
+        pci_scan_function(bus, dev, 0, visited);
+
+        // Çok fonksiyonlu aygıtların diğer fonksiyonları
+        if (pci_config_read(bus, dev, 0, PCI_HEADER_TYPE & 0xFC) & (0x80 << 16)) {
+            for (u8 func = 1; func < 8; func++) pci_scan_function(bus, dev, func, visited);
+        }
+    }
+}
+
+int pci_init() {
+    u32 visited[256 / 32];
+    memset(visited, 0, sizeof(visited));
+    pci_log = klog_component_id("PCI");
+    nr_devices = 0;
+
+    pci_scan_bus(0, visited);
+    // Birden çok host köprüsü: 0:0.N, N numaralı veriyolunun köküdür
+    if (pci_config_read(0, 0, 0, PCI_HEADER_TYPE & 0xFC) & (0x80 << 16)) {
+        for (u8 func = 1; func < 8; func++) {
+            u32 id = pci_config_read(0, 0, func, PCI_VENDOR_ID);
+            if ((id & 0xFFFF) == 0xFFFF || (visited[0] & (1u << func))) continue;
+            pci_scan_bus(func, visited);
+        }
+    }
+
+    KLOG(LOG_LEVEL_INFO, pci_log, "%u functions found", nr_devices);
+    return (int)nr_devices;
+}
+
+u32 pci_device_count() {
+    return nr_devices;
+}
+
+pci_device_t* pci_get_device(u32 index) {
+    return index < nr_devices ? &devices[index] : NULL;
+}
+
+pci_device_t* pci_find_device(u16 vendor_id, u16 device_id) {
+    for (u32 i = 0; i < nr_devices; i++) {
+        if (devices[i].vendor_id == vendor_id && devices[i].device_id == device_id) return &devices[i];
+    }
+    return NULL;
+}
+
+// --- Sürücü Eşleştirme ---
+
+static const pci_device_id_t* pci_match(const pci_driver_t* drv, const pci_device_t* d) {
+    for (const pci_device_id_t* id = drv->id_table; id->vendor_id; id++) {
+        if (id->vendor_id != PCI_ANY_ID && id->vendor_id != d->vendor_id) continue;
+        if (id->device_id != PCI_ANY_ID && id->device_id != d->device_id) continue;
+        if (id->class_id != PCI_ANY_ID && id->class_id != ((d->class_code << 8) | d->subclass)) continue;
+        return id;
+    }
+    return NULL;
+}
+
+int pci_register_driver(pci_driver_t* drv) {
+    drv->next = drivers;
+    drivers = drv;
+
+    int bound = 0;
+    for (u32 i = 0; i < nr_devices; i++) {
+        pci_device_t* d = &devices[i];
+        if (d->driver) continue;
+        const pci_device_id_t* id = pci_match(drv, d);
+        if (!id || drv->probe(d, id) != 0) continue;
+        d->driver = drv;
+        bound++;
+    }
+    return bound;
+}
+
+// --- İsimler ---
+
+const char* pci_class_name(u8 class_code, u8 subclass) {
+    switch (class_code) {
+    case 0x00: return "Unclassified device";
+    case 0x01:
+        switch (subclass) {
+        case 0x00: return "SCSI storage controller";
+        case 0x01: return "IDE interface";
+        case 0x05: return "ATA controller";
+        case 0x06: return "SATA controller";
+        case 0x08: return "Non-Volatile memory controller";
+        default:   return "Mass storage controller";
+        }
+    case 0x02: return subclass == 0x00 ? "Ethernet controller" : "Network controller";
+    case 0x03: return subclass == 0x00 ? "VGA compatible controller" : "Display controller";
+    case 0x04: return "Multimedia controller";
+    case 0x05: return "Memory controller";
+    case 0x06:
+        switch (subclass) {
+        case 0x00: return "Host bridge";
+        case 0x01: return "ISA bridge";
+        case 0x04: return "PCI bridge";
+        case 0x80: return "Bridge";
+        default:   return "Bridge device";
+        }
+    case 0x07: return "Communication controller";
+    case 0x08: return "System peripheral";
+    case 0x09: return "Input device controller";
+    case 0x0C: return subclass == 0x03 ? "USB controller" : "Serial bus controller";
+    case 0x0D: return "Wireless controller";
+    case 0x10: return "Encryption controller";
+    case 0x11: return "Signal processing controller";
+    case 0xFF: return "Unassigned class";
+    default:   return "Unknown device";
+    }
+}
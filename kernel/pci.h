@@ -0,0 +1,140 @@
+#ifndef PCI_H
+#define PCI_H
+
+#include "utils.h"
+
+// --- PCI Alt Sistemi ---
+// Yapılandırma alanına mekanizma #1 (0xCF8 adres, 0xCFC veri portu) ile
+// erişilir. pci_init 0. veriyolundan başlayıp PCI-PCI köprülerinin ikincil
+// veriyollarına inerek bütün aygıt ve fonksiyonları tarar; her fonksiyon
+// için BAR'lar (taban, boyut, tür) ve yetenek listesi (MSI, MSI-X, PCIe...)
+// çözülüp aygıt tablosuna yazılır.
+//
+// Sürücüler pci_register_driver ile (üretici, aygıt, sınıf) eşleşme
+// tablosunu verir; eşleşen ve henüz sahipsiz her aygıt için probe çağrılır.
+
+#define PCI_CONFIG_ADDRESS 0xCF8
+#define PCI_CONFIG_DATA    0xCFC
+
+#define PCI_MAX_DEVICES 64
+#define PCI_MAX_BARS    6
+#define PCI_MAX_CAPS    8
+
+// Yapılandırma alanı ofsetleri (tip 0 başlık)
+#define PCI_VENDOR_ID      0x00
+#define PCI_DEVICE_ID      0x02
+#define PCI_COMMAND        0x04
+#define PCI_STATUS         0x06
+#define PCI_REVISION       0x08
+#define PCI_PROG_IF        0x09
+#define PCI_SUBCLASS       0x0A
+#define PCI_CLASS          0x0B
+#define PCI_HEADER_TYPE    0x0E
+#define PCI_BAR0           0x10
+#define PCI_SECONDARY_BUS  0x19 // Tip 1 (köprü) başlık
+#define PCI_SUBSYS_VENDOR  0x2C
+#define PCI_SUBSYS_ID      0x2E
+#define PCI_CAP_PTR        0x34
+#define PCI_IRQ_LINE       0x3C
+#define PCI_IRQ_PIN        0x3D
+
+#define PCI_CMD_IO          0x0001
+#define PCI_CMD_MEMORY      0x0002
+#define PCI_CMD_BUS_MASTER  0x0004
+#define PCI_CMD_INTX_OFF    0x0400
+#define PCI_STATUS_CAP_LIST 0x0010
+
+// Yetenek kimlikleri
+#define PCI_CAP_PM      0x01
+#define PCI_CAP_MSI     0x05
+#define PCI_CAP_VENDOR  0x09
+#define PCI_CAP_PCIE    0x10
+#define PCI_CAP_MSIX    0x11
+
+// pci_bar_t.flags
+#define PCI_BAR_IO       0x01
+#define PCI_BAR_MEM64    0x02
+#define PCI_BAR_PREFETCH 0x04
+
+#define PCI_ANY_ID 0xFFFF
+
+typedef struct {
+    u64 base;               // G/Ç portu ya da fiziksel adres; 0: BAR yok
+    u32 size;
+    u8  flags;
+} pci_bar_t;
+
+struct pci_driver;
+
+typedef struct pci_device {
+    u8  bus, dev, func;
+    u8  header_type;        // Çok fonksiyon biti temizlenmiş
+    u16 vendor_id;
+    u16 device_id;
+    u16 subsys_vendor;
+    u16 subsys_id;
+    u8  class_code;
+    u8  subclass;
+    u8  prog_if;
+    u8  revision;
+    u8  irq_line;           // BIOS'un atadığı IRQ (0xFF: yok)
+    u8  irq_pin;            // 1 = INTA# ... 0: kesme kullanmıyor
+    pci_bar_t bars[PCI_MAX_BARS];
+
+    u8  cap_ids[PCI_MAX_CAPS];  // Bulunan yetenekler, listedeki sırayla
+    u8  cap_offsets[PCI_MAX_CAPS];
+    u8  nr_caps;
+    u8  msi_vectors;        // MSI: desteklenen vektör sayısı (0: MSI yok)
+    u8  msi_64bit;
+    u16 msix_vectors;       // MSI-X tablo boyutu (0: MSI-X yok)
+
+    struct pci_driver* driver;
+    void* driver_data;
+} pci_device_t;
+
+typedef struct {
+    u16 vendor_id;          // PCI_ANY_ID: her üretici
+    u16 device_id;          // PCI_ANY_ID: her aygıt
+    u16 class_id;           // (sınıf << 8) | alt sınıf; PCI_ANY_ID: her sınıf
+} pci_device_id_t;
+
+typedef struct pci_driver {
+    const char* name;
+    const pci_device_id_t* id_table; // vendor_id == 0 ile biter
+    // 0 dönerse aygıt bu sürücüye bağlanır
+    int (*probe)(pci_device_t* dev, const pci_device_id_t* id);
+    struct pci_driver* next;
+} pci_driver_t;
+
+// Veriyollarını tarar ve aygıt tablosunu doldurur. Bulunan fonksiyon sayısını döner.
+int pci_init();
+
+u32 pci_device_count();
+pci_device_t* pci_get_device(u32 index);
+pci_device_t* pci_find_device(u16 vendor_id, u16 device_id);
+
+/**
+ * @brief Sürücüyü kaydeder ve tablodaki eşleşen, sahipsiz aygıtlar için
+ *        probe'u çağırır.
+ * @return Sürücüye bağlanan aygıt sayısı.
+ */
+int pci_register_driver(pci_driver_t* drv);
+
+u32 pci_read32(const pci_device_t* dev, u8 offset);
+u16 pci_read16(const pci_device_t* dev, u8 offset);
+u8  pci_read8(const pci_device_t* dev, u8 offset);
+void pci_write32(const pci_device_t* dev, u8 offset, u32 value);
+void pci_write16(const pci_device_t* dev, u8 offset, u16 value);
+void pci_write8(const pci_device_t* dev, u8 offset, u8 value);
+
+// G/Ç ve bellek çözümlemesini ve bus-mastering'i (DMA) açar
+void pci_enable_device(pci_device_t* dev);
+
+// Yeteneğin yapılandırma alanındaki ofseti; yoksa 0. `after` 0 değilse o
+// ofsetten sonrakiler aranır (aynı kimlikten birden çok yetenek için).
+u8 pci_find_capability(const pci_device_t* dev, u8 cap_id, u8 after);
+
+// "Mass storage", "IDE controller" gibi okunabilir sınıf adı
+const char* pci_class_name(u8 class_code, u8 subclass);
+
+#endif
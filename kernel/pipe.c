@@ -0,0 +1,167 @@
+#include "pipe.h"
+#include "epoll.h"
+#include "slab.h"
+#include "pmm.h"
+#include "io.h"
+#include "string.h"
+
+static slab_cache_t pipe_cache = SLAB_CACHE_INIT("pipe", sizeof(pipe_t));
+
+static int pipe_readable(void* arg) {
+    pipe_t* p = (pipe_t*)arg;
+    return p->count || !p->writers;
+}
+
+static int pipe_writable(void* arg) {
+    pipe_t* p = (pipe_t*)arg;
+    return p->count < PIPE_SIZE || !p->readers;
+}
+
+static size_t pipe_read(vfs_node_t* node, u32 offset, size_t size, u8* buffer) {
+    pipe_t* p = (pipe_t*)node->internal_data;
+    if (!size) return 0;
+
+    u32 flags = irq_save();
+    waitq_wait_event(&p->read_wq, pipe_readable, p);
+    size_t n = 0;
+    while (n < size && p->count) {
+        // Halkanın sonuna kadar olan parça, sonra baştan devam
+        u32 chunk = PIPE_SIZE - p->head;
+        if (chunk > p->count) chunk = p->count;
+        if (chunk > size - n) chunk = size - n;
+        memcpy(buffer + n, p->buf + p->head, chunk);
+        p->head = (p->head + chunk) % PIPE_SIZE;
+        p->count -= chunk;
+        n += chunk;
+    }
+    irq_restore(flags);
+
+    if (n) waitq_wake_all(&p->write_wq, POLL_KEY(EPOLLOUT));
+    return n;
+}
+
+static size_t pipe_write(vfs_node_t* node, u32 offset, size_t size, const u8* buffer) {
+    pipe_t* p = (pipe_t*)node->internal_data;
+    size_t done = 0;
+
+    while (done < size) {
+        u32 flags = irq_save();
+        waitq_wait_event(&p->write_wq, pipe_writable, p);
+        if (!p->readers) {
+            irq_restore(flags);
+            return done ? done : (size_t)-1;
+        }
+        while (done < size && p->count < PIPE_SIZE) {
+            u32 tail = (p->head + p->count) % PIPE_SIZE;
+            // Boş alanın bitişik kısmı: halkanın sonuna ya da ilk okunmamış byte'a kadar
+            u32 chunk = tail >= p->head ? PIPE_SIZE - tail : p->head - tail;
+            if (chunk > size - done) chunk = size - done;
+            memcpy(p->buf + tail, buffer + done, chunk);
+            p->count += chunk;
+            done += chunk;
+        }
+        irq_restore(flags);
+        waitq_wake_all(&p->read_wq, POLL_KEY(EPOLLIN));
+    }
+    return done;
+}
+
+static u32 pipe_poll_read(vfs_node_t* node, poll_table_t* pt) {
+    pipe_t* p = (pipe_t*)node->internal_data;
+    poll_wait(&p->read_wq, pt);
+    u32 mask = 0;
+    if (p->count) mask |= EPOLLIN;
+    if (!p->writers) mask |= EPOLLHUP;
+    return mask;
+}
+
+static u32 pipe_poll_write(vfs_node_t* node, poll_table_t* pt) {
+    pipe_t* p = (pipe_t*)node->internal_data;
+    poll_wait(&p->write_wq, pt);
+    u32 mask = 0;
+    if (p->count < PIPE_SIZE) mask |= EPOLLOUT;
+    if (!p->readers) mask |= EPOLLERR;
+    return mask;
+}
+
+// Uçlardan biri kapanınca karşı taraf uyanır (dosya sonu / EPIPE görür);
+// ikisi de kapanınca boru serbest kalır
+static int pipe_close(vfs_node_t* node) {
+    pipe_t* p = (pipe_t*)node->internal_data;
+    int reader = node == &p->read_node;
+
+    u32 flags = irq_save();
+    if (reader) p->readers = 0;
+    else p->writers = 0;
+    int last = !p->readers && !p->writers;
+    irq_restore(flags);
+
+    if (last) {
+        pmm_free_page(p->buf);
+        slab_free(&pipe_cache, p);
+    } else {
+        if (reader) waitq_wake_all(&p->write_wq, POLL_KEY(EPOLLERR));
+        else waitq_wake_all(&p->read_wq, POLL_KEY(EPOLLHUP));
+    }
+    return 0;
+}
+
+static void pipe_node_init(pipe_t* p, vfs_node_t* node, const char* name) {
+    strlcpy(node->name, name, sizeof(node->name));
+    node->type = FS_NODE_DEVICE;
+    node->close = pipe_close;
+    node->internal_data = p;
+}
+
+int pipe_create(file_t** read_end, file_t** write_end) {
+    pipe_t* p = (pipe_t*)slab_alloc(&pipe_cache);
+    if (!p) return -1;
+    p->buf = (u8*)pmm_alloc_page();
+    if (!p->buf) {
+        slab_free(&pipe_cache, p);
+        return -1;
+    }
+    pipe_node_init(p, &p->read_node, "pipe:r");
+    pipe_node_init(p, &p->write_node, "pipe:w");
+    p->read_node.read = pipe_read;
+    p->write_node.write = pipe_write;
+    p->read_node.poll = pipe_poll_read;
+    p->write_node.poll = pipe_poll_write;
+
+    file_t* r = file_alloc(&p->read_node, O_RDONLY);
+    file_t* w = file_alloc(&p->write_node, O_WRONLY);
+    if (!r || !w) {
+        // Açılmamış uçların close'u çağrılmamalı: file_t'ler elle bırakılır
+        if (r) { r->node = NULL; file_put(r); }
+        if (w) { w->node = NULL; file_put(w); }
+        pmm_free_page(p->buf);
+        slab_free(&pipe_cache, p);
+        return -1;
+    }
+    p->readers = 1;
+    p->writers = 1;
+    *read_end = r;
+    *write_end = w;
+    return 0;
+}
+
+u32 sys_pipe(u32 fds_ptr, ...) {
+    int* fds = (int*)fds_ptr;
+    fd_table_t* table = fdtable_current();
+    file_t *r, *w;
+    if (!fds || !table || pipe_create(&r, &w) < 0) return (u32)-1;
+
+    fds[0] = fd_install(table, r);
+    if (fds[0] < 0) {
+        file_put(r);
+        file_put(w);
+        return (u32)-1;
+    }
+    fds[1] = fd_install(table, w);
+    if (fds[1] < 0) {
+        fd_close(table, fds[0]);
+        file_put(w);
+        return (u32)-1;
+    }
+    return 0;
+}
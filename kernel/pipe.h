@@ -0,0 +1,53 @@
+#ifndef PIPE_H
+#define PIPE_H
+
+#include "utils.h"
+#include "vfs.h"
+#include "waitq.h"
+#include "fdtable.h"
+
+// --- Borular (Pipes) ---
+// Tek yönlü, sınırlı bir byte akışı: yazan uçtan girenler okuyan uçtan aynı
+// sırayla çıkar. Veri bir sayfalık halka tamponda durur; üretici tüketiciden
+// hızlıysa tampon dolunca uyur, yani boru hattı ne kadar veri akarsa aksın
+// bellek kullanımı sabittir.
+//
+//  * Okuma, tampon boşsa en az bir byte gelene kadar bekler ve o an mevcut
+//    olanı döner (tamponu doldurmayı beklemez). Yazan uç kapandıysa ve tampon
+//    boşsa 0 (dosya sonu) döner.
+//  * Yazma, verinin tamamı tampona geçene kadar gerektiği kadar bekler.
+//    Okuyan uç kapandıysa (size_t)-1 döner (EPIPE); o ana kadar bir kısmı
+//    yazıldıysa yazılan byte sayısı döner.
+//
+// Okuyan uç veri varken EPOLLIN, yazan uç kapanınca EPOLLHUP; yazan uç boş
+// yer varken EPOLLOUT, okuyan uç kapanınca EPOLLERR bildirir (epoll.h).
+//
+// Her uç bir vfs_node_t'dir ve bir file_t ile açılır; dup/fork ile paylaşılan
+// uç, son file_t kapanınca kapanır.
+
+#define PIPE_SIZE PAGE_SIZE
+
+typedef struct pipe {
+    u8* buf;
+    u32 head;               // İlk okunmamış byte
+    u32 count;              // Tampondaki byte sayısı
+    u8 readers;             // Okuyan uç açık mı
+    u8 writers;             // Yazan uç açık mı
+    wait_queue_t read_wq;   // Veri ya da dosya sonu bekleyenler
+    wait_queue_t write_wq;  // Boş yer bekleyenler
+    vfs_node_t read_node;
+    vfs_node_t write_node;
+} pipe_t;
+
+/**
+ * @brief Yeni bir boru oluşturur.
+ * @param read_end Okuyan ucun açık dosyası (O_RDONLY).
+ * @param write_end Yazan ucun açık dosyası (O_WRONLY).
+ * @return Başarılıysa 0; bellek yoksa -1.
+ */
+int pipe_create(file_t** read_end, file_t** write_end);
+
+// Syscall arayüzü: fds_ptr'deki int[2]'ye okuyan ve yazan ucun fd'lerini yazar
+u32 sys_pipe(u32 fds_ptr, ...);
+
+#endif
@@ -2,6 +2,8 @@
 #include "pmm.h"
 #include "utils.h"
 #include "vga.h" // Hata mesajları için
+#include "memory.h"
+#include "io.h"
 
 // Linker script'ten gelen `end` sembolü
 extern u32 end;
@@ -11,6 +13,21 @@ static u32 pmm_memory_end = 0;
 static u32 pmm_current_break = 0;
 static u32 pmm_start_addr = 0;
 
+// Serbest bırakılan sayfalar kendi ilk word'lerinde bir sonrakini gösteren
+// tek yönlü bir listede (intrusive free list) tutulur; ek bellek gerekmez.
+// Liste, break ve referans sayaçları kesme handler'larından da değiştiği
+// için irq_save altında güncellenir.
+static void* pmm_free_list = 0;
+static u32 pmm_free_count = 0;
+
+// Sayfa başına referans sayacı (pmm_start_addr'dan itibaren çerçeve numarasıyla)
+static u16* pmm_refcounts = 0;
+static u32 pmm_nr_frames = 0;
+
+static pmm_shrinker_t pmm_shrinkers[PMM_MAX_SHRINKERS];
+static u32 pmm_shrinker_count = 0;
+static int pmm_shrinking = 0; // Shrinker içinden gelen tahsis tekrar shrink etmesin
+
 void init_pmm(multiboot_info_t* mbd) {
     // Multiboot yapısında mmap bayrağı set edilmiş mi kontrol et
     if (!(mbd->flags & MBOOT_FLAG_MMAP)) {
@@ -45,6 +62,9 @@ void init_pmm(multiboot_info_t* mbd) {
 
     // Belleğin sonunu belirle
     pmm_memory_end = (u32)best_region_base + (u32)best_region_len;
+    if (best_region_base + best_region_len > PMM_MAX_ADDR) {
+        pmm_memory_end = PMM_MAX_ADDR;
+    }
 
     if (pmm_current_break >= pmm_memory_end) {
         panic("Not enough memory to start PMM!");
@@ -52,10 +72,88 @@ void init_pmm(multiboot_info_t* mbd) {
 
     // Kaydet: başlangıç adresi (kullanılan bellek hesabı için)
     pmm_start_addr = pmm_current_break;
+
+    // Boot modülleri (initrd) genelde çekirdeğin hemen arkasına yüklenir;
+    // bump allocator onları dağıtmasın. Artan adres sırasıyla ayrılmalılar.
+    if (mbd->flags & MBOOT_FLAG_MODS) {
+        multiboot_module_t* mods = (multiboot_module_t*)mbd->mods_addr;
+        u32 last = 0;
+        for (u32 n = 0; n < mbd->mods_count; n++) {
+            // Henüz ayrılmamış, en düşük adresli modülü seç
+            multiboot_module_t* next = 0;
+            for (u32 i = 0; i < mbd->mods_count; i++) {
+                if ((n == 0 || mods[i].mod_start > last) &&
+                    (!next || mods[i].mod_start < next->mod_start)) {
+                    next = &mods[i];
+                }
+            }
+            if (!next) break;
+            pmm_reserve_region(next->mod_start, next->mod_end - next->mod_start);
+            last = next->mod_start;
+        }
+    }
+
+    // Referans sayaçları bölgenin başına yerleşir; modüller ayrıldıktan sonra
+    pmm_nr_frames = (pmm_memory_end - pmm_start_addr) / PAGE_SIZE;
+    u32 ref_pages = (pmm_nr_frames * sizeof(u16) + PAGE_SIZE - 1) / PAGE_SIZE;
+    u8* refs = (u8*)pmm_alloc_contiguous(ref_pages);
+    if (!refs) panic("Not enough memory for page reference counts!");
+    for (u32 i = 0; i < ref_pages; i++) zero_page(refs + i * PAGE_SIZE);
+    pmm_refcounts = (u16*)refs;
 }
 
-// Bump allocator mantığı
-void* pmm_alloc_page() {
+static inline u16* pmm_ref(void* p) {
+    u32 addr = (u32)p;
+    if (!pmm_refcounts || addr < pmm_start_addr || addr >= pmm_memory_end) return 0;
+    return &pmm_refcounts[(addr - pmm_start_addr) / PAGE_SIZE];
+}
+
+void pmm_reserve_region(u32 base, u32 length) {
+    u32 start = base & ~(PAGE_SIZE - 1);
+    u32 end = (base + length + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    if (end <= pmm_current_break || start >= pmm_memory_end) return;
+
+    // Break ile bölge arasındaki sayfalar boş kalır: serbest listeye ekle
+    for (u32 p = pmm_current_break; p < start; p += PAGE_SIZE) {
+        pmm_free_page((void*)p);
+    }
+    pmm_current_break = end;
+}
+
+void pmm_register_shrinker(pmm_shrinker_t shrinker) {
+    if (pmm_shrinker_count < PMM_MAX_SHRINKERS) {
+        pmm_shrinkers[pmm_shrinker_count++] = shrinker;
+    }
+}
+
+u32 pmm_get_free_pages() {
+    return pmm_free_count + (pmm_memory_end - pmm_current_break) / PAGE_SIZE;
+}
+
+// Önbelleklerden biraz sayfa geri iste; en az bir sayfa geldiyse 1
+static int pmm_shrink(u32 want) {
+    u32 flags = irq_save();
+    int busy = pmm_shrinking;
+    pmm_shrinking = 1;
+    irq_restore(flags);
+    if (busy) return 0;
+
+    u32 freed = 0;
+    for (u32 i = 0; i < pmm_shrinker_count && freed < want; i++) {
+        freed += pmm_shrinkers[i](want - freed);
+    }
+    pmm_shrinking = 0;
+    return freed != 0;
+}
+
+static void* pmm_take_page() {
+    if (pmm_free_list) {
+        void* page = pmm_free_list;
+        pmm_free_list = *(void**)page;
+        pmm_free_count--;
+        return page;
+    }
+
     if (pmm_current_break + PAGE_SIZE > pmm_memory_end) {
         // Bellek tükendi!
         return 0; 
@@ -66,16 +164,81 @@ void* pmm_alloc_page() {
     return allocated_page;
 }
 
-// Basit bir bump allocator'da 'free' işlemi yoktur.
-// Şimdilik bu fonksiyon hiçbir şey yapmaz.
+static void* pmm_take_page_ref() {
+    u32 flags = irq_save();
+    void* page = pmm_take_page();
+    u16* ref = pmm_ref(page);
+    if (ref) *ref = 1;
+    irq_restore(flags);
+    return page;
+}
+
+// Önce serbest listeden, o boşsa bump allocator'dan; ikisi de boşsa shrinker'lar
+void* pmm_alloc_page() {
+    void* page = pmm_take_page_ref();
+    if (!page && pmm_shrink(32)) page = pmm_take_page_ref();
+    return page;
+}
+
+void* pmm_alloc_zeroed_page() {
+    void* page = pmm_alloc_page();
+    if (page) {
+        zero_page(page);
+    }
+    return page;
+}
+
+void* pmm_alloc_contiguous(u32 count) {
+    u32 flags = irq_save();
+    if (!count || count > (pmm_memory_end - pmm_current_break) / PAGE_SIZE) {
+        irq_restore(flags);
+        return 0;
+    }
+    void* base = (void*)pmm_current_break;
+    pmm_current_break += count * PAGE_SIZE;
+    for (u32 i = 0; i < count; i++) {
+        u16* ref = pmm_ref((u8*)base + i * PAGE_SIZE);
+        if (ref) *ref = 1;
+    }
+    irq_restore(flags);
+    return base;
+}
+
+void pmm_page_get(void* p) {
+    u32 flags = irq_save();
+    u16* ref = pmm_ref(p);
+    if (ref && *ref < 0xFFFF) (*ref)++;
+    irq_restore(flags);
+}
+
+u32 pmm_page_refcount(void* p) {
+    u16* ref = pmm_ref(p);
+    return ref ? *ref : 0;
+}
+
 void pmm_free_page(void* p) {
-    // No-op
+    if (!p) return;
+    u32 flags = irq_save();
+    u16* ref = pmm_ref(p);
+    if (ref) {
+        // Paylaşılan çerçeve: yalnızca bu sahibin referansı düşer
+        if (*ref > 1) {
+            (*ref)--;
+            irq_restore(flags);
+            return;
+        }
+        *ref = 0;
+    }
+    *(void**)p = pmm_free_list;
+    pmm_free_list = p;
+    pmm_free_count++;
+    irq_restore(flags);
 }
 
 // Basit wrapper'lar: shell'in beklediği isimlerle uyum sağlamak için
 u32 pmm_get_used_mem() {
     if (pmm_current_break < pmm_start_addr) return 0;
-    return pmm_current_break - pmm_start_addr;
+    return pmm_current_break - pmm_start_addr - pmm_free_count * PAGE_SIZE;
 }
 
 u32 pmm_get_total_mem() {
@@ -5,15 +5,65 @@
 
 #define PAGE_SIZE 4096
 
+// Çekirdek fiziksel belleğe kimlik eşlemesiyle (sanal = fiziksel) erişir.
+// Bu adresin üstü kullanıcı adres alanına ayrıldığından PMM oradan sayfa vermez.
+#define PMM_MAX_ADDR 0x40000000
+
 // PMM'yi başlatır
 void init_pmm(multiboot_info_t* mbd);
 
+/**
+ * Bir fiziksel bellek bölgesini (örn. boot modülü) tahsis edilemez yapar.
+ * Bölgeler artan adres sırasıyla ve ilk tahsisten önce verilmelidir;
+ * init_pmm multiboot modüllerini kendisi ayırır.
+ */
+void pmm_reserve_region(u32 base, u32 length);
+
 // Bir adet fiziksel sayfa (page) tahsis eder
 void* pmm_alloc_page();
 
-// Bir sayfayı serbest bırakır (bump allocator için şimdilik boş)
+// Sıfırlanmış bir fiziksel sayfa tahsis eder (zero_page ile)
+void* pmm_alloc_zeroed_page();
+
+/**
+ * `count` adet fiziksel olarak bitişik sayfa tahsis eder (DMA halkaları gibi
+ * aygıtın tek taban adresle gördüğü yapılar için). Serbest liste sayfaları
+ * dağınık olduğundan yalnızca henüz dağıtılmamış bölgeden verilir; yer yoksa 0.
+ * Sayfalar tek tek pmm_free_page ile geri verilebilir.
+ */
+void* pmm_alloc_contiguous(u32 count);
+
+// Bir sayfanın referansını bırakır; son referanssa sayfa serbest kalır ve
+// sonraki pmm_alloc_page çağrıları onu yeniden kullanır
 void pmm_free_page(void* p);
 
+// --- Çerçeve Referans Sayaçları ---
+// Tahsis edilen her sayfa tek referansla başlar. Bir çerçeveyi birden çok
+// sahip (paylaşımlı bellek nesnesi, birkaç adres alanının sayfa tablosu)
+// tuttuğunda her biri pmm_page_get ile bir referans alır ve işi bitince
+// pmm_free_page ile bırakır.
+void pmm_page_get(void* p);
+u32 pmm_page_refcount(void* p);
+
+// --- Bellek Baskısı ---
+// pmm_alloc_page boş sayfa bulamayınca kayıtlı shrinker'ları sırayla çağırır
+// ve bir kez daha dener. Shrinker en fazla `want` sayfayı pmm_free_page ile
+// geri verir ve kaç sayfa verdiğini döner; G/Ç yapmamalı, uyumamalıdır.
+typedef u32 (*pmm_shrinker_t)(u32 want);
+
+#define PMM_MAX_SHRINKERS  4
+#define PMM_LOW_WATERMARK  256 // Bunun altında boş sayfa kalınca baskı var sayılır
+
+void pmm_register_shrinker(pmm_shrinker_t shrinker);
+
+// Boş sayfa sayısı (serbest liste + henüz dağıtılmamış bölge)
+u32 pmm_get_free_pages();
+
+// Önbellekler büyümek yerine kendi sayfalarını yeniden kullanmalı mı?
+static inline int pmm_under_pressure() {
+    return pmm_get_free_pages() < PMM_LOW_WATERMARK;
+}
+
 // Shell ile uyumluluk için kullanılacak sayaç fonksiyonları
 u32 pmm_get_used_mem();
 u32 pmm_get_total_mem();
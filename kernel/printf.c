@@ -0,0 +1,359 @@
+#include "printf.h"
+#include "vga.h"
+#include "serial.h"
+#include "ksyms.h"
+
+#define FLAG_LEFT  0x01 // '-' sola yasla
+#define FLAG_ZERO  0x02 // '0' sıfırla doldur
+#define FLAG_PLUS  0x04 // '+' pozitif sayılarda da işaret
+#define FLAG_SPACE 0x08 // ' ' pozitif sayılarda boşluk
+#define FLAG_ALT   0x10 // '#' 0x / 0 öneki
+#define FLAG_UPPER 0x20 // %X
+
+// 00..99 arası tüm iki basamaklı sayılar: her adımda iki basamak üretilir
+static const char digit_pairs[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static const char hex_lower[] = "0123456789abcdef";
+static const char hex_upper[] = "0123456789ABCDEF";
+
+// Sayıyı `end`'de biten tampona sağdan sola yazar, ilk basamağın adresini döndürür.
+static char* fmt_u32_dec(u32 v, char* end) {
+    char* p = end;
+    while (v >= 100) {
+        const char* pair = &digit_pairs[(v % 100) * 2];
+        v /= 100;
+        *--p = pair[1];
+        *--p = pair[0];
+    }
+    if (v >= 10) {
+        *--p = digit_pairs[v * 2 + 1];
+        *--p = digit_pairs[v * 2];
+    } else {
+        *--p = (char)('0' + v);
+    }
+    return p;
+}
+
+static char* fmt_u64_dec(u64 v, char* end) {
+    char* p = end;
+    // 32 bite sığana kadar 10^8'lik parçalar halinde ilerle
+    while (v >> 32) {
+        u32 chunk = divmod64_32(&v, 100000000);
+        char* q = fmt_u32_dec(chunk, p);
+        while (q > p - 8) *--q = '0';
+        p -= 8;
+    }
+    return fmt_u32_dec((u32)v, p);
+}
+
+// Her adımda bir byte (iki hex basamak) üretir
+static char* fmt_hex(u64 v, char* end, const char* digits) {
+    char* p = end;
+    do {
+        u32 b = (u32)v & 0xFF;
+        v >>= 8;
+        *--p = digits[b & 0xF];
+        *--p = digits[b >> 4];
+    } while (v);
+    if (*p == '0' && p + 1 < end) p++; // Baştaki sıfır nibble'ı at
+    return p;
+}
+
+static char* fmt_oct(u64 v, char* end) {
+    char* p = end;
+    do {
+        *--p = (char)('0' + (v & 7));
+        v >>= 3;
+    } while (v);
+    return p;
+}
+
+static void emit_pad(kprintf_sink_t* sink, char c, int n) {
+    static const char spaces[16] = "                ";
+    static const char zeros[16]  = "0000000000000000";
+    const char* src = (c == '0') ? zeros : spaces;
+    while (n > 0) {
+        int chunk = n > 16 ? 16 : n;
+        sink->write(sink, src, chunk);
+        n -= chunk;
+    }
+}
+
+int kvprintf(kprintf_sink_t* sink, const char* fmt, va_list ap) {
+    int count = 0;
+    const char* f = fmt;
+
+    for (;;) {
+        // Düz metni tek parça halinde yaz
+        const char* run = f;
+        while (*f && *f != '%') f++;
+        if (f > run) {
+            sink->write(sink, run, f - run);
+            count += f - run;
+        }
+        if (*f == '\0') break;
+        const char* spec_start = f++;
+
+        // Bayraklar
+        int flags = 0;
+        for (;; f++) {
+            if (*f == '-') flags |= FLAG_LEFT;
+            else if (*f == '0') flags |= FLAG_ZERO;
+            else if (*f == '+') flags |= FLAG_PLUS;
+            else if (*f == ' ') flags |= FLAG_SPACE;
+            else if (*f == '#') flags |= FLAG_ALT;
+            else break;
+        }
+
+        // Genişlik
+        int width = 0;
+        if (*f == '*') {
+            width = va_arg(ap, int);
+            if (width < 0) { flags |= FLAG_LEFT; width = -width; }
+            f++;
+        } else {
+            while (*f >= '0' && *f <= '9') width = width * 10 + (*f++ - '0');
+        }
+
+        // Kesinlik
+        int precision = -1;
+        if (*f == '.') {
+            f++;
+            precision = 0;
+            if (*f == '*') {
+                precision = va_arg(ap, int);
+                if (precision < 0) precision = -1;
+                f++;
+            } else {
+                while (*f >= '0' && *f <= '9') precision = precision * 10 + (*f++ - '0');
+            }
+        }
+
+        // Uzunluk: 0=int, 1=hh, 2=h, 3=l, 4=ll
+        int length = 0;
+        if (*f == 'h') {
+            f++;
+            length = 2;
+            if (*f == 'h') { f++; length = 1; }
+        } else if (*f == 'l') {
+            f++;
+            length = 3;
+            if (*f == 'l') { f++; length = 4; }
+        } else if (*f == 'z' || *f == 't') {
+            f++;
+            length = 3; // size_t/ptrdiff_t i386'da long ile aynı genişlikte
+        }
+
+        char numbuf[24];
+        char* end = numbuf + sizeof(numbuf);
+        char* digits = end;
+        const char* prefix = "";
+        int prefix_len = 0;
+        char conv = *f;
+        if (conv == '\0') {
+            // Yarım kalmış belirteç: olduğu gibi yaz
+            sink->write(sink, spec_start, f - spec_start);
+            count += f - spec_start;
+            break;
+        }
+        f++;
+
+        // %pS: kod adresi "fonksiyon+0xofset" olarak (ksyms.h); sembol yoksa 0x%08x
+        if (conv == 'p' && *f == 'S') {
+            f++;
+            char sym[KSYMS_NAME_MAX];
+            int len = ksyms_format((u32)va_arg(ap, void*), sym, sizeof(sym));
+            if (len >= (int)sizeof(sym)) len = sizeof(sym) - 1;
+            int pad = width > len ? width - len : 0;
+            if (!(flags & FLAG_LEFT)) emit_pad(sink, ' ', pad);
+            sink->write(sink, sym, len);
+            if (flags & FLAG_LEFT) emit_pad(sink, ' ', pad);
+            count += len + pad;
+            continue;
+        }
+
+        switch (conv) {
+            case 'd':
+            case 'i': {
+                long long v;
+                if (length == 4)      v = va_arg(ap, long long);
+                else if (length == 3) v = va_arg(ap, long);
+                else                  v = va_arg(ap, int);
+                if (length == 1) v = (signed char)v;
+                if (length == 2) v = (short)v;
+
+                u64 uv = v < 0 ? -(u64)v : (u64)v;
+                if (precision != 0 || uv != 0) digits = fmt_u64_dec(uv, end);
+                if (v < 0)                  { prefix = "-"; prefix_len = 1; }
+                else if (flags & FLAG_PLUS) { prefix = "+"; prefix_len = 1; }
+                else if (flags & FLAG_SPACE){ prefix = " "; prefix_len = 1; }
+                break;
+            }
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+            case 'p': {
+                u64 uv;
+                if (conv == 'p') {
+                    uv = (u32)va_arg(ap, void*);
+                    flags |= FLAG_ALT;
+                    if (precision < 0) precision = sizeof(void*) * 2;
+                } else if (length == 4) {
+                    uv = va_arg(ap, unsigned long long);
+                } else if (length == 3) {
+                    uv = va_arg(ap, unsigned long);
+                } else {
+                    uv = va_arg(ap, unsigned int);
+                    if (length == 1) uv = (unsigned char)uv;
+                    if (length == 2) uv = (unsigned short)uv;
+                }
+
+                if (precision == 0 && uv == 0) {
+                    digits = end;
+                } else if (conv == 'u') {
+                    digits = fmt_u64_dec(uv, end);
+                } else if (conv == 'o') {
+                    digits = fmt_oct(uv, end);
+                    if ((flags & FLAG_ALT) && *digits != '0') { prefix = "0"; prefix_len = 1; }
+                } else {
+                    digits = fmt_hex(uv, end, conv == 'X' ? hex_upper : hex_lower);
+                    if ((flags & FLAG_ALT) && (uv != 0 || conv == 'p')) {
+                        prefix = conv == 'X' ? "0X" : "0x";
+                        prefix_len = 2;
+                    }
+                }
+                break;
+            }
+            case 'c': {
+                numbuf[0] = (char)va_arg(ap, int);
+                int pad = width > 1 ? width - 1 : 0;
+                if (!(flags & FLAG_LEFT)) emit_pad(sink, ' ', pad);
+                sink->write(sink, numbuf, 1);
+                if (flags & FLAG_LEFT) emit_pad(sink, ' ', pad);
+                count += 1 + pad;
+                continue;
+            }
+            case 's': {
+                const char* s = va_arg(ap, const char*);
+                if (!s) s = "(null)";
+                int len = 0;
+                while (s[len] && (precision < 0 || len < precision)) len++;
+                int pad = width > len ? width - len : 0;
+                if (!(flags & FLAG_LEFT)) emit_pad(sink, ' ', pad);
+                sink->write(sink, s, len);
+                if (flags & FLAG_LEFT) emit_pad(sink, ' ', pad);
+                count += len + pad;
+                continue;
+            }
+            case '%':
+                sink->write(sink, "%", 1);
+                count++;
+                continue;
+            default:
+                // Bilinmeyen belirteç: olduğu gibi yaz
+                sink->write(sink, spec_start, f - spec_start);
+                count += f - spec_start;
+                continue;
+        }
+
+        // Sayısal çıktı: [boşluk][önek][sıfırlar][basamaklar][boşluk]
+        int ndigits = end - digits;
+        int zeros = precision > ndigits ? precision - ndigits : 0;
+        int total = prefix_len + zeros + ndigits;
+        int pad = width > total ? width - total : 0;
+
+        if ((flags & FLAG_ZERO) && !(flags & FLAG_LEFT) && precision < 0) {
+            zeros += pad;
+            pad = 0;
+        }
+        if (!(flags & FLAG_LEFT)) emit_pad(sink, ' ', pad);
+        if (prefix_len) sink->write(sink, prefix, prefix_len);
+        emit_pad(sink, '0', zeros);
+        sink->write(sink, digits, ndigits);
+        if (flags & FLAG_LEFT) emit_pad(sink, ' ', pad);
+        count += prefix_len + zeros + ndigits + pad;
+    }
+
+    return count;
+}
+
+int kprintf_to(kprintf_sink_t* sink, const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    int n = kvprintf(sink, fmt, ap);
+    va_end(ap);
+    return n;
+}
+
+// --- Sink'ler ---
+
+static void vga_sink_write(kprintf_sink_t* sink, const char* s, size_t len) {
+    u8 attr = (u8)(u32)sink->ctx;
+    for (size_t i = 0; i < len; i++) {
+        write_char_at(s[i], -1, -1, attr);
+    }
+}
+
+static void serial_sink_write(kprintf_sink_t* sink, const char* s, size_t len) {
+    serial_write(s, len);
+}
+
+static void console_sink_write(kprintf_sink_t* sink, const char* s, size_t len) {
+    vga_sink_write(&kprintf_vga_sink, s, len);
+    serial_write(s, len);
+}
+
+kprintf_sink_t kprintf_vga_sink     = { vga_sink_write, (void*)0x07 };
+kprintf_sink_t kprintf_serial_sink  = { serial_sink_write, 0 };
+kprintf_sink_t kprintf_console_sink = { console_sink_write, 0 };
+
+int kprintf(const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    int n = kvprintf(&kprintf_console_sink, fmt, ap);
+    va_end(ap);
+    return n;
+}
+
+// Kullanıcı tamponu sink'i: sığmayanı atar ama saymaya devam eder
+typedef struct {
+    char* buf;
+    size_t size;
+    size_t pos;
+} buffer_sink_ctx_t;
+
+static void buffer_sink_write(kprintf_sink_t* sink, const char* s, size_t len) {
+    buffer_sink_ctx_t* b = (buffer_sink_ctx_t*)sink->ctx;
+    if (b->pos + 1 < b->size) {
+        size_t room = b->size - 1 - b->pos;
+        size_t n = len < room ? len : room;
+        for (size_t i = 0; i < n; i++) {
+            b->buf[b->pos + i] = s[i];
+        }
+    }
+    b->pos += len;
+}
+
+int kvsnprintf(char* buf, size_t size, const char* fmt, va_list ap) {
+    buffer_sink_ctx_t ctx = { buf, size, 0 };
+    kprintf_sink_t sink = { buffer_sink_write, &ctx };
+    int n = kvprintf(&sink, fmt, ap);
+    if (size > 0) {
+        buf[ctx.pos < size ? ctx.pos : size - 1] = '\0';
+    }
+    return n;
+}
+
+int ksnprintf(char* buf, size_t size, const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    int n = kvsnprintf(buf, size, fmt, ap);
+    va_end(ap);
+    return n;
+}
@@ -0,0 +1,47 @@
+#ifndef PRINTF_H
+#define PRINTF_H
+
+#include <stdarg.h>
+#include <stddef.h>
+#include "utils.h"
+
+// Çekirdek genelinde tek biçimlendirme motoru. Çıktı ara bir tampona
+// kopyalanmadan doğrudan bir "sink"e (VGA, seri port, kullanıcı tamponu...)
+// parça parça yazılır.
+//
+// Desteklenenler: %d %i %u %x %X %o %p %s %c %%
+//   %pS: kod adresini çekirdek sembol tablosuyla "fonksiyon+0xofset" yazar
+//        (KLOG kayıtlarında da çalışır; biçimlendirme okunurken yapılır)
+//   bayraklar: - 0 + boşluk #   genişlik/kesinlik: sayı veya *
+//   uzunluk:   hh h l ll z t
+
+typedef struct kprintf_sink {
+    // `len` byte'lık parçayı çıktıya yazar (NUL ile bitmek zorunda değil)
+    void (*write)(struct kprintf_sink* sink, const char* s, size_t len);
+    void* ctx;
+} kprintf_sink_t;
+
+// Hazır sink'ler
+extern kprintf_sink_t kprintf_vga_sink;     // VGA metin modu (açık gri)
+extern kprintf_sink_t kprintf_serial_sink;  // COM1
+extern kprintf_sink_t kprintf_console_sink; // VGA + COM1
+
+/**
+ * @brief Biçimlendirilmiş çıktıyı verilen sink'e yazar.
+ * @return Yazılan karakter sayısı.
+ */
+int kvprintf(kprintf_sink_t* sink, const char* fmt, va_list ap);
+int kprintf_to(kprintf_sink_t* sink, const char* fmt, ...);
+
+// Konsola (VGA + seri port) yazar
+int kprintf(const char* fmt, ...);
+
+/**
+ * @brief Tampona yazar; çıktı her zaman NUL ile sonlandırılır.
+ * @return Tampon yeterince büyük olsaydı yazılacak karakter sayısı (C99 gibi).
+ *         Dönüş değeri >= size ise çıktı kesilmiştir.
+ */
+int kvsnprintf(char* buf, size_t size, const char* fmt, va_list ap);
+int ksnprintf(char* buf, size_t size, const char* fmt, ...);
+
+#endif
@@ -0,0 +1,232 @@
+#include "prof.h"
+#include "ksyms.h"
+#include "sched.h"
+#include "timer.h"
+#include "vmm.h"
+#include "printf.h"
+#include "io.h"
+
+#define PROF_BOOT_STACK_SIZE 16384 // main.core.asm: kernel_stack_bottom..top
+#define PROF_LINE_MAX        512
+
+static prof_sample_t samples[PROF_MAX_SAMPLES];
+static u16 order[PROF_MAX_SAMPLES]; // Rapor: örnek indeksleri, sıralanır
+static volatile int running = 0;
+static volatile u32 nr_samples = 0;
+static volatile u32 dropped = 0;
+static u32 start_tick, stop_tick;
+static int symbolized = 0;          // Adresler fonksiyon başlangıçlarına çevrildi mi
+static int reporting = 0;           // Rapor tamponu okurken (ve yerinde çevirirken) 1
+
+int prof_start() {
+    u32 flags = irq_save();
+    if (reporting) {
+        irq_restore(flags);
+        return -1;
+    }
+    nr_samples = 0;
+    dropped = 0;
+    symbolized = 0;
+    start_tick = stop_tick = timer_ticks();
+    running = 1;
+    irq_restore(flags);
+    return 0;
+}
+
+void prof_stop() {
+    u32 flags = irq_save();
+    if (running) stop_tick = timer_ticks();
+    running = 0;
+    irq_restore(flags);
+}
+
+void prof_get_status(prof_status_t* out) {
+    out->running = running;
+    out->samples = nr_samples;
+    out->dropped = dropped;
+    out->start_tick = start_tick;
+    out->stop_tick = running ? timer_ticks() : stop_tick;
+}
+
+void prof_tick(isr_frame_t* frame) {
+    if (!running || !frame) return;
+    if (nr_samples >= PROF_MAX_SAMPLES) {
+        dropped++;
+        return;
+    }
+
+    prof_sample_t* s = &samples[nr_samples];
+    s->eip = frame->eip;
+
+    // EBP zinciri yalnızca kesilen görevin çekirdek yığını içinde ve yukarı doğru izlenir
+    task_t* t = sched_current();
+    u32 lo, hi;
+    if (t && t->kstack) {
+        lo = (u32)t->kstack;
+        hi = lo + PAGE_SIZE;
+    } else {
+        lo = frame->ebp;
+        hi = frame->ebp + PROF_BOOT_STACK_SIZE;
+    }
+    if (hi > USER_BASE) hi = USER_BASE;
+
+    u32 depth = 0;
+    u32 fp = frame->ebp;
+    while (depth < PROF_STACK_DEPTH && fp >= lo && fp + 8 <= hi && !(fp & 3)) {
+        u32* f = (u32*)fp;
+        if (!f[1]) break;
+        s->stack[depth++] = f[1];
+        if (f[0] <= fp) break;
+        fp = f[0];
+    }
+    s->depth = depth;
+    nr_samples++;
+}
+
+// --- Rapor ---
+
+// Profiler durmuşsa ve başka rapor yoksa tamponu rapora ayırır; örnek
+// sayısını *n'ye yazar. Tampon prof_report_end'e kadar değişmez.
+static int prof_report_begin(u32* n) {
+    u32 flags = irq_save();
+    int ok = !running && !reporting;
+    if (ok) {
+        reporting = 1;
+        *n = nr_samples;
+    }
+    irq_restore(flags);
+    return ok ? 0 : -1;
+}
+
+static void prof_report_end() {
+    reporting = 0;
+}
+
+// Adresi içeren fonksiyonun başlangıcı; sembol yoksa adresin kendisi
+static u32 prof_func(u32 addr) {
+    u32 start;
+    return ksyms_lookup(addr, &start) ? start : addr;
+}
+
+// Örnekleri fonksiyonlara çevirir. Dönüş adresleri çağrının ardını gösterir:
+// noreturn bir çağrı fonksiyonun son komutuysa adres sonraki fonksiyona düşer,
+// bu yüzden bir byte geriden aranır.
+static void prof_symbolize(u32 n) {
+    if (symbolized) return;
+    for (u32 i = 0; i < n; i++) {
+        prof_sample_t* s = &samples[i];
+        s->eip = prof_func(s->eip);
+        for (u32 d = 0; d < s->depth; d++) s->stack[d] = prof_func(s->stack[d] - 1);
+    }
+    symbolized = 1;
+}
+
+static int prof_cmp_eip(const prof_sample_t* a, const prof_sample_t* b) {
+    if (a->eip != b->eip) return a->eip < b->eip ? -1 : 1;
+    return 0;
+}
+
+// Yığınlar en dıştaki çerçeveden başlayarak karşılaştırılır (katlanmış biçimin sırası)
+static int prof_cmp_stack(const prof_sample_t* a, const prof_sample_t* b) {
+    u32 n = a->depth < b->depth ? a->depth : b->depth;
+    for (u32 i = 1; i <= n; i++) {
+        u32 x = a->stack[a->depth - i], y = b->stack[b->depth - i];
+        if (x != y) return x < y ? -1 : 1;
+    }
+    if (a->depth != b->depth) return a->depth < b->depth ? -1 : 1;
+    return prof_cmp_eip(a, b);
+}
+
+// order[0..n) üzerinde Shell sıralaması (bellek ayırmaz, n <= PROF_MAX_SAMPLES)
+static void prof_sort(u32 n, int (*cmp)(const prof_sample_t*, const prof_sample_t*)) {
+    for (u32 i = 0; i < n; i++) order[i] = (u16)i;
+    for (u32 gap = n / 2; gap; gap /= 2) {
+        for (u32 i = gap; i < n; i++) {
+            u16 v = order[i];
+            u32 j = i;
+            while (j >= gap && cmp(&samples[order[j - gap]], &samples[v]) > 0) {
+                order[j] = order[j - gap];
+                j -= gap;
+            }
+            order[j] = v;
+        }
+    }
+}
+
+void prof_report_flat(prof_output_t out) {
+    char line[128];
+    char name[KSYMS_NAME_MAX];
+    u32 n;
+    if (prof_report_begin(&n) < 0) return;
+
+    ksnprintf(line, sizeof(line), "%u samples over %u ticks (%u dropped)%s\n", n,
+              stop_tick - start_tick, dropped, ksyms_available() ? "" : ", no symbol table");
+    out(line);
+    if (!n) {
+        prof_report_end();
+        return;
+    }
+
+    prof_symbolize(n);
+    prof_sort(n, prof_cmp_eip);
+
+    // Ardışık aynı fonksiyonlar tek satırdır; en büyük PROF_TOP_FUNCS sayı sıralı tutulur
+    u32 top_addr[PROF_TOP_FUNCS], top_count[PROF_TOP_FUNCS];
+    u32 nr_top = 0;
+    for (u32 i = 0; i < n;) {
+        u32 addr = samples[order[i]].eip;
+        u32 count = 0;
+        while (i < n && samples[order[i]].eip == addr) {
+            count++;
+            i++;
+        }
+        if (nr_top == PROF_TOP_FUNCS && count <= top_count[nr_top - 1]) continue;
+        u32 j = nr_top < PROF_TOP_FUNCS ? nr_top++ : nr_top - 1;
+        while (j > 0 && top_count[j - 1] < count) {
+            top_addr[j] = top_addr[j - 1];
+            top_count[j] = top_count[j - 1];
+            j--;
+        }
+        top_addr[j] = addr;
+        top_count[j] = count;
+    }
+
+    out("  samples     %  function\n");
+    for (u32 i = 0; i < nr_top; i++) {
+        u32 permille = top_count[i] * 1000 / n;
+        ksyms_format(top_addr[i], name, sizeof(name));
+        ksnprintf(line, sizeof(line), "  %7u %3u.%u  %s\n", top_count[i], permille / 10, permille % 10, name);
+        out(line);
+    }
+    prof_report_end();
+}
+
+void prof_report_collapsed(prof_output_t out) {
+    static char line[PROF_LINE_MAX]; // reporting bayrağı tek rapora izin verir
+    u32 n;
+    if (prof_report_begin(&n) < 0) return;
+
+    prof_symbolize(n);
+    prof_sort(n, prof_cmp_stack);
+
+    for (u32 i = 0; i < n;) {
+        prof_sample_t* s = &samples[order[i]];
+        u32 count = 0;
+        while (i < n && prof_cmp_stack(&samples[order[i]], s) == 0) {
+            count++;
+            i++;
+        }
+
+        // "dış;...;iç sayı"
+        u32 len = 0;
+        for (u32 d = s->depth; d > 0 && len < sizeof(line); d--) {
+            len += ksyms_format(s->stack[d - 1], line + len, sizeof(line) - len);
+            if (len < sizeof(line) - 1) line[len++] = ';';
+        }
+        if (len < sizeof(line)) len += ksyms_format(s->eip, line + len, sizeof(line) - len);
+        if (len < sizeof(line)) ksnprintf(line + len, sizeof(line) - len, " %u\n", count);
+        line[sizeof(line) - 1] = '\0';
+        out(line);
+    }
+    prof_report_end();
+}
@@ -0,0 +1,55 @@
+#ifndef PROF_H
+#define PROF_H
+
+#include "utils.h"
+#include "idt.h"
+
+// --- Örnekleyen Profiler ---
+// Çalışırken her timer tick'inde kesilen kodun EIP'sini ve EBP zincirinden
+// en fazla PROF_STACK_DEPTH dönüş adresini bir örnek tamponuna yazar
+// (tek işlemci: tek tampon). Tampon dolunca yeni örnekler sayılıp atılır.
+// Örnekleme kesme bağlamında birkaç düzine bellek okumasıdır; kilit ya da
+// bellek ayırma yoktur.
+//
+// Rapor durdurulmuş bir tampondan üretilir ve adresleri çekirdek sembol
+// tablosuyla (ksyms.h) fonksiyonlara çevirir:
+//  * Düz profil: en çok örneklenen PROF_TOP_FUNCS fonksiyon.
+//  * Katlanmış yığınlar: "dış;...;iç sayı" satırları (flame graph araçlarının
+//    girdi biçimi), seri porta yazılır.
+//
+// EBP zinciri çekirdek çerçeve işaretçileriyle derlendiyse anlamlıdır;
+// zincir görevin çekirdek yığınının dışına çıkar ya da geriye giderse kesilir.
+
+#define PROF_MAX_SAMPLES 2048
+#define PROF_STACK_DEPTH 8
+#define PROF_TOP_FUNCS   15
+
+typedef struct {
+    u32 eip;
+    u32 depth;                    // stack[]'teki geçerli girdi sayısı
+    u32 stack[PROF_STACK_DEPTH];  // Dönüş adresleri, içten dışa
+} prof_sample_t;
+
+typedef struct {
+    int running;
+    u32 samples;                  // Tampondaki örnek sayısı
+    u32 dropped;                  // Tampon dolu olduğu için atılanlar
+    u32 start_tick;
+    u32 stop_tick;
+} prof_status_t;
+
+// Tamponu temizler ve örneklemeyi başlatır; bir rapor sürüyorsa -1 döner
+int prof_start();
+void prof_stop();
+void prof_get_status(prof_status_t* out);
+
+// Timer handler'ından çağrılır; profiler kapalıysa hemen döner
+void prof_tick(isr_frame_t* frame);
+
+// Rapor satırlarını `out`a verir (satır sonları dahil). Profiler durmuş olmalı;
+// rapor tamponu yerinde sembolleştirdiği için sürerken prof_start reddedilir.
+typedef void (*prof_output_t)(const char* line);
+void prof_report_flat(prof_output_t out);
+void prof_report_collapsed(prof_output_t out);
+
+#endif
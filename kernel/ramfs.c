@@ -0,0 +1,149 @@
+#include "ramfs.h"
+#include "dcache.h"
+#include "slab.h"
+#include "pmm.h"
+#include "string.h"
+
+static slab_cache_t ramfs_inode_cache = SLAB_CACHE_INIT("ramfs_inode", sizeof(ramfs_inode_t));
+
+// --- Dosya İşlemleri ---
+// RamFS'in yedek deposu yoktur; dosya verisi doğrudan sayfa önbelleğinde
+// yaşar (readpage/writepage boş, bu yüzden sayfalar hiç kirli işaretlenmez).
+
+static size_t ramfs_read(vfs_node_t* node, uint32_t offset, size_t size, uint8_t* buffer) {
+    ramfs_inode_t* ino = (ramfs_inode_t*)node;
+    if (!ino->external || ino->cache.nr_pages) {
+        return pagecache_read(node, offset, size, buffer);
+    }
+
+    // Henüz hiç değiştirilmemiş harici dosya: kaynaktan tek kopya
+    if (offset >= node->size) return 0;
+    if (size > node->size - offset) size = node->size - offset;
+    size_t from_ext = 0;
+    if (offset < ino->external_size) {
+        from_ext = ino->external_size - offset;
+        if (from_ext > size) from_ext = size;
+        memcpy(buffer, ino->external + offset, from_ext);
+    }
+    memset(buffer + from_ext, 0, size - from_ext); // Büyütülmüş dosyanın deliği
+    return size;
+}
+
+// Harici dosyanın bir sayfasını önbelleğe getirir (yazma ya da mmap için)
+static int ramfs_readpage_external(vfs_node_t* node, uint32_t index, uint8_t* page) {
+    ramfs_inode_t* ino = (ramfs_inode_t*)node;
+    u32 offset = index * PAGE_SIZE;
+    u32 n = 0;
+    if (offset < ino->external_size) {
+        n = ino->external_size - offset;
+        if (n > PAGE_SIZE) n = PAGE_SIZE;
+        memcpy(page, ino->external + offset, n);
+    }
+    memset(page + n, 0, PAGE_SIZE - n);
+    return 0;
+}
+
+static size_t ramfs_write(vfs_node_t* node, uint32_t offset, size_t size, const uint8_t* buffer) {
+    return pagecache_write(node, offset, size, buffer);
+}
+
+int ramfs_truncate(vfs_node_t* node, u32 length) {
+    ramfs_inode_t* ino = (ramfs_inode_t*)node;
+    if (node->type != FS_NODE_FILE) return -1;
+    // Kesilen harici veri sonradan büyütülünce geri gelmemeli
+    if (ino->external && length < ino->external_size) ino->external_size = length;
+    return pagecache_truncate(node, length);
+}
+
+static int ramfs_truncate_op(vfs_node_t* node, uint32_t length) {
+    return ramfs_truncate(node, length);
+}
+
+// --- Dizin İşlemleri ---
+
+static vfs_node_t* ramfs_finddir(vfs_node_t* dir, const char* name) {
+    for (vfs_node_t* child = dir->first_child; child; child = child->next_sibling) {
+        if (strcmp(child->name, name) == 0) return child;
+    }
+    return NULL;
+}
+
+static int ramfs_link_new(vfs_node_t* dir, const char* name, fs_node_type_t type, uint32_t perms) {
+    size_t len = strnlen(name, MAX_FILENAME_LENGTH);
+    if (len == 0 || len >= MAX_FILENAME_LENGTH) return -1;
+    if (vfs_finddir(dir, name, len)) return -1; // Zaten var
+
+    vfs_node_t* node = ramfs_create_node(name, type);
+    if (!node) return -1;
+    node->permissions = perms;
+    node->parent = dir;
+    node->next_sibling = dir->first_child;
+    dir->first_child = node;
+
+    // vfs_finddir yukarıda negatif girdi bıraktı; doğrudan yeni düğümle değiştir
+    dcache_insert(dir, name, len, node);
+    return 0;
+}
+
+static int ramfs_mkdir(vfs_node_t* dir, const char* name, uint32_t perms) {
+    return ramfs_link_new(dir, name, FS_NODE_DIRECTORY, perms);
+}
+
+static int ramfs_create(vfs_node_t* dir, const char* name, uint32_t perms) {
+    return ramfs_link_new(dir, name, FS_NODE_FILE, perms);
+}
+
+vfs_node_t* ramfs_create_node(const char* name, fs_node_type_t type) {
+    ramfs_inode_t* ino = (ramfs_inode_t*)slab_alloc(&ramfs_inode_cache);
+    if (!ino) return NULL;
+
+    vfs_node_t* node = &ino->vfs;
+    strlcpy(node->name, name, sizeof(node->name));
+    node->type = type;
+    node->internal_data = ino;
+
+    if (type == FS_NODE_DIRECTORY) {
+        node->finddir = ramfs_finddir;
+        node->mkdir = ramfs_mkdir;
+        node->create = ramfs_create;
+    } else {
+        node->read = ramfs_read;
+        node->write = ramfs_write;
+        node->truncate = ramfs_truncate_op;
+        pagecache_attach(node, &ino->cache);
+    }
+    return node;
+}
+
+vfs_node_t* ramfs_create_external(vfs_node_t* dir, const char* name, const void* data, u32 size) {
+    size_t len = strnlen(name, MAX_FILENAME_LENGTH);
+    if (!dir || dir->type != FS_NODE_DIRECTORY || !dir->create) return NULL;
+    if (dir->create(dir, name, 0444) < 0) return NULL;
+
+    vfs_node_t* node = vfs_finddir(dir, name, len);
+    ramfs_inode_t* ino = (ramfs_inode_t*)node;
+    ino->external = (const u8*)data;
+    ino->external_size = size;
+    node->size = size;
+    node->readpage = ramfs_readpage_external;
+    return node;
+}
+
+int ramfs_link_device(vfs_node_t* dir, vfs_node_t* node) {
+    size_t len = strnlen(node->name, MAX_FILENAME_LENGTH);
+    if (!dir || dir->type != FS_NODE_DIRECTORY || dir->finddir != ramfs_finddir) return -1;
+    if (len == 0 || len >= MAX_FILENAME_LENGTH) return -1;
+    if (vfs_finddir(dir, node->name, len)) return -1;
+
+    node->parent = dir;
+    node->next_sibling = dir->first_child;
+    dir->first_child = node;
+    dcache_insert(dir, node->name, len, node);
+    return 0;
+}
+
+vfs_node_t* ramfs_initialize() {
+    vfs_node_t* root = ramfs_create_node("/", FS_NODE_DIRECTORY);
+    if (root) root->permissions = 0755;
+    return root;
+}
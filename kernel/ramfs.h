@@ -0,0 +1,59 @@
+#ifndef RAMFS_H
+#define RAMFS_H
+
+#include "utils.h"
+#include "vfs.h"
+#include "pagecache.h"
+
+// --- RamFS Implementasyonu ---
+// RamFS, tüm dosya ve dizinleri RAM'de saklayan basit bir dosya sistemidir.
+// Dosya verisi tek parça bir tamponda değil, dosyanın sayfa önbelleğinde
+// (pagecache.h) tutulur: sona ekleme kopyalama yapmaz, hiç yazılmamış
+// bölgeler (delikler) bellek harcamaz ve sıfır okunur.
+
+typedef struct {
+    vfs_node_t vfs;     // İlk alan olmalı; vfs_node_t* <-> ramfs_inode_t* dönüşümü için
+    page_cache_t cache; // Dosyanın verisi (dizinlerde kullanılmaz)
+
+    // Harici dosyalar (ramfs_create_external): verinin asıl kopyası çekirdeğin
+    // dışından gelen salt-okunur bellektedir (örn. initrd modülü). Önbellekte
+    // hiç sayfa yokken read() doğrudan buradan kopyalar. İlk yazma ya da
+    // mmap'ten sonra dosya önbellek üzerinden okunur; sayfalar gerektikçe
+    // readpage ile kaynaktan kopyalanır.
+    const u8* external;
+    u32 external_size;
+} ramfs_inode_t;
+
+/**
+ * @brief RamFS'i başlatır ve kök dizinini ("/") oluşturur.
+ * @return Kök dizinin düğümü; bellek yoksa NULL.
+ */
+vfs_node_t* ramfs_initialize();
+
+/**
+ * @brief VFS arayüzünü kullanarak bir RamFS düğümü oluşturur (henüz hiçbir
+ *        dizine bağlanmaz).
+ */
+vfs_node_t* ramfs_create_node(const char* name, fs_node_type_t type);
+
+/**
+ * @brief Verisi kopyalanmadan harici bellekte kalan bir dosya oluşturur ve
+ *        `dir` dizinine bağlar. Dosya normal bir RamFS dosyası gibi yazılabilir;
+ *        değişiklikler harici belleğe değil önbelleğe gider.
+ * @param data Dosya içeriği; dosya yaşadığı sürece geçerli kalmalı.
+ * @return Yeni düğüm; isim zaten varsa ya da bellek yoksa NULL.
+ */
+vfs_node_t* ramfs_create_external(vfs_node_t* dir, const char* name, const void* data, u32 size);
+
+/**
+ * @brief Sürücünün sahip olduğu bir aygıt düğümünü (örn. /dev/kbd) kendi
+ *        adıyla `dir` dizinine bağlar. Düğüm RamFS'e ait değildir, serbest
+ *        bırakılmaz.
+ * @return Başarılıysa 0; isim zaten varsa -1.
+ */
+int ramfs_link_device(vfs_node_t* dir, vfs_node_t* node);
+
+// Dosyayı `length` byte'a getirir; kesilen sayfalar PMM'ye geri verilir
+int ramfs_truncate(vfs_node_t* node, u32 length);
+
+#endif
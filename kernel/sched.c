@@ -0,0 +1,298 @@
+#include "sched.h"
+#include "timer.h"
+#include "slab.h"
+#include "pmm.h"
+#include "io.h"
+#include "string.h"
+#include "fdtable.h"
+#include "vmm.h"
+#include "gdt.h"
+#include "vdso.h"
+
+// switch.s: prev'in ESP'sini *prev_esp'ye yazar, next_esp'ye geçer
+extern void switch_to(u32* prev_esp, u32 next_esp);
+
+static slab_cache_t task_cache = SLAB_CACHE_INIT("task", sizeof(task_t));
+
+static task_t boot_task;
+static task_t* current = NULL;
+static task_t* all_tasks = NULL;
+static task_t* run_head = NULL;
+static task_t* run_tail = NULL;
+static task_t* sleepers = NULL;
+static task_t* reap_task = NULL; // Yığını, ondan çıkıldıktan sonra serbest bırakılır
+static u32 next_tid = 1;
+static u32 slice_left = SCHED_QUANTUM;
+static volatile int need_resched = 0;
+static int in_idle = 0;
+
+static void rq_push(task_t* t) {
+    t->run_next = NULL;
+    if (run_tail) run_tail->run_next = t;
+    else run_head = t;
+    run_tail = t;
+}
+
+static task_t* rq_pop() {
+    task_t* t = run_head;
+    if (t) {
+        run_head = t->run_next;
+        if (!run_head) run_tail = NULL;
+        t->run_next = NULL;
+    }
+    return t;
+}
+
+void sched_init() {
+    boot_task.tid = 0;
+    boot_task.state = TASK_RUNNING;
+    strlcpy(boot_task.name, "kernel", sizeof(boot_task.name));
+    all_tasks = &boot_task;
+    current = &boot_task;
+}
+
+task_t* sched_current() {
+    return current;
+}
+
+task_t* sched_first_task() {
+    return all_tasks;
+}
+
+// Yeni göreve geçildikten sonra, yeni görevin bağlamında çalışır
+static void sched_finish_switch() {
+    if (reap_task && reap_task != current) {
+        pmm_free_page(reap_task->kstack);
+        slab_free(&task_cache, reap_task);
+        reap_task = NULL;
+    }
+}
+
+// Görevin bağlamını yükler: fd tablosu, adres alanı (yalnızca farklıysa) ve TLS
+static void sched_load_context(task_t* prev, task_t* next) {
+    fdtable_switch(next->files);
+    if (next->mm != vmm_current()) vmm_switch(next->mm);
+    if (next->tls_base || prev->tls_base) gdt_load_tls(next->tls_base);
+    vdso_set_current(next->tgid, next->tid);
+}
+
+static void schedule() {
+    u32 flags = irq_save();
+    task_t* prev = current;
+    if (prev->state == TASK_RUNNING) {
+        prev->state = TASK_READY;
+        rq_push(prev);
+    }
+
+    // Hazır görev yok: kesmelerin birini uyandırmasını bekle
+    task_t* next;
+    in_idle = 1;
+    while (!(next = rq_pop())) {
+        asm volatile ("sti; hlt; cli" ::: "memory");
+    }
+    in_idle = 0;
+
+    next->state = TASK_RUNNING;
+    need_resched = 0;
+    slice_left = SCHED_QUANTUM;
+    if (next != prev) {
+        current = next;
+        sched_load_context(prev, next);
+        switch_to(&prev->esp, next->esp);
+        sched_finish_switch();
+    }
+    irq_restore(flags);
+}
+
+static void kthread_start() {
+    sched_finish_switch();
+    asm volatile ("sti");
+    current->entry(current->arg);
+    kthread_exit();
+}
+
+static task_t* task_alloc(const char* name, void (*entry)(void* arg), void* arg) {
+    task_t* t = (task_t*)slab_alloc(&task_cache);
+    if (!t) return NULL;
+    t->kstack = pmm_alloc_page();
+    if (!t->kstack) {
+        slab_free(&task_cache, t);
+        return NULL;
+    }
+    strlcpy(t->name, name, sizeof(t->name));
+    t->entry = entry;
+    t->arg = arg;
+
+    // switch_to'nun pop sırasına uygun ilk çerçeve: edi, esi, ebx, ebp, dönüş
+    u32* sp = (u32*)((u8*)t->kstack + PAGE_SIZE);
+    *--sp = 0;                  // kthread_start'ın sahte dönüş adresi
+    *--sp = (u32)kthread_start;
+    *--sp = 0;                  // ebp
+    *--sp = 0;                  // ebx
+    *--sp = 0;                  // esi
+    *--sp = 0;                  // edi
+    t->esp = (u32)sp;
+    return t;
+}
+
+static void task_free(task_t* t) {
+    pmm_free_page(t->kstack);
+    slab_free(&task_cache, t);
+}
+
+// tid verir ve hazır kuyruğuna ekler; `group` NULL ise görev yeni bir grubun ilkidir
+static void task_start(task_t* t, task_t* group) {
+    u32 flags = irq_save();
+    t->tid = next_tid++;
+    t->tgid = group ? group->tgid : t->tid;
+    t->all_next = all_tasks;
+    all_tasks = t;
+    t->state = TASK_READY;
+    rq_push(t);
+    irq_restore(flags);
+}
+
+task_t* kthread_create(const char* name, void (*entry)(void* arg), void* arg) {
+    task_t* t = task_alloc(name, entry, arg);
+    if (t) task_start(t, NULL);
+    return t;
+}
+
+task_t* sched_clone(const char* name, void (*entry)(void* arg), void* arg, const clone_args_t* args) {
+    task_t* parent = current;
+    u32 flags = args->flags;
+    task_t* t = task_alloc(name, entry, arg);
+    if (!t) return NULL;
+
+    if (flags & CLONE_FILES) {
+        t->files = fdtable_get(parent->files);
+    } else if (fdtable_current() && !(t->files = fdtable_clone(fdtable_current()))) {
+        task_free(t);
+        return NULL;
+    }
+    if (flags & CLONE_VM) t->mm = vmm_mm_get(parent->mm);
+    t->user_stack = args->user_stack;
+    t->tls_base = (flags & CLONE_SETTLS) ? args->tls : parent->tls_base;
+
+    task_start(t, (flags & CLONE_THREAD) ? parent : NULL);
+    return t;
+}
+
+u32 sys_clone(u32 flags, u32 user_stack, u32 tls, u32 entry, u32 arg, ...) {
+    clone_args_t args = { flags, user_stack, tls };
+    if (!entry) return (u32)-1;
+    task_t* t = sched_clone(current->name, (void (*)(void*))entry, (void*)arg, &args);
+    return t ? t->tid : (u32)-1;
+}
+
+void kthread_exit() {
+    task_t* t = current;
+    // Tablonun dosyaları kapanırken (örn. boru ucu) başkası uyanabilir
+    if (t->files) {
+        fd_table_t* files = t->files;
+        t->files = NULL;
+        fdtable_switch(NULL);
+        fdtable_put(files);
+    }
+    // Son thread'se adres alanı yok edilir (yüklüyse önce çekirdek dizinine geçilir)
+    if (t->mm) {
+        struct mm* mm = t->mm;
+        t->mm = NULL;
+        vmm_mm_put(mm);
+    }
+
+    irq_save();
+    task_t** link = &all_tasks;
+    while (*link && *link != t) link = &(*link)->all_next;
+    if (*link) *link = t->all_next;
+
+    t->state = TASK_DEAD;
+    reap_task = t;
+    schedule();
+    for (;;) asm volatile ("hlt"); // Buraya dönülmez
+}
+
+void sched_yield() {
+    schedule();
+}
+
+void sched_block() {
+    current->state = TASK_BLOCKED;
+    schedule();
+}
+
+void sched_wake(task_t* t) {
+    u32 flags = irq_save();
+    if (t->state == TASK_BLOCKED) {
+        t->state = TASK_READY;
+        rq_push(t);
+        // Açılış görevi hlt'de beklerken uyanan görev hemen çalışsın
+        if (current == &boot_task || in_idle) need_resched = 1;
+    }
+    irq_restore(flags);
+}
+
+void sched_switch_to(task_t* next) {
+    task_t* prev = current;
+    if (prev->state == TASK_RUNNING) {
+        prev->state = TASK_READY;
+        rq_push(prev);
+    }
+    next->state = TASK_RUNNING;
+    current = next;
+    sched_load_context(prev, next);
+    switch_to(&prev->esp, next->esp);
+    sched_finish_switch();
+}
+
+static void sleepers_remove(task_t* t) {
+    task_t** link = &sleepers;
+    while (*link && *link != t) link = &(*link)->sleep_next;
+    if (*link) *link = t->sleep_next;
+    t->sleep_next = NULL;
+}
+
+void sched_sleep_ms(u32 ms) {
+    u32 flags = irq_save();
+    task_t* t = current;
+    t->wake_tick = timer_ticks() + timer_ms_to_ticks(ms);
+    t->sleep_next = sleepers;
+    sleepers = t;
+    sched_block();
+    sleepers_remove(t); // Erken uyandırıldıysa hâlâ listede
+    irq_restore(flags);
+}
+
+void sched_tick(u32 now) {
+    task_t** link = &sleepers;
+    while (*link) {
+        task_t* t = *link;
+        if ((int)(now - t->wake_tick) >= 0) {
+            *link = t->sleep_next;
+            t->sleep_next = NULL;
+            sched_wake(t);
+        } else {
+            link = &t->sleep_next;
+        }
+    }
+
+    if (slice_left) slice_left--;
+    if (!slice_left && run_head) need_resched = 1;
+}
+
+void sched_preempt() {
+    if (need_resched && current && !current->preempt_count && !in_idle) schedule();
+}
+
+// sched_init'ten önce (current yokken) tek bağlam vardır: sayaç tutulmaz
+void preempt_disable() {
+    if (current) current->preempt_count++;
+}
+
+void preempt_enable() {
+    if (current && --current->preempt_count == 0) sched_preempt();
+}
+
+void preempt_enable_no_resched() {
+    if (current) current->preempt_count--;
+}
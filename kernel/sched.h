@@ -0,0 +1,144 @@
+#ifndef SCHED_H
+#define SCHED_H
+
+#include "utils.h"
+
+// --- Çekirdek Thread'leri ve Zamanlayıcı ---
+// Her görevin bir sayfalık kernel yığını vardır; bağlam değişimi yalnızca
+// callee-saved register'ları ve ESP'yi saklar (switch.s). Hazır görevler FIFO
+// bir kuyrukta bekler (round-robin). Timer kesmesi zaman dilimini sayar;
+// dilim bitince kesme dönüşünde (isr_handler, EOI'den sonra) görev değişir;
+// görev preempt_disable içindeyse değişim preempt_enable'a ertelenir.
+//
+// kernel_main'in kendi bağlamı sched_init ile 0 numaralı görev olur. Hiç hazır
+// görev yoksa o an çalışan bağlam kuyruk dolana kadar hlt ile bekler.
+//
+// Thread'ler: sched_clone ile oluşturulan görev, CLONE_* bayraklarına göre
+// oluşturanın adres alanını (mm) ve fd tablosunu paylaşır; kendi kernel
+// yığını, kullanıcı yığını ve TLS tabanı vardır. Aynı adres alanındaki
+// thread'ler arasında geçişte CR3 yeniden yüklenmez (TLB boşaltılmaz);
+// yalnızca TLS girdisi ve gs güncellenir (gdt.h).
+
+struct fd_table;
+struct mm;
+struct ipc_msg;
+
+#define TASK_NAME_MAX     16
+#define SCHED_QUANTUM     5  // Tick cinsinden zaman dilimi
+
+// sched_clone bayrakları (Linux değerleri)
+#define CLONE_VM          0x00000100 // Adres alanı paylaşılır (yoksa thread'in kullanıcı alanı olmaz)
+#define CLONE_FILES       0x00000400 // fd tablosu paylaşılır (yoksa kopyalanır)
+#define CLONE_THREAD      0x00010000 // Aynı thread grubu (tgid): aynı süreç
+#define CLONE_SETTLS      0x00080000 // tls_base, clone_args_t.tls olur
+
+typedef enum {
+    TASK_RUNNING,
+    TASK_READY,
+    TASK_BLOCKED,  // Bir bekleme kuyruğunda ya da süreli uykuda
+    TASK_DEAD
+} task_state_t;
+
+// Görevin IPC beklemesi (ipc.h). Uç noktanın kuyruğuna görevin kendi
+// kaydı girer; görev aynı anda en fazla bir IPC işleminde bekler.
+typedef struct ipc_waiter {
+    struct task* task;
+    struct ipc_msg* msg;       // Gönderilecek ya da doldurulacak mesaj
+    struct ipc_msg* reply;     // ipc_call: yanıtın yazılacağı yer; ipc_send'de NULL
+    struct ipc_waiter* caller; // Alıcı: mesajı getiren çağrı (yanıt tutamacı)
+    volatile int done;
+    int result;
+    struct ipc_waiter* next;
+} ipc_waiter_t;
+
+typedef struct task {
+    u32 esp;                // Bağlam değişiminde saklanan yığın işaretçisi
+    u32 tid;
+    u32 tgid;               // Thread grubu (süreç) kimliği: grubun ilk thread'inin tid'i
+    task_state_t state;
+    char name[TASK_NAME_MAX];
+    void* kstack;           // NULL: açılış görevi (yığını boot.s'te)
+    u32 wake_tick;          // Süreli uykuda uyanma zamanı
+    void (*entry)(void* arg);
+    void* arg;
+    struct fd_table* files; // NULL: çekirdek bağlamının tablosu; görev bitince bırakılır
+    struct mm* mm;          // Kullanıcı adres alanı (NULL: yalnızca çekirdek); paylaşılabilir
+    u32 user_stack;         // Kullanıcı yığınının tepesi (0: yok)
+    u32 tls_base;           // TLS segmentinin tabanı (0: TLS yok, gs = çekirdek verisi)
+    u32 preempt_count;      // > 0 iken kesme dönüşünde görev değişmez (preempt_disable)
+    ipc_waiter_t ipc;       // IPC beklemesi (ipc.c)
+
+    struct task* run_next;  // Hazır kuyruğu
+    struct task* sleep_next;
+    struct task* all_next;  // Tüm görevler
+} task_t;
+
+void sched_init();
+
+/**
+ * @brief Yeni bir çekirdek thread'i oluşturur ve hazır kuyruğuna ekler.
+ *        entry döndüğünde thread kthread_exit ile sonlanır.
+ * @return Görev; bellek yoksa NULL.
+ */
+task_t* kthread_create(const char* name, void (*entry)(void* arg), void* arg);
+void kthread_exit();
+
+typedef struct {
+    u32 flags;              // CLONE_*
+    u32 user_stack;         // Yeni thread'in kullanıcı yığınının tepesi
+    u32 tls;                // CLONE_SETTLS ile TLS tabanı
+} clone_args_t;
+
+/**
+ * @brief Çağıran görevden yeni bir thread oluşturur; paylaşılanlar
+ *        args->flags ile seçilir. Thread entry(arg) ile başlar.
+ * @return Görev; bellek yoksa NULL.
+ */
+task_t* sched_clone(const char* name, void (*entry)(void* arg), void* arg, const clone_args_t* args);
+
+// Syscall arayüzü: yeni thread'in tid'ini döner, hata durumunda -1.
+// Kullanıcı kipi henüz yok; entry çekirdek kipinde çalışır.
+u32 sys_clone(u32 flags, u32 user_stack, u32 tls, u32 entry, u32 arg, ...);
+
+task_t* sched_current();
+task_t* sched_first_task(); // Liste: task->all_next
+
+// Sıradaki hazır göreve geçer; çağıran hazır kalır
+void sched_yield();
+
+// Çağıranı TASK_BLOCKED yapıp başka göreve geçer; sched_wake ile döner.
+// Kesmeler kapalı çağrılmalıdır (uyandırma koşulu kontrolüyle atomik olsun diye).
+void sched_block();
+void sched_wake(task_t* task);
+
+// Hazır kuyruğunu atlayıp doğrudan `next`e geçer (IPC hızlı yolu). `next`
+// TASK_BLOCKED olmalı ve çağıranın kalan zaman dilimiyle çalışır. Çağıran
+// önceden TASK_BLOCKED yapılmadıysa hazır kuyruğuna girer. Kesmeler kapalı çağrılır.
+void sched_switch_to(task_t* next);
+
+// En az `ms` milisaniye uyur (sched_wake ile erken uyandırılabilir)
+void sched_sleep_ms(u32 ms);
+
+// Timer kesmesinden her tick'te çağrılır
+void sched_tick(u32 now);
+
+// Kesme dönüşünde çağrılır: zaman dilimi bittiyse ve görev preempt_disable
+// içinde değilse görev değiştirir
+void sched_preempt();
+
+/**
+ * @brief Kesme dönüşündeki görev değişimini engeller; iç içe çağrılabilir.
+ *        Görevler arasında paylaşılan yapılar (dcache, fd tabloları, sayfa
+ *        önbelleği) bununla korunur; kesme handler'larından da erişilenler
+ *        (PMM, slab) irq_save kullanır. Sayaç göreve aittir: görev içerideyken
+ *        kendi isteğiyle uyuyabilir, ama uyanınca korunan yapı değişmiş olabilir.
+ */
+void preempt_disable();
+
+// Sayaç sıfıra inerse bekleyen görev değişimini hemen yapar
+void preempt_enable();
+
+// Sayacı görev değiştirmeden düşürür (isr_handler: değişim EOI'den sonra)
+void preempt_enable_no_resched();
+
+#endif
@@ -0,0 +1,262 @@
+#include "serial.h"
+#include "io.h"
+#include "idt.h"
+#include "epoll.h"
+#include "string.h"
+
+// UART register ofsetleri
+#define UART_DATA 0 // RBR/THR (DLAB=0), DLL (DLAB=1)
+#define UART_IER  1 // Interrupt Enable, DLM (DLAB=1)
+#define UART_IIR  2 // Interrupt Identification (okuma)
+#define UART_FCR  2 // FIFO Control (yazma)
+#define UART_LCR  3
+#define UART_MCR  4
+#define UART_LSR  5
+#define UART_MSR  6
+#define UART_SCR  7
+
+#define UART_IER_RDI   0x01 // Veri geldi kesmesi
+#define UART_IER_THRI  0x02 // Gönderim tamponu boş kesmesi
+#define UART_LSR_DR    0x01
+#define UART_LSR_THRE  0x20
+#define UART_MCR_OUT2  0x08 // IRQ hattını PIC'e bağlar
+
+#define UART_FIFO_DEPTH 16
+
+#define SERIAL_TX_RING_MASK (SERIAL_TX_RING_SIZE - 1)
+#define SERIAL_RX_RING_MASK (SERIAL_RX_RING_SIZE - 1)
+
+static const u16 port = SERIAL_COM1_BASE;
+
+static char tx_ring[SERIAL_TX_RING_SIZE];
+static volatile u32 tx_head = 0; // Yazıcının bir sonraki yazacağı indeks
+static volatile u32 tx_tail = 0; // IRQ'nun bir sonraki göndereceği indeks
+static volatile int tx_active = 0; // THRE kesmesi açık ve FIFO boşalıyor
+
+static int uart_present = 0;
+static int uart_irq_mode = 0;
+static int uart_fifo_depth = 1;
+static serial_rx_handler_t rx_handler = 0;
+
+// /dev/ttyS0 açıkken gelen baytlar rx_handler yerine bu halkaya gider
+static char rx_ring[SERIAL_RX_RING_SIZE];
+static volatile u32 rx_head = 0;
+static volatile u32 rx_tail = 0;
+static u32 rx_opened = 0;
+static wait_queue_t rx_wq = WAIT_QUEUE_INIT;
+static vfs_node_t tty_node;
+
+static void serial_putc_polled(char c) {
+    while (!(inb(port + UART_LSR) & UART_LSR_THRE));
+    outb(port + UART_DATA, (u8)c);
+}
+
+void serial_early_init() {
+    outb(port + UART_IER, 0x00);     // Tüm kesmeleri kapat
+    outb(port + UART_LCR, 0x80);     // DLAB=1, bölücüyü ayarla
+    outb(port + UART_DATA, 0x01);    // 115200 baud (bölücü = 1)
+    outb(port + UART_IER, 0x00);
+    outb(port + UART_LCR, 0x03);     // 8 bit, parite yok, 1 stop bit
+    outb(port + UART_FCR, 0xC7);     // FIFO'yu aç ve temizle, 14 byte eşik
+    outb(port + UART_MCR, 0x03);     // DTR + RTS
+
+    // Scratch register ile portun gerçekten var olup olmadığını kontrol et
+    outb(port + UART_SCR, 0xA5);
+    uart_present = (inb(port + UART_SCR) == 0xA5);
+
+    // IIR'nin üst iki biti 11 ise FIFO'lu 16550A
+    uart_fifo_depth = ((inb(port + UART_IIR) & 0xC0) == 0xC0) ? UART_FIFO_DEPTH : 1;
+}
+
+// FIFO'yu halka tampondan doldurur. Kesmeler kapalıyken çağrılmalı.
+static void serial_fill_fifo() {
+    int n = uart_fifo_depth;
+    while (n-- > 0 && tx_tail != tx_head) {
+        outb(port + UART_DATA, (u8)tx_ring[tx_tail & SERIAL_TX_RING_MASK]);
+        tx_tail++;
+    }
+
+    if (tx_tail == tx_head) {
+        // Gönderilecek bir şey kalmadı, THRE kesmesini kapat
+        outb(port + UART_IER, UART_IER_RDI);
+        tx_active = 0;
+    } else if (!tx_active) {
+        outb(port + UART_IER, UART_IER_RDI | UART_IER_THRI);
+        tx_active = 1;
+    }
+}
+
+static void serial_irq_handler() {
+    u8 iir;
+    // IIR bit 0 = 0 olduğu sürece bekleyen bir kesme kaynağı vardır
+    while (!((iir = inb(port + UART_IIR)) & 0x01)) {
+        switch ((iir >> 1) & 0x07) {
+            case 1: // THR boş
+                serial_fill_fifo();
+                break;
+            case 2: // Veri geldi
+            case 6: // Karakter zaman aşımı (FIFO'da veri var)
+                while (inb(port + UART_LSR) & UART_LSR_DR) {
+                    char c = (char)inb(port + UART_DATA);
+                    if (rx_opened) {
+                        // Halka doluysa yeni bayt atılır
+                        if (rx_head - rx_tail < SERIAL_RX_RING_SIZE) {
+                            rx_ring[rx_head & SERIAL_RX_RING_MASK] = c;
+                            rx_head++;
+                        }
+                    } else if (rx_handler) {
+                        rx_handler(c);
+                    }
+                }
+                if (rx_head != rx_tail) waitq_wake_all(&rx_wq, POLL_KEY(EPOLLIN));
+                break;
+            case 3: // Hat durumu
+                inb(port + UART_LSR);
+                break;
+            default: // Modem durumu
+                inb(port + UART_MSR);
+                break;
+        }
+    }
+}
+
+void serial_init() {
+    if (!uart_present) return;
+
+    irq_register_handler(SERIAL_COM1_IRQ, serial_irq_handler);
+    outb(port + UART_MCR, 0x03 | UART_MCR_OUT2);
+    outb(port + UART_IER, UART_IER_RDI);
+    uart_irq_mode = 1;
+}
+
+static void serial_enqueue(char c) {
+    u32 flags = irq_save();
+
+    if (tx_head - tx_tail >= SERIAL_TX_RING_SIZE) {
+        // Tampon dolu: veriyi kaybetmek yerine en eski baytı elle gönder
+        serial_putc_polled(tx_ring[tx_tail & SERIAL_TX_RING_MASK]);
+        tx_tail++;
+    }
+    tx_ring[tx_head & SERIAL_TX_RING_MASK] = c;
+    tx_head++;
+
+    // Kesme kurulu değilse: FIFO boşsa ilk 16 byte'ı hemen gönder, gerisini
+    // THRE kesmesi halleder. FIFO hâlâ boşalıyorsa kesmeyi şimdi aç; FIFO
+    // boşalınca kesme gelir ve halkayı o gönderir.
+    if (!tx_active) {
+        if (inb(port + UART_LSR) & UART_LSR_THRE) {
+            serial_fill_fifo();
+        } else {
+            outb(port + UART_IER, UART_IER_RDI | UART_IER_THRI);
+            tx_active = 1;
+        }
+    }
+
+    irq_restore(flags);
+}
+
+void serial_putc(char c) {
+    if (!uart_present) return;
+
+    if (c == '\n') serial_putc('\r');
+    if (uart_irq_mode) {
+        serial_enqueue(c);
+    } else {
+        serial_putc_polled(c);
+    }
+}
+
+void serial_write(const char* s, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        serial_putc(s[i]);
+    }
+}
+
+void serial_puts(const char* s) {
+    while (*s) {
+        serial_putc(*s++);
+    }
+}
+
+void serial_enter_polled_mode() {
+    if (!uart_present) return;
+
+    asm volatile ("cli");
+    outb(port + UART_IER, 0x00);
+    uart_irq_mode = 0;
+    tx_active = 0;
+
+    // Kuyrukta kalanları gönder ki çöküşten önceki çıktı kaybolmasın
+    while (tx_tail != tx_head) {
+        serial_putc_polled(tx_ring[tx_tail & SERIAL_TX_RING_MASK]);
+        tx_tail++;
+    }
+}
+
+void serial_set_rx_handler(serial_rx_handler_t handler) {
+    rx_handler = handler;
+}
+
+int serial_is_present() {
+    return uart_present;
+}
+
+// --- /dev/ttyS0 ---
+
+static int serial_readable(void* arg) {
+    return rx_head != rx_tail;
+}
+
+static size_t serial_dev_read(vfs_node_t* node, u32 offset, size_t size, u8* buffer) {
+    if (!size) return 0;
+    u32 flags = irq_save();
+    waitq_wait_event(&rx_wq, serial_readable, NULL);
+    size_t n = 0;
+    while (n < size && rx_tail != rx_head) {
+        buffer[n++] = (u8)rx_ring[rx_tail & SERIAL_RX_RING_MASK];
+        rx_tail++;
+    }
+    irq_restore(flags);
+    return n;
+}
+
+static size_t serial_dev_write(vfs_node_t* node, u32 offset, size_t size, const u8* buffer) {
+    serial_write((const char*)buffer, size);
+    return size;
+}
+
+// Gönderim hiçbir zaman beklemez (halka dolunca en eskisi elle gönderilir)
+static u32 serial_dev_poll(vfs_node_t* node, poll_table_t* pt) {
+    poll_wait(&rx_wq, pt);
+    return (rx_head != rx_tail ? EPOLLIN : 0) | EPOLLOUT;
+}
+
+static int serial_dev_open(vfs_node_t* node, u32 flags) {
+    if (!uart_irq_mode) return -1;
+    u32 irq = irq_save();
+    rx_opened++;
+    irq_restore(irq);
+    return 0;
+}
+
+// Son kapanışta okunmamış baytlar atılır ve girdi yeniden rx_handler'a gider
+static int serial_dev_close(vfs_node_t* node) {
+    u32 flags = irq_save();
+    if (--rx_opened == 0) rx_tail = rx_head;
+    irq_restore(flags);
+    return 0;
+}
+
+vfs_node_t* serial_device() {
+    if (!tty_node.read) {
+        strlcpy(tty_node.name, "ttyS0", sizeof(tty_node.name));
+        tty_node.type = FS_NODE_DEVICE;
+        tty_node.permissions = 0666;
+        tty_node.open = serial_dev_open;
+        tty_node.close = serial_dev_close;
+        tty_node.read = serial_dev_read;
+        tty_node.write = serial_dev_write;
+        tty_node.poll = serial_dev_poll;
+    }
+    return &tty_node;
+}
@@ -0,0 +1,47 @@
+#ifndef SERIAL_H
+#define SERIAL_H
+
+#include <stddef.h>
+#include "utils.h"
+#include "vfs.h"
+
+// 16550 UART (COM1) sürücüsü. Açılışta önce polled (bekleme döngülü) modda
+// çalışır; serial_init() sonrası gönderim kesme tabanlı bir halka tampondan
+// yapılır ve her THRE kesmesinde 16 byte'lık FIFO bir seferde doldurulur.
+
+#define SERIAL_COM1_BASE 0x3F8
+#define SERIAL_COM1_IRQ  4
+
+#define SERIAL_TX_RING_SIZE 4096 // 2'nin kuvveti olmalı
+#define SERIAL_RX_RING_SIZE 256  // 2'nin kuvveti olmalı
+
+// Alınan her karakter için çağrılan fonksiyon (IRQ bağlamında çalışır)
+typedef void (*serial_rx_handler_t)(char c);
+
+// Portu 115200 8N1 olarak ayarlar, kesmeler kapalı (polled mod).
+// Başka hiçbir alt sisteme ihtiyaç duymaz, ilk çağrılacak fonksiyon olabilir.
+void serial_early_init();
+
+// IRQ4'ü kaydeder ve kesme tabanlı gönderim/alıma geçer. init_idt() sonrası çağrılmalı.
+void serial_init();
+
+// Bir karakter/bayt dizisi gönderir. '\n' -> "\r\n" çevrilir.
+void serial_putc(char c);
+void serial_write(const char* s, size_t len);
+void serial_puts(const char* s);
+
+// Kesme modunu kapatır, tampondakileri boşaltır ve bundan sonra her baytı
+// doğrudan porta yazar. kernel_panic tarafından kullanılır.
+void serial_enter_polled_mode();
+
+void serial_set_rx_handler(serial_rx_handler_t handler);
+
+// Karakter aygıtı (/dev/ttyS0). Açık olduğu sürece gelen baytlar rx_handler'a
+// (shell konsolu) değil aygıtın okuyucularına gider; poll veri varken EPOLLIN,
+// her zaman EPOLLOUT döner. Kesme modu yoksa açılamaz.
+vfs_node_t* serial_device();
+
+// Seri port bir konsol olarak kullanılabilir durumda mı (UART bulundu mu)
+int serial_is_present();
+
+#endif
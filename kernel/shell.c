@@ -4,14 +4,145 @@
 #include "string.h" // Yeni
 #include "pmm.h"    // Yeni
 #include "utils.h"
+#include "serial.h"
+#include "printf.h"
+#include "bcache.h"
+#include "pci.h"
+#include "ipc.h"
+#include "sched.h"
+#include "pipe.h"
+#include "fdtable.h"
+#include "vfs.h"
+#include "io.h"
+#include "prof.h"
 
 #define PROMPT "MK++ > "
 #define MAX_CMD_LEN 256
+#define MAX_ARGS 32
+#define SHELL_MAX_STAGES 8
 
 // Komut tamponu ve mevcut pozisyon
 static char cmd_buffer[MAX_CMD_LEN];
 static int cmd_pos = 0;
 
+// Seri port da konsol olarak kullanılıyorsa çıktı oraya da yansıtılır
+static int serial_console = 0;
+
+// Tuş işlenirken (kesme bağlamı) kesilen görevin fd'leri shell'e ait değildir
+static int in_keypress = 0;
+
+// --- Shell Thread'i ---
+// Klavye/seri kesmesi yalnızca satırı düzenler. Enter'da satır "shell"
+// thread'ine verilir; komut görev bağlamında (kendi yığını ve fd tablosuyla,
+// gerekirse uyuyarak) çalışır. Komut sürerken girilen bir sonraki satır
+// bekletilir; o da doluysa yeni satır atılır.
+
+static task_t* shell_task = NULL;
+static char pending_line[MAX_CMD_LEN]; // Kesme bağlamı yazar, thread okur
+static char run_line[MAX_CMD_LEN];     // Çalışan komutun satırı (yerinde bölünür)
+static volatile int line_pending = 0;
+
+// --- Boru Hattı (Pipeline) ---
+// `a | b > dosya` gibi bir satırda her aşama kendi thread'inde, aynı anda
+// çalışır: aşamanın fd 0/1'i önceki/sonraki aşamaya bağlanan borunun uçları
+// ya da '<' / '>' ile verilen dosyalardır. Yönlendirilmemiş çıktı konsola
+// gider, yönlendirilmemiş girdi boştur. Aynı anda tek bir boru hattı çalışır;
+// istem (prompt) son aşama bitince yeniden yazılır.
+
+typedef struct {
+    char** argv;            // job.argv içinde, NULL ile biten dilim
+    int argc;
+    char* in_path;          // '<' ile verilen dosya
+    char* out_path;         // '>' ile verilen dosya
+} shell_stage_t;
+
+static struct {
+    char line[MAX_CMD_LEN]; // Aşamalar çalışırken cmd_buffer yeniden kullanılır
+    char* argv[MAX_ARGS];
+    shell_stage_t stages[SHELL_MAX_STAGES];
+    int nr_stages;
+    volatile int running;   // Henüz bitmemiş aşama sayısı
+} job;
+
+static void shell_stage_exit();
+
+// Boru hattı aşamasının fd'si (0: girdi, 1: çıktı) yönlendirilmiş mi; konsola bağlıysa 0
+static int shell_stdio(int fd) {
+    task_t* self = sched_current();
+    if (in_keypress || !self || !self->files) return 0;
+    file_t* file = fd_get(self->files, fd);
+    if (!file) return 0;
+    file_put(file);
+    return 1;
+}
+
+// Okuyan taraf kapandıysa (EPIPE) aşamanın işi bitmiştir
+static void shell_stage_output(const char* s, u32 len) {
+    if (vfs_write(1, s, len) == (size_t)-1) shell_stage_exit();
+}
+
+// --- Konsol Çıktısı ---
+// Tüm shell çıktısı bu iki fonksiyondan geçer (VGA + varsa seri konsol ya da
+// aşamanın yönlendirilmiş çıktısı).
+
+static void shell_write(const char* s, u8 attr) {
+    if (shell_stdio(1)) {
+        shell_stage_output(s, strlen(s));
+        return;
+    }
+    write_vga_at(s, -1, -1, attr);
+    if (serial_console) serial_puts(s);
+}
+
+static void shell_putc(char c, u8 attr) {
+    if (shell_stdio(1)) {
+        shell_stage_output(&c, 1);
+        return;
+    }
+    write_char_at(c, -1, -1, attr);
+    if (serial_console) {
+        if (c == '\b') serial_puts("\b \b"); // Terminalde karakteri sil
+        else serial_putc(c);
+    }
+}
+
+// --- Aşama Girdisi ---
+
+// Girdi yönlendirilmemişse (konsol) hemen 0 (dosya sonu) döner
+static int shell_read(char* buf, u32 size) {
+    if (!shell_stdio(0)) return 0;
+    size_t n = vfs_read(0, buf, size);
+    return n == (size_t)-1 ? 0 : (int)n;
+}
+
+typedef struct {
+    char buf[128];
+    u32 pos;
+    u32 len;
+} shell_input_t;
+
+static int shell_getc(shell_input_t* in) {
+    if (in->pos == in->len) {
+        int n = shell_read(in->buf, sizeof(in->buf));
+        if (n <= 0) return -1;
+        in->pos = 0;
+        in->len = n;
+    }
+    return (u8)in->buf[in->pos++];
+}
+
+// '\n' dahil bir satır okur (sığmayan kısım sonraki satır olarak gelir); dosya sonunda 0
+static int shell_getline(shell_input_t* in, char* line, u32 size) {
+    u32 n = 0;
+    int c;
+    while (n < size - 1 && (c = shell_getc(in)) >= 0) {
+        line[n++] = (char)c;
+        if (c == '\n') break;
+    }
+    line[n] = '\0';
+    return n;
+}
+
 // --- Komut Fonksiyonları ---
 // Her komut aynı imzaya sahip olmalı: int func(int argc, char** argv)
 
@@ -20,6 +151,15 @@ int cmd_echo(int argc, char** argv);
 int cmd_memstat(int argc, char** argv);
 int cmd_panic_test(int argc, char** argv);
 int cmd_clear(int argc, char** argv);
+int cmd_bcache(int argc, char** argv);
+static int cmd_lspci(int argc, char** argv); // coresystem.c'de de aynı isimde bir komut var
+int cmd_ipcbench(int argc, char** argv);
+static int cmd_cat(int argc, char** argv);
+static int cmd_grep(int argc, char** argv);
+static int cmd_head(int argc, char** argv);
+static int cmd_wc(int argc, char** argv);
+static int cmd_hexdump(int argc, char** argv);
+static int cmd_prof(int argc, char** argv);
 
 // --- Komut Tablosu ---
 // Yeni bir komut eklemek için buraya bir satır eklemek yeterlidir.
@@ -38,26 +178,43 @@ const shell_command_t commands[] = {
     {"memstat", "Displays physical memory usage.", cmd_memstat},
     {"clear", "Clears the screen.", cmd_clear},
     {"panic", "Tests the kernel panic.", cmd_panic_test},
+    {"bcache", "Displays block cache and disk I/O statistics.", cmd_bcache},
+    {"lspci", "Lists PCI devices.", cmd_lspci},
+    {"ipcbench", "Measures IPC call/reply round-trip latency.", cmd_ipcbench},
+    {"cat", "Prints files, or its input if none is given.", cmd_cat},
+    {"grep", "Prints input lines containing a pattern.", cmd_grep},
+    {"head", "Prints the first lines of its input (-n N).", cmd_head},
+    {"wc", "Counts lines, words and bytes of its input.", cmd_wc},
+    {"hexdump", "Dumps memory as hex and ASCII.", cmd_hexdump},
+    {"prof", "Sampling profiler (start, stop, report).", cmd_prof},
     {0, 0, 0} // Tablonun sonunu işaretler
 };
 
 // --- Komut İşleme Mantığı ---
 
-static void shell_execute_command(char* input) {
-    char* argv[32]; // Maksimum 32 argüman
-    int argc = 0;
+static int shell_is_operator(const char* tok) {
+    return tok[1] == '\0' && (tok[0] == '|' || tok[0] == '<' || tok[0] == '>');
+}
 
-    char* token = strtok(input, " ");
-    while (token != NULL && argc < 31) {
-        argv[argc++] = token;
-        token = strtok(NULL, " ");
+// Satırı boşluklardan böler; '|', '<' ve '>' bitişik yazılsa da ayrı kelimedir
+static int shell_tokenize(char* s, char** argv) {
+    int argc = 0;
+    while (argc < MAX_ARGS - 1) {
+        while (*s == ' ') *s++ = '\0';
+        if (!*s) break;
+        if (*s == '|' || *s == '<' || *s == '>') {
+            argv[argc++] = *s == '|' ? "|" : *s == '<' ? "<" : ">";
+            *s++ = '\0';
+            continue;
+        }
+        argv[argc++] = s;
+        while (*s && *s != ' ' && *s != '|' && *s != '<' && *s != '>') s++;
     }
     argv[argc] = NULL;
+    return argc;
+}
 
-    if (argc == 0) {
-        return; // Boş komut
-    }
-
+static void shell_run(int argc, char** argv) {
     // Komutu tabloda ara ve çalıştır
     for (int i = 0; commands[i].name != 0; i++) {
         if (strcmp(commands[i].name, argv[0]) == 0) {
@@ -66,31 +223,172 @@ static void shell_execute_command(char* input) {
         }
     }
     
-    write_vga_at("Command not found: ", -1, -1, 0x0C);
-    write_vga_at(argv[0], -1, -1, 0x0C);
-    write_char_at('\n', -1, -1, 0x07);
+    shell_write("Command not found: ", 0x0C);
+    shell_write(argv[0], 0x0C);
+    shell_putc('\n', 0x07);
+}
+
+// job.argv'yi '|' ile aşamalara böler ve yönlendirmeleri ayıklar (yerinde)
+static int shell_parse_pipeline(int argc) {
+    char** argv = job.argv;
+    shell_stage_t* st = &job.stages[0];
+    memset(job.stages, 0, sizeof(job.stages));
+    st->argv = argv;
+    job.nr_stages = 1;
+
+    int n = 0;
+    for (int i = 0; i < argc; i++) {
+        char* tok = argv[i];
+        if (!shell_is_operator(tok)) {
+            argv[n++] = tok;
+            st->argc++;
+        } else if (tok[0] == '|') {
+            if (!st->argc || job.nr_stages == SHELL_MAX_STAGES) goto syntax;
+            argv[n++] = NULL;
+            st = &job.stages[job.nr_stages++];
+            st->argv = &argv[n];
+        } else {
+            if (i + 1 >= argc || shell_is_operator(argv[i + 1])) goto syntax;
+            if (tok[0] == '<') st->in_path = argv[++i];
+            else st->out_path = argv[++i];
+        }
+    }
+    argv[n] = NULL;
+    if (st->argc) return 0;
+
+syntax:
+    shell_write("Syntax error in pipeline.\n", 0x0C);
+    return -1;
+}
+
+static void shell_stage_main(void* arg) {
+    shell_stage_t* st = (shell_stage_t*)arg;
+    shell_run(st->argc, st->argv);
+    shell_stage_exit();
+}
+
+// Uçlar hemen kapanır: sonraki aşama dosya sonunu, önceki EPIPE'ı görür
+static void shell_stage_exit() {
+    task_t* self = sched_current();
+    fd_table_t* files = self->files;
+    u32 flags = irq_save();
+    self->files = NULL;
+    fdtable_switch(NULL);
+    irq_restore(flags);
+    fdtable_put(files);
+
+    flags = irq_save();
+    int last = --job.running == 0;
+    irq_restore(flags);
+    if (last) shell_write(PROMPT, 0x0A);
+    kthread_exit();
+}
+
+// Aşamaların fd tablolarını kurar ve thread'lerini başlatır. En az bir aşama
+// başladıysa 1 döner (istemi son aşama yazar).
+static int shell_start_pipeline() {
+    fd_table_t* tables[SHELL_MAX_STAGES];
+    file_t* pipe_in = NULL; // Önceki aşamanın borusunun okuyan ucu
+    const char* error = NULL;
+    int n = job.nr_stages;
+    int s;
+
+    for (s = 0; s < n && !error; s++) {
+        shell_stage_t* st = &job.stages[s];
+        file_t* in = pipe_in;
+        file_t* out = NULL;
+        pipe_in = NULL;
+
+        if (s + 1 < n && pipe_create(&pipe_in, &out) < 0) error = "out of memory";
+        // Dosya yönlendirmesi borunun yerine geçer
+        if (st->in_path) {
+            file_put(in);
+            in = vfs_open_file(st->in_path, O_RDONLY);
+            if (!in) error = st->in_path;
+        }
+        if (st->out_path) {
+            file_put(out);
+            out = vfs_open_file(st->out_path, O_WRONLY | O_CREAT | O_TRUNC);
+            if (!out) error = st->out_path;
+        }
+
+        tables[s] = fdtable_create();
+        if (!tables[s]) {
+            file_put(in);
+            file_put(out);
+            error = "out of memory";
+            continue;
+        }
+        if (in) fd_install_at(tables[s], 0, in);
+        if (out) fd_install_at(tables[s], 1, out);
+    }
+
+    if (error) {
+        file_put(pipe_in);
+        while (s-- > 0) fdtable_put(tables[s]);
+        shell_write("Cannot start pipeline: ", 0x0C);
+        shell_write(error, 0x0C);
+        shell_putc('\n', 0x07);
+        return 0;
+    }
+
+    // Aşamalar fd tabloları atanmadan çalışmasın: kesmeler kapalıyken görev değişmez
+    u32 flags = irq_save();
+    for (s = 0; s < n; s++) {
+        task_t* t = kthread_create(job.stages[s].argv[0], shell_stage_main, &job.stages[s]);
+        if (!t) break;
+        t->files = tables[s];
+        job.running++;
+    }
+    irq_restore(flags);
+
+    if (s < n) {
+        shell_write("Cannot start pipeline: out of memory\n", 0x0C);
+        while (s < n) fdtable_put(tables[s++]);
+    }
+    return job.running > 0;
+}
+
+// Boru hattı başlatıldıysa 1 döner
+static int shell_execute_command(char* input) {
+    char* argv[MAX_ARGS];
+
+    if (!strchr(input, '|') && !strchr(input, '<') && !strchr(input, '>')) {
+        int argc = shell_tokenize(input, argv);
+        if (argc) shell_run(argc, argv);
+        return 0;
+    }
+
+    if (job.running) {
+        shell_write("A pipeline is already running.\n", 0x0C);
+        return 0;
+    }
+    strlcpy(job.line, input, sizeof(job.line));
+    int argc = shell_tokenize(job.line, job.argv);
+    if (!argc || shell_parse_pipeline(argc) < 0) return 0;
+    return shell_start_pipeline();
 }
 
 // --- Komut Fonksiyonlarının Implementasyonu ---
 
 int cmd_help(int argc, char** argv) {
-    write_vga_at("MicroKernel++ Shell - v0.4\nAvailable commands:\n", -1, -1, 0x0A);
+    shell_write("MicroKernel++ Shell - v0.4\nAvailable commands:\n", 0x0A);
     for (int i = 0; commands[i].name != 0; i++) {
-        write_vga_at("  ", -1, -1, 0x07);
-        write_vga_at(commands[i].name, -1, -1, 0x0E);
-        write_vga_at("\t- ", -1, -1, 0x07);
-        write_vga_at(commands[i].description, -1, -1, 0x07);
-        write_char_at('\n', -1, -1, 0x07);
+        shell_write("  ", 0x07);
+        shell_write(commands[i].name, 0x0E);
+        shell_write("\t- ", 0x07);
+        shell_write(commands[i].description, 0x07);
+        shell_putc('\n', 0x07);
     }
     return 0;
 }
 
 int cmd_echo(int argc, char** argv) {
     for (int i = 1; i < argc; i++) {
-        write_vga_at(argv[i], -1, -1, 0x0F);
-        write_char_at(' ', -1, -1, 0x0F);
+        shell_write(argv[i], 0x0F);
+        shell_putc(' ', 0x0F);
     }
-    write_char_at('\n', -1, -1, 0x07);
+    shell_putc('\n', 0x07);
     return 0;
 }
 
@@ -99,17 +397,17 @@ int cmd_memstat(int argc, char** argv) {
     u32 used_mem = pmm_get_used_mem();
     u32 total_mem = pmm_get_total_mem();
     
-    write_vga_at("Physical Memory Usage:\n", -1, -1, 0x0B);
+    shell_write("Physical Memory Usage:\n", 0x0B);
     
-    utoa(used_mem / 1024, buffer, 10);
-    write_vga_at("  Used: ", -1, -1, 0x07);
-    write_vga_at(buffer, -1, -1, 0x0F);
-    write_vga_at(" KB\n", -1, -1, 0x07);
+    ksnprintf(buffer, sizeof(buffer), "%u", used_mem / 1024);
+    shell_write("  Used: ", 0x07);
+    shell_write(buffer, 0x0F);
+    shell_write(" KB\n", 0x07);
 
-    utoa(total_mem / 1024, buffer, 10);
-    write_vga_at("  Total: ", -1, -1, 0x07);
-    write_vga_at(buffer, -1, -1, 0x0F);
-    write_vga_at(" KB\n", -1, -1, 0x07);
+    ksnprintf(buffer, sizeof(buffer), "%u", total_mem / 1024);
+    shell_write("  Total: ", 0x07);
+    shell_write(buffer, 0x0F);
+    shell_write(" KB\n", 0x07);
 
     return 0;
 }
@@ -124,28 +422,285 @@ int cmd_clear(int argc, char** argv) {
     return 0;
 }
 
+int cmd_bcache(int argc, char** argv) {
+    char line[96];
+    bcache_stats_t st;
+    bcache_get_stats(&st);
+
+    u32 lookups = st.hits + st.misses;
+    shell_write("Block Cache:\n", 0x0B);
+    ksnprintf(line, sizeof(line), "  Hits: %u  Misses: %u  Hit rate: %u%%\n",
+              st.hits, st.misses, lookups ? st.hits * 100 / lookups : 0);
+    shell_write(line, 0x07);
+    ksnprintf(line, sizeof(line), "  Buffers: %u (%u KB)  Dirty: %u\n",
+              st.buffers, st.buffers * (BCACHE_BLOCK_SIZE / 1024), st.dirty);
+    shell_write(line, 0x07);
+    ksnprintf(line, sizeof(line), "  Disk reads: %u  Writebacks: %u  Flusher runs: %u\n",
+              st.reads, st.writebacks, st.flusher_runs);
+    shell_write(line, 0x07);
+    ksnprintf(line, sizeof(line), "  Evictions: %u  Pages returned to PMM: %u\n",
+              st.evictions, st.shrunk);
+    shell_write(line, 0x07);
+
+    for (blk_dev_t* dev = blk_first(); dev; dev = dev->next) {
+        ksnprintf(line, sizeof(line), "  %s: %u reads, %u writes, %u requests, %u merges, %u errors\n",
+                  dev->name, dev->stats.reads, dev->stats.writes, dev->stats.requests,
+                  dev->stats.merges, dev->stats.errors);
+        shell_write(line, 0x0F);
+    }
+    return 0;
+}
+
+static int cmd_lspci(int argc, char** argv) {
+    char line[96];
+    for (u32 i = 0; i < pci_device_count(); i++) {
+        pci_device_t* d = pci_get_device(i);
+        ksnprintf(line, sizeof(line), "%02x:%02x.%u %04x:%04x %s", d->bus, d->dev, d->func,
+                  d->vendor_id, d->device_id, pci_class_name(d->class_code, d->subclass));
+        shell_write(line, 0x07);
+        if (d->driver) {
+            ksnprintf(line, sizeof(line), " [%s]", d->driver->name);
+            shell_write(line, 0x0F);
+        }
+        shell_write("\n", 0x07);
+    }
+    return 0;
+}
+
+static void prof_shell_out(const char* line) {
+    shell_write(line, 0x07);
+}
+
+// Düz profil konsola; katlanmış yığınlar (flame graph girdisi) seri porta
+static int cmd_prof(int argc, char** argv) {
+    char line[96];
+    prof_status_t st;
+    if (argc < 2) {
+        prof_get_status(&st);
+        ksnprintf(line, sizeof(line), "prof: %s, %u samples, %u dropped\n",
+                  st.running ? "running" : "stopped", st.samples, st.dropped);
+        shell_write(line, 0x07);
+        shell_write("usage: prof start|stop|report\n", 0x0C);
+        return 0;
+    }
+    if (strcmp(argv[1], "start") == 0) {
+        if (prof_start() < 0) {
+            shell_write("prof: a report is in progress\n", 0x0C);
+            return -1;
+        }
+    } else if (strcmp(argv[1], "stop") == 0) {
+        prof_stop();
+    } else if (strcmp(argv[1], "report") == 0) {
+        prof_get_status(&st);
+        if (st.running) {
+            shell_write("prof: stop the profiler first\n", 0x0C);
+            return -1;
+        }
+        shell_write("Profile:\n", 0x0B);
+        prof_report_flat(prof_shell_out);
+        serial_puts("# prof collapsed begin\n");
+        prof_report_collapsed(serial_puts);
+        serial_puts("# prof collapsed end\n");
+        shell_write("Collapsed stacks written to serial.\n", 0x07);
+    } else {
+        shell_write("usage: prof start|stop|report\n", 0x0C);
+        return -1;
+    }
+    return 0;
+}
+
+// --- Akış Komutları ---
+// Boru hattının ortasında ya da sonunda kullanılmak üzere: girdiyi shell_read
+// ile okur, çıktıyı shell_write ile yazar.
+
+static int cmd_cat(int argc, char** argv) {
+    char buf[128];
+    int n;
+    if (argc < 2) {
+        while ((n = shell_read(buf, sizeof(buf) - 1)) > 0) {
+            buf[n] = '\0';
+            shell_write(buf, 0x07);
+        }
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        int fd = vfs_open(argv[i], O_RDONLY);
+        if (fd < 0) {
+            shell_write("cat: cannot open ", 0x0C);
+            shell_write(argv[i], 0x0C);
+            shell_putc('\n', 0x07);
+            continue;
+        }
+        size_t r;
+        while ((r = vfs_read(fd, buf, sizeof(buf) - 1)) > 0 && r != (size_t)-1) {
+            buf[r] = '\0';
+            shell_write(buf, 0x07);
+        }
+        vfs_close(fd);
+    }
+    return 0;
+}
+
+static int cmd_grep(int argc, char** argv) {
+    char line[MAX_CMD_LEN];
+    shell_input_t in = { .pos = 0, .len = 0 };
+    if (argc < 2) {
+        shell_write("usage: grep <pattern>\n", 0x0C);
+        return -1;
+    }
+    while (shell_getline(&in, line, sizeof(line))) {
+        if (strstr(line, argv[1])) shell_write(line, 0x07);
+    }
+    return 0;
+}
+
+// Yeterli satır yazılınca girdi kapanır; yazan aşama EPIPE ile erken biter
+static int cmd_head(int argc, char** argv) {
+    char line[MAX_CMD_LEN];
+    shell_input_t in = { .pos = 0, .len = 0 };
+    u32 lines = 10;
+    if (argc > 2 && strcmp(argv[1], "-n") == 0) lines = (u32)strtoul(argv[2], NULL, 10);
+
+    u32 n = 0;
+    while (n < lines && shell_getline(&in, line, sizeof(line))) {
+        shell_write(line, 0x07);
+        if (strchr(line, '\n')) n++;
+    }
+    return 0;
+}
+
+static int cmd_wc(int argc, char** argv) {
+    char buf[128];
+    u32 lines = 0, words = 0, bytes = 0;
+    int in_word = 0;
+    int n;
+    while ((n = shell_read(buf, sizeof(buf))) > 0) {
+        bytes += n;
+        for (int i = 0; i < n; i++) {
+            char c = buf[i];
+            if (c == '\n') lines++;
+            if (c == ' ' || c == '\t' || c == '\n') {
+                in_word = 0;
+            } else if (!in_word) {
+                in_word = 1;
+                words++;
+            }
+        }
+    }
+    ksnprintf(buf, sizeof(buf), "%u %u %u\n", lines, words, bytes);
+    shell_write(buf, 0x0F);
+    return 0;
+}
+
+static int cmd_hexdump(int argc, char** argv) {
+    char line[96];
+    if (argc < 3) {
+        shell_write("usage: hexdump <address> <length>\n", 0x0C);
+        return -1;
+    }
+    u32 addr = (u32)strtoul(argv[1], NULL, 0);
+    u32 len = (u32)strtoul(argv[2], NULL, 0);
+    const u8* p = (const u8*)addr;
+
+    for (u32 off = 0; off < len; off += 16) {
+        int pos = ksnprintf(line, sizeof(line), "0x%08x: ", addr + off);
+        for (u32 i = 0; i < 16; i++) {
+            if (off + i < len) pos += ksnprintf(line + pos, sizeof(line) - pos, "%02x ", p[off + i]);
+            else pos += ksnprintf(line + pos, sizeof(line) - pos, "   ");
+        }
+        line[pos++] = ' ';
+        line[pos++] = '|';
+        for (u32 i = 0; i < 16 && off + i < len; i++) {
+            u8 c = p[off + i];
+            line[pos++] = (c >= 32 && c <= 126) ? (char)c : '.';
+        }
+        line[pos++] = '|';
+        line[pos++] = '\n';
+        line[pos] = '\0';
+        shell_write(line, 0x07);
+    }
+    return 0;
+}
+
 // --- Ana Shell Döngüsü ve Girdi İşleme ---
 
+// Terminal emülatörleri Enter için '\r', Backspace için DEL (0x7F) gönderir
+static void shell_handle_serial_char(char c) {
+    if (c == '\r') c = '\n';
+    else if (c == 0x7F) c = '\b';
+    shell_handle_keypress(c);
+}
+
 void shell_main_loop() {
-    write_vga_at(PROMPT, -1, -1, 0x0A);
+    shell_write(PROMPT, 0x0A);
+}
+
+static void shell_thread(void* arg) {
+    for (;;) {
+        u32 flags = irq_save();
+        while (!line_pending) sched_block();
+        strlcpy(run_line, pending_line, sizeof(run_line));
+        line_pending = 0;
+        irq_restore(flags);
+
+        // Boru hattı başladıysa istemi son aşama yazar
+        if (!run_line[0] || !shell_execute_command(run_line)) shell_write(PROMPT, 0x0A);
+    }
+}
+
+void shell_init() {
+    shell_task = kthread_create("shell", shell_thread, NULL);
+    if (!shell_task) shell_write("Cannot start shell thread: out of memory\n", 0x0C);
 }
 
 void shell_handle_keypress(char c) {
+    int outer = in_keypress;
+    in_keypress = 1;
     if (c == '\n') { // Enter
-        write_char_at(c, -1, -1, 0x07);
-        if (cmd_pos > 0) {
+        shell_putc(c, 0x07);
+        if (line_pending) {
+            shell_write("Shell busy, line dropped.\n", 0x0C);
+        } else {
             cmd_buffer[cmd_pos] = '\0'; // String'i sonlandır
-            shell_execute_command(cmd_buffer);
+            strlcpy(pending_line, cmd_buffer, sizeof(pending_line));
+            line_pending = 1;
+            if (shell_task) sched_wake(shell_task);
         }
         cmd_pos = 0;
-        write_vga_at(PROMPT, -1, -1, 0x0A);
     } else if (c == '\b') { // Backspace
         if (cmd_pos > 0) {
             cmd_pos--;
-            write_char_at('\b', -1, -1, 0x07);
+            shell_putc('\b', 0x07);
         }
     } else if (cmd_pos < MAX_CMD_LEN - 1) {
         cmd_buffer[cmd_pos++] = c;
-        write_char_at(c, -1, -1, 0x0F);
+        shell_putc(c, 0x0F);
+    }
+    in_keypress = outer;
+}
+
+// Seri port girdisini shell'e bağlar ve çıktıyı seri porta da yansıtır
+void shell_attach_serial_console() {
+    if (!serial_is_present()) return;
+    serial_console = 1;
+    serial_set_rx_handler(shell_handle_serial_char);
+}
+
+// Komutlar shell thread'inde çalıştığı için ölçüm IPC'de doğrudan uyuyabilir
+int cmd_ipcbench(int argc, char** argv) {
+    char line[96];
+    ipc_bench_result_t r;
+    u32 iterations = argc > 1 ? (u32)strtoul(argv[1], NULL, 10) : 10000;
+    if (!iterations) iterations = 1;
+    if (ipc_benchmark(iterations, &r) < 0) {
+        shell_write("ipcbench: out of memory\n", 0x0C);
+        return 1;
     }
-}
\ No newline at end of file
+    ksnprintf(line, sizeof(line), "IPC round trip (%u calls): min %u, avg %u, max %u cycles\n",
+              r.iterations, r.min_cycles, r.avg_cycles, r.max_cycles);
+    shell_write(line, 0x0F);
+    ksnprintf(line, sizeof(line), "  Direct switches: %u of %u\n", r.direct_switches, r.iterations * 2);
+    shell_write(line, 0x07);
+    return 0;
+}
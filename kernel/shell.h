@@ -4,7 +4,13 @@
 // Shell'in ana döngüsünü başlatır
 void shell_main_loop();
 
+// Komut satırlarını çalıştıran "shell" thread'ini başlatır (sched_init'ten sonra)
+void shell_init();
+
 // Klavye sürücüsünden bir tuş vuruşu alır ve işler
 void shell_handle_keypress(char c);
 
+// COM1'i ikinci bir konsol olarak bağlar (girdi + çıktı)
+void shell_attach_serial_console();
+
 #endif
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "shm.h"
+#include "slab.h"
+#include "io.h"
+#include "string.h"
+
+static slab_cache_t shm_cache = SLAB_CACHE_INIT("shm", sizeof(shm_t));
+
+static shm_t* shm_list = NULL; // Adı olan (unlink edilmemiş) nesneler
+
+static shm_t* shm_lookup(const char* name) {
+    for (shm_t* s = shm_list; s; s = s->next) {
+        if (strcmp(s->name, name) == 0) return s;
+    }
+    return NULL;
+}
+
+shm_t* shm_create(const char* name, u32 size) {
+    u32 pages = (size + PAGE_SIZE - 1) / PAGE_SIZE;
+    if (!name || !pages || pages > SHM_MAX_PAGES) return NULL;
+
+    shm_t* shm = (shm_t*)slab_alloc(&shm_cache);
+    if (!shm) return NULL;
+    shm->frames = (void**)pmm_alloc_zeroed_page();
+    if (!shm->frames) {
+        slab_free(&shm_cache, shm);
+        return NULL;
+    }
+    strlcpy(shm->name, name, sizeof(shm->name));
+    shm->nr_pages = pages;
+    shm->refcount = 1;
+
+    u32 flags = irq_save();
+    if (shm_lookup(shm->name)) {
+        irq_restore(flags);
+        pmm_free_page(shm->frames);
+        slab_free(&shm_cache, shm);
+        return NULL;
+    }
+    shm->next = shm_list;
+    shm_list = shm;
+    irq_restore(flags);
+    return shm;
+}
+
+shm_t* shm_open(const char* name) {
+    u32 flags = irq_save();
+    shm_t* shm = shm_lookup(name);
+    if (shm) shm->refcount++;
+    irq_restore(flags);
+    return shm;
+}
+
+void shm_get(shm_t* shm) {
+    u32 flags = irq_save();
+    shm->refcount++;
+    irq_restore(flags);
+}
+
+void shm_put(shm_t* shm) {
+    u32 flags = irq_save();
+    int last = --shm->refcount == 0;
+    irq_restore(flags);
+    if (!last) return;
+
+    // Hâlâ bir sayfa tablosunda duran çerçeveler o eşleme kalkınca serbest kalır
+    for (u32 i = 0; i < shm->nr_pages; i++) {
+        if (shm->frames[i]) pmm_free_page(shm->frames[i]);
+    }
+    pmm_free_page(shm->frames);
+    slab_free(&shm_cache, shm);
+}
+
+void shm_destroy(shm_t* shm) {
+    u32 flags = irq_save();
+    int owner = !shm->unlinked;
+    if (owner) {
+        shm_t** link = &shm_list;
+        while (*link && *link != shm) link = &(*link)->next;
+        if (*link) *link = shm->next;
+        shm->unlinked = 1;
+    }
+    irq_restore(flags);
+    if (owner) shm_put(shm);
+}
+
+void* shm_frame(shm_t* shm, u32 index) {
+    if (index >= shm->nr_pages) return NULL;
+    if (!shm->frames[index]) shm->frames[index] = pmm_alloc_zeroed_page();
+    return shm->frames[index];
+}
+
+u32 shm_map(mm_t* mm, shm_t* shm, u32 addr, u32 prot, u32 flags) {
+    return vmm_mmap_shm(mm, addr, shm->nr_pages * PAGE_SIZE, prot, flags & MAP_FIXED, shm, 0);
+}
+
+u32 sys_shm_map(u32 name_ptr, u32 size, u32 prot, ...) {
+    const char* name = (const char*)name_ptr;
+    if (!name) return MAP_FAILED;
+
+    shm_t* shm = shm_open(name);
+    if (!shm) {
+        // Yeni nesnenin oluşturan referansı sys_shm_unlink'e kadar durur
+        shm = shm_create(name, size);
+        if (!shm) return MAP_FAILED;
+        shm_get(shm);
+    }
+    u32 addr = shm_map(vmm_current(), shm, 0, prot, 0);
+    shm_put(shm); // Eşleme kendi referansını tutar
+    return addr;
+}
+
+u32 sys_shm_unlink(u32 name_ptr, ...) {
+    const char* name = (const char*)name_ptr;
+    shm_t* shm = name ? shm_open(name) : NULL;
+    if (!shm) return (u32)-1;
+    shm_destroy(shm);
+    shm_put(shm);
+    return 0;
+}
@@ -0,0 +1,60 @@
+#ifndef SHM_H
+#define SHM_H
+
+#include "utils.h"
+#include "vmm.h"
+
+// --- Paylaşımlı Bellek Nesneleri ---
+// Adlandırılmış, sayfa boyutunun katı büyüklükte bir çerçeve kümesi. Nesne
+// birden çok adres alanına eşlenebilir (shm_map): hepsi aynı fiziksel
+// çerçeveleri görür, veri kopyalanmaz. Çerçeveler ilk erişimde (sayfa
+// hatasında) sıfırlanmış olarak ayrılır.
+//
+// Ömür referans sayılarıyla yönetilir: nesneyi oluşturan, açan (shm_open) ve
+// onu eşleyen her VMA bir referans tutar; shm_destroy adı kaldırır ve
+// oluşturanın referansını bırakır, son eşleme de kalkınca nesne serbest kalır.
+// Çerçevelerin kendisi PMM referans sayılarıyla paylaşılır: nesne ve çerçeveyi
+// eşleyen her sayfa tablosu girdisi birer referans tutar.
+
+#define SHM_NAME_MAX  16
+#define SHM_MAX_PAGES (PAGE_SIZE / sizeof(void*)) // Tek sayfalık çerçeve tablosu: 4 MB
+
+typedef struct shm {
+    char name[SHM_NAME_MAX];
+    u32 nr_pages;
+    void** frames;          // Sayfa -> çerçeve; NULL: henüz dokunulmadı
+    u32 refcount;
+    u8 unlinked;            // shm_destroy çağrıldı, adla bulunamaz
+    struct shm* next;
+} shm_t;
+
+/**
+ * @brief Yeni bir nesne oluşturur (boyut sayfaya yuvarlanır).
+ * @return Nesne; ad kullanılıyorsa, boyut 0 ya da SHM_MAX_PAGES'ten büyükse veya bellek yoksa NULL.
+ */
+shm_t* shm_create(const char* name, u32 size);
+
+// Adla bulup referans alır; yoksa NULL. İş bitince shm_put.
+shm_t* shm_open(const char* name);
+
+void shm_get(shm_t* shm);
+void shm_put(shm_t* shm);
+
+// Adı kaldırır ve oluşturanın referansını bırakır; eşlemeler geçerli kalır
+void shm_destroy(shm_t* shm);
+
+/**
+ * @brief Nesneyi bir adres alanına eşler (MAP_SHARED). addr bir ipucudur;
+ *        MAP_FIXED verilirse tam o adrese eşlenir.
+ * @return Eşlemenin adresi ya da MAP_FAILED.
+ */
+u32 shm_map(mm_t* mm, shm_t* shm, u32 addr, u32 prot, u32 flags);
+
+// Sayfa hatası için: `index`inci sayfanın çerçevesi (gerekirse ayrılır); bellek yoksa NULL
+void* shm_frame(shm_t* shm, u32 index);
+
+// Syscall arayüzü: adla aç (yoksa `size` ile oluştur) ve eşle / adı kaldır
+u32 sys_shm_map(u32 name_ptr, u32 size, u32 prot, ...);
+u32 sys_shm_unlink(u32 name_ptr, ...);
+
+#endif
@@ -0,0 +1,49 @@
+#include "slab.h"
+#include "pmm.h"
+#include "string.h"
+#include "io.h"
+
+// Nesneler en az bir pointer boyutunda ve 8 byte hizalı tutulur
+static inline u32 slab_stride(const slab_cache_t* cache) {
+    u32 size = cache->object_size < sizeof(void*) ? sizeof(void*) : cache->object_size;
+    return (size + 7) & ~7u;
+}
+
+// Yeni bir sayfayı nesnelere bölüp serbest listeye ekler
+static int slab_grow(slab_cache_t* cache) {
+    u8* page = (u8*)pmm_alloc_page();
+    if (!page) return 0;
+
+    u32 stride = slab_stride(cache);
+    for (u32 off = 0; off + stride <= PAGE_SIZE; off += stride) {
+        *(void**)(page + off) = cache->free_list;
+        cache->free_list = page + off;
+    }
+    cache->pages++;
+    return 1;
+}
+
+// Önbellekler kesme handler'larından da kullanıldığı için liste irq_save altında
+void* slab_alloc(slab_cache_t* cache) {
+    u32 flags = irq_save();
+    if (!cache->free_list && !slab_grow(cache)) {
+        irq_restore(flags);
+        return NULL;
+    }
+
+    void* obj = cache->free_list;
+    cache->free_list = *(void**)obj;
+    cache->allocated++;
+    irq_restore(flags);
+    memset(obj, 0, cache->object_size);
+    return obj;
+}
+
+void slab_free(slab_cache_t* cache, void* obj) {
+    if (!obj) return;
+    u32 flags = irq_save();
+    *(void**)obj = cache->free_list;
+    cache->free_list = obj;
+    cache->allocated--;
+    irq_restore(flags);
+}
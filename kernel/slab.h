@@ -0,0 +1,29 @@
+#ifndef SLAB_H
+#define SLAB_H
+
+#include <stddef.h>
+#include "utils.h"
+
+// --- Sabit Boyutlu Nesne Önbelleği (Slab) ---
+// Çekirdekte henüz genel amaçlı bir heap yok. Aynı türden çok sayıda küçük
+// nesne (VFS düğümleri vb.) gereken modüller kendi slab_cache_t'lerini tanımlar;
+// nesneler PMM sayfalarından kesilir ve serbest bırakılanlar bir listede
+// tekrar kullanılmak üzere bekletilir.
+
+typedef struct slab_cache {
+    const char* name;
+    u32 object_size;
+    void* free_list;  // Boştaki nesneler, ilk word'leri bir sonrakini gösterir
+    u32 allocated;    // Kullanımdaki nesne sayısı
+    u32 pages;        // Bu önbelleğe verilmiş PMM sayfası sayısı
+} slab_cache_t;
+
+// Statik tanım için: static slab_cache_t c = SLAB_CACHE_INIT("name", sizeof(T));
+#define SLAB_CACHE_INIT(n, size) { (n), (size), 0, 0, 0 }
+
+// Sıfırlanmış bir nesne döner; bellek kalmadıysa NULL
+void* slab_alloc(slab_cache_t* cache);
+
+void slab_free(slab_cache_t* cache, void* obj);
+
+#endif
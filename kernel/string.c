@@ -2,7 +2,64 @@
 #include <stddef.h>
 #include "utils.h"
 
+// --- Word-at-a-time yardımcıları ---
+// Bir 32-bit word'de sıfır byte olup olmadığı tek bir işlemle bulunur:
+// (v - 0x01010101) & ~v & 0x80808080 sadece sıfır byte'larda yüksek biti bırakır.
+// Hizalı bir word asla sayfa sınırını geçmediği için string'in sonundan
+// sonrasını okumak güvenlidir.
+
+typedef u32 __attribute__((may_alias)) word_t;
+
+#define ONES  0x01010101u
+#define HIGHS 0x80808080u
+#define HAS_ZERO(v) (((v) - ONES) & ~(v) & HIGHS)
+#define WORD_ALIGNED(p) (((u32)(p) & 3) == 0)
+
+size_t strlen(const char* s) {
+    const char* p = s;
+    while (!WORD_ALIGNED(p)) {
+        if (*p == '\0') return p - s;
+        p++;
+    }
+    const word_t* w = (const word_t*)p;
+    while (!HAS_ZERO(*w)) w++;
+    p = (const char*)w;
+    while (*p) p++;
+    return p - s;
+}
+
+size_t strnlen(const char* s, size_t maxlen) {
+    const char* p = s;
+    const char* end = s + maxlen;
+    while (p < end && !WORD_ALIGNED(p)) {
+        if (*p == '\0') return p - s;
+        p++;
+    }
+    const word_t* w = (const word_t*)p;
+    while ((const char*)w + 4 <= end && !HAS_ZERO(*w)) w++;
+    p = (const char*)w;
+    while (p < end && *p) p++;
+    return p - s;
+}
+
 int strcmp(const char* s1, const char* s2) {
+    // İki string aynı hizalamadaysa gövde word word karşılaştırılabilir
+    if (((u32)s1 & 3) == ((u32)s2 & 3)) {
+        while (!WORD_ALIGNED(s1)) {
+            if (*s1 == '\0' || *s1 != *s2) goto bytewise;
+            s1++;
+            s2++;
+        }
+        const word_t* w1 = (const word_t*)s1;
+        const word_t* w2 = (const word_t*)s2;
+        while (*w1 == *w2 && !HAS_ZERO(*w1)) {
+            w1++;
+            w2++;
+        }
+        s1 = (const char*)w1;
+        s2 = (const char*)w2;
+    }
+bytewise:
     while (*s1 && (*s1 == *s2)) {
         s1++;
         s2++;
@@ -10,57 +67,161 @@ int strcmp(const char* s1, const char* s2) {
     return *(const unsigned char*)s1 - *(const unsigned char*)s2;
 }
 
-// Basit, re-entrant olmayan strtok
-char* strtok(char* str, const char* delim) {
-    static char* last;
-    if (str) {
-        last = str;
+int strncmp(const char* s1, const char* s2, size_t n) {
+    if (((u32)s1 & 3) == ((u32)s2 & 3)) {
+        while (n && !WORD_ALIGNED(s1)) {
+            if (*s1 == '\0' || *s1 != *s2) goto bytewise;
+            s1++;
+            s2++;
+            n--;
+        }
+        const word_t* w1 = (const word_t*)s1;
+        const word_t* w2 = (const word_t*)s2;
+        while (n >= 4 && *w1 == *w2 && !HAS_ZERO(*w1)) {
+            w1++;
+            w2++;
+            n -= 4;
+        }
+        s1 = (const char*)w1;
+        s2 = (const char*)w2;
     }
-    if (!last || *last == '\0') {
-        return NULL;
+bytewise:
+    while (n && *s1 && (*s1 == *s2)) {
+        s1++;
+        s2++;
+        n--;
     }
+    if (n == 0) return 0;
+    return *(const unsigned char*)s1 - *(const unsigned char*)s2;
+}
 
-    char* token_start = last;
-    while (*last != '\0') {
-        const char* d = delim;
-        while (*d != '\0') {
-            if (*last == *d) {
-                *last = '\0';
-                last++;
-                return token_start;
-            }
-            d++;
-        }
-        last++;
+char* strchr(const char* s, int c) {
+    char ch = (char)c;
+    while (!WORD_ALIGNED(s)) {
+        if (*s == ch) return (char*)s;
+        if (*s == '\0') return NULL;
+        s++;
+    }
+    // Aranan karakter ya da sonlandırıcı içeren ilk word'e kadar atla
+    u32 mask = (u8)ch * ONES;
+    const word_t* w = (const word_t*)s;
+    while (!HAS_ZERO(*w) && !HAS_ZERO(*w ^ mask)) w++;
+    s = (const char*)w;
+    while (*s != ch) {
+        if (*s == '\0') return NULL;
+        s++;
     }
-    return token_start;
+    return (char*)s;
 }
 
-char* utoa(unsigned int value, char* str, int base) {
-    char *ptr = str, *ptr1 = str, tmp_char;
-    unsigned int tmp_value;
+char* strrchr(const char* s, int c) {
+    char ch = (char)c;
+    if (ch == '\0') return strchr(s, 0);
 
-    if (base < 2 || base > 36) { *str = '\0'; return str; }
+    const char* last = NULL;
+    while ((s = strchr(s, ch)) != NULL) {
+        last = s++;
+    }
+    return (char*)last;
+}
 
-    if (value == 0) {
-        *ptr++ = '0';
-        *ptr = '\0';
-        return str;
+char* strstr(const char* haystack, const char* needle) {
+    size_t n = strlen(needle);
+    if (!n) return (char*)haystack;
+    while ((haystack = strchr(haystack, *needle)) != NULL) {
+        if (strncmp(haystack, needle, n) == 0) return (char*)haystack;
+        haystack++;
     }
+    return NULL;
+}
 
-    while (value > 0) {
-        tmp_value = value % base;
-        value /= base;
-        *ptr++ = (tmp_value < 10) ? ('0' + tmp_value) : ('A' + (tmp_value - 10));
+size_t strlcpy(char* dst, const char* src, size_t size) {
+    size_t len = strlen(src);
+    if (size > 0) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
     }
+    return len;
+}
 
-    *ptr = '\0';
-    ptr--;
+// Re-entrant strtok: tüm durum çağıranın verdiği `*saveptr` içinde tutulur
+char* strtok_r(char* str, const char* delim, char** saveptr) {
+    char* s = str ? str : *saveptr;
+    if (!s) return NULL;
+
+    // Baştaki ayırıcıları atla
+    while (*s && strchr(delim, *s)) s++;
+    if (*s == '\0') {
+        *saveptr = s;
+        return NULL;
+    }
 
-    while (ptr1 < ptr) {
-        tmp_char = *ptr;
-        *ptr-- = *ptr1;
-        *ptr1++ = tmp_char;
+    char* token = s;
+    while (*s && !strchr(delim, *s)) s++;
+    if (*s) {
+        *s++ = '\0';
     }
-    return str;
-}
\ No newline at end of file
+    *saveptr = s;
+    return token;
+}
+
+// Eski, re-entrant olmayan arayüz; yeni kod strtok_r kullanmalı
+char* strtok(char* str, const char* delim) {
+    static char* last;
+    return strtok_r(str, delim, &last);
+}
+
+unsigned long strtoul(const char* nptr, char** endptr, int base) {
+    const char* s = nptr;
+    unsigned long result = 0;
+    int neg = 0;
+    int overflow = 0;
+    int any = 0;
+
+    while (*s == ' ' || *s == '\t' || *s == '\n' || *s == '\r' || *s == '\f' || *s == '\v') s++;
+    if (*s == '-') { neg = 1; s++; }
+    else if (*s == '+') s++;
+
+    // Taban önekleri: 0x/0X (16), 0b/0B (2), 0 (8)
+    const char* prefix = NULL;
+    if ((base == 0 || base == 16) && s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
+        prefix = s;
+        s += 2;
+        base = 16;
+    } else if ((base == 0 || base == 2) && s[0] == '0' && (s[1] == 'b' || s[1] == 'B')) {
+        prefix = s;
+        s += 2;
+        base = 2;
+    } else if (base == 0) {
+        base = (s[0] == '0') ? 8 : 10;
+    }
+    if (base < 2 || base > 36) {
+        if (endptr) *endptr = (char*)nptr;
+        return 0;
+    }
+
+    unsigned long limit = (unsigned long)-1 / base;
+    for (;; s++) {
+        int digit;
+        if (*s >= '0' && *s <= '9')      digit = *s - '0';
+        else if (*s >= 'a' && *s <= 'z') digit = *s - 'a' + 10;
+        else if (*s >= 'A' && *s <= 'Z') digit = *s - 'A' + 10;
+        else break;
+        if (digit >= base) break;
+
+        any = 1;
+        if (result > limit || (result == limit && (unsigned long)digit > (unsigned long)-1 % base)) {
+            overflow = 1;
+        }
+        result = result * base + digit;
+    }
+
+    if (endptr) {
+        // "0x" gibi basamaksız bir önek sadece "0" olarak okunmuş sayılır
+        if (any) *endptr = (char*)s;
+        else *endptr = (char*)(prefix ? prefix + 1 : nptr);
+    }
+    if (overflow) return (unsigned long)-1;
+    return neg ? -result : result;
+}
@@ -1,8 +1,30 @@
 #ifndef STRING_H
 #define STRING_H
 
+#include <stddef.h>
+
+// strlen/strnlen/strcmp/strncmp/strchr gövdeyi 4 byte'lık word'ler halinde tarar
+size_t strlen(const char* s);
+size_t strnlen(const char* s, size_t maxlen);
 int strcmp(const char* s1, const char* s2);
-char* strtok(char* str, const char* delim);
-char* utoa(unsigned int value, char* str, int base); // Unsigned int to string
+int strncmp(const char* s1, const char* s2, size_t n);
+char* strchr(const char* s, int c);
+char* strrchr(const char* s, int c);
+char* strstr(const char* haystack, const char* needle);
+
+// Hedefi her zaman NUL ile sonlandırır; strlen(src) döner (>= size ise kesildi)
+size_t strlcpy(char* dst, const char* src, size_t size);
+
+char* strtok_r(char* str, const char* delim, char** saveptr);
+char* strtok(char* str, const char* delim); // Re-entrant değil, strtok_r tercih edin
+
+// base 0 ise önekten belirlenir: 0x -> 16, 0b -> 2, 0 -> 8, diğer -> 10
+unsigned long strtoul(const char* nptr, char** endptr, int base);
+
+// Bellek fonksiyonları (kernel/memory.c)
+void* memcpy(void* dest, const void* src, size_t len);
+void* memset(void* dest, int val, size_t len);
+void* memmove(void* dest, const void* src, size_t len);
+int memcmp(const void* a, const void* b, size_t len);
 
-#endif
\ No newline at end of file
+#endif
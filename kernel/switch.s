@@ -0,0 +1,22 @@
+.section .text
+.globl switch_to
+
+/* void switch_to(u32* prev_esp, u32 next_esp)
+   cdecl'e göre eax/ecx/edx çağıranındır; sadece ebp, ebx, esi, edi ve
+   ESP saklanır. Yeni görevin yığını aynı düzende hazırlanır (sched.c). */
+switch_to:
+    mov eax, [esp + 4]
+    mov edx, [esp + 8]
+
+    push ebp
+    push ebx
+    push esi
+    push edi
+    mov [eax], esp  /* Eski görevin yığın işaretçisini sakla */
+
+    mov esp, edx    /* Yeni görevin yığınına geç */
+    pop edi
+    pop esi
+    pop ebx
+    pop ebp
+    ret             /* Yeni görevin kaldığı yere (ya da kthread_start'a) dön */
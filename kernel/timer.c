@@ -0,0 +1,30 @@
+#include "timer.h"
+#include "sched.h"
+#include "idt.h"
+#include "io.h"
+#include "vdso.h"
+#include "prof.h"
+
+#define PIT_CHANNEL0 0x40
+#define PIT_COMMAND  0x43
+
+static volatile u32 ticks = 0;
+
+static void timer_handler() {
+    ticks++;
+    vdso_tick(ticks);
+    prof_tick(irq_frame()); // Görev değişiminden önce: örnek kesilen koda ait
+    sched_tick(ticks);
+}
+
+void timer_init() {
+    u32 divisor = PIT_BASE_FREQ / TIMER_HZ;
+    outb(PIT_COMMAND, 0x36); // Kanal 0, lo/hi byte, mod 3 (kare dalga)
+    outb(PIT_CHANNEL0, divisor & 0xFF);
+    outb(PIT_CHANNEL0, (divisor >> 8) & 0xFF);
+    irq_register_handler(0, timer_handler);
+}
+
+u32 timer_ticks() {
+    return ticks;
+}
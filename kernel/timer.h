@@ -0,0 +1,22 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+#include "utils.h"
+
+// --- Sistem Zamanlayıcısı (PIT) ---
+// PIT kanal 0, IRQ0'ı TIMER_HZ sıklıkta üretir. Her tick zamanlayıcıya
+// (sched_tick) iletilir: uyuyan görevler uyandırılır, zaman dilimi sayılır.
+
+#define TIMER_HZ        100
+#define PIT_BASE_FREQ   1193182
+
+void timer_init();
+
+// Açılıştan beri geçen tick sayısı
+u32 timer_ticks();
+
+static inline u32 timer_ms_to_ticks(u32 ms) {
+    return (ms * TIMER_HZ + 999) / 1000;
+}
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef ULOCK_H
+#define ULOCK_H
+
+#include "utils.h"
+
+// --- Kullanıcı Alanı Kilitleri (mutex / condvar) ---
+// Kullanıcı programları için yalnızca başlıktan oluşan kütüphane; çekirdeğe
+// derlenmez. Kilidin durumu tek bir u32'dir ve çekişme yoksa lock/unlock
+// birer atomik komuttur, syscall yapılmaz. Yalnızca beklemek ya da bekleyen
+// birini uyandırmak gerektiğinde futex syscall'ı (kernel/futex.h) çağrılır.
+//
+// Mutex durumları (Drepper, "Futexes Are Tricky", mutex2):
+//   0: serbest, 1: kilitli ve bekleyen yok, 2: kilitli ve bekleyen olabilir.
+// unlock yalnızca durum 2 ise çekirdeğe girer.
+//
+// Condvar bir sayaçtır: wait sayacın değerini okuyup mutex'i bırakır ve
+// sayaç değişmediyse uyur; signal/broadcast sayacı artırıp uyandırır.
+// Böylece mutex bırakılırken gelen bir signal kaçırılmaz. Bekleyen yoksa
+// signal/broadcast da çekirdeğe girmez.
+
+#define ULOCK_SYSCALL_FUTEX 18 // coresystem.c: SYSCALL_FUTEX
+#define ULOCK_FUTEX_WAIT    0  // futex.h: FUTEX_WAIT
+#define ULOCK_FUTEX_WAKE    1  // futex.h: FUTEX_WAKE
+
+typedef struct {
+    volatile u32 state;
+} umutex_t;
+
+typedef struct {
+    volatile u32 seq;
+    volatile u32 waiters;
+} ucond_t;
+
+#define UMUTEX_INIT { 0 }
+#define UCOND_INIT  { 0, 0 }
+
+static inline int ulock_futex(volatile u32* addr, u32 op, u32 val, u32 timeout_ms) {
+    int ret;
+    asm volatile ("int $0x80"
+                  : "=a"(ret)
+                  : "a"(ULOCK_SYSCALL_FUTEX), "b"(addr), "c"(op), "d"(val), "S"(timeout_ms)
+                  : "memory");
+    return ret;
+}
+
+static inline u32 ulock_cmpxchg(volatile u32* p, u32 expected, u32 desired) {
+    __atomic_compare_exchange_n(p, &expected, desired, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+    return expected; // Eski değer
+}
+
+static inline void umutex_init(umutex_t* m) {
+    m->state = 0;
+}
+
+static inline int umutex_trylock(umutex_t* m) {
+    return ulock_cmpxchg(&m->state, 0, 1) == 0;
+}
+
+static inline void umutex_lock(umutex_t* m) {
+    u32 c = ulock_cmpxchg(&m->state, 0, 1);
+    if (c == 0) return; // Hızlı yol: çekişme yok
+
+    // Bekleyen var olarak işaretle ve serbest kalana kadar uyu
+    if (c != 2) c = __atomic_exchange_n(&m->state, 2, __ATOMIC_ACQUIRE);
+    while (c != 0) {
+        ulock_futex(&m->state, ULOCK_FUTEX_WAIT, 2, 0);
+        c = __atomic_exchange_n(&m->state, 2, __ATOMIC_ACQUIRE);
+    }
+}
+
+static inline void umutex_unlock(umutex_t* m) {
+    // 1 -> 0 ise kimse beklemiyor; 2 ise biri uyandırılır
+    if (__atomic_fetch_sub(&m->state, 1, __ATOMIC_RELEASE) != 1) {
+        __atomic_store_n(&m->state, 0, __ATOMIC_RELEASE);
+        ulock_futex(&m->state, ULOCK_FUTEX_WAKE, 1, 0);
+    }
+}
+
+static inline void ucond_init(ucond_t* cv) {
+    cv->seq = 0;
+    cv->waiters = 0;
+}
+
+// Çağıran `m`yi tutmalıdır; dönüşte yine tutar
+static inline void ucond_wait(ucond_t* cv, umutex_t* m) {
+    __atomic_fetch_add(&cv->waiters, 1, __ATOMIC_RELAXED);
+    u32 seq = __atomic_load_n(&cv->seq, __ATOMIC_RELAXED);
+    umutex_unlock(m);
+    ulock_futex(&cv->seq, ULOCK_FUTEX_WAIT, seq, 0);
+    __atomic_fetch_sub(&cv->waiters, 1, __ATOMIC_RELAXED);
+
+    // Başka uyananlar da olabilir: mutex'i "bekleyen var" durumunda al
+    while (__atomic_exchange_n(&m->state, 2, __ATOMIC_ACQUIRE) != 0) {
+        ulock_futex(&m->state, ULOCK_FUTEX_WAIT, 2, 0);
+    }
+}
+
+static inline void ucond_signal(ucond_t* cv) {
+    __atomic_fetch_add(&cv->seq, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&cv->waiters, __ATOMIC_SEQ_CST)) ulock_futex(&cv->seq, ULOCK_FUTEX_WAKE, 1, 0);
+}
+
+static inline void ucond_broadcast(ucond_t* cv) {
+    __atomic_fetch_add(&cv->seq, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&cv->waiters, __ATOMIC_SEQ_CST)) ulock_futex(&cv->seq, ULOCK_FUTEX_WAKE, 0x7FFFFFFF, 0);
+}
+
+#endif
@@ -9,4 +9,17 @@ typedef unsigned long long u64;
 // Simple panic wrapper used across kernel modules
 void panic(const char* msg);
 
+// 64-bit sayıyı 32-bit bölene böler (libgcc'nin __udivdi3'üne gerek kalmadan).
+// Bölümü *n'ye yazar, kalanı döndürür.
+static inline u32 divmod64_32(u64* n, u32 d) {
+    u32 hi = (u32)(*n >> 32);
+    u32 lo = (u32)*n;
+    u32 qhi = hi / d;
+    u32 r = hi % d;
+    u32 qlo;
+    asm ("divl %4" : "=a"(qlo), "=d"(r) : "a"(lo), "d"(r), "rm"(d));
+    *n = ((u64)qhi << 32) | qlo;
+    return r;
+}
+
 #endif
\ No newline at end of file
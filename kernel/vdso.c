@@ -0,0 +1,169 @@
+#include "vdso.h"
+#include "vmm.h"
+#include "timer.h"
+#include "io.h"
+
+#define NS_PER_TICK (1000000000u / TIMER_HZ)
+
+// Kod sayfasına giren fonksiyonlar ve yalnızca onların kullandığı yardımcılar.
+// Yardımcılar her zaman satır içine açılmalı: çekirdeğin .text'ine yapılan
+// bir çağrı kullanıcı adres alanında geçersizdir.
+#define VDSO_TEXT   __attribute__((section(".vdso.text"), used, noinline))
+#define VDSO_INLINE static inline __attribute__((always_inline))
+
+// Kullanıcı tarafının gördüğü veri sayfası
+#define VDATA ((const volatile vdso_data_t*)VDSO_DATA_ADDR)
+
+extern char __vdso_text_start[];
+extern char __vdso_text_end[];
+
+// Kullanıcıya bütün sayfa eşlenir: yapıdan sonrası sıfır kalır, böylece
+// çekirdeğin komşu .bss verisi kullanıcı alanından okunamaz
+static union {
+    vdso_data_t data;
+    u8 bytes[PAGE_SIZE];
+} vdso_page __attribute__((aligned(PAGE_SIZE)));
+
+// Kalibrasyon durumu (yalnızca timer kesmesi yazar)
+static u64 calib_tsc = 0;
+static u32 calib_tick = 0;
+
+VDSO_INLINE u64 vdso_rdtsc() {
+    u32 lo, hi;
+    asm volatile ("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((u64)hi << 32) | lo;
+}
+
+// 64 bit döngü sayısını ns'ye çevirir. Çarpım taşmasın diye üst ve alt
+// yarılar ayrı çarpılır (tsc_shift <= 32).
+VDSO_INLINE u64 vdso_cycles_to_ns(u64 cycles, u32 mult, u32 shift) {
+    u32 hi = (u32)(cycles >> 32);
+    u64 ns = ((u64)(u32)cycles * mult) >> shift;
+    if (hi) ns += ((u64)hi * mult) << (32 - shift);
+    return ns;
+}
+
+// 64 / 32 bölme (libgcc'nin __udivdi3'üne çağrı üretmesin diye)
+VDSO_INLINE u32 vdso_div(u64 n, u32 d, u32* rem) {
+    u32 hi = (u32)(n >> 32);
+    u32 lo = (u32)n;
+    u32 q;
+    asm ("divl %4" : "=a"(q), "=d"(*rem) : "a"(lo), "d"(hi % d), "rm"(d));
+    return q;
+}
+
+VDSO_INLINE u64 vdso_read_clock(const volatile vdso_data_t* d) {
+    u32 seq, mult, shift;
+    u64 base_tsc, base_ns;
+    do {
+        seq = d->seq;
+        asm volatile ("" ::: "memory");
+        mult = d->tsc_mult;
+        shift = d->tsc_shift;
+        base_tsc = d->base_tsc;
+        base_ns = d->base_ns;
+        asm volatile ("" ::: "memory");
+    } while ((seq & 1) || seq != d->seq);
+
+    u64 now = vdso_rdtsc();
+    return base_ns + (now > base_tsc ? vdso_cycles_to_ns(now - base_tsc, mult, shift) : 0);
+}
+
+// --- Kod Sayfası ---
+
+VDSO_TEXT u64 vdso_clock_ns() {
+    return vdso_read_clock(VDATA);
+}
+
+VDSO_TEXT int vdso_clock_gettime(vdso_timespec_t* ts) {
+    u32 rem;
+    u32 sec = vdso_div(vdso_read_clock(VDATA), 1000000000u, &rem);
+    ts->tv_sec = sec;
+    ts->tv_nsec = rem;
+    return 0;
+}
+
+VDSO_TEXT u32 vdso_ticks() {
+    return VDATA->ticks;
+}
+
+VDSO_TEXT u32 vdso_getpid() {
+    return VDATA->pid;
+}
+
+VDSO_TEXT u32 vdso_gettid() {
+    return VDATA->tid;
+}
+
+// --- Çekirdek Tarafı ---
+
+void vdso_init() {
+    vdso_page.data.hz = TIMER_HZ;
+    vdso_page.data.sym[VDSO_SYM_CLOCK_NS] = (u32)vdso_clock_ns - (u32)__vdso_text_start;
+    vdso_page.data.sym[VDSO_SYM_CLOCK_GETTIME] = (u32)vdso_clock_gettime - (u32)__vdso_text_start;
+    vdso_page.data.sym[VDSO_SYM_TICKS] = (u32)vdso_ticks - (u32)__vdso_text_start;
+    vdso_page.data.sym[VDSO_SYM_GETPID] = (u32)vdso_getpid - (u32)__vdso_text_start;
+    vdso_page.data.sym[VDSO_SYM_GETTID] = (u32)vdso_gettid - (u32)__vdso_text_start;
+}
+
+int vdso_map(mm_t* mm) {
+    u32 text_size = ((u32)(__vdso_text_end - __vdso_text_start) + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    if (text_size > VDSO_TEXT_MAX) return -1;
+    if (vmm_map_pinned(mm, VDSO_DATA_ADDR, &vdso_page, sizeof(vdso_page), PROT_READ) < 0) return -1;
+    if (text_size && vmm_map_pinned(mm, VDSO_TEXT_ADDR, __vdso_text_start, text_size,
+                                    PROT_READ | PROT_EXEC) < 0) return -1;
+    return 0;
+}
+
+// TSC'nin tick başına döngü sayısından çarpan ve kaymayı seçer: kayma
+// çarpan 32 bite sığdığı sürece büyük tutulur (hassasiyet için)
+static void vdso_calibrate(u32 cycles_per_tick) {
+    u32 shift = 32;
+    u64 mult;
+    for (;;) {
+        mult = (u64)NS_PER_TICK << shift;
+        divmod64_32(&mult, cycles_per_tick);
+        if (mult <= 0xFFFFFFFF || shift == 0) break;
+        shift--;
+    }
+    vdso_page.data.tsc_mult = (u32)mult;
+    vdso_page.data.tsc_shift = shift;
+}
+
+void vdso_tick(u32 ticks) {
+    u64 now = rdtsc();
+
+    // Seqlock yazıcısı: okuyucular tek `seq` görürse ya da `seq` değişirse tekrar dener
+    vdso_page.data.seq++;
+    asm volatile ("" ::: "memory");
+
+    if (vdso_page.data.tsc_mult) {
+        vdso_page.data.base_ns += vdso_cycles_to_ns(now - vdso_page.data.base_tsc,
+                                                    vdso_page.data.tsc_mult, vdso_page.data.tsc_shift);
+    } else {
+        // Kalibrasyon bitene kadar tick çözünürlüğü
+        vdso_page.data.base_ns += NS_PER_TICK;
+        if (!calib_tick) {
+            calib_tick = ticks;
+            calib_tsc = now;
+        } else if (ticks - calib_tick >= VDSO_CALIB_TICKS) {
+            u64 cycles = now - calib_tsc;
+            divmod64_32(&cycles, ticks - calib_tick);
+            if (cycles && cycles <= 0xFFFFFFFF) vdso_calibrate((u32)cycles);
+        }
+    }
+    vdso_page.data.base_tsc = now;
+    vdso_page.data.ticks = ticks;
+
+    asm volatile ("" ::: "memory");
+    vdso_page.data.seq++;
+}
+
+void vdso_set_current(u32 pid, u32 tid) {
+    vdso_page.data.pid = pid;
+    vdso_page.data.tid = tid;
+}
+
+u64 vdso_clock_ns_kernel() {
+    return vdso_read_clock(&vdso_page.data);
+}
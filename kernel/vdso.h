@@ -0,0 +1,81 @@
+#ifndef VDSO_H
+#define VDSO_H
+
+#include "utils.h"
+
+// --- vDSO (Kullanıcıya Eşlenen Çekirdek Sayfaları) ---
+// Her adres alanının tepesine iki salt-okunur bölge eşlenir:
+//
+//  * Veri sayfası (VDSO_DATA_ADDR): monoton saatin parametreleri (TSC
+//    çarpanı/kayması, son tick'teki TSC ve ns değeri), tick sayacı ve o an
+//    çalışan görevin pid/tid'i. Saat alanları her timer tick'inde bir
+//    seqlock altında güncellenir: yazıcı `seq`i tek yapar, alanları yazar,
+//    yeniden çift yapar; okuyucu `seq` değişmediyse tutarlı bir kopya
+//    okumuştur, değiştiyse tekrar dener. pid/tid görev değişiminde yazılır
+//    (tek işlemci: sayfayı yalnızca o an çalışan görev okur).
+//  * Kod sayfası (VDSO_TEXT_ADDR): veri sayfasını okuyan küçük yardımcı
+//    fonksiyonlar. Çekirdek imajındaki .vdso.text bölümünün kendisidir;
+//    yalnızca birbirini (göreli call ile) ve veri sayfasını (sabit adres)
+//    kullanırlar, bu yüzden çekirdek içindeki adreslerinden bağımsızdır.
+//
+// Böylece getpid ve saat sorguları syscall tuzağı olmadan, birkaç bellek
+// okuması ve bir rdtsc ile yanıtlanır. Fonksiyonların kod sayfasındaki
+// ofsetleri veri sayfasındaki `sym` tablosundadır (VDSO_FN).
+//
+// TSC frekansı açılışta VDSO_CALIB_TICKS tick boyunca PIT'e karşı ölçülür;
+// o zamana kadar saat tick çözünürlüğündedir (mult = 0).
+
+#define VDSO_DATA_ADDR    0xBFFFD000 // USER_TOP - 3 sayfa
+#define VDSO_TEXT_ADDR    0xBFFFE000
+#define VDSO_TEXT_MAX     (2 * PAGE_SIZE)
+
+#define VDSO_CALIB_TICKS  10
+
+// Kod sayfasındaki fonksiyonlar (veri sayfasındaki `sym` indeksleri)
+#define VDSO_SYM_CLOCK_NS      0 // u64 (void): açılıştan beri ns (monoton)
+#define VDSO_SYM_CLOCK_GETTIME 1 // int (vdso_timespec_t*)
+#define VDSO_SYM_TICKS         2 // u32 (void): timer tick sayısı
+#define VDSO_SYM_GETPID        3 // u32 (void): süreç (thread grubu) kimliği
+#define VDSO_SYM_GETTID        4 // u32 (void): thread kimliği
+#define VDSO_NR_SYMS           5
+
+typedef struct {
+    u32 tv_sec;
+    u32 tv_nsec;
+} vdso_timespec_t;
+
+typedef struct {
+    volatile u32 seq;        // Tek: güncelleme sürüyor
+    u32 tsc_mult;            // ns = (döngü * tsc_mult) >> tsc_shift
+    u32 tsc_shift;
+    u64 base_tsc;            // Son tick'teki TSC
+    u64 base_ns;             // Son tick'teki monoton zaman
+    u32 ticks;               // Timer tick sayısı
+    u32 hz;                  // TIMER_HZ
+    volatile u32 pid;        // Çalışan görevin tgid'i
+    volatile u32 tid;
+    u32 sym[VDSO_NR_SYMS];   // Fonksiyonların VDSO_TEXT_ADDR'e göre ofsetleri
+} vdso_data_t;
+
+// Kullanıcı tarafı: bir vDSO fonksiyonuna pointer (örn. VDSO_FN(u32 (*)(void), VDSO_SYM_GETPID)())
+#define VDSO_DATA ((const vdso_data_t*)VDSO_DATA_ADDR)
+#define VDSO_FN(type, sym_index) ((type)(VDSO_TEXT_ADDR + VDSO_DATA->sym[sym_index]))
+
+struct mm;
+
+// Veri sayfasını ve sembol tablosunu hazırlar; timer_init'ten önce çağrılır
+void vdso_init();
+
+// Her adres alanı oluşturulurken çağrılır (vmm_create_mm); hata durumunda -1
+int vdso_map(struct mm* mm);
+
+// Timer kesmesinden her tick'te çağrılır (seqlock yazıcısı)
+void vdso_tick(u32 ticks);
+
+// Görev değişiminde çağrılır
+void vdso_set_current(u32 pid, u32 tid);
+
+// Çekirdek içinden monoton saat (vDSO'nun kullandığı veriyle aynı)
+u64 vdso_clock_ns_kernel();
+
+#endif
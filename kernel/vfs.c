@@ -0,0 +1,205 @@
+#include "vfs.h"
+#include "dcache.h"
+#include "pagecache.h"
+#include "fdtable.h"
+#include "string.h"
+
+static vfs_node_t* vfs_root_node = NULL;
+
+void vfs_initialize(vfs_node_t* root_fs) {
+    dcache_init();
+    vfs_root_node = root_fs;
+    if (root_fs) root_fs->parent = NULL;
+}
+
+vfs_node_t* vfs_root() {
+    return vfs_root_node;
+}
+
+// Önbellek ıskalandığında: dosya sisteminin kendi finddir'i, o yoksa çocuk listesi
+static vfs_node_t* vfs_finddir_slow(vfs_node_t* dir, const char* name, size_t len) {
+    if (dir->finddir) {
+        char buf[MAX_FILENAME_LENGTH];
+        memcpy(buf, name, len);
+        buf[len] = '\0';
+        return dir->finddir(dir, buf);
+    }
+    for (vfs_node_t* child = dir->first_child; child; child = child->next_sibling) {
+        if (strncmp(child->name, name, len) == 0 && child->name[len] == '\0') {
+            return child;
+        }
+    }
+    return NULL;
+}
+
+vfs_node_t* vfs_finddir(vfs_node_t* dir, const char* name, size_t len) {
+    if (!dir || dir->type != FS_NODE_DIRECTORY) return NULL;
+    if (len == 0 || len >= MAX_FILENAME_LENGTH) return NULL;
+
+    vfs_node_t* node;
+    if (dcache_lookup(dir, name, len, &node) != DCACHE_HIT) {
+        node = vfs_finddir_slow(dir, name, len);
+        dcache_insert(dir, name, len, node);
+    }
+    // Bağlama noktası: dcache dizinin kendisini tutar, bağlı kök döner
+    while (node && node->mount) node = node->mount;
+    return node;
+}
+
+int vfs_mount(const char* path, vfs_node_t* fs_root) {
+    vfs_node_t* dir = vfs_lookup(path);
+    if (!dir || !fs_root || dir == vfs_root_node || dir->type != FS_NODE_DIRECTORY) return -1;
+    if (dir->mount) return -1;
+    fs_root->parent = dir->parent;
+    dir->mount = fs_root;
+    return 0;
+}
+
+// `path`'in ilk `len` karakterini bileşen bileşen çözer. Kopya yapılmaz;
+// her bileşen (pointer, uzunluk) olarak doğrudan dcache'e verilir.
+static vfs_node_t* vfs_resolve(const char* path, size_t len) {
+    vfs_node_t* node = vfs_root_node;
+    const char* p = path;
+    const char* end = path + len;
+
+    while (node && p < end) {
+        while (p < end && *p == '/') p++;
+        const char* comp = p;
+        while (p < end && *p != '/') p++;
+        size_t clen = p - comp;
+
+        if (clen == 0 || (clen == 1 && comp[0] == '.')) continue;
+        if (clen == 2 && comp[0] == '.' && comp[1] == '.') {
+            if (node->parent) node = node->parent;
+            continue;
+        }
+        node = vfs_finddir(node, comp, clen);
+    }
+    return node;
+}
+
+vfs_node_t* vfs_lookup(const char* path) {
+    if (!path) return NULL;
+    return vfs_resolve(path, strnlen(path, MAX_PATH_LENGTH));
+}
+
+// Yolun son bileşenini ayırır ve üst dizini çözer. Sondaki '/' karakterleri
+// yok sayılır; `name` NUL ile sonlandırılmış olarak kopyalanır.
+static vfs_node_t* vfs_resolve_parent(const char* path, char name[MAX_FILENAME_LENGTH], size_t* name_len) {
+    size_t len = strnlen(path, MAX_PATH_LENGTH);
+    while (len > 1 && path[len - 1] == '/') len--;
+    size_t name_start = len;
+    while (name_start > 0 && path[name_start - 1] != '/') name_start--;
+    *name_len = len - name_start;
+    if (*name_len == 0 || *name_len >= MAX_FILENAME_LENGTH) return NULL;
+
+    vfs_node_t* parent = vfs_resolve(path, name_start);
+    if (!parent || parent->type != FS_NODE_DIRECTORY) return NULL;
+    memcpy(name, path + name_start, *name_len);
+    name[*name_len] = '\0';
+    return parent;
+}
+
+int vfs_mkdir(const char* path, uint32_t mode) {
+    if (!path) return -1;
+    char name[MAX_FILENAME_LENGTH];
+    size_t name_len;
+    vfs_node_t* parent = vfs_resolve_parent(path, name, &name_len);
+    if (!parent || !parent->mkdir) return -1;
+    if (vfs_finddir(parent, name, name_len)) return -1; // Zaten var
+
+    int ret = parent->mkdir(parent, name, mode);
+    // Yukarıdaki arama negatif bir girdi bıraktı; yeni dizin görünür olmalı
+    dcache_invalidate(parent, name, name_len);
+    return ret;
+}
+
+int vfs_truncate(const char* path, uint32_t length) {
+    vfs_node_t* node = vfs_lookup(path);
+    if (!node || node->type != FS_NODE_FILE || !node->truncate) return -1;
+    return node->truncate(node, length);
+}
+
+size_t vfs_read_node(vfs_node_t* node, uint32_t offset, size_t size, uint8_t* buffer) {
+    if (!node || node->type == FS_NODE_DIRECTORY) return 0;
+    if (node->read) return node->read(node, offset, size, buffer);
+    if (node->page_cache || node->readpage) return pagecache_read(node, offset, size, buffer);
+    return 0;
+}
+
+size_t vfs_write_node(vfs_node_t* node, uint32_t offset, size_t size, const uint8_t* buffer) {
+    if (!node || node->type == FS_NODE_DIRECTORY) return 0;
+    if (node->write) return node->write(node, offset, size, buffer);
+    if (node->page_cache || node->readpage) return pagecache_write(node, offset, size, buffer);
+    return 0;
+}
+
+// --- Dosya Tanıtıcısı Arayüzü ---
+
+file_t* vfs_open_file(const char* path, uint32_t flags) {
+    if (!path) return NULL;
+
+    vfs_node_t* node = vfs_lookup(path);
+    if (!node && (flags & O_CREAT)) {
+        char name[MAX_FILENAME_LENGTH];
+        size_t name_len;
+        vfs_node_t* parent = vfs_resolve_parent(path, name, &name_len);
+        if (!parent || !parent->create || parent->create(parent, name, 0644) < 0) return NULL;
+        dcache_invalidate(parent, name, name_len);
+        node = vfs_finddir(parent, name, name_len);
+    }
+    if (!node) return NULL;
+
+    int writable = (flags & O_ACCMODE) != O_RDONLY;
+    if (node->type == FS_NODE_DIRECTORY && writable) return NULL;
+    if ((flags & O_TRUNC) && writable && node->truncate) node->truncate(node, 0);
+    if (node->open && node->open(node, flags) < 0) return NULL;
+
+    file_t* file = file_alloc(node, flags);
+    if (!file && node->close) node->close(node);
+    return file;
+}
+
+int vfs_open(const char* path, uint32_t flags) {
+    fd_table_t* table = fdtable_current();
+    if (!path || !table) return -1;
+
+    file_t* file = vfs_open_file(path, flags);
+    if (!file) return -1;
+    int fd = fd_install(table, file);
+    if (fd < 0) file_put(file);
+    return fd;
+}
+
+int vfs_close(int fd) {
+    return fd_close(fdtable_current(), fd);
+}
+
+size_t vfs_read(int fd, void* buffer, size_t count) {
+    file_t* file = fd_get(fdtable_current(), fd);
+    if (!file) return (size_t)-1;
+    if ((file->flags & O_ACCMODE) == O_WRONLY) {
+        file_put(file);
+        return (size_t)-1;
+    }
+
+    size_t n = vfs_read_node(file->node, file->offset, count, (uint8_t*)buffer);
+    file->offset += n;
+    file_put(file);
+    return n;
+}
+
+size_t vfs_write(int fd, const void* buffer, size_t count) {
+    file_t* file = fd_get(fdtable_current(), fd);
+    if (!file) return (size_t)-1;
+    if ((file->flags & O_ACCMODE) == O_RDONLY) {
+        file_put(file);
+        return (size_t)-1;
+    }
+
+    if (file->flags & O_APPEND) file->offset = file->node->size;
+    size_t n = vfs_write_node(file->node, file->offset, count, (const uint8_t*)buffer);
+    file->offset += n;
+    file_put(file);
+    return n;
+}
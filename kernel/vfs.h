@@ -0,0 +1,179 @@
+#ifndef VFS_H
+#define VFS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// --- Sanal Dosya Sistemi (VFS) ---
+// Dosya sistemleri vfs_node_t içindeki fonksiyon pointer'larını doldurur.
+// Yol çözümleme her bileşende dentry cache'i (dcache.h) kullanır; bu yüzden
+// bir dizine çocuk ekleyen/silen kod dcache_invalidate() çağırmalıdır.
+
+#define MAX_FILENAME_LENGTH    128
+#define MAX_PATH_LENGTH        1024
+
+// vfs_open bayrakları (Linux değerleri)
+#define O_RDONLY    0x0000
+#define O_WRONLY    0x0001
+#define O_RDWR      0x0002
+#define O_ACCMODE   0x0003
+#define O_CREAT     0x0040
+#define O_TRUNC     0x0200
+#define O_APPEND    0x0400
+
+typedef enum {
+    FS_NODE_FILE,
+    FS_NODE_DIRECTORY,
+    FS_NODE_SYMLINK,
+    FS_NODE_DEVICE
+} fs_node_type_t;
+
+// VFS Düğüm Yapısı (Inode'un soyut hali)
+struct vfs_node;
+struct page_cache;
+struct file;
+struct poll_table;
+typedef struct vfs_node {
+    char name[MAX_FILENAME_LENGTH];
+    fs_node_type_t type;
+    uint32_t flags;
+    uint32_t permissions;
+    uint32_t uid;
+    uint32_t gid;
+    uint32_t size;
+    uint32_t creation_time;
+    uint32_t modification_time;
+
+    // Fonksiyon pointer'ları (Her dosya sistemi bunları kendi implement eder)
+    int (*open)(struct vfs_node* node, uint32_t flags);
+    int (*close)(struct vfs_node* node);
+    size_t (*read)(struct vfs_node* node, uint32_t offset, size_t size, uint8_t* buffer);
+    size_t (*write)(struct vfs_node* node, uint32_t offset, size_t size, const uint8_t* buffer);
+    struct vfs_node* (*finddir)(struct vfs_node* node, const char* name);
+    int (*mkdir)(struct vfs_node* node, const char* name, uint32_t perms);
+    int (*create)(struct vfs_node* node, const char* name, uint32_t perms);
+    int (*truncate)(struct vfs_node* node, uint32_t length);
+    // Hazırlık maskesi (EPOLL*) ve bekleme kuyrukları (epoll.h); NULL: her zaman hazır
+    uint32_t (*poll)(struct vfs_node* node, struct poll_table* pt);
+
+    // Blok tabanlı dosya sistemleri için sayfa önbelleği arayüzü (pagecache.h).
+    // readpage sayfanın tamamını doldurmalı (dosya sonrası sıfır); ikisi de
+    // başarıda 0, hatada negatif döner.
+    int (*readpage)(struct vfs_node* node, uint32_t index, uint8_t* page);
+    int (*writepage)(struct vfs_node* node, uint32_t index, const uint8_t* page);
+    struct page_cache* page_cache; // NULL ise ilk erişimde oluşturulur
+    
+    void* internal_data; // Dosya sistemine özel veri (örn. RamFS için inode'u)
+    struct vfs_node* parent;
+    struct vfs_node* first_child;
+    struct vfs_node* next_sibling;
+    struct vfs_node* mount; // Bu dizine bağlanmış dosya sisteminin kökü (vfs_mount)
+
+} vfs_node_t;
+
+
+// --- VFS Ana Fonksiyonları ---
+
+/**
+ * @brief Sanal dosya sistemini başlatır ve kök olarak bir dosya sistemi bağlar.
+ * @param root_fs Kök olarak bağlanacak dosya sisteminin vfs_node'u.
+ */
+void vfs_initialize(vfs_node_t* root_fs);
+
+/**
+ * @brief Verilen bir yola (path) karşılık gelen VFS düğümünü bulur.
+ * @param path Aranacak yol (örn. "/usr/bin/program").
+ * @return Düğüm bulunduysa pointer'ı, bulunamadıysa NULL.
+ */
+vfs_node_t* vfs_lookup(const char* path);
+
+/**
+ * @brief Bir dizin içinde tek bir isim bileşenini çözer. Önce dentry cache'e
+ *        bakılır; bulunamazsa dosya sisteminin finddir'i (ya da çocuk listesi)
+ *        kullanılır ve sonuç (yokluk dahil) önbelleğe eklenir.
+ * @param dir Aranacak dizin düğümü.
+ * @param name Tek bir yol bileşeni ('/' içermez).
+ * @param len İsmin uzunluğu.
+ * @return Düğüm bulunduysa pointer'ı, bulunamadıysa NULL.
+ */
+vfs_node_t* vfs_finddir(vfs_node_t* dir, const char* name, size_t len);
+
+/**
+ * @brief Bir dosya sistemini var olan bir dizinin üstüne bağlar. Yol
+ *        çözümleme o dizine geldiğinde `fs_root`'a geçer; `fs_root`'tan ".."
+ *        bağlama noktasının üst dizinine çıkar.
+ * @return Başarılıysa 0; dizin yoksa ya da zaten bağlıysa -1.
+ */
+int vfs_mount(const char* path, vfs_node_t* fs_root);
+
+// Kök dizin düğümü (vfs_initialize çağrılmadıysa NULL)
+vfs_node_t* vfs_root();
+
+/**
+ * @brief Bir dosyayı açar.
+ * @param path Dosyanın yolu.
+ * @param flags Açma modları (O_RDONLY, O_WRONLY, O_CREAT vb.).
+ * @return Dosya tanıtıcısı (file descriptor) numarası. Hata durumunda -1.
+ *         Tanıtıcı mevcut sürecin tablosuna (fdtable_current) yerleşir.
+ */
+int vfs_open(const char* path, uint32_t flags);
+
+/**
+ * @brief vfs_open gibi açar ama dosyayı bir tabloya yerleştirmez (örn.
+ *        başka bir görevin tablosuna fd_install_at ile konacaksa).
+ * @return Açık dosya tanımı (refcount = 1); hata durumunda NULL.
+ */
+struct file* vfs_open_file(const char* path, uint32_t flags);
+
+/**
+ * @brief Açık bir dosyayı kapatır.
+ * @param fd Kapatılacak dosyanın tanıtıcısı.
+ */
+int vfs_close(int fd);
+
+/**
+ * @brief Bir dosyadan veri okur.
+ * @param fd Dosya tanıtıcısı.
+ * @param buffer Okunan verinin yazılacağı tampon.
+ * @param count Okunacak byte sayısı.
+ * @return Okunan byte sayısı. Hata durumunda -1.
+ */
+size_t vfs_read(int fd, void* buffer, size_t count);
+
+/**
+ * @brief Bir dosyaya veri yazar.
+ * @param fd Dosya tanıtıcısı.
+ * @param buffer Yazılacak veriyi içeren tampon.
+ * @param count Yazılacak byte sayısı.
+ * @return Yazılan byte sayısı. Hata durumunda -1.
+ */
+size_t vfs_write(int fd, const void* buffer, size_t count);
+
+/**
+ * @brief Yeni bir dizin oluşturur.
+ * @param path Oluşturulacak dizinin yolu.
+ * @param mode İzinler.
+ * @return Başarılıysa 0, hata durumunda negatif bir değer.
+ */
+int vfs_mkdir(const char* path, uint32_t mode);
+
+/**
+ * @brief Bir dosyanın boyutunu değiştirir. Küçültmede aradaki veri atılır,
+ *        büyütmede yeni alan sıfır okunur.
+ * @param path Dosyanın yolu.
+ * @param length Yeni boyut (byte).
+ * @return Başarılıysa 0, hata durumunda negatif bir değer.
+ */
+int vfs_truncate(const char* path, uint32_t length);
+
+/**
+ * @brief Bir düğümden okur/düğüme yazar. Düğüm read/write sağlıyorsa onlar
+ *        çağrılır (RamFS gibi dosya sistemleri bunları önbelleğe yönlendirir);
+ *        sağlamayan blok tabanlı dosya sistemlerinde (readpage) veri doğrudan
+ *        sayfa önbelleği üzerinden akar.
+ * @return Aktarılan byte sayısı.
+ */
+size_t vfs_read_node(vfs_node_t* node, uint32_t offset, size_t size, uint8_t* buffer);
+size_t vfs_write_node(vfs_node_t* node, uint32_t offset, size_t size, const uint8_t* buffer);
+
+#endif
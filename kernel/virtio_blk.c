@@ -0,0 +1,459 @@
+#include "virtio_blk.h"
+#include "blk.h"
+#include "pci.h"
+#include "idt.h"
+#include "io.h"
+#include "pmm.h"
+#include "memory.h"
+#include "sched.h"
+#include "slab.h"
+#include "klog.h"
+#include "string.h"
+
+// Legacy virtio-pci register'ları, BAR0 G/Ç tabanına göre
+#define VIRTIO_REG_HOST_FEATURES  0x00
+#define VIRTIO_REG_GUEST_FEATURES 0x04
+#define VIRTIO_REG_QUEUE_PFN      0x08
+#define VIRTIO_REG_QUEUE_SIZE     0x0C
+#define VIRTIO_REG_QUEUE_SELECT   0x0E
+#define VIRTIO_REG_QUEUE_NOTIFY   0x10
+#define VIRTIO_REG_STATUS         0x12
+#define VIRTIO_REG_ISR            0x13
+#define VIRTIO_REG_CONFIG         0x14 // MSI-X kapalıyken aygıta özel alan
+
+#define VIRTIO_STATUS_ACK       0x01
+#define VIRTIO_STATUS_DRIVER    0x02
+#define VIRTIO_STATUS_DRIVER_OK 0x04
+#define VIRTIO_STATUS_FAILED    0x80
+
+#define VIRTIO_ISR_QUEUE 0x01
+
+// Özellik bitleri
+#define VIRTIO_BLK_F_SIZE_MAX   (1u << 1)
+#define VIRTIO_BLK_F_SEG_MAX    (1u << 2)
+#define VIRTIO_BLK_F_RO         (1u << 5)
+#define VIRTIO_RING_F_EVENT_IDX (1u << 29)
+
+// virtio_blk_config ofsetleri
+#define VIRTIO_BLK_CFG_CAPACITY 0x00 // u64, 512 byte'lık sektör
+#define VIRTIO_BLK_CFG_SIZE_MAX 0x08
+#define VIRTIO_BLK_CFG_SEG_MAX  0x0C
+
+#define VIRTIO_BLK_T_IN  0
+#define VIRTIO_BLK_T_OUT 1
+#define VIRTIO_BLK_S_OK  0
+
+#define VRING_DESC_F_NEXT  1
+#define VRING_DESC_F_WRITE 2 // Aygıt yazar
+#define VRING_USED_F_NO_NOTIFY 1
+
+#define VIRTQ_MAX_SIZE  1024
+#define VIRTQ_ALIGN     PAGE_SIZE
+#define VIRTIO_BLK_MAX_SECTORS 256
+
+typedef struct {
+    u64 addr;
+    u32 len;
+    u16 flags;
+    u16 next;
+} vring_desc_t;
+
+typedef struct {
+    u16 flags;
+    u16 idx;
+    u16 ring[];             // ring[size] sonrasında used_event
+} vring_avail_t;
+
+typedef struct {
+    u32 id;                 // Zincirin baş tanımlayıcısı
+    u32 len;
+} vring_used_elem_t;
+
+typedef struct {
+    u16 flags;
+    u16 idx;
+    vring_used_elem_t ring[]; // ring[size] sonrasında avail_event
+} vring_used_t;
+
+// İstek başlığı ve durum byte'ı: aygıt okur/yazar, req->driver_data'da durur
+typedef struct {
+    u32 type;
+    u32 reserved;
+    u64 sector;
+    volatile u8 status;
+} __attribute__((packed)) virtio_blk_req_t;
+
+typedef struct {
+    u32 requests;           // Halkaya yazılan istekler
+    u32 kicks;              // Aygıta yapılan bildirimler
+    u32 kicks_suppressed;   // Aygıt zaten çalışırken atlananlar
+    u32 irqs;
+    u32 completions;
+} virtio_blk_stats_t;
+
+typedef struct {
+    pci_device_t* pci;
+    u16 io;
+    u8 irq;
+    u8 event_idx;           // VIRTIO_RING_F_EVENT_IDX anlaşıldı
+    u8 read_only;
+
+    u16 size;               // Halkadaki tanımlayıcı sayısı
+    vring_desc_t* desc;
+    vring_avail_t* avail;
+    vring_used_t* used;
+    u16 free_head;          // Boş tanımlayıcılar desc->next ile zincirli
+    u16 num_free;
+    u16 avail_idx;          // Yayımlanan son avail->idx
+    u16 kicked_idx;         // Son kick anındaki avail_idx
+    u16 last_used;          // Toplanan son used->idx
+    u32 max_segments;       // İstek başına veri tanımlayıcısı
+    u32 size_max;           // Tanımlayıcı başına byte (0: sınırsız)
+    blk_request_t* inflight[VIRTQ_MAX_SIZE]; // Baş tanımlayıcıya göre
+
+    volatile int bh_pending;
+    wait_queue_t bh_wait;
+    task_t* bh_task;
+    virtio_blk_stats_t stats;
+    blk_dev_t blk;
+} virtio_blk_t;
+
+static slab_cache_t vreq_cache = SLAB_CACHE_INIT("virtio_blk_req", sizeof(virtio_blk_req_t));
+
+static virtio_blk_t vblks[VIRTIO_BLK_MAX_DEVICES];
+static u32 vblk_count = 0;
+static u8 vblk_log;
+
+// Tam bariyer: avail->idx yazısı ile avail_event/used->flags okuması yer
+// değiştirmemeli (x86'da yalnızca store-load sırası bozulabilir)
+static inline void virtio_mb() {
+    asm volatile ("lock; addl $0, 0(%%esp)" ::: "memory");
+}
+
+// Derleyici bariyeri; x86'da store-store ve load-load sırası donanımca korunur
+static inline void virtio_wmb() {
+    asm volatile ("" ::: "memory");
+}
+
+#define virtio_rmb virtio_wmb
+
+static inline volatile u16* vring_used_event(virtio_blk_t* vb) {
+    return (volatile u16*)&vb->avail->ring[vb->size];
+}
+
+static inline volatile u16* vring_avail_event(virtio_blk_t* vb) {
+    return (volatile u16*)&vb->used->ring[vb->size];
+}
+
+// old..new aralığında yayımlanan indekslerden biri `event` ise bildirim gerekir
+static inline int vring_need_event(u16 event, u16 new_idx, u16 old_idx) {
+    return (u16)(new_idx - event - 1) < (u16)(new_idx - old_idx);
+}
+
+// --- Halka ---
+
+static u32 vring_bytes(u16 size) {
+    u32 first = sizeof(vring_desc_t) * size + sizeof(u16) * (3 + size);
+    first = (first + VIRTQ_ALIGN - 1) & ~(VIRTQ_ALIGN - 1);
+    return first + sizeof(u16) * 3 + sizeof(vring_used_elem_t) * size;
+}
+
+static int vring_setup(virtio_blk_t* vb) {
+    outw(vb->io + VIRTIO_REG_QUEUE_SELECT, 0);
+    u16 size = inw(vb->io + VIRTIO_REG_QUEUE_SIZE);
+    // Boyut 2'nin kuvveti olmalı; legacy arayüzde sürücü değiştiremez
+    if (!size || (size & (size - 1)) || size > VIRTQ_MAX_SIZE) return -1;
+
+    u32 pages = (vring_bytes(size) + PAGE_SIZE - 1) / PAGE_SIZE;
+    u8* ring = (u8*)pmm_alloc_contiguous(pages);
+    if (!ring) return -1;
+    for (u32 i = 0; i < pages; i++) zero_page(ring + i * PAGE_SIZE);
+
+    u32 used_offset = sizeof(vring_desc_t) * size + sizeof(u16) * (3 + size);
+    used_offset = (used_offset + VIRTQ_ALIGN - 1) & ~(VIRTQ_ALIGN - 1);
+    vb->size = size;
+    vb->desc = (vring_desc_t*)ring;
+    vb->avail = (vring_avail_t*)(ring + sizeof(vring_desc_t) * size);
+    vb->used = (vring_used_t*)(ring + used_offset);
+
+    for (u16 i = 0; i < size; i++) vb->desc[i].next = i + 1;
+    vb->free_head = 0;
+    vb->num_free = size;
+
+    outl(vb->io + VIRTIO_REG_QUEUE_PFN, (u32)ring / PAGE_SIZE);
+    return 0;
+}
+
+// Kesmeler kapalıyken çağrılır
+static u16 vring_take_desc(virtio_blk_t* vb) {
+    u16 d = vb->free_head;
+    vb->free_head = vb->desc[d].next;
+    vb->num_free--;
+    return d;
+}
+
+static void vring_free_chain(virtio_blk_t* vb, u16 head) {
+    u16 d = head;
+    while (vb->desc[d].flags & VRING_DESC_F_NEXT) {
+        vb->num_free++;
+        d = vb->desc[d].next;
+    }
+    vb->num_free++;
+    vb->desc[d].next = vb->free_head;
+    vb->free_head = head;
+}
+
+static void vring_set_desc(virtio_blk_t* vb, u16 d, const void* addr, u32 len, u16 flags) {
+    vb->desc[d].addr = (u32)addr;
+    vb->desc[d].len = len;
+    vb->desc[d].flags = flags;
+}
+
+// --- Blok Katmanı Arayüzü ---
+
+// Bellekte bitişik bio'lar tek tanımlayıcıya sığar; gereken veri tanımlayıcısı sayısı
+static u32 virtio_blk_segments(virtio_blk_t* vb, blk_request_t* req) {
+    u32 n = 0;
+    u32 len = 0;
+    u8* end = NULL;
+    for (bio_t* bio = req->bio_head; bio; bio = bio->next) {
+        u32 bytes = bio->count * BLK_SECTOR_SIZE;
+        if (bio->buffer == end && (!vb->size_max || len + bytes <= vb->size_max)) {
+            len += bytes;
+        } else {
+            n++;
+            len = bytes;
+        }
+        end = bio->buffer + bytes;
+    }
+    return n;
+}
+
+static int virtio_blk_start(blk_dev_t* dev, blk_request_t* req) {
+    virtio_blk_t* vb = (virtio_blk_t*)dev->driver_data;
+    int write = req->dir == BLK_WRITE;
+    if (write && vb->read_only) {
+        blk_complete(dev, req, -1);
+        return 0;
+    }
+
+    u32 segments = virtio_blk_segments(vb, req);
+    if (segments + 2 > vb->num_free) return -1; // Halka dolu; tamamlanınca tekrar
+
+    virtio_blk_req_t* hdr = (virtio_blk_req_t*)slab_alloc(&vreq_cache);
+    if (!hdr) return -1;
+    hdr->type = write ? VIRTIO_BLK_T_OUT : VIRTIO_BLK_T_IN;
+    hdr->sector = req->sector;
+    hdr->status = 0xFF;
+    req->driver_data = hdr;
+
+    // Başlık -> veri parçaları -> durum
+    u16 head = vring_take_desc(vb);
+    vring_set_desc(vb, head, hdr, 16, VRING_DESC_F_NEXT);
+    u16 prev = head;
+    u16 data_flags = VRING_DESC_F_NEXT | (write ? 0 : VRING_DESC_F_WRITE);
+    for (bio_t* bio = req->bio_head; bio; bio = bio->next) {
+        u32 bytes = bio->count * BLK_SECTOR_SIZE;
+        vring_desc_t* last = &vb->desc[prev];
+        if (prev != head && (u32)last->addr + last->len == (u32)bio->buffer &&
+            (!vb->size_max || last->len + bytes <= vb->size_max)) {
+            last->len += bytes;
+            continue;
+        }
+        u16 d = vring_take_desc(vb);
+        vring_set_desc(vb, d, bio->buffer, bytes, data_flags);
+        vb->desc[prev].next = d;
+        prev = d;
+    }
+    u16 status = vring_take_desc(vb);
+    vring_set_desc(vb, status, (const void*)&hdr->status, 1, VRING_DESC_F_WRITE);
+    vb->desc[prev].next = status;
+
+    vb->inflight[head] = req;
+    vb->avail->ring[vb->avail_idx & (vb->size - 1)] = head;
+    virtio_wmb(); // Zincir, indeks yayımlanmadan önce görünür olmalı
+    vb->avail_idx++;
+    vb->avail->idx = vb->avail_idx;
+    vb->stats.requests++;
+    return 0;
+}
+
+// Son kick'ten beri yayımlanan istekler için aygıtı bir kez uyarır
+static void virtio_blk_commit(blk_dev_t* dev) {
+    virtio_blk_t* vb = (virtio_blk_t*)dev->driver_data;
+    u16 old_idx = vb->kicked_idx;
+    u16 new_idx = vb->avail_idx;
+    if (old_idx == new_idx) return;
+    vb->kicked_idx = new_idx;
+
+    virtio_mb();
+    int notify = vb->event_idx ? vring_need_event(*vring_avail_event(vb), new_idx, old_idx)
+                               : !(vb->used->flags & VRING_USED_F_NO_NOTIFY);
+    if (!notify) {
+        vb->stats.kicks_suppressed++;
+        return;
+    }
+    outw(vb->io + VIRTIO_REG_QUEUE_NOTIFY, 0);
+    vb->stats.kicks++;
+}
+
+// --- Tamamlanma (Bottom Half) ---
+
+// Kesmeler kapalıyken çağrılır: used halkasındaki bütün istekleri bitirir
+static void virtio_blk_reap(virtio_blk_t* vb) {
+    blk_plug(&vb->blk); // blk_complete her seferinde kick yapmasın
+    for (;;) {
+        while (vb->last_used != vb->used->idx) {
+            virtio_rmb(); // Girdi, indeksten sonra okunmalı
+            vring_used_elem_t* e = &vb->used->ring[vb->last_used & (vb->size - 1)];
+            u16 head = (u16)e->id;
+            vb->last_used++;
+
+            blk_request_t* req = vb->inflight[head];
+            vb->inflight[head] = NULL;
+            vring_free_chain(vb, head);
+            if (!req) continue;
+
+            virtio_blk_req_t* hdr = (virtio_blk_req_t*)req->driver_data;
+            int status = hdr->status == VIRTIO_BLK_S_OK ? 0 : -1;
+            slab_free(&vreq_cache, hdr);
+            vb->stats.completions++;
+            blk_complete(&vb->blk, req, status);
+        }
+        if (!vb->event_idx) break;
+
+        // Aygıt bundan sonraki ilk tamamlanmada kesme üretsin; yazıyla kontrol
+        // arasında gelmiş olanlar kesmesiz kalacağından tekrar bakılır
+        *vring_used_event(vb) = vb->last_used;
+        virtio_mb();
+        if (vb->last_used == vb->used->idx) break;
+    }
+    blk_unplug(&vb->blk); // Boşalan yere kuyruktakiler, tek kick ile
+}
+
+static int virtio_blk_bh_ready(void* arg) {
+    return ((virtio_blk_t*)arg)->bh_pending;
+}
+
+static void virtio_blk_bh(void* arg) {
+    virtio_blk_t* vb = (virtio_blk_t*)arg;
+    for (;;) {
+        u32 flags = irq_save();
+        waitq_wait_event(&vb->bh_wait, virtio_blk_bh_ready, vb);
+        vb->bh_pending = 0;
+        virtio_blk_reap(vb);
+        irq_restore(flags);
+    }
+}
+
+// PCI INTx hattı paylaşılabilir: hattaki her aygıtın ISR'ı okunur (okuma temizler)
+static void virtio_blk_irq() {
+    for (u32 i = 0; i < vblk_count; i++) {
+        virtio_blk_t* vb = &vblks[i];
+        if (!(inb(vb->io + VIRTIO_REG_ISR) & VIRTIO_ISR_QUEUE)) continue;
+        vb->stats.irqs++;
+        vb->bh_pending = 1;
+        waitq_wake_one(&vb->bh_wait, NULL);
+    }
+}
+
+// --- Keşif ---
+
+static int virtio_blk_probe(pci_device_t* dev, const pci_device_id_t* id) {
+    static const char* names[VIRTIO_BLK_MAX_DEVICES] = { "vda", "vdb", "vdc", "vdd" };
+    if (vblk_count == VIRTIO_BLK_MAX_DEVICES) return -1;
+    // Legacy register'lar BAR0'da G/Ç alanı olarak durur
+    if (!dev->bars[0].base || !(dev->bars[0].flags & PCI_BAR_IO)) return -1;
+    if (!dev->irq_pin || dev->irq_line >= 16) return -1;
+
+    virtio_blk_t* vb = &vblks[vblk_count];
+    memset(vb, 0, sizeof(*vb));
+    vb->pci = dev;
+    vb->io = (u16)dev->bars[0].base;
+    vb->irq = dev->irq_line;
+    pci_enable_device(dev);
+    pci_write16(dev, PCI_COMMAND, pci_read16(dev, PCI_COMMAND) & ~PCI_CMD_INTX_OFF);
+
+    // Sıfırla, tanı, özellikleri anlaş
+    u16 io = vb->io;
+    outb(io + VIRTIO_REG_STATUS, 0);
+    outb(io + VIRTIO_REG_STATUS, VIRTIO_STATUS_ACK);
+    outb(io + VIRTIO_REG_STATUS, VIRTIO_STATUS_ACK | VIRTIO_STATUS_DRIVER);
+
+    u32 host = inl(io + VIRTIO_REG_HOST_FEATURES);
+    u32 guest = host & (VIRTIO_BLK_F_SIZE_MAX | VIRTIO_BLK_F_SEG_MAX | VIRTIO_BLK_F_RO |
+                        VIRTIO_RING_F_EVENT_IDX);
+    outl(io + VIRTIO_REG_GUEST_FEATURES, guest);
+    vb->event_idx = (guest & VIRTIO_RING_F_EVENT_IDX) != 0;
+    vb->read_only = (guest & VIRTIO_BLK_F_RO) != 0;
+
+    if (vring_setup(vb) < 0) {
+        outb(io + VIRTIO_REG_STATUS, VIRTIO_STATUS_FAILED);
+        return -1;
+    }
+
+    // En kötü durumda her sektör ayrı bio'dur: istek halkaya her zaman sığmalı
+    vb->max_segments = vb->size - 2;
+    if (guest & VIRTIO_BLK_F_SEG_MAX) {
+        u32 seg_max = inl(io + VIRTIO_REG_CONFIG + VIRTIO_BLK_CFG_SEG_MAX);
+        if (seg_max && seg_max < vb->max_segments) vb->max_segments = seg_max;
+    }
+    u32 max_sectors = vb->max_segments < VIRTIO_BLK_MAX_SECTORS ? vb->max_segments
+                                                                : VIRTIO_BLK_MAX_SECTORS;
+    if (guest & VIRTIO_BLK_F_SIZE_MAX) {
+        vb->size_max = inl(io + VIRTIO_REG_CONFIG + VIRTIO_BLK_CFG_SIZE_MAX);
+        if (vb->size_max && vb->size_max / BLK_SECTOR_SIZE < max_sectors) {
+            max_sectors = vb->size_max / BLK_SECTOR_SIZE;
+        }
+    }
+    if (!max_sectors) max_sectors = 1;
+
+    u32 cap_lo = inl(io + VIRTIO_REG_CONFIG + VIRTIO_BLK_CFG_CAPACITY);
+    u32 cap_hi = inl(io + VIRTIO_REG_CONFIG + VIRTIO_BLK_CFG_CAPACITY + 4);
+
+    waitq_init(&vb->bh_wait);
+    vb->bh_task = kthread_create("virtio_blk", virtio_blk_bh, vb);
+    if (!vb->bh_task) {
+        outb(io + VIRTIO_REG_STATUS, VIRTIO_STATUS_FAILED);
+        return -1;
+    }
+
+    // Aynı hatta önceki bir virtio diski varsa handler zaten kayıtlı
+    int irq_shared = 0;
+    for (u32 i = 0; i < vblk_count; i++) {
+        if (vblks[i].irq == vb->irq) irq_shared = 1;
+    }
+    vblk_count++;
+    if (!irq_shared) irq_register_handler(vb->irq, virtio_blk_irq);
+
+    blk_dev_t* blk = &vb->blk;
+    strlcpy(blk->name, names[vb - vblks], sizeof(blk->name));
+    blk->sector_count = cap_hi ? 0xFFFFFFFFu : cap_lo; // 2 TB üstü kullanılmaz
+    blk->max_sectors = max_sectors;
+    // Her istek en az üç tanımlayıcı (başlık, veri, durum) kullanır
+    blk->queue_depth = vb->size / 3;
+    blk->start = virtio_blk_start;
+    blk->commit = virtio_blk_commit;
+    blk->driver_data = vb;
+    blk_register(blk);
+
+    outb(io + VIRTIO_REG_STATUS, VIRTIO_STATUS_ACK | VIRTIO_STATUS_DRIVER | VIRTIO_STATUS_DRIVER_OK);
+    dev->driver_data = vb;
+
+    KLOG(LOG_LEVEL_INFO, vblk_log, "%s: %u MB, queue %u, irq %u", blk->name, blk->sector_count / 2048,
+         vb->size, vb->irq);
+    return 0;
+}
+
+// 0x1001: geçiş (transitional) blok aygıtı; modern-yalnız 0x1042 MMIO ister
+static const pci_device_id_t virtio_blk_ids[] = {
+    { 0x1AF4, 0x1001, PCI_ANY_ID },
+    { 0, 0, 0 }
+};
+
+static pci_driver_t virtio_blk_driver = { "virtio-blk", virtio_blk_ids, virtio_blk_probe, NULL };
+
+int virtio_blk_init() {
+    vblk_log = klog_component_id("VIRTIO");
+    return pci_register_driver(&virtio_blk_driver);
+}
@@ -0,0 +1,30 @@
+#ifndef VIRTIO_BLK_H
+#define VIRTIO_BLK_H
+
+#include "utils.h"
+
+// --- virtio-blk Disk Sürücüsü ---
+// QEMU/KVM'nin paravirtual diski (-drive if=virtio). Aygıt PCI'da legacy
+// (geçiş) arayüzüyle bulunur: register'lar BAR0'daki G/Ç portlarındadır,
+// tek istek kuyruğu (split virtqueue) bitişik sayfalarda durur. Diskler blok
+// katmanına "vda".."vdd" adıyla kaydedilir.
+//
+//  * Her blok isteği bir tanımlayıcı zinciridir: başlık (tür, sektör), bio
+//    başına bir veri tanımlayıcısı (bellekte bitişik bio'lar birleşir) ve
+//    aygıtın yazdığı durum byte'ı. Halkada yer oldukça birden çok istek
+//    aygıtta bekleyebilir.
+//  * İstekler start'ta halkaya yazılır; aygıt commit'te, blk_run_queue'nun
+//    bir turunda verilen tüm istekler için tek seferde uyarılır (kick).
+//  * VIRTIO_RING_F_EVENT_IDX anlaşılırsa iki yönde de bildirim bastırılır:
+//    aygıt avail_event'i geçmeyen yeni istekler için kick yapılmaz, sürücü
+//    used_event ile yalnızca yakalayamadığı tamamlanmalar için kesme ister.
+//  * Kesme handler'ı yalnızca ISR'ı okuyup alt yarıyı (bottom half) uyandırır;
+//    used halkası aygıt başına bir "virtio_blk" thread'inde toplanır ve o ana
+//    kadar biten bütün istekler blok katmanına tek plug altında bildirilir.
+
+#define VIRTIO_BLK_MAX_DEVICES 4
+
+// pci_init ve sched_init'ten sonra çağrılır. Bulunan disk sayısını döner.
+int virtio_blk_init();
+
+#endif
@@ -0,0 +1,618 @@
+#include "vmm.h"
+#include "vdso.h"
+#include "pagecache.h"
+#include "slab.h"
+#include "memory.h"
+#include "string.h"
+#include "idt.h"
+#include "klog.h"
+#include "fdtable.h"
+#include "shm.h"
+#include "sched.h"
+
+#define PAGE_ALIGN_UP(x) (((x) + PAGE_SIZE - 1) & PTE_FRAME)
+#define PDE_INDEX(a)     ((a) >> 22)
+#define PTE_INDEX(a)     (((a) >> 12) & 1023)
+#define KERNEL_PDES      PDE_INDEX(USER_BASE)
+
+// Page fault hata kodu bitleri
+#define PF_PRESENT 0x1
+#define PF_WRITE   0x2
+
+static u32 kernel_page_dir[1024] __attribute__((aligned(PAGE_SIZE)));
+static mm_t* current_mm = NULL;
+
+static slab_cache_t mm_cache  = SLAB_CACHE_INIT("mm", sizeof(mm_t));
+static slab_cache_t vma_cache = SLAB_CACHE_INIT("vma", sizeof(vma_t));
+
+static inline void vmm_load_cr3(u32* dir) {
+    asm volatile ("mov %0, %%cr3" :: "r"(dir) : "memory");
+}
+
+static inline void vmm_invlpg(mm_t* mm, u32 addr) {
+    if (mm == current_mm) {
+        asm volatile ("invlpg (%0)" :: "r"(addr) : "memory");
+    }
+}
+
+// `addr`'ın sayfa tablosu girdisini döner; create=1 ise eksik tabloyu oluşturur
+static u32* vmm_pte(mm_t* mm, u32 addr, int create) {
+    u32* pde = &mm->page_dir[PDE_INDEX(addr)];
+    if (!(*pde & PTE_PRESENT)) {
+        if (!create) return NULL;
+        u32* table = (u32*)pmm_alloc_zeroed_page();
+        if (!table) return NULL;
+        *pde = (u32)table | PTE_PRESENT | PTE_WRITE | PTE_USER;
+    }
+    u32* table = (u32*)(*pde & PTE_FRAME);
+    return &table[PTE_INDEX(addr)];
+}
+
+// --- VMA AVL Ağacı ---
+// Anahtar VMA'nın başlangıç adresidir. VMA'lar çakışmadığı için bir VMA'nın
+// sınırlarını komşularına taşmadan daraltmak sıralamayı bozmaz.
+
+static inline int vma_height(vma_t* n) {
+    return n ? n->height : 0;
+}
+
+static inline void vma_update(vma_t* n) {
+    int l = vma_height(n->left), r = vma_height(n->right);
+    n->height = 1 + (l > r ? l : r);
+}
+
+static vma_t* vma_rotate_right(vma_t* y) {
+    vma_t* x = y->left;
+    y->left = x->right;
+    x->right = y;
+    vma_update(y);
+    vma_update(x);
+    return x;
+}
+
+static vma_t* vma_rotate_left(vma_t* x) {
+    vma_t* y = x->right;
+    x->right = y->left;
+    y->left = x;
+    vma_update(x);
+    vma_update(y);
+    return y;
+}
+
+static vma_t* vma_balance(vma_t* n) {
+    vma_update(n);
+    int bf = vma_height(n->left) - vma_height(n->right);
+    if (bf > 1) {
+        if (vma_height(n->left->left) < vma_height(n->left->right)) {
+            n->left = vma_rotate_left(n->left);
+        }
+        return vma_rotate_right(n);
+    }
+    if (bf < -1) {
+        if (vma_height(n->right->right) < vma_height(n->right->left)) {
+            n->right = vma_rotate_right(n->right);
+        }
+        return vma_rotate_left(n);
+    }
+    return n;
+}
+
+static vma_t* vma_insert(vma_t* root, vma_t* v) {
+    if (!root) {
+        v->left = v->right = NULL;
+        v->height = 1;
+        return v;
+    }
+    if (v->start < root->start) root->left = vma_insert(root->left, v);
+    else root->right = vma_insert(root->right, v);
+    return vma_balance(root);
+}
+
+static vma_t* vma_remove_min(vma_t* n, vma_t** min) {
+    if (!n->left) {
+        *min = n;
+        return n->right;
+    }
+    n->left = vma_remove_min(n->left, min);
+    return vma_balance(n);
+}
+
+static vma_t* vma_remove(vma_t* root, vma_t* v) {
+    if (!root) return NULL;
+    if (v->start < root->start) {
+        root->left = vma_remove(root->left, v);
+    } else if (v->start > root->start) {
+        root->right = vma_remove(root->right, v);
+    } else {
+        vma_t* l = root->left;
+        vma_t* r = root->right;
+        if (!r) return l;
+        vma_t* min;
+        r = vma_remove_min(r, &min);
+        min->left = l;
+        min->right = r;
+        return vma_balance(min);
+    }
+    return vma_balance(root);
+}
+
+vma_t* vmm_find_vma(mm_t* mm, u32 addr) {
+    vma_t* n = mm->vma_root;
+    while (n) {
+        if (addr < n->start) n = n->left;
+        else if (addr >= n->end) n = n->right;
+        else return n;
+    }
+    return NULL;
+}
+
+// Bitişi `addr`'dan büyük olan ilk VMA (addr'ı içeren ya da sonraki)
+static vma_t* vma_first_after(mm_t* mm, u32 addr) {
+    vma_t* best = NULL;
+    vma_t* n = mm->vma_root;
+    while (n) {
+        if (n->end > addr) {
+            best = n;
+            n = n->left;
+        } else {
+            n = n->right;
+        }
+    }
+    return best;
+}
+
+// USER_MMAP_BASE'den itibaren `length` byte'lık ilk boşluğu bulur
+static u32 vmm_find_gap(mm_t* mm, u32 length) {
+    u32 addr = USER_MMAP_BASE;
+    for (vma_t* v = vma_first_after(mm, addr); v; v = vma_first_after(mm, addr)) {
+        if (v->start >= addr && v->start - addr >= length) break;
+        addr = v->end;
+    }
+    if (addr > USER_TOP || USER_TOP - addr < length) return MAP_FAILED;
+    return addr;
+}
+
+static int vmm_range_free(mm_t* mm, u32 addr, u32 length) {
+    vma_t* v = vma_first_after(mm, addr);
+    return !v || v->start >= addr + length;
+}
+
+// --- Dosya Eşleme Listesi ---
+// Paylaşımlı dosya eşlemeleri dosyanın önbelleğine (page_cache_t::mmap_list)
+// bağlanır; writeback temizlediği sayfanın eşlemelerini buradan bulur.
+// Liste başka görevlerin writeback'inden de okunduğu için preempt_disable
+// altında değişir.
+
+static inline int vma_shared_file(vma_t* v) {
+    return v->file && (v->flags & MAP_SHARED);
+}
+
+static void vma_link_file(vma_t* v) {
+    page_cache_t* c = v->file->page_cache;
+    preempt_disable();
+    v->mmap_next = c->mmap_list;
+    c->mmap_list = v;
+    preempt_enable();
+}
+
+static void vma_unlink_file(vma_t* v) {
+    preempt_disable();
+    for (vma_t** pp = &v->file->page_cache->mmap_list; *pp; pp = &(*pp)->mmap_next) {
+        if (*pp == v) {
+            *pp = v->mmap_next;
+            break;
+        }
+    }
+    v->mmap_next = NULL;
+    preempt_enable();
+}
+
+// --- Sayfa Eşleme ---
+
+// [start, end) aralığındaki sayfaları kaldırır. Girdinin tuttuğu çerçeve
+// referansı (PTE_PRIVATE) PMM'ye bırakılır; önbellek sayfası dosyadan
+// kesildiyse çerçeve son eşlemeyle birlikte serbest kalır.
+static void vmm_unmap_range(mm_t* mm, u32 start, u32 end) {
+    u32 addr = start;
+    while (addr < end) {
+        u32* pte = vmm_pte(mm, addr, 0);
+        if (!pte) {
+            addr = (addr | 0x3FFFFF) + 1; // Tablo yok: sonraki 4 MB'a atla
+            continue;
+        }
+        if (*pte & PTE_PRESENT) {
+            if (*pte & PTE_PRIVATE) pmm_free_page((void*)(*pte & PTE_FRAME));
+            *pte = 0;
+            vmm_invlpg(mm, addr);
+        }
+        addr += PAGE_SIZE;
+    }
+}
+
+int vmm_handle_fault(u32 addr, u32 err_code) {
+    mm_t* mm = current_mm;
+    if (!mm || addr < USER_BASE || addr >= USER_TOP) return -1;
+
+    vma_t* vma = vmm_find_vma(mm, addr);
+    if (!vma || (vma->flags & VM_PINNED)) return -1;
+
+    int write = err_code & PF_WRITE;
+    if (write && !(vma->prot & PROT_WRITE)) return -1;
+    if (!write && !(vma->prot & (PROT_READ | PROT_EXEC))) return -1;
+
+    u32 page_addr = addr & PTE_FRAME;
+    u32* pte = vmm_pte(mm, page_addr, 1);
+    if (!pte) return -1;
+
+    u32 index = vma->pgoff + ((page_addr - vma->start) >> 12);
+    u32 flags = PTE_PRESENT | PTE_USER;
+    u8* page;
+
+    if (vma->shm) {
+        // Paylaşımlı nesne: çerçevesi eşlenir, girdi bir referans tutar
+        if (*pte & PTE_PRESENT) return -1;
+        if (!(page = (u8*)shm_frame(vma->shm, index))) return -1;
+        pmm_page_get(page);
+        flags |= PTE_PRIVATE;
+        if (vma->prot & PROT_WRITE) flags |= PTE_WRITE;
+    } else if (!vma->file) {
+        // Anonim bellek: ilk erişimde sıfır sayfa
+        if (*pte & PTE_PRESENT) return -1;
+        if (!(page = (u8*)pmm_alloc_zeroed_page())) return -1;
+        flags |= PTE_PRIVATE;
+        if (vma->prot & PROT_WRITE) flags |= PTE_WRITE;
+    } else if (vma->flags & MAP_SHARED) {
+        // Paylaşımlı: önbellek sayfasının kendisi eşlenir. Okumada yazılabilir
+        // eşleme bile salt-okunur kurulur; ilk yazma tekrar hata üretir ve
+        // sayfa o anda kirli işaretlenir. Girdi bir referans tutar; dosya
+        // kesilse (truncate) de çerçeve eşleme kalkana kadar yaşar.
+        if (!(page = pagecache_find_page(vma->file, index, 1))) return -1;
+        flags |= PTE_PRIVATE;
+        if (write) {
+            pagecache_set_dirty(vma->file, index);
+            flags |= PTE_WRITE;
+        }
+    } else if (write) {
+        // Özel eşlemeye ilk yazma: önbellek sayfasının kopyası (copy-on-write)
+        int mapped = *pte & PTE_PRESENT;
+        u8* src = mapped ? (u8*)(*pte & PTE_FRAME) : pagecache_find_page(vma->file, index, 0);
+        if ((page = (u8*)pmm_alloc_page())) {
+            if (src) memcpy(page, src, PAGE_SIZE);
+            else zero_page(page);
+        }
+        if (src && !mapped) pmm_free_page(src); // pagecache_find_page'in referansı
+        if (!page) return -1;
+        flags |= PTE_PRIVATE | PTE_WRITE;
+    } else {
+        // Özel eşlemede okuma: kopya yok, önbellek sayfası salt-okunur ve
+        // referansla eşlenir
+        page = pagecache_find_page(vma->file, index, 0);
+        if (page) {
+            flags |= PTE_PRIVATE;
+        } else {
+            // Delik ya da dosya sonu: eşlemeye ait bir sıfır sayfası
+            if (!(page = (u8*)pmm_alloc_zeroed_page())) return -1;
+            flags |= PTE_PRIVATE;
+            if (vma->prot & PROT_WRITE) flags |= PTE_WRITE;
+        }
+    }
+
+    // Yeniden eşlenen girdinin (salt-okunur önbellek sayfası) referansı bırakılır
+    u32 old = *pte;
+    *pte = (u32)page | flags;
+    vmm_invlpg(mm, page_addr);
+    if ((old & PTE_PRESENT) && (old & PTE_PRIVATE)) pmm_free_page((void*)(old & PTE_FRAME));
+    return 0;
+}
+
+u32 vmm_resolve(u32 addr, int write) {
+    if (addr < USER_BASE || addr >= USER_TOP) return addr;
+    if (!current_mm) return 0;
+
+    u32* pte = vmm_pte(current_mm, addr & PTE_FRAME, 0);
+    if (!pte || !(*pte & PTE_PRESENT) || (write && !(*pte & PTE_WRITE))) {
+        if (vmm_handle_fault(addr, write ? PF_WRITE : 0) < 0) return 0;
+        pte = vmm_pte(current_mm, addr & PTE_FRAME, 0);
+    }
+    return (*pte & PTE_FRAME) | (addr & ~PTE_FRAME);
+}
+
+static void vmm_page_fault(u32 int_num, u32 err_code) {
+    u32 addr;
+    asm volatile ("mov %%cr2, %0" : "=r"(addr));
+    if (vmm_handle_fault(addr, err_code) == 0) return;
+
+    KLOG(LOG_LEVEL_FATAL, KLOG_COMP_CORE, "page fault at 0x%08x (err=%x)", addr, err_code);
+    panic("Unhandled page fault");
+}
+
+// --- Genel Arayüz ---
+
+void vmm_init() {
+    // Alt 1 GB: fiziksel belleğin 4 MB'lık sayfalarla kimlik eşlemesi
+    for (u32 i = 0; i < KERNEL_PDES; i++) {
+        kernel_page_dir[i] = (i << 22) | PTE_PRESENT | PTE_WRITE | PTE_PS;
+    }
+
+    u32 cr4, cr0;
+    asm volatile ("mov %%cr4, %0" : "=r"(cr4));
+    asm volatile ("mov %0, %%cr4" :: "r"(cr4 | 0x10)); // CR4.PSE
+    vmm_load_cr3(kernel_page_dir);
+    asm volatile ("mov %%cr0, %0" : "=r"(cr0));
+    asm volatile ("mov %0, %%cr0" :: "r"(cr0 | 0x80000000) : "memory"); // CR0.PG
+
+    exception_register_handler(14, vmm_page_fault);
+}
+
+mm_t* vmm_create_mm() {
+    mm_t* mm = (mm_t*)slab_alloc(&mm_cache);
+    if (!mm) return NULL;
+    mm->page_dir = (u32*)pmm_alloc_zeroed_page();
+    if (!mm->page_dir) {
+        slab_free(&mm_cache, mm);
+        return NULL;
+    }
+    // Çekirdek eşlemeleri paylaşılır, kullanıcı yarısı boş başlar
+    memcpy(mm->page_dir, kernel_page_dir, KERNEL_PDES * sizeof(u32));
+    mm->users = 1;
+    // getpid/saat için syscall'sız sayfalar (vdso.h)
+    if (vdso_map(mm) < 0) {
+        vmm_destroy_mm(mm);
+        return NULL;
+    }
+    return mm;
+}
+
+mm_t* vmm_mm_get(mm_t* mm) {
+    if (mm) __atomic_fetch_add(&mm->users, 1, __ATOMIC_RELAXED);
+    return mm;
+}
+
+void vmm_mm_put(mm_t* mm) {
+    if (mm && __atomic_sub_fetch(&mm->users, 1, __ATOMIC_ACQ_REL) == 0) vmm_destroy_mm(mm);
+}
+
+void vmm_destroy_mm(mm_t* mm) {
+    if (mm == current_mm) vmm_switch(NULL);
+    vmm_munmap(mm, USER_BASE, USER_TOP - USER_BASE);
+    for (u32 i = KERNEL_PDES; i < 1024; i++) {
+        if (mm->page_dir[i] & PTE_PRESENT) pmm_free_page((void*)(mm->page_dir[i] & PTE_FRAME));
+    }
+    pmm_free_page(mm->page_dir);
+    slab_free(&mm_cache, mm);
+}
+
+void vmm_switch(mm_t* mm) {
+    current_mm = mm;
+    vmm_load_cr3(mm ? mm->page_dir : kernel_page_dir);
+}
+
+mm_t* vmm_current() {
+    return current_mm;
+}
+
+// Yer seçer ve VMA'yı ekler; kaynak (dosya / nesne) çağıranlarca denetlenmiştir
+static u32 vmm_map_region(mm_t* mm, u32 addr, u32 length, u32 prot, u32 flags,
+                          vfs_node_t* file, shm_t* shm, u32 offset) {
+    if (length > USER_TOP - USER_BASE) return MAP_FAILED;
+    length = PAGE_ALIGN_UP(length);
+    // Paylaşımlı dosya eşlemesi önbelleğin eşleme listesine girer
+    if (file && (flags & MAP_SHARED) && !pagecache_get(file)) return MAP_FAILED;
+
+    if (flags & MAP_FIXED) {
+        if ((addr & (PAGE_SIZE - 1)) || addr < USER_BASE || addr > USER_TOP - length) return MAP_FAILED;
+        vmm_munmap(mm, addr, length);
+    } else {
+        // Adres sadece bir ipucu: uygun ve boşsa kullanılır
+        addr &= PTE_FRAME;
+        if (addr < USER_BASE || addr > USER_TOP - length || !vmm_range_free(mm, addr, length)) {
+            addr = vmm_find_gap(mm, length);
+            if (addr == MAP_FAILED) return MAP_FAILED;
+        }
+    }
+
+    vma_t* vma = (vma_t*)slab_alloc(&vma_cache);
+    if (!vma) return MAP_FAILED;
+    vma->start = addr;
+    vma->end = addr + length;
+    vma->prot = prot;
+    vma->flags = flags & (MAP_SHARED | MAP_PRIVATE | MAP_ANONYMOUS);
+    vma->file = file;
+    vma->shm = shm;
+    vma->pgoff = offset / PAGE_SIZE;
+    vma->mm = mm;
+    vma->mmap_next = NULL;
+    if (shm) shm_get(shm);
+    if (vma_shared_file(vma)) vma_link_file(vma);
+
+    mm->vma_root = vma_insert(mm->vma_root, vma);
+    mm->map_count++;
+    return addr;
+}
+
+u32 vmm_mmap(mm_t* mm, u32 addr, u32 length, u32 prot, u32 flags, vfs_node_t* file, u32 offset) {
+    u32 type = flags & (MAP_SHARED | MAP_PRIVATE);
+    if (!mm || length == 0 || (type != MAP_SHARED && type != MAP_PRIVATE)) return MAP_FAILED;
+    if (offset & (PAGE_SIZE - 1)) return MAP_FAILED;
+    if (flags & MAP_ANONYMOUS) {
+        file = NULL;
+    } else if (!file || file->type != FS_NODE_FILE) {
+        return MAP_FAILED;
+    }
+    return vmm_map_region(mm, addr, length, prot, flags, file, NULL, offset);
+}
+
+int vmm_map_pinned(mm_t* mm, u32 addr, const void* kaddr, u32 length, u32 prot) {
+    if (!mm || ((u32)kaddr & (PAGE_SIZE - 1)) || length == 0) return -1;
+    if ((addr & (PAGE_SIZE - 1)) || addr < USER_BASE || addr > USER_TOP - PAGE_ALIGN_UP(length) ||
+        !vmm_range_free(mm, addr, PAGE_ALIGN_UP(length))) return -1;
+    if (vmm_map_region(mm, addr, length, prot, MAP_FIXED | MAP_SHARED, NULL, NULL, 0) == MAP_FAILED) return -1;
+    vmm_find_vma(mm, addr)->flags |= VM_PINNED;
+
+    u32 flags = PTE_PRESENT | PTE_USER | ((prot & PROT_WRITE) ? PTE_WRITE : 0);
+    for (u32 off = 0; off < length; off += PAGE_SIZE) {
+        u32* pte = vmm_pte(mm, addr + off, 1);
+        if (!pte) {
+            vmm_munmap(mm, addr, length);
+            return -1;
+        }
+        *pte = ((u32)kaddr + off) | flags;
+        vmm_invlpg(mm, addr + off);
+    }
+    return 0;
+}
+
+u32 vmm_mmap_shm(mm_t* mm, u32 addr, u32 length, u32 prot, u32 flags, shm_t* shm, u32 offset) {
+    if (!mm || !shm || length == 0 || (offset & (PAGE_SIZE - 1))) return MAP_FAILED;
+    if (offset / PAGE_SIZE + PAGE_ALIGN_UP(length) / PAGE_SIZE > shm->nr_pages) return MAP_FAILED;
+    return vmm_map_region(mm, addr, length, prot, (flags & MAP_FIXED) | MAP_SHARED, NULL, shm, offset);
+}
+
+int vmm_munmap(mm_t* mm, u32 addr, u32 length) {
+    if (!mm || (addr & (PAGE_SIZE - 1)) || length == 0) return -1;
+    u32 end = addr + PAGE_ALIGN_UP(length);
+    if (end < addr) end = USER_TOP;
+
+    vma_t* v;
+    while ((v = vma_first_after(mm, addr)) && v->start < end) {
+        u32 s = v->start > addr ? v->start : addr;
+        u32 e = v->end < end ? v->end : end;
+
+        if (s > v->start && e < v->end) {
+            // Ortadan kesiliyor: kuyruk yeni bir VMA olur
+            vma_t* tail = (vma_t*)slab_alloc(&vma_cache);
+            if (!tail) return -1;
+            *tail = *v;
+            if (tail->shm) shm_get(tail->shm);
+            if (vma_shared_file(tail)) vma_link_file(tail);
+            tail->start = e;
+            tail->pgoff = v->pgoff + ((e - v->start) >> 12);
+            v->end = s;
+            mm->vma_root = vma_insert(mm->vma_root, tail);
+            mm->map_count++;
+        } else if (s > v->start) {
+            v->end = s;
+        } else if (e < v->end) {
+            v->pgoff += (e - v->start) >> 12;
+            v->start = e;
+        } else {
+            mm->vma_root = vma_remove(mm->vma_root, v);
+            mm->map_count--;
+            if (v->shm) shm_put(v->shm);
+            if (vma_shared_file(v)) vma_unlink_file(v);
+            slab_free(&vma_cache, v);
+        }
+        vmm_unmap_range(mm, s, e);
+        addr = e;
+    }
+    return 0;
+}
+
+u32 vmm_grant(mm_t* from, u32 from_addr, u32 length, mm_t* to, u32 to_addr, u32 flags) {
+    if (!from || !to || (from_addr & (PAGE_SIZE - 1)) || length == 0) return MAP_FAILED;
+    length = PAGE_ALIGN_UP(length);
+    u32 from_end = from_addr + length;
+    if (from_end < from_addr || from_addr < USER_BASE || from_end > USER_TOP) return MAP_FAILED;
+
+    // Kaynak aralık baştan sona anonim eşlemelerle kaplı olmalı
+    for (u32 a = from_addr; a < from_end;) {
+        vma_t* v = vmm_find_vma(from, a);
+        if (!v || v->file || v->shm || (v->flags & VM_PINNED)) return MAP_FAILED;
+        a = v->end;
+    }
+
+    // Verilen her sayfanın bir çerçevesi olmalı: dokunulmamışları şimdi ayır
+    for (u32 a = from_addr; a < from_end; a += PAGE_SIZE) {
+        u32* pte = vmm_pte(from, a, 1);
+        if (!pte) return MAP_FAILED;
+        if (*pte & PTE_PRESENT) continue;
+        void* page = pmm_alloc_zeroed_page();
+        if (!page) return MAP_FAILED;
+        u32 pflags = PTE_PRESENT | PTE_USER | PTE_PRIVATE;
+        if (vmm_find_vma(from, a)->prot & PROT_WRITE) pflags |= PTE_WRITE;
+        *pte = (u32)page | pflags;
+    }
+
+    u32 prot = PROT_READ | ((flags & GRANT_READONLY) ? 0 : PROT_WRITE);
+    u32 addr = vmm_mmap(to, to_addr, length, prot, MAP_PRIVATE | MAP_ANONYMOUS, NULL, 0);
+    if (addr == MAP_FAILED) return MAP_FAILED;
+    // Sayfa tabloları çerçeveler taşınmadan önce hazır olsun: yarıda kalınmasın
+    for (u32 off = 0; off < length; off += PAGE_SIZE) {
+        if (!vmm_pte(to, addr + off, 1)) {
+            vmm_munmap(to, addr, length);
+            return MAP_FAILED;
+        }
+    }
+
+    u32 pflags = PTE_PRESENT | PTE_USER | PTE_PRIVATE | ((prot & PROT_WRITE) ? PTE_WRITE : 0);
+    for (u32 off = 0; off < length; off += PAGE_SIZE) {
+        u32* src = vmm_pte(from, from_addr + off, 0);
+        u32 frame = *src & PTE_FRAME;
+        if (flags & GRANT_SHARE) {
+            pmm_page_get((void*)frame);
+        } else {
+            *src = 0; // Referans hedefe geçer
+            vmm_invlpg(from, from_addr + off);
+        }
+        *vmm_pte(to, addr + off, 0) = frame | pflags;
+        vmm_invlpg(to, addr + off);
+    }
+    if (!(flags & GRANT_SHARE)) vmm_munmap(from, from_addr, length);
+    return addr;
+}
+
+int vmm_msync(mm_t* mm, u32 addr, u32 length, u32 flags) {
+    if (!mm || (addr & (PAGE_SIZE - 1))) return -1;
+    // MS_ASYNC: sayfalar önbellekte kirli işaretli; bcache flusher'ı
+    // pagecache_writeback_all ile BCACHE_FLUSH_INTERVAL_MS içinde yazar
+    if (!(flags & MS_SYNC)) return 0;
+
+    u32 end = addr + PAGE_ALIGN_UP(length);
+    for (vma_t* v = vma_first_after(mm, addr); v && v->start < end; v = vma_first_after(mm, v->end)) {
+        if (v->file && (v->flags & MAP_SHARED)) pagecache_writeback(v->file);
+    }
+    return 0;
+}
+
+void vmm_page_mkclean(vfs_node_t* node, u32 index) {
+    page_cache_t* c = node->page_cache;
+    for (vma_t* v = c ? c->mmap_list : NULL; v; v = v->mmap_next) {
+        if (index < v->pgoff || index - v->pgoff >= (v->end - v->start) >> 12) continue;
+        u32 addr = v->start + ((index - v->pgoff) << 12);
+        u32* pte = vmm_pte(v->mm, addr, 0);
+        if (pte && (*pte & PTE_WRITE)) {
+            *pte &= ~PTE_WRITE;
+            vmm_invlpg(v->mm, addr); // Diğer adres alanları CR3 yüklenince tazelenir
+        }
+    }
+}
+
+// --- Syscall'lar ---
+
+u32 sys_mmap(u32 args_ptr, ...) {
+    mmap_args_t* args = (mmap_args_t*)args_ptr;
+    if (!args) return MAP_FAILED;
+
+    if (args->flags & MAP_ANONYMOUS)
+        return vmm_mmap(current_mm, args->addr, args->length, args->prot, args->flags, NULL, args->offset);
+
+    // Eşleme kurulana kadar dosya referansı tutulur (başka iş parçacığı fd'yi kapatabilir)
+    file_t* file = fd_get(fdtable_current(), (int)args->fd);
+    if (!file) return MAP_FAILED;
+    u32 ret = MAP_FAILED;
+    u32 acc = file->flags & O_ACCMODE;
+    // Paylaşımlı yazılabilir eşleme dosyaya yazar: tanıtıcı da yazılabilir olmalı
+    if (acc != O_WRONLY &&
+        (!(args->flags & MAP_SHARED) || !(args->prot & PROT_WRITE) || acc == O_RDWR))
+        ret = vmm_mmap(current_mm, args->addr, args->length, args->prot, args->flags, file->node, args->offset);
+    file_put(file);
+    return ret;
+}
+
+u32 sys_munmap(u32 addr, u32 length, ...) {
+    return (u32)vmm_munmap(current_mm, addr, length);
+}
+
+u32 sys_msync(u32 addr, u32 length, u32 flags, ...) {
+    return (u32)vmm_msync(current_mm, addr, length, flags);
+}
@@ -0,0 +1,177 @@
+#ifndef VMM_H
+#define VMM_H
+
+#include <stddef.h>
+#include "utils.h"
+#include "pmm.h"
+#include "vfs.h"
+
+// --- Sanal Bellek Yöneticisi (VMM) ---
+// Her adres alanı (mm_t) kendi sayfa dizinine ve eşleme listesine (VMA) sahiptir.
+// Alt 1 GB tüm adres alanlarında çekirdeğe ait ve fiziksel belleğin kimlik
+// eşlemesidir (4 MB'lık sayfalarla); kullanıcı eşlemeleri USER_BASE üstündedir.
+//
+// Sayfalar eşleme anında değil, ilk erişimde sayfa hatası (page fault) ile
+// getirilir. Dosya eşlemeleri doğrudan dosyanın sayfa önbelleğindeki
+// (pagecache.h) sayfaları gösterir; kopya sadece özel (private) bir eşlemeye
+// ilk kez yazıldığında yapılır (copy-on-write).
+
+#define USER_BASE        PMM_MAX_ADDR  // 1 GB
+#define USER_TOP         0xC0000000    // Kullanıcı alanının sonu (dahil değil)
+#define USER_MMAP_BASE   0x60000000    // Adres verilmeyen mmap'ler buradan itibaren yerleşir
+
+// Sayfa tablosu girdisi bayrakları
+#define PTE_PRESENT   0x001
+#define PTE_WRITE     0x002
+#define PTE_USER      0x004
+#define PTE_PS        0x080 // Sadece sayfa dizininde: 4 MB'lık sayfa
+#define PTE_PRIVATE   0x200 // İşletim sistemine ayrılmış bit: girdi çerçeveye bir PMM referansı tutar
+#define PTE_FRAME     0xFFFFF000
+
+// mmap koruma ve bayrakları (POSIX değerleri)
+#define PROT_NONE     0x0
+#define PROT_READ     0x1
+#define PROT_WRITE    0x2
+#define PROT_EXEC     0x4
+
+#define MAP_SHARED    0x01
+#define MAP_PRIVATE   0x02
+#define MAP_FIXED     0x10
+#define MAP_ANONYMOUS 0x20
+
+#define MS_ASYNC      0x1
+#define MS_SYNC       0x4
+
+#define MAP_FAILED    ((u32)-1)
+
+// vma_t::flags içinde, MAP_* bitlerinin dışında: çerçeveler çekirdeğe aittir
+// (örn. vDSO); sayfa hatasıyla getirilmez, grant edilemez, serbest bırakılmaz
+#define VM_PINNED     0x1000
+
+// vmm_grant bayrakları
+#define GRANT_SHARE    0x1 // Kaynakta da eşli kalır (varsayılan: taşınır)
+#define GRANT_READONLY 0x2 // Hedefte salt-okunur eşlenir
+
+struct shm;
+
+// Sanal bellek alanı (Virtual Memory Area): aynı kaynağa ve korumaya sahip
+// ardışık sayfalar. Her adres alanında başlangıç adresine göre sıralı bir
+// AVL ağacında tutulur.
+typedef struct vma {
+    u32 start;           // Sayfa hizalı
+    u32 end;             // Dahil değil, sayfa hizalı
+    u32 prot;            // PROT_*
+    u32 flags;           // MAP_SHARED / MAP_PRIVATE / MAP_ANONYMOUS, VM_PINNED
+    vfs_node_t* file;    // Anonim eşlemelerde NULL
+    struct shm* shm;     // Paylaşımlı bellek nesnesi eşlemesi (shm.h); değilse NULL
+    u32 pgoff;           // `start`'ın karşılık geldiği dosya sayfası
+    struct mm* mm;       // Eşlemenin ait olduğu adres alanı
+    struct vma* mmap_next; // Paylaşımlı dosya eşlemelerinde: önbelleğin eşleme listesi
+    struct vma* left;
+    struct vma* right;
+    int height;
+} vma_t;
+
+typedef struct mm {
+    u32* page_dir;       // Kimlik eşlemesi sayesinde hem sanal hem fiziksel adres
+    vma_t* vma_root;
+    u32 map_count;
+    u32 users;           // Adres alanını paylaşan thread'ler (vmm_mm_get/put)
+} mm_t;
+
+// mmap syscall'u 6 argüman alır; i386 geleneğine uygun olarak bir yapı
+// pointer'ı ile geçirilir.
+typedef struct {
+    u32 addr;
+    u32 length;
+    u32 prot;
+    u32 flags;
+    u32 fd;
+    u32 offset;
+} mmap_args_t;
+
+/**
+ * @brief Çekirdek sayfa dizinini kurar, sayfalamayı açar ve sayfa hatası
+ *        handler'ını kaydeder. init_pmm()'den sonra çağrılmalıdır.
+ */
+void vmm_init();
+
+// Yeni, boş bir kullanıcı adres alanı (çekirdek eşlemeleri paylaşılır)
+mm_t* vmm_create_mm();
+void vmm_destroy_mm(mm_t* mm);
+
+// Paylaşım sayacı: vmm_create_mm 1 ile başlar, son vmm_mm_put adres alanını yok eder
+mm_t* vmm_mm_get(mm_t* mm);
+void vmm_mm_put(mm_t* mm);
+
+// CR3'ü `mm`'in sayfa dizinine geçirir (NULL ise çekirdek dizini)
+void vmm_switch(mm_t* mm);
+mm_t* vmm_current();
+
+/**
+ * @brief Bir eşleme oluşturur (mmap'in çekirdek tarafı).
+ * @param file Dosya eşlemesi için düğüm; MAP_ANONYMOUS ise NULL.
+ * @param offset Dosya ofseti, sayfa hizalı olmalı.
+ * @return Eşlemenin başlangıç adresi; hata durumunda MAP_FAILED.
+ */
+u32 vmm_mmap(mm_t* mm, u32 addr, u32 length, u32 prot, u32 flags, vfs_node_t* file, u32 offset);
+
+int vmm_munmap(mm_t* mm, u32 addr, u32 length);
+
+/**
+ * @brief Çekirdeğe ait, sayfa hizalı `kaddr`daki belleği `addr`a hemen
+ *        (sayfa hatası beklemeden) eşler. Çerçeveler eşlemeye ait olmaz,
+ *        munmap ya da adres alanının yok edilmesi onları serbest bırakmaz.
+ * @return Başarılıysa 0; aralık dolu ya da bellek yoksa -1.
+ */
+int vmm_map_pinned(mm_t* mm, u32 addr, const void* kaddr, u32 length, u32 prot);
+
+// Paylaşımlı bellek nesnesini eşler (shm_map'in çekirdek tarafı). VMA nesneye
+// bir referans tutar; sayfalar nesnenin çerçeveleridir.
+u32 vmm_mmap_shm(mm_t* mm, u32 addr, u32 length, u32 prot, u32 flags, struct shm* shm, u32 offset);
+
+/**
+ * @brief Anonim bellekteki sayfaları kopyalamadan başka bir adres alanına verir:
+ *        çerçeveler hedefte yeni bir anonim eşlemeye bağlanır. GRANT_SHARE
+ *        yoksa kaynak aralık kaldırılır (taşıma), varsa iki taraf aynı
+ *        çerçeveleri paylaşır. Kaynakta henüz dokunulmamış sayfalar sıfırlanmış
+ *        olarak ayrılır.
+ * @param to_addr Hedef için ipucu (0: uygun ilk yer).
+ * @return Hedefteki adres; kaynak anonim değilse ya da bellek yoksa MAP_FAILED.
+ */
+u32 vmm_grant(mm_t* from, u32 from_addr, u32 length, mm_t* to, u32 to_addr, u32 flags);
+
+// Paylaşımlı dosya eşlemelerindeki kirli sayfaları dosyaya geri yazar
+int vmm_msync(mm_t* mm, u32 addr, u32 length, u32 flags);
+
+/**
+ * @brief Dosyanın `index` sayfasını gösteren bütün paylaşımlı eşlemeleri
+ *        yazmaya karşı korur. Writeback sayfayı temizlerken çağırır; sonraki
+ *        yazma yeniden sayfa hatası üretir ve sayfa tekrar kirli işaretlenir.
+ */
+void vmm_page_mkclean(vfs_node_t* node, u32 index);
+
+// `addr`'ı içeren VMA (yoksa NULL); O(log n)
+vma_t* vmm_find_vma(mm_t* mm, u32 addr);
+
+/**
+ * @brief Sayfa hatasını çözmeye çalışır.
+ * @param err_code CPU'nun verdiği hata kodu (bit 0: koruma, bit 1: yazma, bit 2: kullanıcı).
+ * @return Çözüldüyse 0, geçersiz erişimse -1.
+ */
+int vmm_handle_fault(u32 addr, u32 err_code);
+
+/**
+ * @brief Mevcut adres alanında `addr`ın fiziksel adresini döner; sayfa henüz
+ *        yoksa (ya da `write` istenip salt-okunur/CoW ise) önce hata çözülür.
+ *        Kullanıcı alanı dışındaki adresler birebir eşli kabul edilir.
+ * @return Fiziksel adres; geçersiz erişimse 0.
+ */
+u32 vmm_resolve(u32 addr, int write);
+
+// Syscall arayüzü
+u32 sys_mmap(u32 args_ptr, ...);
+u32 sys_munmap(u32 addr, u32 length, ...);
+u32 sys_msync(u32 addr, u32 length, u32 flags, ...);
+
+#endif
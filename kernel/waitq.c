@@ -0,0 +1,78 @@
+#include "waitq.h"
+#include "io.h"
+#include "sched.h"
+
+void waitq_entry_init(wait_entry_t* entry, wait_func_t func, void* private) {
+    entry->next = entry->prev = 0;
+    entry->func = func;
+    entry->private = private;
+    entry->task = 0;
+    entry->woken = 0;
+}
+
+void waitq_add(wait_queue_t* wq, wait_entry_t* entry) {
+    u32 flags = irq_save();
+    entry->prev = 0;
+    entry->next = wq->head;
+    if (wq->head) wq->head->prev = entry;
+    wq->head = entry;
+    irq_restore(flags);
+}
+
+void waitq_remove(wait_queue_t* wq, wait_entry_t* entry) {
+    u32 flags = irq_save();
+    if (entry->prev) entry->prev->next = entry->next;
+    else if (wq->head == entry) wq->head = entry->next;
+    if (entry->next) entry->next->prev = entry->prev;
+    entry->next = entry->prev = 0;
+    irq_restore(flags);
+}
+
+// Kesmeler kapalıyken çağrılır. `sti; hlt` arasında kesme kaçmaz: sti'den
+// sonraki komut bitmeden kesme kabul edilmez.
+static void waitq_block(wait_entry_t* entry) {
+    entry->task = sched_current();
+    while (!entry->woken) {
+        if (entry->task) sched_block();
+        else asm volatile ("sti; hlt; cli" ::: "memory");
+    }
+}
+
+void waitq_wait_event(wait_queue_t* wq, int (*cond)(void* arg), void* arg) {
+    wait_entry_t entry;
+    waitq_entry_init(&entry, 0, 0);
+
+    u32 flags = irq_save();
+    while (!cond(arg)) {
+        entry.woken = 0;
+        waitq_add(wq, &entry);
+        waitq_block(&entry);
+        waitq_remove(wq, &entry);
+    }
+    irq_restore(flags);
+}
+
+static void waitq_wake(wait_queue_t* wq, void* key, int all) {
+    u32 flags = irq_save();
+    wait_entry_t* e = wq->head;
+    while (e) {
+        wait_entry_t* next = e->next; // Callback kendini kuyruktan çıkarabilir
+        if (e->func) {
+            e->func(e, key);
+        } else if (!e->woken) {
+            e->woken = 1;
+            if (e->task) sched_wake(e->task);
+            if (!all) break;
+        }
+        e = next;
+    }
+    irq_restore(flags);
+}
+
+void waitq_wake_all(wait_queue_t* wq, void* key) {
+    waitq_wake(wq, key, 1);
+}
+
+void waitq_wake_one(wait_queue_t* wq, void* key) {
+    waitq_wake(wq, key, 0);
+}
@@ -0,0 +1,57 @@
+#ifndef WAITQ_H
+#define WAITQ_H
+
+#include "utils.h"
+
+// --- Bekleme Kuyrukları (Wait Queues) ---
+// Bir olayı (I/O tamamlanması, veri gelmesi...) bekleyen görevler olayın
+// kuyruğuna bir wait_entry_t ekler ve uyur. Olayı üreten taraf (çoğu zaman
+// bir kesme handler'ı) waitq_wake_* ile bekleyenleri uyandırır; durum portunu
+// döngüde okumak gerekmez.
+//
+// Her girdinin isteğe bağlı bir uyandırma callback'i vardır. Callback'li
+// girdiler görev uyutmaz; örneğin birden çok kaynağı izleyen bir nesne
+// kendini her kaynağın kuyruğuna callback ile ekleyebilir.
+//
+// Uyuyan görev zamanlayıcıda TASK_BLOCKED olur (sched_block); zamanlayıcı
+// başlatılmadan önce (erken açılış) CPU bir sonraki kesmeye kadar hlt ile
+// durdurulur.
+
+struct wait_entry;
+struct task;
+typedef void (*wait_func_t)(struct wait_entry* entry, void* key);
+
+typedef struct wait_entry {
+    struct wait_entry* next;
+    struct wait_entry* prev;
+    wait_func_t func;       // NULL: varsayılan (uyuyan görevi uyandır)
+    void* private;          // Callback'e ait veri
+    struct task* task;      // Uyuyan görev
+    volatile int woken;
+} wait_entry_t;
+
+typedef struct wait_queue {
+    wait_entry_t* head;
+} wait_queue_t;
+
+#define WAIT_QUEUE_INIT { 0 }
+
+static inline void waitq_init(wait_queue_t* wq) { wq->head = 0; }
+static inline int waitq_active(wait_queue_t* wq) { return wq->head != 0; }
+
+void waitq_entry_init(wait_entry_t* entry, wait_func_t func, void* private);
+void waitq_add(wait_queue_t* wq, wait_entry_t* entry);
+void waitq_remove(wait_queue_t* wq, wait_entry_t* entry);
+
+/**
+ * @brief `cond(arg)` doğru olana kadar çağıranı `wq` üzerinde uyutur.
+ *        Koşul kesmeler kapalıyken kontrol edilir; uyandırma kaçırılmaz.
+ */
+void waitq_wait_event(wait_queue_t* wq, int (*cond)(void* arg), void* arg);
+
+// Tüm bekleyenleri / ilk bekleyeni uyandırır. Kesme bağlamından çağrılabilir.
+// `key` callback'lere olduğu gibi iletilir (örn. hazır olan olay maskesi).
+void waitq_wake_all(wait_queue_t* wq, void* key);
+void waitq_wake_one(wait_queue_t* wq, void* key);
+
+#endif
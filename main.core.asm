@@ -383,6 +383,7 @@ IRQ_STUB 15, 47
 ; --- Ortak ISR Stub'ı ---
 isr_common_stub:
     pushad                  ; Tüm genel amaçlı register'ları (EAX, ECX, EDX, EBX, ESP, EBP, ESI, EDI) kaydet
+    cld                     ; C handler'ı DF=0 bekler (iret kesilenin EFLAGS'ını geri yükler)
     mov ax, ds
     push eax                ; Veri segmentini kaydet
 
@@ -410,6 +411,7 @@ isr_common_stub:
 ; --- Ortak IRQ Stub'ı ---
 irq_common_stub:
     pushad
+    cld                     ; C handler'ı DF=0 bekler
     mov ax, ds
     push eax
 
@@ -527,6 +529,7 @@ cpuid_get_vendor_string:
     push ebx
     push ecx
     push edx
+    push edi
 
     mov eax, 0              ; EAX=0, vendor string için komut.
     cpuid                   ; CPUID komutunu çalıştır.
@@ -538,6 +541,7 @@ cpuid_get_vendor_string:
     mov [edi + 8], ecx
     mov byte [edi + 12], 0  ; String'i null ile sonlandır.
 
+    pop edi
     pop edx
     pop ecx
     pop ebx
@@ -561,6 +565,8 @@ cpuid_check_feature:
     push ebx
     push ecx
     push edx
+    push esi                ; esi/edi cdecl'de çağrılanın korumasındadır.
+    push edi
 
     mov eax, [ebp + 8]      ; Sorgu numarasını al.
     cpuid
@@ -593,6 +599,8 @@ cpuid_check_feature:
     mov eax, 1
 
 .done:
+    pop edi
+    pop esi
     pop edx
     pop ecx
     pop ebx
@@ -852,6 +860,11 @@ keyboard_read_scancode:
 ; onları başlatmamız gerekir. Bu, özellikle çoklu görev (multitasking) sırasında
 ; FPU/SSE durumunu (context) doğru bir şekilde yönetmek için önemlidir.
 
+section .data
+align 4
+global sse_enabled
+sse_enabled         dd 0        ; CR4.OSFXSR set edildiyse 1 (bkz. kernel/memory.c)
+
 section .text
 global fpu_sse_install
 
@@ -881,6 +894,7 @@ fpu_sse_install:
                          ; OSFXSR: FXSAVE/FXRSTOR komutlarını etkinleştirir.
                          ; OSXMMEXCPT: SIMD kayan nokta istisnalarını etkinleştirir.
     mov cr4, eax
+    mov dword [sse_enabled], 1 ; C tarafı artık SSE komutlarını kullanabilir.
     
     ; 4. FPU/SSE birimini başlat (init).
     ;    Bu, FPU kontrol kelimesini varsayılan değerlere ayarlar ve
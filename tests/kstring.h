@@ -0,0 +1,56 @@
+#ifndef KSTRING_H
+#define KSTRING_H
+
+#include <stddef.h>
+
+// Çekirdeğin string/bellek kütüphanesi (kernel/string.c, kernel/memory.c)
+// libc ile aynı programa bağlanabilsin diye sembolleri k_ önekiyle yeniden
+// adlandırılır. Çekirdek kaynakları KSTRING_BUILD tanımlıyken bu dosyayı
+// -include ile alarak derlenir (tests/run.sh); testler k_* isimlerini çağırır.
+
+#ifdef KSTRING_BUILD
+
+#define memcpy   k_memcpy
+#define memset   k_memset
+#define memmove  k_memmove
+#define memcmp   k_memcmp
+#define strlen   k_strlen
+#define strnlen  k_strnlen
+#define strcmp   k_strcmp
+#define strncmp  k_strncmp
+#define strchr   k_strchr
+#define strrchr  k_strrchr
+#define strstr   k_strstr
+#define strlcpy  k_strlcpy
+#define strtok_r k_strtok_r
+#define strtok   k_strtok
+#define strtoul  k_strtoul
+
+#else
+
+void* k_memcpy(void* dest, const void* src, size_t len);
+void* k_memset(void* dest, int val, size_t len);
+void* k_memmove(void* dest, const void* src, size_t len);
+int k_memcmp(const void* a, const void* b, size_t len);
+size_t k_strlen(const char* s);
+size_t k_strnlen(const char* s, size_t maxlen);
+int k_strcmp(const char* s1, const char* s2);
+int k_strncmp(const char* s1, const char* s2, size_t n);
+char* k_strchr(const char* s, int c);
+char* k_strrchr(const char* s, int c);
+char* k_strstr(const char* haystack, const char* needle);
+size_t k_strlcpy(char* dst, const char* src, size_t size);
+char* k_strtok_r(char* str, const char* delim, char** saveptr);
+unsigned long k_strtoul(const char* nptr, char** endptr, int base);
+
+// kernel/memory.c
+void mem_init();
+int mem_sse2_enabled();
+void zero_page(void* page);
+
+// main.core.asm'nin yerine testler tanımlar: 1 ise mem_init SSE2'yi seçer
+extern unsigned int sse_enabled;
+
+#endif
+
+#endif
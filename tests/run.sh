@@ -0,0 +1,34 @@
+#!/bin/sh
+# run.sh - Çekirdek string/bellek kütüphanesinin host testleri
+#
+# Kullanım: sh tests/run.sh          # birim testi (glibc ile karşılaştırma)
+#           sh tests/run.sh bench    # testten sonra ölçümler
+#
+# Çekirdek kodu i386'ya özgü satır içi assembly içerdiğinden testler -m32
+# ile derlenir; 32 bit glibc gerekir (Debian/Ubuntu: gcc-multilib).
+# Derleme çıktıları OUT dizinine (varsayılan: /tmp/mkpp-tests) yazılır.
+
+set -e
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+OUT=${OUT:-${TMPDIR:-/tmp}/mkpp-tests}
+CC=${CC:-gcc}
+
+CFLAGS="-m32 -O2 -g -Wall -Wextra -Wno-unused-parameter"
+# Çekirdek kaynakları: semboller k_ önekiyle (tests/kstring.h), derleyici
+# döngüleri libc çağrılarına çevirmesin diye freestanding
+KFLAGS="$CFLAGS -ffreestanding -fno-builtin -DKSTRING_BUILD -include $ROOT/tests/kstring.h -iquote $ROOT/kernel"
+
+mkdir -p "$OUT"
+$CC $KFLAGS -c "$ROOT/kernel/string.c" -o "$OUT/string.o"
+$CC $KFLAGS -c "$ROOT/kernel/memory.c" -o "$OUT/memory.o"
+
+$CC $CFLAGS -iquote "$ROOT/tests" "$ROOT/tests/string_test.c" "$OUT/string.o" "$OUT/memory.o" \
+    -o "$OUT/string_test"
+"$OUT/string_test"
+
+if [ "$1" = "bench" ]; then
+    $CC $CFLAGS -iquote "$ROOT/tests" "$ROOT/tests/string_bench.c" "$OUT/string.o" "$OUT/memory.o" \
+        -o "$OUT/string_bench"
+    "$OUT/string_bench"
+fi
@@ -0,0 +1,109 @@
+// Çekirdek string/bellek fonksiyonlarının glibc ile karşılaştırmalı ölçümü.
+// Her satır bir fonksiyon ve boyut için çağrı başına ns verir (daha küçük
+// daha iyi). Sonuçlar host işlemcisine ve glibc'nin seçtiği (çoğu zaman
+// AVX2) sürüme bağlıdır; amaç çekirdek sürümlerindeki gerilemeleri görmek.
+//
+// Derleme ve çalıştırma: sh tests/run.sh bench
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "kstring.h"
+
+unsigned int sse_enabled = 1;
+
+static const size_t sizes[] = { 8, 32, 128, 512, 4096, 65536 };
+#define NR_SIZES (sizeof(sizes) / sizeof(sizes[0]))
+
+// Derleyici sonuçları atmasın diye
+static volatile size_t sink;
+
+static unsigned long long now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+// Toplam ~64 MB işleyecek kadar tekrar (küçük boyutlarda en az 1000)
+static unsigned int iterations(size_t size) {
+    unsigned int n = (unsigned int)((64u << 20) / size);
+    return n < 1000 ? 1000 : n;
+}
+
+typedef size_t (*bench_fn_t)(unsigned char* dst, unsigned char* src, size_t size);
+
+#define BENCH_PAIR(name, kexpr, lexpr)                                                  \
+    static size_t kernel_##name(unsigned char* dst, unsigned char* src, size_t size) {  \
+        (void)dst; (void)src; (void)size;                                               \
+        return (size_t)(kexpr);                                                         \
+    }                                                                                   \
+    static size_t libc_##name(unsigned char* dst, unsigned char* src, size_t size) {    \
+        (void)dst; (void)src; (void)size;                                               \
+        return (size_t)(lexpr);                                                         \
+    }
+
+BENCH_PAIR(memcpy,  k_memcpy(dst, src, size),        memcpy(dst, src, size))
+BENCH_PAIR(memmove, k_memmove(dst + 1, dst, size),   memmove(dst + 1, dst, size))
+BENCH_PAIR(memset,  k_memset(dst, 0x5A, size),       memset(dst, 0x5A, size))
+BENCH_PAIR(memcmp,  k_memcmp(dst, src, size),        memcmp(dst, src, size))
+BENCH_PAIR(strlen,  k_strlen((char*)src),            strlen((char*)src))
+BENCH_PAIR(strcmp,  k_strcmp((char*)src, (char*)dst), strcmp((char*)src, (char*)dst))
+BENCH_PAIR(strchr,  k_strchr((char*)src, '!'),       strchr((char*)src, '!'))
+
+typedef struct {
+    const char* name;
+    bench_fn_t kernel;
+    bench_fn_t libc;
+    int string;        // Girdiler `size` uzunluğunda eşit string'ler olmalı
+} bench_t;
+
+static const bench_t benches[] = {
+    { "memcpy",   kernel_memcpy,   libc_memcpy,  0 },
+    { "memmove",  kernel_memmove,  libc_memmove, 0 },
+    { "memset",   kernel_memset,   libc_memset,  0 },
+    { "memcmp",   kernel_memcmp,   libc_memcmp,  0 },
+    { "strlen",   kernel_strlen,   libc_strlen,  1 },
+    { "strcmp",   kernel_strcmp,   libc_strcmp,  1 },
+    { "strchr",   kernel_strchr,   libc_strchr,  1 },
+};
+
+// Çağrı başına süre, ns * 10 (bir ondalık basamak için)
+static unsigned long long run(bench_fn_t fn, unsigned char* dst, unsigned char* src, size_t size) {
+    unsigned int n = iterations(size);
+    unsigned long long best = ~0ull;
+    for (int round = 0; round < 3; round++) {
+        unsigned long long t0 = now_ns();
+        for (unsigned int i = 0; i < n; i++) sink += fn(dst, src, size);
+        unsigned long long t = now_ns() - t0;
+        if (t < best) best = t;
+    }
+    return best * 10 / n;
+}
+
+int main() {
+    size_t max = sizes[NR_SIZES - 1];
+    unsigned char* dst = malloc(max + 64);
+    unsigned char* src = malloc(max + 64);
+    if (!dst || !src) return 2;
+    mem_init();
+
+    printf("%-8s %7s %12s %12s %8s\n", "func", "size", "kernel ns", "glibc ns", "ratio");
+    for (size_t b = 0; b < sizeof(benches) / sizeof(benches[0]); b++) {
+        for (size_t s = 0; s < NR_SIZES; s++) {
+            size_t size = sizes[s];
+            memset(src, 'a', max + 64);
+            memset(dst, 'a', max + 64);
+            if (benches[b].string) {
+                src[size] = '\0';
+                dst[size] = '\0';
+            }
+            unsigned long long k = run(benches[b].kernel, dst, src, size);
+            unsigned long long l = run(benches[b].libc, dst, src, size);
+            unsigned long long ratio = l ? k * 100 / l : 0; // kernel / glibc, yüzde
+            printf("%-8s %7zu %10llu.%llu %10llu.%llu %5llu.%02llu\n", benches[b].name, size,
+                   k / 10, k % 10, l / 10, l % 10, ratio / 100, ratio % 100);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,361 @@
+// Çekirdek string/bellek kütüphanesinin host testi: her fonksiyon glibc'nin
+// karşılığıyla farklı hizalamalarda, uzunluklarda ve (memmove için) çakışan
+// bölgelerde karşılaştırılır. Word-at-a-time fonksiyonlar, string'in hemen
+// arkasında erişilemez bir sayfa varken de çalıştırılır: sonlandırıcıdan
+// sonrasını sayfa sınırı ötesinde okursa test SIGSEGV ile biter.
+//
+// Derleme ve çalıştırma: sh tests/run.sh
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "kstring.h"
+
+#define PAGE 4096
+#define BUF  (3 * PAGE)
+
+unsigned int sse_enabled = 0;
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond, ...) do {                                   \
+    checks++;                                                   \
+    if (!(cond)) {                                              \
+        if (++failures <= 25) {                                 \
+            printf("FAIL %s:%d: ", __func__, __LINE__);         \
+            printf(__VA_ARGS__);                                \
+            printf("\n");                                       \
+        }                                                       \
+    }                                                           \
+} while (0)
+
+static int sign(int v) {
+    return (v > 0) - (v < 0);
+}
+
+static unsigned int rng_state = 0x12345678;
+
+static unsigned int rng() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void fill_random(unsigned char* p, size_t n) {
+    for (size_t i = 0; i < n; i++) p[i] = (unsigned char)rng();
+}
+
+// Rastgele, içinde NUL olmayan (yüksek bitli byte'lar dahil) bir string
+static void fill_string(char* p, size_t len) {
+    for (size_t i = 0; i < len; i++) p[i] = (char)(rng() % 255 + 1);
+    p[len] = '\0';
+}
+
+// İkinci sayfası erişilemez iki sayfalık bölge; ilk sayfanın sonuna yazılan
+// veriden sonrası okunamaz
+static char* guard_alloc() {
+    char* p = mmap(NULL, 2 * PAGE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED || mprotect(p + PAGE, PAGE, PROT_NONE) != 0) {
+        printf("mmap/mprotect failed\n");
+        exit(2);
+    }
+    return p;
+}
+
+// `s`i (sonlandırıcısıyla) korumalı sayfanın en sonuna kopyalar
+static char* at_page_end(char* guard, const char* s) {
+    size_t n = strlen(s) + 1;
+    char* d = guard + PAGE - n;
+    memcpy(d, s, n);
+    return d;
+}
+
+static const size_t big_lengths[] = { 511, 1000, 4095, 4096, 4097, 8191, 8192 };
+#define NR_BIG (sizeof(big_lengths) / sizeof(big_lengths[0]))
+
+// --- mem* ---
+
+static void test_memcpy(unsigned char* a, unsigned char* b, unsigned char* src) {
+    fill_random(src, BUF);
+    for (size_t so = 0; so < 8; so++) {
+        for (size_t d = 0; d < 8; d++) {
+            for (size_t len = 0; len < 300 + NR_BIG; len++) {
+                size_t n = len < 300 ? len : big_lengths[len - 300];
+                memset(a, 0xAA, n + 64);
+                memset(b, 0xAA, n + 64);
+                void* r = k_memcpy(a + d, src + so, n);
+                memcpy(b + d, src + so, n);
+                CHECK(r == a + d, "return value, len %zu", n);
+                CHECK(memcmp(a, b, n + 64) == 0, "src+%zu dst+%zu len %zu", so, d, n);
+            }
+        }
+    }
+}
+
+static void test_memset(unsigned char* a, unsigned char* b) {
+    static const int values[] = { 0, 0x5A, 0xFF, 0x1A5 }; // 0x1A5: yalnızca alt byte kullanılır
+    for (size_t v = 0; v < 4; v++) {
+        for (size_t d = 0; d < 16; d++) {
+            for (size_t len = 0; len < 150 + NR_BIG; len++) {
+                size_t n = len < 150 ? len : big_lengths[len - 150];
+                memset(a, 0x11, n + 64);
+                memset(b, 0x11, n + 64);
+                void* r = k_memset(a + d, values[v], n);
+                memset(b + d, values[v], n);
+                CHECK(r == a + d, "return value, len %zu", n);
+                CHECK(memcmp(a, b, n + 64) == 0, "value 0x%x dst+%zu len %zu (sse2 %d)",
+                      values[v], d, n, mem_sse2_enabled());
+            }
+        }
+    }
+}
+
+// Kaynak ve hedef aynı tamponda: ileri ve geri yönde her kayma miktarı
+static void test_memmove(unsigned char* a, unsigned char* b) {
+    unsigned char pattern[640];
+    fill_random(pattern, sizeof(pattern));
+    for (size_t so = 0; so < 20; so++) {
+        for (size_t d = 0; d < 20; d++) {
+            for (size_t n = 0; n <= 600; n += (n < 40 ? 1 : 37)) {
+                memcpy(a, pattern, sizeof(pattern));
+                memcpy(b, pattern, sizeof(pattern));
+                void* r = k_memmove(a + d, a + so, n);
+                memmove(b + d, b + so, n);
+                CHECK(r == a + d, "return value, len %zu", n);
+                CHECK(memcmp(a, b, sizeof(pattern)) == 0, "src+%zu dst+%zu len %zu", so, d, n);
+            }
+        }
+    }
+
+    // Büyük bloklar, kısa kaymalar
+    for (size_t shift = 1; shift < 9; shift++) {
+        fill_random(a, 2 * PAGE + 16);
+        memcpy(b, a, 2 * PAGE + 16);
+        k_memmove(a + shift, a, 2 * PAGE);
+        memmove(b + shift, b, 2 * PAGE);
+        CHECK(memcmp(a, b, 2 * PAGE + 16) == 0, "forward overlap by %zu", shift);
+        k_memmove(a, a + shift, 2 * PAGE);
+        memmove(b, b + shift, 2 * PAGE);
+        CHECK(memcmp(a, b, 2 * PAGE + 16) == 0, "backward overlap by %zu", shift);
+    }
+}
+
+static void test_memcmp(unsigned char* a, unsigned char* b) {
+    for (size_t o = 0; o < 8; o++) {
+        for (size_t n = 0; n < 80; n++) {
+            fill_random(a + o, n);
+            memcpy(b + (7 - o), a + o, n);
+            CHECK(k_memcmp(a + o, b + (7 - o), n) == 0, "equal, len %zu", n);
+            // Her konumda fark; yüksek bitli byte'lar işaretsiz karşılaştırılmalı
+            for (size_t i = 0; i < n; i++) {
+                unsigned char saved = b[7 - o + i];
+                b[7 - o + i] = (unsigned char)(saved ^ 0x80);
+                CHECK(sign(k_memcmp(a + o, b + (7 - o), n)) == sign(memcmp(a + o, b + (7 - o), n)),
+                      "diff at %zu, len %zu", i, n);
+                b[7 - o + i] = saved;
+            }
+        }
+    }
+}
+
+static void test_zero_page(unsigned char* a) {
+    unsigned char* page = (unsigned char*)(((size_t)a + PAGE - 1) & ~(size_t)(PAGE - 1));
+    memset(page, 0xCC, PAGE + 8);
+    zero_page(page);
+    size_t i = 0;
+    while (i < PAGE && page[i] == 0) i++;
+    CHECK(i == PAGE, "byte %zu not cleared", i);
+    CHECK(page[PAGE] == 0xCC, "wrote past the page");
+}
+
+// --- str* ---
+
+static void test_strlen(char* buf, char* guard) {
+    for (size_t o = 0; o < 8; o++) {
+        for (size_t len = 0; len < 80; len++) {
+            fill_string(buf + o, len);
+            CHECK(k_strlen(buf + o) == len, "offset %zu len %zu", o, len);
+            for (size_t max = 0; max < len + 6; max++) {
+                CHECK(k_strnlen(buf + o, max) == strnlen(buf + o, max),
+                      "strnlen offset %zu len %zu max %zu", o, len, max);
+            }
+            char* end = at_page_end(guard, buf + o);
+            CHECK(k_strlen(end) == len, "at page end, len %zu", len);
+            CHECK(k_strnlen(end, len + 100) == len, "strnlen at page end, len %zu", len);
+        }
+    }
+}
+
+static void test_strcmp(char* s1, char* s2, char* g1, char* g2) {
+    for (size_t o1 = 0; o1 < 4; o1++) {
+        for (size_t o2 = 0; o2 < 4; o2++) {
+            for (size_t len = 0; len < 40; len++) {
+                fill_string(s1 + o1, len);
+                memcpy(s2 + o2, s1 + o1, len + 1);
+                CHECK(k_strcmp(s1 + o1, s2 + o2) == 0, "equal, len %zu", len);
+                CHECK(k_strcmp(at_page_end(g1, s1 + o1), at_page_end(g2, s2 + o2)) == 0,
+                      "equal at page end, len %zu", len);
+
+                for (size_t i = 0; i <= len; i++) {
+                    char saved = s2[o2 + i];
+                    // Fark, kısa string (NUL) ve yüksek bit durumları
+                    static const unsigned char alt[] = { 0x01, 0x7F, 0x80, 0xFF, 0x00 };
+                    for (size_t k = 0; k < sizeof(alt); k++) {
+                        if ((char)alt[k] == saved) continue;
+                        s2[o2 + i] = (char)alt[k];
+                        CHECK(sign(k_strcmp(s1 + o1, s2 + o2)) == sign(strcmp(s1 + o1, s2 + o2)),
+                              "strcmp diff at %zu of %zu (0x%02x)", i, len, alt[k]);
+                        for (size_t n = 0; n <= len + 2; n++) {
+                            CHECK(sign(k_strncmp(s1 + o1, s2 + o2, n)) ==
+                                  sign(strncmp(s1 + o1, s2 + o2, n)),
+                                  "strncmp diff at %zu of %zu, n %zu", i, len, n);
+                        }
+                        CHECK(sign(k_strcmp(at_page_end(g1, s1 + o1), at_page_end(g2, s2 + o2))) ==
+                              sign(strcmp(s1 + o1, s2 + o2)), "strcmp at page end, diff at %zu", i);
+                    }
+                    s2[o2 + i] = saved;
+                }
+            }
+        }
+    }
+}
+
+static void test_strchr(char* buf, char* guard) {
+    for (size_t o = 0; o < 8; o++) {
+        for (size_t len = 0; len < 70; len++) {
+            fill_string(buf + o, len);
+            char* s = buf + o;
+            char* e = at_page_end(guard, s);
+            // Her mevcut karakter, sonlandırıcı, olmayan karakterler ve
+            // int'in yalnızca alt byte'ının kullanılması
+            for (int c = 0; c < 256; c += (c < 8 ? 1 : 13)) {
+                CHECK(k_strchr(s, c) == strchr(s, c), "strchr 0x%x offset %zu len %zu", c, o, len);
+                CHECK(k_strrchr(s, c) == strrchr(s, c), "strrchr 0x%x offset %zu len %zu", c, o, len);
+                CHECK(k_strchr(e, c) == strchr(e, c), "strchr at page end 0x%x len %zu", c, len);
+                CHECK(k_strrchr(e, c) == strrchr(e, c), "strrchr at page end 0x%x len %zu", c, len);
+            }
+            for (size_t i = 0; i < len; i++) {
+                int c = (unsigned char)s[i];
+                CHECK(k_strchr(s, c) == strchr(s, c), "strchr present char at %zu", i);
+                CHECK(k_strrchr(s, c) == strrchr(s, c), "strrchr present char at %zu", i);
+                CHECK(k_strchr(s, c | 0x100) == strchr(s, c | 0x100), "strchr int 0x%x", c | 0x100);
+            }
+        }
+    }
+}
+
+static void test_strstr() {
+    static const char* const hay[] = { "", "a", "abc", "aaab", "hello world", "abababac", "/usr/bin/sh" };
+    static const char* const needle[] = { "", "a", "b", "ab", "abac", "world", "bin/", "x", "aaaab" };
+    for (size_t h = 0; h < sizeof(hay) / sizeof(hay[0]); h++) {
+        for (size_t n = 0; n < sizeof(needle) / sizeof(needle[0]); n++) {
+            CHECK(k_strstr(hay[h], needle[n]) == strstr(hay[h], needle[n]),
+                  "strstr(\"%s\", \"%s\")", hay[h], needle[n]);
+        }
+    }
+}
+
+// glibc 2.38 öncesinde strlcpy yok: beklenen sonuç elle hesaplanır
+static void test_strlcpy() {
+    char src[64], dst[80];
+    for (size_t len = 0; len < 40; len++) {
+        fill_string(src, len);
+        for (size_t size = 0; size < 48; size++) {
+            memset(dst, 0x55, sizeof(dst));
+            size_t r = k_strlcpy(dst, src, size);
+            CHECK(r == len, "return %zu, want %zu", r, len);
+            if (size == 0) {
+                CHECK((unsigned char)dst[0] == 0x55, "wrote with size 0");
+                continue;
+            }
+            size_t copied = len < size - 1 ? len : size - 1;
+            CHECK(memcmp(dst, src, copied) == 0 && dst[copied] == '\0',
+                  "len %zu size %zu", len, size);
+            CHECK((unsigned char)dst[size] == 0x55, "wrote past size %zu", size);
+        }
+    }
+}
+
+static void test_strtok_r() {
+    static const char* const inputs[] = {
+        "", "   ", "a", "  a  b ", "ls -l /bin", "a,,b;;c", "|x|y|", "cat f | grep x > out",
+    };
+    static const char* const delims[] = { " ", ",;", " |>", "" };
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+        for (size_t d = 0; d < sizeof(delims) / sizeof(delims[0]); d++) {
+            char a[64], b[64];
+            char *sa, *sb;
+            strcpy(a, inputs[i]);
+            strcpy(b, inputs[i]);
+            char* ta = k_strtok_r(a, delims[d], &sa);
+            char* tb = strtok_r(b, delims[d], &sb);
+            for (int n = 0; n < 16; n++) {
+                CHECK((ta == NULL) == (tb == NULL), "\"%s\" / \"%s\" token %d", inputs[i], delims[d], n);
+                if (!ta || !tb) break;
+                CHECK(ta - a == tb - b && strcmp(ta, tb) == 0,
+                      "\"%s\" / \"%s\" token %d: \"%s\" vs \"%s\"", inputs[i], delims[d], n, ta, tb);
+                ta = k_strtok_r(NULL, delims[d], &sa);
+                tb = strtok_r(NULL, delims[d], &sb);
+            }
+        }
+    }
+}
+
+static void test_strtoul() {
+    static const char* const inputs[] = {
+        "0", "42", "  +17", "-1", "\t99x", "0x1F", "0X1f", "0x", "0xg", "017", "08", "09",
+        "z", "Zz", "4294967295", "4294967296", "99999999999", "0xFFFFFFFF", "0x100000000",
+        "", "   ", "+", "-0x10", "1010", "0b", "777", "deadbeef",
+    };
+    static const int bases[] = { 0, 2, 8, 10, 16, 36, 1, 37 };
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+        for (size_t b = 0; b < sizeof(bases) / sizeof(bases[0]); b++) {
+            char *ea, *eb;
+            unsigned long ra = k_strtoul(inputs[i], &ea, bases[b]);
+            unsigned long rb = strtoul(inputs[i], &eb, bases[b]);
+            CHECK(ra == rb && ea == eb, "strtoul(\"%s\", %d): %lu/+%d vs %lu/+%d", inputs[i], bases[b],
+                  ra, (int)(ea - inputs[i]), rb, (int)(eb - inputs[i]));
+        }
+    }
+
+    // 0b öneki çekirdeğe özgü (glibc 2.38 öncesi desteklemez)
+    char* end;
+    CHECK(k_strtoul("0b1011", &end, 0) == 11 && *end == '\0', "0b prefix");
+    CHECK(k_strtoul("0b1011", &end, 2) == 11 && *end == '\0', "0b prefix, base 2");
+    CHECK(k_strtoul("0b2", &end, 0) == 0 && *end == 'b', "0b without digits");
+}
+
+int main() {
+    unsigned char* a = malloc(BUF + PAGE);
+    unsigned char* b = malloc(BUF + PAGE);
+    unsigned char* src = malloc(BUF + PAGE);
+    char* g1 = guard_alloc();
+    char* g2 = guard_alloc();
+    if (!a || !b || !src) return 2;
+
+    // Önce rep movs/stos yolları, sonra (varsa) SSE2 yolları
+    for (int pass = 0; pass < 2; pass++) {
+        sse_enabled = pass;
+        mem_init();
+        if (pass && !mem_sse2_enabled()) break;
+        test_memcpy(a, b, src);
+        test_memset(a, b);
+        test_memmove(a, b);
+        test_memcmp(a, b);
+        test_zero_page(a);
+    }
+
+    test_strlen((char*)a, g1);
+    test_strcmp((char*)a, (char*)b, g1, g2);
+    test_strchr((char*)a, g1);
+    test_strstr();
+    test_strlcpy();
+    test_strtok_r();
+    test_strtoul();
+
+    printf("%d checks, %d failures\n", checks, failures);
+    return failures != 0;
+}